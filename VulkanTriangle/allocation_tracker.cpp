@@ -0,0 +1,247 @@
+// ================================================================================
+// ================================================================================
+// - File:    allocation_tracker.cpp
+// - Purpose: Contains the implementation for allocation_tracker.hpp
+//
+// Source Metadata
+// - Author:  Jonathan A. Webb
+// - Date:    October 18, 2026
+// - Version: 1.0
+// - Copyright: Copyright 2022, Jon Webb Inc.
+// ================================================================================
+// ================================================================================
+// Include modules here
+
+#include "include/allocation_tracker.hpp"
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#include <execinfo.h>
+#include <unistd.h>
+// ================================================================================
+// ================================================================================
+
+// Everything touched inside operator new is trivially constructible, so none
+// of it allocates or needs dynamic initialization
+namespace {
+    const uint64_t NO_LIMIT = ~0ull;
+    const int MAX_STACK_DEPTH = 32;
+
+    // Stack traces are only printed for the first few violations so a frame
+    // that allocates every time does not flood the log
+    const uint32_t MAX_LOGGED_VIOLATIONS = 16;
+
+    struct ThreadState {
+        uint64_t allocations;
+        uint64_t bytes;
+        uint64_t limit;
+        AllocationViolation action;
+        bool reporting;
+    };
+
+    thread_local ThreadState threadState = {0, 0, NO_LIMIT, AllocationViolation::Count, false};
+    std::atomic<uint64_t> totalAllocations{0};
+    std::atomic<uint64_t> totalBytes{0};
+    std::atomic<uint32_t> loggedViolations{0};
+}
+// ================================================================================
+// ================================================================================
+
+#ifdef TRACK_ALLOCATIONS
+
+/**
+ * @brief Prints the allocation and the stack that made it to stderr, using
+ * only calls that do not allocate
+ */
+static void reportViolation(size_t size) {
+    ThreadState& state = threadState;
+    if (loggedViolations.fetch_add(1, std::memory_order_relaxed) >= MAX_LOGGED_VIOLATIONS &&
+        state.action != AllocationViolation::Abort) {
+        return;
+    }
+
+    char message[128];
+    int length = std::snprintf(message, sizeof(message),
+                               "allocation of %zu bytes past the allocation budget!\n", size);
+    if (length > 0 && write(STDERR_FILENO, message, static_cast<size_t>(length)) < 0) {
+        return;
+    }
+
+    void* frames[MAX_STACK_DEPTH];
+    int depth = backtrace(frames, MAX_STACK_DEPTH);
+    backtrace_symbols_fd(frames, depth, STDERR_FILENO);
+}
+// --------------------------------------------------------------------------------
+
+/**
+ * @brief Counts an allocation and checks it against the thread's budget
+ */
+static void countAllocation(size_t size) {
+    ThreadState& state = threadState;
+    state.allocations++;
+    state.bytes += size;
+    totalAllocations.fetch_add(1, std::memory_order_relaxed);
+    totalBytes.fetch_add(size, std::memory_order_relaxed);
+
+    // Reporting can allocate the first time backtrace() loads its unwinder,
+    // which must not be reported again
+    if (state.allocations > state.limit && !state.reporting &&
+        state.action != AllocationViolation::Count) {
+        state.reporting = true;
+        reportViolation(size);
+        state.reporting = false;
+        if (state.action == AllocationViolation::Abort) {
+            std::abort();
+        }
+    }
+}
+// --------------------------------------------------------------------------------
+
+static void* allocate(size_t size) {
+    countAllocation(size);
+    void* pointer = std::malloc(size == 0 ? 1 : size);
+    if (pointer == nullptr) {
+        throw std::bad_alloc();
+    }
+    return pointer;
+}
+// --------------------------------------------------------------------------------
+
+static void* allocateAligned(size_t size, std::align_val_t alignment) {
+    countAllocation(size);
+    size_t align = static_cast<size_t>(alignment);
+    void* pointer = nullptr;
+    if (posix_memalign(&pointer, align < sizeof(void*) ? sizeof(void*) : align, size == 0 ? 1 : size) != 0) {
+        throw std::bad_alloc();
+    }
+    return pointer;
+}
+// ================================================================================
+// ================================================================================
+
+void* operator new(size_t size) {
+    return allocate(size);
+}
+// --------------------------------------------------------------------------------
+
+void* operator new[](size_t size) {
+    return allocate(size);
+}
+// --------------------------------------------------------------------------------
+
+void* operator new(size_t size, const std::nothrow_t&) noexcept {
+    try {
+        return allocate(size);
+    } catch (const std::bad_alloc&) {
+        return nullptr;
+    }
+}
+// --------------------------------------------------------------------------------
+
+void* operator new[](size_t size, const std::nothrow_t&) noexcept {
+    try {
+        return allocate(size);
+    } catch (const std::bad_alloc&) {
+        return nullptr;
+    }
+}
+// --------------------------------------------------------------------------------
+
+void* operator new(size_t size, std::align_val_t alignment) {
+    return allocateAligned(size, alignment);
+}
+// --------------------------------------------------------------------------------
+
+void* operator new[](size_t size, std::align_val_t alignment) {
+    return allocateAligned(size, alignment);
+}
+// --------------------------------------------------------------------------------
+
+void operator delete(void* pointer) noexcept {
+    std::free(pointer);
+}
+// --------------------------------------------------------------------------------
+
+void operator delete[](void* pointer) noexcept {
+    std::free(pointer);
+}
+// --------------------------------------------------------------------------------
+
+void operator delete(void* pointer, size_t) noexcept {
+    std::free(pointer);
+}
+// --------------------------------------------------------------------------------
+
+void operator delete[](void* pointer, size_t) noexcept {
+    std::free(pointer);
+}
+// --------------------------------------------------------------------------------
+
+void operator delete(void* pointer, std::align_val_t) noexcept {
+    std::free(pointer);
+}
+// --------------------------------------------------------------------------------
+
+void operator delete[](void* pointer, std::align_val_t) noexcept {
+    std::free(pointer);
+}
+// --------------------------------------------------------------------------------
+
+void operator delete(void* pointer, size_t, std::align_val_t) noexcept {
+    std::free(pointer);
+}
+// --------------------------------------------------------------------------------
+
+void operator delete[](void* pointer, size_t, std::align_val_t) noexcept {
+    std::free(pointer);
+}
+// ================================================================================
+// ================================================================================
+
+bool AllocationTracker::isEnabled() {
+    return true;
+}
+
+#else
+
+bool AllocationTracker::isEnabled() {
+    return false;
+}
+
+#endif /* TRACK_ALLOCATIONS */
+// --------------------------------------------------------------------------------
+
+AllocationCounters AllocationTracker::getThreadCounters() {
+    return {threadState.allocations, threadState.bytes};
+}
+// --------------------------------------------------------------------------------
+
+AllocationCounters AllocationTracker::getTotalCounters() {
+    return {totalAllocations.load(std::memory_order_relaxed),
+            totalBytes.load(std::memory_order_relaxed)};
+}
+// ================================================================================
+// ================================================================================
+
+AllocationBudget::AllocationBudget(uint64_t budget, AllocationViolation action)
+    : start(threadState.allocations),
+      previousLimit(threadState.limit),
+      previousAction(threadState.action) {
+    threadState.limit = budget >= NO_LIMIT - start ? NO_LIMIT : start + budget;
+    threadState.action = action;
+}
+// --------------------------------------------------------------------------------
+
+AllocationBudget::~AllocationBudget() {
+    threadState.limit = previousLimit;
+    threadState.action = previousAction;
+}
+// --------------------------------------------------------------------------------
+
+uint64_t AllocationBudget::getAllocations() const {
+    return threadState.allocations - start;
+}
+// ================================================================================
+// ================================================================================
+// eof
@@ -13,8 +13,15 @@
 // Include modules here
 
 #include "include/application.hpp"
+#include "include/constants.hpp"
+#include "include/host_allocator.hpp"
+#include <array>
 #include <vector>
 #include <iostream>
+#include <thread>
+#include <exception>
+#include <algorithm>
+#include <chrono>
 // ================================================================================
 // ================================================================================
 
@@ -28,12 +35,12 @@ VulkanInstance::VulkanInstance(std::unique_ptr<Window>& window, std::unique_ptr<
 
 VulkanInstance::~VulkanInstance() {
     if (surface != VK_NULL_HANDLE) {
-        vkDestroySurfaceKHR(instance, surface, nullptr);
+        vkDestroySurfaceKHR(instance, surface, hostAllocator(VK_OBJECT_TYPE_SURFACE_KHR));
     }
 
     if (instance != VK_NULL_HANDLE) {
         validationLayers->cleanup(instance);
-        vkDestroyInstance(instance, nullptr);
+        vkDestroyInstance(instance, hostAllocator(VK_OBJECT_TYPE_INSTANCE));
     }
 }
 // --------------------------------------------------------------------------------
@@ -95,7 +102,7 @@ void VulkanInstance::createInstance() {
     }
 
     // Create the Vulkan instance
-    if (vkCreateInstance(&createInfo, nullptr, &instance) != VK_SUCCESS) {
+    if (vkCreateInstance(&createInfo, hostAllocator(VK_OBJECT_TYPE_INSTANCE), &instance) != VK_SUCCESS) {
         throw std::runtime_error("Failed to Create Vulkan Instance!");
     }
 
@@ -106,24 +113,163 @@ void VulkanInstance::createInstance() {
 // --------------------------------------------------------------------------------
 
 void VulkanInstance::createSurface() {
-    if (window->createWindowSurface(instance, nullptr, &surface) != VK_SUCCESS)
+    if (window->createWindowSurface(instance, hostAllocator(VK_OBJECT_TYPE_SURFACE_KHR), &surface) != VK_SUCCESS)
         throw std::runtime_error("Failed to create window surface\n");
 }
 // ================================================================================
 // ================================================================================
 
+HeadlessVulkanInstance::HeadlessVulkanInstance(std::unique_ptr<ValidationLayers>& validationLayers)
+    : validationLayers(validationLayers) {
+    if (validationLayers->isEnabled() && !validationLayers->checkValidationLayerSupport()) {
+        throw std::runtime_error("validation layers requested, but not available!");
+    }
+
+    VkApplicationInfo appInfo{};
+    appInfo.sType = VK_STRUCTURE_TYPE_APPLICATION_INFO;
+    appInfo.pApplicationName = "VulkanTriangle";
+    appInfo.applicationVersion = VK_MAKE_VERSION(0, 1, 0);
+    appInfo.pEngineName = "No Engine";
+    appInfo.engineVersion = VK_MAKE_VERSION(1, 0, 0);
+    appInfo.apiVersion = VK_API_VERSION_1_3;
+
+    // No surface is created, so only the debug utils extension may be needed
+    std::vector<const char*> extensions;
+    if (validationLayers->isEnabled()) {
+        extensions = validationLayers->getRequiredExtensions();
+    }
+
+    VkInstanceCreateInfo createInfo{};
+    createInfo.sType = VK_STRUCTURE_TYPE_INSTANCE_CREATE_INFO;
+    createInfo.pApplicationInfo = &appInfo;
+    createInfo.enabledExtensionCount = static_cast<uint32_t>(extensions.size());
+    createInfo.ppEnabledExtensionNames = extensions.data();
+
+    VkDebugUtilsMessengerCreateInfoEXT debugCreateInfo{};
+    if (validationLayers->isEnabled()) {
+        createInfo.enabledLayerCount = static_cast<uint32_t>(validationLayers->getValidationLayers().size());
+        createInfo.ppEnabledLayerNames = validationLayers->getValidationLayers().data();
+        validationLayers->populateDebugMessengerCreateInfo(debugCreateInfo);
+        createInfo.pNext = &debugCreateInfo;
+    }
+
+    if (vkCreateInstance(&createInfo, hostAllocator(VK_OBJECT_TYPE_INSTANCE), &instance) != VK_SUCCESS) {
+        throw std::runtime_error("Failed to Create Vulkan Instance!");
+    }
+
+    if (validationLayers->isEnabled()) {
+        validationLayers->setupDebugMessenger(instance);
+    }
+}
+// --------------------------------------------------------------------------------
+
+HeadlessVulkanInstance::~HeadlessVulkanInstance() {
+    if (instance != VK_NULL_HANDLE) {
+        validationLayers->cleanup(instance);
+        vkDestroyInstance(instance, hostAllocator(VK_OBJECT_TYPE_INSTANCE));
+    }
+}
+// --------------------------------------------------------------------------------
+
+VkInstance* HeadlessVulkanInstance::getInstance() {
+    return &instance;
+}
+// --------------------------------------------------------------------------------
+
+VkSurfaceKHR HeadlessVulkanInstance::getSurface() const {
+    return VK_NULL_HANDLE;
+}
+// ================================================================================
+// ================================================================================
+
 HelloTriangleApplication::HelloTriangleApplication(std::unique_ptr<Window> window,
                                                    std::unique_ptr<CreateVulkanInstance> vulkanInstanceCreator,
                                                    std::unique_ptr<VulkanPhysicalDevice> physicalDevice,
                                                    std::unique_ptr<VulkanLogicalDevice> logicalDevice,
+                                                   std::unique_ptr<ResidencyManager> residency,
+                                                   std::unique_ptr<JobSystem> jobs,
                                                    std::unique_ptr<SwapChain> swapChain,
+                                                   std::unique_ptr<UniformRingBuffer> uniformBuffer,
+                                                   std::unique_ptr<PipelineStateCache> pipelineCache,
+                                                   std::unique_ptr<ObjectCache> objectCache,
                                                    std::unique_ptr<GraphicsPipeline> pipeline)
     : windowInstance(std::move(window)), 
       vulkanInstanceCreator(std::move(vulkanInstanceCreator)), 
       physicalDevice(std::move(physicalDevice)),
       logicalDevice(std::move(logicalDevice)),
+      residency(std::move(residency)),
+      jobs(std::move(jobs)),
       swapChain(std::move(swapChain)),
-      pipeline(std::move(pipeline)){}
+      uniformBuffer(std::move(uniformBuffer)),
+      pipelineCache(std::move(pipelineCache)),
+      objectCache(std::move(objectCache)),
+      pipeline(std::move(pipeline)){
+    graphicsQueue = this->logicalDevice->getGraphicsQueue();
+    presentQueue = this->logicalDevice->getPresentQueue();
+    deletionQueue = std::make_unique<DeletionQueue>(this->logicalDevice->getDevice(),
+                                                    this->logicalDevice->getGraphicsTimeline());
+
+    commandBuffers = std::make_unique<CommandBufferManager>(this->logicalDevice->getDevice(),
+                                                            this->physicalDevice->getPhysicalDevice(),
+                                                            this->vulkanInstanceCreator->getSurface(),
+                                                            MAX_FRAMES_IN_FLIGHT);
+    syncObjects = std::make_unique<SyncObjects>(this->logicalDevice->getDevice(),
+                                                this->logicalDevice->getGraphicsTimeline(),
+                                                MAX_FRAMES_IN_FLIGHT,
+                                                static_cast<uint32_t>(this->swapChain->getSwapChainImages().size()));
+    staticCommandBuffers = std::make_unique<CommandBufferManager>(this->logicalDevice->getDevice(),
+                                                                  this->physicalDevice->getPhysicalDevice(),
+                                                                  this->vulkanInstanceCreator->getSurface(),
+                                                                  static_cast<uint32_t>(this->swapChain->getSwapChainImages().size()));
+    textureStreamer = std::make_unique<TextureStreamer>(this->logicalDevice->getDevice(),
+                                                        this->physicalDevice->getPhysicalDevice(),
+                                                        this->logicalDevice->getQueueFamilyIndices(),
+                                                        this->logicalDevice->getTransferQueue(),
+                                                        this->logicalDevice->getTransferTimeline(),
+                                                        this->logicalDevice->getGraphicsTimeline(),
+                                                        *this->residency,
+                                                        *this->jobs);
+    uploads = std::make_unique<UploadManager>(this->logicalDevice->getDevice(),
+                                              this->physicalDevice->getPhysicalDevice(),
+                                              this->logicalDevice->getQueueFamilyIndices(),
+                                              this->logicalDevice->getTransferQueue(),
+                                              this->logicalDevice->getTransferTimeline(),
+                                              this->logicalDevice->getGraphicsTimeline(),
+                                              UPLOAD_STAGING_RING_SIZE,
+                                              UPLOAD_BATCH_COUNT);
+    if (ENABLE_PARTICLE_SIMULATION) {
+        particles = std::make_unique<ParticleSystem>(this->logicalDevice->getDevice(),
+                                                     this->physicalDevice->getPhysicalDevice(),
+                                                     this->logicalDevice->getQueueFamilyIndices(),
+                                                     this->logicalDevice->getComputeQueue(),
+                                                     this->logicalDevice->getComputeTimeline(),
+                                                     *this->uploads,
+                                                     *this->residency,
+                                                     *this->pipelineCache,
+                                                     PARTICLE_COUNT,
+                                                     MAX_FRAMES_IN_FLIGHT);
+        PipelineDesc particleDesc = ParticleSystem::getPipelineDesc(this->pipeline->getPipelineDesc(),
+                                                                    this->pipeline->getViewCount());
+        particlePipeline = this->pipeline->getPipeline(particleDesc);
+    }
+    frameCapture = std::make_unique<FrameCapture>(this->logicalDevice->getDevice(),
+                                                  this->physicalDevice->getPhysicalDevice(),
+                                                  *this->jobs,
+                                                  this->logicalDevice->getGraphicsTimeline(),
+                                                  FRAME_CAPTURE_SLOT_COUNT);
+    if (ENABLE_SHADER_HOT_RELOAD) {
+        // Reloading is a convenience, so a missing source directory only disables it
+        try {
+            shaderWatcher = std::make_unique<ShaderWatcher>(SHADER_SOURCE_DIRECTORY,
+                                                            SHADER_BINARY_DIRECTORY,
+                                                            this->pipelineCache->getShaderLibrary(),
+                                                            SHADER_COMPILER);
+        } catch (const std::exception& e) {
+            std::cerr << "Shader hot reload disabled: " << e.what() << std::endl;
+        }
+    }
+    buildRenderGraph();
+}
 // --------------------------------------------------------------------------------
 
 HelloTriangleApplication::~HelloTriangleApplication() {
@@ -132,21 +278,712 @@ HelloTriangleApplication::~HelloTriangleApplication() {
 // --------------------------------------------------------------------------------
 
 void HelloTriangleApplication::run() {
-    while (!windowInstance->windowShouldClose()) {
-        windowInstance->pollEvents();
+    windowInstance->getFrameBufferSize();
+    framebufferWidth = windowInstance->get_width();
+    framebufferHeight = windowInstance->get_height();
+    windowInstance->setEventQueue(&windowEvents);
+    stopRendering = false;
+
+    std::atomic<bool> renderThreadDone{false};
+    std::exception_ptr renderError;
+    std::thread renderThread([this, &renderThreadDone, &renderError]() {
+        try {
+            renderLoop();
+        } catch (...) {
+            renderError = std::current_exception();
+        }
+        renderThreadDone = true;
+    });
+
+    // GLFW requires events to be processed here; this thread only feeds the queue
+    while (!windowInstance->windowShouldClose() && !renderThreadDone) {
+        windowInstance->waitEventsTimeout(IDLE_EVENT_TIMEOUT);
+    }
+
+    stopRendering = true;
+    renderThread.join();
+    windowInstance->setEventQueue(nullptr);
+
+    if (renderError) {
+        std::rethrow_exception(renderError);
+    }
+
+    if (particles && particles->getMeasuredStepCount() > 0) {
+        double microseconds = particles->getAverageStepMicroseconds();
+        std::cout << "Particle simulation: " << particles->getParticleCount() << " particles, "
+                  << microseconds << " us per step, "
+                  << particles->getParticleCount() / microseconds << " million particles per second over "
+                  << particles->getMeasuredStepCount() << " steps" << std::endl;
+    }
+
+    const RenderQueueStats& queueStats = renderQueue.getTotalStats();
+    if (queueStats.flushes > 0) {
+        double flushes = static_cast<double>(queueStats.flushes);
+        std::cout << "Render queue: " << queueStats.draws / flushes << " draws and "
+                  << queueStats.stateChanges / flushes << " state changes per pass, "
+                  << (static_cast<double>(queueStats.unsortedStateChanges) - queueStats.stateChanges) / flushes
+                  << " saved by sorting" << std::endl;
+    }
+
+    const FrameArenaStats& arenaStats = frameArena.getStats();
+    std::cout << "Frame arena: " << arenaStats.peakFrameBytes << " bytes at peak in one frame, "
+              << arenaStats.capacity << " reserved in " << arenaStats.blockAllocations << " allocations" << std::endl;
+
+    if (AllocationTracker::isEnabled()) {
+        std::cout << "Allocations: " << framesOverBudget << " of " << budgetedFrames
+                  << " frames after warm-up exceeded the budget of " << FRAME_ALLOCATION_BUDGET << std::endl;
     }
+
+    const UploadStats& uploadStats = uploads->getStats();
+    if (uploadStats.writes > 0) {
+        std::cout << "Uploads: " << uploadStats.writes << " writes of " << uploadStats.bytes
+                  << " bytes coalesced into " << uploadStats.copyRegions << " copy regions over "
+                  << uploadStats.submits << " submits" << std::endl;
+    }
+
+    FrameCaptureStats captureStats = frameCapture->getStats();
+    if (captureStats.framesRecorded > 0 || captureStats.framesDropped > 0) {
+        std::cout << "Frame capture: " << captureStats.framesWritten << " of "
+                  << captureStats.framesRecorded << " frames written, "
+                  << captureStats.framesDropped << " dropped, "
+                  << captureStats.writeFailures << " failed" << std::endl;
+    }
+}
+// --------------------------------------------------------------------------------
+
+void HelloTriangleApplication::setStaticFrames(bool enabled) {
+    requestedStaticFrames = enabled;
+}
+// --------------------------------------------------------------------------------
+
+void HelloTriangleApplication::markFramesDirty() {
+    framesDirty = true;
+}
+// --------------------------------------------------------------------------------
+
+uint64_t HelloTriangleApplication::getSkippedRecordCount() const {
+    return skippedRecordCount;
+}
+// --------------------------------------------------------------------------------
+
+void HelloTriangleApplication::setTargetFps(double targetFps) {
+    requestedTargetFps = targetFps;
+}
+// --------------------------------------------------------------------------------
+
+TextureHandle HelloTriangleApplication::loadTexture(const std::string& path) {
+    return textureStreamer->load(path);
+}
+// --------------------------------------------------------------------------------
+
+void HelloTriangleApplication::captureFrames(const std::string& directory, CaptureFormat format, uint32_t frameCount) {
+    std::lock_guard<std::mutex> lock(captureRequestMutex);
+    captureRequested = true;
+    captureDirectory = directory;
+    captureFormat = format;
+    captureFrameCount = frameCount;
 }
 // --------------------------------------------------------------------------------
 
 void HelloTriangleApplication::destroyResources() {
     // Destroy Vulkan instance before the window
+    shaderWatcher.reset();
+    uploads.reset();
+    textureStreamer.reset();
+    particles.reset();
+    frameCapture.reset();
+    deletionQueue.reset();
+    renderGraph.reset();
+    syncObjects.reset();
+    staticCommandBuffers.reset();
+    commandBuffers.reset();
     pipeline.reset();
+    objectCache.reset();
+    if (pipelineCache) {
+        pipelineCache->saveCacheData(PIPELINE_CACHE_FILE);
+    }
+    pipelineCache.reset();
+    uniformBuffer.reset();
     swapChain.reset();
+    residency.reset();
+    jobs.reset();
     logicalDevice.reset();
     physicalDevice.reset();
     vulkanInstanceCreator.reset();
     windowInstance.reset();
 }
 // ================================================================================
+
+void HelloTriangleApplication::renderLoop() {
+    frameLimiter.reset();
+    lastFrameTime = std::chrono::steady_clock::now();
+    while (!stopRendering) {
+        processWindowEvents();
+        applyRequestedSettings();
+
+        // Nothing is visible, so wait for the event thread to report a restore
+        if (minimized || framebufferWidth == 0 || framebufferHeight == 0) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(RENDER_IDLE_SLEEP_MILLISECONDS));
+            frameLimiter.reset();
+            continue;
+        }
+        if (framebufferResized) {
+            recreateSwapChain();
+        }
+
+        // After warm-up the whole frame must stay within its allocation budget
+        if (frameNumber < ALLOCATION_WARMUP_FRAMES) {
+            drawFrame();
+        } else {
+            AllocationBudget budget(FRAME_ALLOCATION_BUDGET, FRAME_ALLOCATION_VIOLATION);
+            drawFrame();
+            budgetedFrames++;
+            if (budget.getAllocations() > FRAME_ALLOCATION_BUDGET) {
+                framesOverBudget++;
+            }
+        }
+        frameLimiter.wait();
+    }
+    vkDeviceWaitIdle(logicalDevice->getDevice());
+}
+// --------------------------------------------------------------------------------
+
+void HelloTriangleApplication::processWindowEvents() {
+    WindowEvent event;
+    while (windowEvents.pop(event)) {
+        switch (event.type) {
+            case WindowEventType::Key:
+            case WindowEventType::MouseButton:
+            case WindowEventType::CursorPosition:
+                // Input is consumed here once the scene responds to it
+                break;
+        }
+    }
+
+    // The window state is read rather than queued, so a burst of input that
+    // fills the queue cannot lose a resize or a restore
+    uint32_t width = windowInstance->get_width();
+    uint32_t height = windowInstance->get_height();
+    if (width != framebufferWidth || height != framebufferHeight) {
+        framebufferWidth = width;
+        framebufferHeight = height;
+        framebufferResized = true;
+    }
+    minimized = windowInstance->isIconified();
+}
+// --------------------------------------------------------------------------------
+
+void HelloTriangleApplication::applyRequestedSettings() {
+    bool enableStaticFrames = requestedStaticFrames;
+    if (enableStaticFrames != staticFrames) {
+        // Both modes read uniforms out of the same ring, so neither may overwrite
+        // data the other still has in flight
+        syncObjects->waitForAllFrames();
+        staticFrames = enableStaticFrames;
+        framesDirty = true;
+    }
+
+    double targetFps = requestedTargetFps;
+    if (targetFps != frameLimiter.getTargetFps()) {
+        frameLimiter.setTargetFps(targetFps);
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(captureRequestMutex);
+        if (captureRequested) {
+            captureRequested = false;
+            if (capturesFromBackbuffer() && !(swapChain->getSwapChainImageUsage() & VK_IMAGE_USAGE_TRANSFER_SRC_BIT)) {
+                std::cerr << "Frame capture: the surface does not allow swap chain images to be read; "
+                          << "enable ENABLE_OFFSCREEN_RENDERING with a single view to capture" << std::endl;
+            } else if (!FrameCapture::isFormatSupported(swapChain->getSwapChainImageFormat())) {
+                std::cerr << "Frame capture: the swap chain format cannot be captured" << std::endl;
+            } else {
+                frameCapture->start(captureDirectory, captureFormat, captureFrameCount);
+            }
+        }
+    }
+
+    // Only the backbuffer path adds a pass for the capture, so the copy and its
+    // barriers cost nothing while no capture runs
+    if (frameCapture->isActive() != captureInGraph && capturesFromBackbuffer()) {
+        buildRenderGraph();
+        framesDirty = true;
+    }
+}
+// --------------------------------------------------------------------------------
+
+void HelloTriangleApplication::reloadShaders() {
+    if (!shaderWatcher) {
+        return;
+    }
+    for (const std::string& shader : shaderWatcher->takeChangedShaders()) {
+        pipelineCache->rebuildPipelines(shader, *jobs);
+    }
+
+    // Replaced pipelines are retired on the graphics timeline.  Each graphics
+    // submission waits for the simulation step it draws, so this also covers
+    // the compute pipeline.
+    if (pipelineCache->swapRebuiltPipelines(*deletionQueue) == 0) {
+        return;
+    }
+    pipeline->refreshPipeline();
+    if (particles) {
+        particles->refreshPipeline();
+        particlePipeline = pipeline->getPipeline(ParticleSystem::getPipelineDesc(pipeline->getPipelineDesc(), pipeline->getViewCount()));
+    }
+    framesDirty = true;
+}
+// --------------------------------------------------------------------------------
+
+void HelloTriangleApplication::drawFrame() {
+    VkDevice device = logicalDevice->getDevice();
+    TimelineSemaphore& graphicsTimeline = logicalDevice->getGraphicsTimeline();
+
+    syncObjects->waitForFrame(currentFrame);
+    frameArena.reset();
+    deletionQueue->collect(&frameArena);
+    frameCapture->poll();
+    reloadShaders();
+
+    // Resources last used before this slot's frame are now safe to evict
+    residency->beginFrame(++frameNumber);
+    textureStreamer->update(frameNumber, &frameArena);
+
+    uint32_t imageIndex;
+    VkResult result = vkAcquireNextImageKHR(device, swapChain->getSwapChain(), UINT64_MAX,
+                                            syncObjects->getImageAvailableSemaphore(currentFrame),
+                                            VK_NULL_HANDLE, &imageIndex);
+    if (result == VK_ERROR_OUT_OF_DATE_KHR) {
+        framebufferResized = true;
+        return;
+    } else if (result != VK_SUCCESS && result != VK_SUBOPTIMAL_KHR) {
+        throw std::runtime_error("failed to acquire swap chain image!");
+    }
+
+    // Steps are kept in lockstep with submitted frames, so a step only
+    // overwrites particles that a finished frame drew
+    VkSemaphoreSubmitInfo waitInfos[3];
+    uint32_t waitCount = 0;
+    waitInfos[waitCount++] = semaphoreSubmitInfo(syncObjects->getImageAvailableSemaphore(currentFrame), 0,
+                                                 VK_PIPELINE_STAGE_2_COLOR_ATTACHMENT_OUTPUT_BIT);
+
+    // Buffer writes made since the last frame go out in one transfer submit,
+    // submitted here where the frame can no longer bail out before using it
+    VkCommandBufferSubmitInfo commandBufferInfos[2]{};
+    uint32_t commandBufferCount = 0;
+    UploadSubmission uploadSubmission;
+    bool uploading = uploads->submit(uploadSubmission);
+    if (uploading) {
+        waitInfos[waitCount++] = uploadSubmission.waitInfo;
+        if (uploadSubmission.acquireCommandBuffer != VK_NULL_HANDLE) {
+            commandBufferInfos[commandBufferCount].sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_SUBMIT_INFO;
+            commandBufferInfos[commandBufferCount++].commandBuffer = uploadSubmission.acquireCommandBuffer;
+        }
+    }
+    if (particles) {
+        auto now = std::chrono::steady_clock::now();
+        float deltaTime = std::chrono::duration<float>(now - lastFrameTime).count();
+        lastFrameTime = now;
+
+        // A long stall such as a window drag must not fling particles away
+        uint64_t stepValue = particles->simulate(currentFrame, std::min(deltaTime, 0.05f));
+        waitInfos[waitCount++] = logicalDevice->getComputeTimeline().waitInfo(stepValue,
+                                                                               VK_PIPELINE_STAGE_2_VERTEX_ATTRIBUTE_INPUT_BIT);
+    }
+
+    VkCommandBuffer commandBuffer;
+    // Pre-recorded frames would draw a stale half of the particle buffers, and
+    // would not record a capture copy
+    if (staticFrames && !particles && !frameCapture->isActive()) {
+        // In steady state the only CPU work is the submit and present
+        if (framesDirty) {
+            recordStaticCommandBuffers();
+        } else {
+            skippedRecordCount++;
+        }
+        commandBuffer = staticCommandBuffers->getCommandBuffer(imageIndex);
+    } else {
+        // The timeline wait above guarantees the GPU is done with this frame's region
+        uniformBuffer->beginFrame(currentFrame);
+
+        commandBuffer = commandBuffers->getCommandBuffer(currentFrame);
+        vkResetCommandBuffer(commandBuffer, 0);
+        recordCommandBuffer(commandBuffer, imageIndex);
+    }
+
+    // The binary semaphore hands the image to present; the timeline value
+    // throttles this frame slot and retires the resources the frame used
+    uint64_t frameValue = graphicsTimeline.reserve();
+    VkSemaphore signalSemaphores[] = {syncObjects->getRenderFinishedSemaphore(imageIndex)};
+    VkSemaphoreSubmitInfo signalInfos[] = {
+        semaphoreSubmitInfo(signalSemaphores[0], 0, VK_PIPELINE_STAGE_2_COLOR_ATTACHMENT_OUTPUT_BIT),
+        graphicsTimeline.signalInfo(frameValue, VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT)
+    };
+
+    commandBufferInfos[commandBufferCount].sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_SUBMIT_INFO;
+    commandBufferInfos[commandBufferCount++].commandBuffer = commandBuffer;
+
+    VkSubmitInfo2 submitInfo{};
+    submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO_2;
+    submitInfo.waitSemaphoreInfoCount = waitCount;
+    submitInfo.pWaitSemaphoreInfos = waitInfos;
+    submitInfo.commandBufferInfoCount = commandBufferCount;
+    submitInfo.pCommandBufferInfos = commandBufferInfos;
+    submitInfo.signalSemaphoreInfoCount = 2;
+    submitInfo.pSignalSemaphoreInfos = signalInfos;
+
+    if (vkQueueSubmit2(graphicsQueue, 1, &submitInfo, VK_NULL_HANDLE) != VK_SUCCESS) {
+        throw std::runtime_error("failed to submit draw command buffer!");
+    }
+    syncObjects->setFrameValue(currentFrame, frameValue);
+    frameCapture->submitted(frameValue);
+    if (uploading) {
+        uploads->submitted(frameValue);
+    }
+
+    VkSwapchainKHR swapChains[] = {swapChain->getSwapChain()};
+
+    VkPresentInfoKHR presentInfo{};
+    presentInfo.sType = VK_STRUCTURE_TYPE_PRESENT_INFO_KHR;
+    presentInfo.waitSemaphoreCount = 1;
+    presentInfo.pWaitSemaphores = signalSemaphores;
+    presentInfo.swapchainCount = 1;
+    presentInfo.pSwapchains = swapChains;
+    presentInfo.pImageIndices = &imageIndex;
+
+    result = vkQueuePresentKHR(presentQueue, &presentInfo);
+    if (result == VK_ERROR_OUT_OF_DATE_KHR || result == VK_SUBOPTIMAL_KHR) {
+        framebufferResized = true;
+    } else if (result != VK_SUCCESS) {
+        throw std::runtime_error("failed to present swap chain image!");
+    }
+
+    currentFrame = (currentFrame + 1) % MAX_FRAMES_IN_FLIGHT;
+}
+// --------------------------------------------------------------------------------
+
+void HelloTriangleApplication::recordCommandBuffer(VkCommandBuffer commandBuffer,
+                                                   uint32_t imageIndex,
+                                                   VkCommandBufferUsageFlags usage) {
+    VkCommandBufferBeginInfo beginInfo{};
+    beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+    beginInfo.flags = usage;
+
+    if (vkBeginCommandBuffer(commandBuffer, &beginInfo) != VK_SUCCESS) {
+        throw std::runtime_error("failed to begin recording command buffer!");
+    }
+
+    // The graph emits the layout transitions around the render pass
+    renderGraph->setImportedImage(backbuffer,
+                                  swapChain->getSwapChainImages()[imageIndex],
+                                  swapChain->getSwapChainImageViews()[imageIndex]);
+    renderGraph->execute(commandBuffer);
+
+    if (vkEndCommandBuffer(commandBuffer) != VK_SUCCESS) {
+        throw std::runtime_error("failed to record command buffer!");
+    }
+}
+// --------------------------------------------------------------------------------
+
+void HelloTriangleApplication::recordStaticCommandBuffers() {
+    syncObjects->waitForAllFrames();
+
+    // Every image pushes its uniforms into the same region, which is left
+    // untouched until the command buffers are recorded again
+    uniformBuffer->beginFrame(currentFrame);
+
+    // An acquired image may still be referenced by a submission that has not
+    // retired yet, so the same command buffer can be pending more than once
+    for (uint32_t i = 0; i < swapChain->getSwapChainImages().size(); i++) {
+        VkCommandBuffer commandBuffer = staticCommandBuffers->getCommandBuffer(i);
+        vkResetCommandBuffer(commandBuffer, 0);
+        recordCommandBuffer(commandBuffer, i, VK_COMMAND_BUFFER_USAGE_SIMULTANEOUS_USE_BIT);
+    }
+    framesDirty = false;
+}
+// --------------------------------------------------------------------------------
+
+void HelloTriangleApplication::recordMainPass(VkCommandBuffer commandBuffer, const RenderGraph& graph) {
+    // A multiview framebuffer has one layer; the view mask picks the layers
+    VkExtent2D extent = viewExtent;
+
+    // Framebuffers are looked up every frame; only the first lookup after a
+    // resize creates a new one
+    FramebufferDesc framebufferDesc;
+    framebufferDesc.renderPass = pipeline->getRenderPass();
+    framebufferDesc.attachments[0] = graph.getImageView(colorTarget);
+    framebufferDesc.attachmentCount = 1;
+    framebufferDesc.extent = extent;
+
+    VkRenderPassBeginInfo renderPassInfo{};
+    renderPassInfo.sType = VK_STRUCTURE_TYPE_RENDER_PASS_BEGIN_INFO;
+    renderPassInfo.renderPass = pipeline->getRenderPass();
+    renderPassInfo.framebuffer = objectCache->getFramebuffer(framebufferDesc);
+    renderPassInfo.renderArea.offset = {0, 0};
+    renderPassInfo.renderArea.extent = extent;
+
+    VkClearValue clearColor = {{{0.0f, 0.0f, 0.0f, 1.0f}}};
+    renderPassInfo.clearValueCount = 1;
+    renderPassInfo.pClearValues = &clearColor;
+
+    vkCmdBeginRenderPass(commandBuffer, &renderPassInfo, VK_SUBPASS_CONTENTS_INLINE);
+
+    VkViewport viewport{};
+    viewport.x = 0.0f;
+    viewport.y = 0.0f;
+    viewport.width = static_cast<float>(extent.width);
+    viewport.height = static_cast<float>(extent.height);
+    viewport.minDepth = 0.0f;
+    viewport.maxDepth = 1.0f;
+    vkCmdSetViewport(commandBuffer, 0, 1, &viewport);
+
+    VkRect2D scissor{};
+    scissor.offset = {0, 0};
+    scissor.extent = extent;
+    vkCmdSetScissor(commandBuffer, 0, 1, &scissor);
+
+    // Per-frame constants go through the ring buffer; the descriptor set is
+    // never rewritten, only the dynamic offset changes
+    FrameUniforms frameUniforms{};
+    frameUniforms.tint[0] = 1.0f;
+    frameUniforms.tint[1] = 1.0f;
+    frameUniforms.tint[2] = 1.0f;
+    frameUniforms.tint[3] = 1.0f;
+    for (uint32_t i = 0; i < MAX_VIEW_COUNT; i++) {
+        frameUniforms.views[i][2] = 1.0f;
+    }
+    if (pipeline->getViewCount() == 2) {
+        // Each eye sees the scene shifted away from it by half the separation
+        frameUniforms.views[0][0] = 0.5f * STEREO_EYE_SEPARATION;
+        frameUniforms.views[1][0] = -0.5f * STEREO_EYE_SEPARATION;
+    }
+    uint32_t frameOffset = uniformBuffer->push(frameUniforms);
+
+    DrawPushConstants pushConstants{};
+    pushConstants.offset[0] = 0.0f;
+    pushConstants.offset[1] = 0.0f;
+    pushConstants.scale = 1.0f;
+
+    DrawItem triangle{};
+    triangle.pipeline = pipeline->getPipeline();
+    triangle.layout = pipeline->getPipelineLayout();
+    triangle.descriptorSet = uniformBuffer->getDescriptorSet();
+    triangle.dynamicOffset = frameOffset;
+    triangle.hasDynamicOffset = true;
+    triangle.vertexCount = 3;
+    renderQueue.submit(triangle, &pushConstants, sizeof(DrawPushConstants),
+                       VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT);
+
+    // The particle pipeline shares the layout, so the uniforms stay bound
+    if (particles) {
+        DrawItem particleDraw = triangle;
+        particleDraw.pass = 1;
+        particleDraw.pipeline = particlePipeline;
+        particleDraw.vertexBuffer = particles->getVertexBuffer();
+        particleDraw.vertexCount = 1;
+        particleDraw.instanceCount = particles->getParticleCount();
+        renderQueue.submit(particleDraw);
+    }
+    renderQueue.flush(commandBuffer);
+    vkCmdEndRenderPass(commandBuffer);
+}
+// --------------------------------------------------------------------------------
+
+void HelloTriangleApplication::recordPresentCopy(VkCommandBuffer commandBuffer, const RenderGraph& graph) {
+    VkExtent2D extent = swapChain->getSwapChainExtent();
+    frameCapture->record(commandBuffer, graph.getImage(colorTarget), swapChain->getSwapChainImageFormat(), extent);
+
+    // Both images share the swap chain format and extent, so a copy suffices
+    VkImageCopy region{};
+    region.srcSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+    region.srcSubresource.layerCount = 1;
+    region.dstSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+    region.dstSubresource.layerCount = 1;
+    region.extent = {extent.width, extent.height, 1};
+    vkCmdCopyImage(commandBuffer,
+                   graph.getImage(colorTarget), VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
+                   graph.getImage(backbuffer), VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+                   1, &region);
+}
+// --------------------------------------------------------------------------------
+
+void HelloTriangleApplication::recordComposeViews(VkCommandBuffer commandBuffer, const RenderGraph& graph) {
+    VkExtent2D extent = swapChain->getSwapChainExtent();
+    uint32_t viewCount = pipeline->getViewCount();
+    uint32_t viewRows = (viewCount + viewColumns - 1) / viewColumns;
+    VkImage target = graph.getImage(backbuffer);
+
+    // An odd extent, or three players in a 2x2 grid, leaves pixels uncovered
+    if (viewCount < viewColumns * viewRows ||
+        viewExtent.width * viewColumns != extent.width ||
+        viewExtent.height * viewRows != extent.height) {
+        VkClearColorValue clearColor = {{0.0f, 0.0f, 0.0f, 1.0f}};
+        VkImageSubresourceRange range{};
+        range.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+        range.levelCount = 1;
+        range.layerCount = 1;
+        vkCmdClearColorImage(commandBuffer, target, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, &clearColor, 1, &range);
+
+        VkMemoryBarrier2 barrier{};
+        barrier.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER_2;
+        barrier.srcStageMask = VK_PIPELINE_STAGE_2_ALL_TRANSFER_BIT;
+        barrier.srcAccessMask = VK_ACCESS_2_TRANSFER_WRITE_BIT;
+        barrier.dstStageMask = VK_PIPELINE_STAGE_2_ALL_TRANSFER_BIT;
+        barrier.dstAccessMask = VK_ACCESS_2_TRANSFER_WRITE_BIT;
+
+        VkDependencyInfo dependency{};
+        dependency.sType = VK_STRUCTURE_TYPE_DEPENDENCY_INFO;
+        dependency.memoryBarrierCount = 1;
+        dependency.pMemoryBarriers = &barrier;
+        vkCmdPipelineBarrier2(commandBuffer, &dependency);
+    }
+
+    // Every tile is the same size, so one copy call covers all the views
+    std::array<VkImageCopy, MAX_VIEW_COUNT> regions{};
+    for (uint32_t i = 0; i < viewCount; i++) {
+        VkImageCopy& region = regions[i];
+        region.srcSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+        region.srcSubresource.baseArrayLayer = i;
+        region.srcSubresource.layerCount = 1;
+        region.dstSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+        region.dstSubresource.layerCount = 1;
+        region.dstOffset = {static_cast<int32_t>((i % viewColumns) * viewExtent.width),
+                            static_cast<int32_t>((i / viewColumns) * viewExtent.height), 0};
+        region.extent = {viewExtent.width, viewExtent.height, 1};
+    }
+    vkCmdCopyImage(commandBuffer,
+                   graph.getImage(colorTarget), VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
+                   target, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+                   viewCount, regions.data());
+}
+// --------------------------------------------------------------------------------
+
+bool HelloTriangleApplication::capturesFromBackbuffer() const {
+    return !ENABLE_OFFSCREEN_RENDERING || pipeline->getViewCount() > 1;
+}
+// --------------------------------------------------------------------------------
+
+void HelloTriangleApplication::buildRenderGraph() {
+    // Frames in flight may still use the old graph's transient images.  The
+    // framebuffer around the old color target goes with them, or a new view
+    // reusing its handle would be handed the stale framebuffer.
+    if (renderGraph) {
+        if (colorTarget != backbuffer) {
+            objectCache->invalidateImageViews({renderGraph->getImageView(colorTarget)}, *deletionQueue);
+        }
+        deletionQueue->release(std::move(renderGraph));
+    }
+    renderGraph = std::make_unique<RenderGraph>(logicalDevice->getDevice(),
+                                                physicalDevice->getPhysicalDevice(),
+                                                residency.get());
+
+    // The acquire semaphore is waited on at the color attachment stage, so the
+    // first transition of the backbuffer only has to wait on that stage
+    ResourceState acquired;
+    acquired.stages = VK_PIPELINE_STAGE_2_COLOR_ATTACHMENT_OUTPUT_BIT;
+    acquired.layout = VK_IMAGE_LAYOUT_UNDEFINED;
+    backbuffer = renderGraph->importImage("backbuffer", VK_IMAGE_ASPECT_COLOR_BIT,
+                                          acquired, ResourceUsage::Present);
+
+    // Multiview draws every view at once into the layers of one image, which
+    // is then tiled into the backbuffer.  Stereo views sit side by side and
+    // three or four players share a 2x2 grid.
+    VkExtent2D extent = swapChain->getSwapChainExtent();
+    uint32_t viewCount = pipeline->getViewCount();
+    viewColumns = std::min(viewCount, 2u);
+    uint32_t viewRows = (viewCount + viewColumns - 1) / viewColumns;
+    viewExtent = {std::max(extent.width / viewColumns, 1u), std::max(extent.height / viewRows, 1u)};
+
+    // Offscreen frames, and the views, are drawn into a transient image that
+    // lives only until it has been copied to the backbuffer
+    if (viewCount > 1) {
+        TransientImageDesc viewsDesc;
+        viewsDesc.format = swapChain->getSwapChainImageFormat();
+        viewsDesc.extent = viewExtent;
+        viewsDesc.usage = VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT | VK_IMAGE_USAGE_TRANSFER_SRC_BIT;
+        viewsDesc.layers = viewCount;
+        colorTarget = renderGraph->createImage("views", viewsDesc);
+    } else if (ENABLE_OFFSCREEN_RENDERING) {
+        TransientImageDesc sceneDesc;
+        sceneDesc.format = swapChain->getSwapChainImageFormat();
+        sceneDesc.extent = extent;
+        sceneDesc.usage = VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT | VK_IMAGE_USAGE_TRANSFER_SRC_BIT;
+        colorTarget = renderGraph->createImage("scene", sceneDesc);
+    } else {
+        colorTarget = backbuffer;
+    }
+
+    renderGraph->addPass("main", {{colorTarget, ResourceUsage::ColorAttachment}},
+                         [this](VkCommandBuffer commandBuffer, const RenderGraph& graph) {
+                             recordMainPass(commandBuffer, graph);
+                         });
+    if (viewCount > 1) {
+        renderGraph->addPass("compose views",
+                             {{colorTarget, ResourceUsage::TransferSrc}, {backbuffer, ResourceUsage::TransferDst}},
+                             [this](VkCommandBuffer commandBuffer, const RenderGraph& graph) {
+                                 recordComposeViews(commandBuffer, graph);
+                             });
+    } else if (ENABLE_OFFSCREEN_RENDERING) {
+        renderGraph->addPass("present copy",
+                             {{colorTarget, ResourceUsage::TransferSrc}, {backbuffer, ResourceUsage::TransferDst}},
+                             [this](VkCommandBuffer commandBuffer, const RenderGraph& graph) {
+                                 recordPresentCopy(commandBuffer, graph);
+                             });
+    }
+    if (capturesFromBackbuffer() && frameCapture->isActive()) {
+        renderGraph->addPass("capture", {{backbuffer, ResourceUsage::TransferSrc}},
+                             [this](VkCommandBuffer commandBuffer, const RenderGraph& graph) {
+                                 frameCapture->record(commandBuffer, graph.getImage(backbuffer),
+                                                      swapChain->getSwapChainImageFormat(),
+                                                      swapChain->getSwapChainExtent());
+                             });
+    }
+    captureInGraph = !capturesFromBackbuffer() || frameCapture->isActive();
+    renderGraph->compile();
+
+    const RenderGraphStats& stats = renderGraph->getStats();
+    std::cout << "Render graph: " << stats.passCount << " passes ("
+              << stats.culledPassCount << " culled), "
+              << stats.barrierCount << " barriers in "
+              << stats.barrierBatchCount << " batches per frame, "
+              << stats.memorySaved() << " of "
+              << stats.transientMemoryRequested << " transient bytes saved by aliasing" << std::endl;
+}
+// --------------------------------------------------------------------------------
+
+void HelloTriangleApplication::recreateSwapChain() {
+    // Called on the render thread, which only renders while the framebuffer
+    // has a non-zero size
+    framebufferResized = false;
+
+    // Only the framebuffers that reference the old views are evicted; the render
+    // pass, pipeline and samplers are reused as long as the format is unchanged
+    objectCache->invalidateImageViews(swapChain->getSwapChainImageViews(), *deletionQueue);
+
+    VkFormat oldFormat = swapChain->getSwapChainImageFormat();
+    size_t oldImageCount = swapChain->getSwapChainImages().size();
+
+    swapChain->recreateSwapChain(*deletionQueue);
+
+    if (swapChain->getSwapChainImageFormat() != oldFormat) {
+        pipeline->setColorFormat(swapChain->getSwapChainImageFormat());
+        if (particles) {
+            particlePipeline = pipeline->getPipeline(ParticleSystem::getPipelineDesc(pipeline->getPipelineDesc(), pipeline->getViewCount()));
+        }
+    }
+    if (swapChain->getSwapChainImages().size() != oldImageCount) {
+        // The frame slots keep their timeline values, so throttling carries on
+        // across the resize
+        syncObjects->setImageCount(static_cast<uint32_t>(swapChain->getSwapChainImages().size()), *deletionQueue);
+        deletionQueue->release(std::move(staticCommandBuffers));
+        staticCommandBuffers = std::make_unique<CommandBufferManager>(logicalDevice->getDevice(),
+                                                                      physicalDevice->getPhysicalDevice(),
+                                                                      vulkanInstanceCreator->getSurface(),
+                                                                      static_cast<uint32_t>(swapChain->getSwapChainImages().size()));
+    }
+    buildRenderGraph();
+    framesDirty = true;
+}
+// ================================================================================
 // ================================================================================
 // eof
@@ -0,0 +1,407 @@
+// ================================================================================
+// ================================================================================
+// - File:    batch_renderer.cpp
+// - Purpose: Contains the implementation for batch_renderer.hpp
+//
+// Source Metadata
+// - Author:  Jonathan A. Webb
+// - Date:    October 18, 2026
+// - Version: 1.0
+// - Copyright: Copyright 2022, Jon Webb Inc.
+// ================================================================================
+// ================================================================================
+// Include modules here
+
+#include "include/batch_renderer.hpp"
+#include "include/constants.hpp"
+#include "include/host_allocator.hpp"
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <iostream>
+#include <stdexcept>
+// ================================================================================
+// ================================================================================
+
+/**
+ * @brief Returns true if a path names a headerless RGBA file
+ */
+static bool isRawOutput(const std::string& path) {
+    return std::filesystem::path(path).extension() == ".rgba";
+}
+// ================================================================================
+// ================================================================================
+
+BatchRenderer::BatchRenderer(VkDevice device,
+                             VkPhysicalDevice physicalDevice,
+                             const QueueFamilyIndices& queueFamilies,
+                             VkQueue graphicsQueue,
+                             TimelineSemaphore& graphicsTimeline,
+                             JobSystem& jobs,
+                             PipelineStateCache& pipelineCache,
+                             ObjectCache& objectCache,
+                             uint32_t jobsInFlight,
+                             uint32_t targetPoolSize,
+                             uint32_t readbackSlots)
+    : device(device),
+      physicalDevice(physicalDevice),
+      graphicsQueue(graphicsQueue),
+      graphicsTimeline(graphicsTimeline),
+      objectCache(objectCache),
+      targetPoolSize(targetPoolSize),
+      slotValues(jobsInFlight, 0) {
+    if (jobsInFlight == 0 || targetPoolSize < jobsInFlight) {
+        throw std::runtime_error("batch renderer needs at least one target per job in flight!");
+    }
+
+    uniformBuffer = std::make_unique<UniformRingBuffer>(device,
+                                                        physicalDevice,
+                                                        UNIFORM_RING_FRAME_SIZE,
+                                                        jobsInFlight,
+                                                        UNIFORM_RING_MAX_ALLOCATION);
+    // The viewport is dynamic, so the pipeline serves every job size
+    pipeline = std::make_unique<GraphicsPipeline>(device,
+                                                  VkExtent2D{1, 1},
+                                                  BATCH_RENDER_FORMAT,
+                                                  uniformBuffer->getDescriptorSetLayout(),
+                                                  pipelineCache,
+                                                  objectCache);
+    commandBuffers = std::make_unique<CommandBufferManager>(device,
+                                                            queueFamilies.graphicsFamily.value(),
+                                                            jobsInFlight);
+    readback = std::make_unique<FrameCapture>(device, physicalDevice, jobs, graphicsTimeline, readbackSlots);
+    deletionQueue = std::make_unique<DeletionQueue>(device, graphicsTimeline);
+
+    // Targets are referenced while the pool grows, so it must never reallocate
+    targets.reserve(targetPoolSize);
+}
+// --------------------------------------------------------------------------------
+
+BatchRenderer::~BatchRenderer() {
+    graphicsTimeline.wait(*std::max_element(slotValues.begin(), slotValues.end()));
+    for (RenderTarget& target : targets) {
+        destroyTarget(target);
+    }
+    deletionQueue.reset();
+}
+// --------------------------------------------------------------------------------
+
+void BatchRenderer::enqueue(const RenderJob& job) {
+    queue.push_back(job);
+}
+// --------------------------------------------------------------------------------
+
+size_t BatchRenderer::getQueuedJobCount() const {
+    return queue.size();
+}
+// --------------------------------------------------------------------------------
+
+BatchRenderStats BatchRenderer::run() {
+    BatchRenderStats stats;
+    FrameCaptureStats before = readback->getStats();
+    uint64_t targetsBefore = targetsCreated;
+    auto start = std::chrono::steady_clock::now();
+
+    while (!queue.empty()) {
+        RenderJob job = std::move(queue.front());
+        queue.pop_front();
+
+        const SceneDesc* scene = nullptr;
+        try {
+            scene = &getScene(job.scenePath);
+
+            std::filesystem::path directory = std::filesystem::path(job.outputPath).parent_path();
+            std::error_code error;
+            if (!directory.empty()) {
+                std::filesystem::create_directories(directory, error);
+            }
+            if (error) {
+                throw std::runtime_error("failed to create output directory '" + directory.string() + "'!");
+            }
+        } catch (const std::runtime_error& error) {
+            std::cerr << "Batch render: " << error.what() << std::endl;
+            stats.jobsFailed++;
+            continue;
+        }
+
+        // Only the job submitted jobsInFlight jobs ago must be finished; the
+        // encoders of earlier jobs keep running meanwhile
+        uint32_t slot = nextSlot;
+        nextSlot = (nextSlot + 1) % static_cast<uint32_t>(slotValues.size());
+        graphicsTimeline.wait(slotValues[slot]);
+        deletionQueue->collect();
+        readback->waitForFreeSlot();
+        uniformBuffer->beginFrame(slot);
+        RenderTarget& target = acquireTarget({job.width, job.height});
+
+        VkCommandBuffer commandBuffer = commandBuffers->getCommandBuffer(slot);
+        vkResetCommandBuffer(commandBuffer, 0);
+
+        VkCommandBufferBeginInfo beginInfo{};
+        beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+        beginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+        if (vkBeginCommandBuffer(commandBuffer, &beginInfo) != VK_SUCCESS) {
+            throw std::runtime_error("failed to begin recording batch command buffer!");
+        }
+        recordJob(commandBuffer, job, *scene, target);
+        if (vkEndCommandBuffer(commandBuffer) != VK_SUCCESS) {
+            throw std::runtime_error("failed to record batch command buffer!");
+        }
+
+        uint64_t value = graphicsTimeline.reserve();
+        VkSemaphoreSubmitInfo signalInfo = graphicsTimeline.signalInfo(value, VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT);
+
+        VkCommandBufferSubmitInfo commandBufferInfo{};
+        commandBufferInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_SUBMIT_INFO;
+        commandBufferInfo.commandBuffer = commandBuffer;
+
+        VkSubmitInfo2 submitInfo{};
+        submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO_2;
+        submitInfo.commandBufferInfoCount = 1;
+        submitInfo.pCommandBufferInfos = &commandBufferInfo;
+        submitInfo.signalSemaphoreInfoCount = 1;
+        submitInfo.pSignalSemaphoreInfos = &signalInfo;
+
+        if (vkQueueSubmit2(graphicsQueue, 1, &submitInfo, VK_NULL_HANDLE) != VK_SUCCESS) {
+            throw std::runtime_error("failed to submit batch render job!");
+        }
+        readback->submitted(value);
+        slotValues[slot] = value;
+        target.lastUse = value;
+        stats.jobsRendered++;
+
+        // Hands finished jobs to the encoders while the GPU works on this one
+        readback->poll();
+    }
+    readback->flush();
+
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    FrameCaptureStats after = readback->getStats();
+    stats.filesWritten = after.framesWritten - before.framesWritten;
+    stats.writeFailures = after.writeFailures - before.writeFailures;
+    stats.targetsCreated = targetsCreated - targetsBefore;
+    stats.seconds = elapsed.count();
+    return stats;
+}
+// ================================================================================
+
+const SceneDesc& BatchRenderer::getScene(const std::string& path) {
+    auto it = scenes.find(path);
+    if (it == scenes.end()) {
+        it = scenes.emplace(path, loadScene(path)).first;
+    }
+    return it->second;
+}
+// --------------------------------------------------------------------------------
+
+BatchRenderer::RenderTarget& BatchRenderer::acquireTarget(VkExtent2D extent) {
+    // The caller has waited for the slot, so at most jobsInFlight - 1 targets
+    // are busy and the pool always has an idle one
+    RenderTarget* leastRecent = nullptr;
+    for (RenderTarget& target : targets) {
+        if (!graphicsTimeline.isComplete(target.lastUse)) {
+            continue;
+        }
+        if (target.extent.width == extent.width && target.extent.height == extent.height) {
+            return target;
+        }
+        if (!leastRecent || target.lastUse < leastRecent->lastUse) {
+            leastRecent = &target;
+        }
+    }
+
+    if (targets.size() < targetPoolSize) {
+        targets.emplace_back();
+        createTarget(targets.back(), extent);
+        return targets.back();
+    }
+    if (!leastRecent) {
+        throw std::runtime_error("batch renderer has no idle render target!");
+    }
+    destroyTarget(*leastRecent);
+    createTarget(*leastRecent, extent);
+    return *leastRecent;
+}
+// --------------------------------------------------------------------------------
+
+void BatchRenderer::createTarget(RenderTarget& target, VkExtent2D extent) {
+    VkImageCreateInfo imageInfo{};
+    imageInfo.sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO;
+    imageInfo.imageType = VK_IMAGE_TYPE_2D;
+    imageInfo.format = BATCH_RENDER_FORMAT;
+    imageInfo.extent = {extent.width, extent.height, 1};
+    imageInfo.mipLevels = 1;
+    imageInfo.arrayLayers = 1;
+    imageInfo.samples = VK_SAMPLE_COUNT_1_BIT;
+    imageInfo.tiling = VK_IMAGE_TILING_OPTIMAL;
+    imageInfo.usage = VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT | VK_IMAGE_USAGE_TRANSFER_SRC_BIT;
+    imageInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+    imageInfo.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+
+    if (vkCreateImage(device, &imageInfo, hostAllocator(VK_OBJECT_TYPE_IMAGE), &target.image) != VK_SUCCESS) {
+        throw std::runtime_error("failed to create batch render target!");
+    }
+
+    VkMemoryRequirements requirements;
+    vkGetImageMemoryRequirements(device, target.image, &requirements);
+
+    VkMemoryAllocateInfo allocInfo{};
+    allocInfo.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
+    allocInfo.allocationSize = requirements.size;
+    allocInfo.memoryTypeIndex = findMemoryType(physicalDevice, requirements.memoryTypeBits,
+                                               VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
+    if (vkAllocateMemory(device, &allocInfo, hostAllocator(VK_OBJECT_TYPE_DEVICE_MEMORY), &target.memory) != VK_SUCCESS) {
+        vkDestroyImage(device, target.image, hostAllocator(VK_OBJECT_TYPE_IMAGE));
+        target.image = VK_NULL_HANDLE;
+        throw std::runtime_error("failed to allocate batch render target memory!");
+    }
+    vkBindImageMemory(device, target.image, target.memory, 0);
+
+    VkImageViewCreateInfo viewInfo{};
+    viewInfo.sType = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO;
+    viewInfo.image = target.image;
+    viewInfo.viewType = VK_IMAGE_VIEW_TYPE_2D;
+    viewInfo.format = BATCH_RENDER_FORMAT;
+    viewInfo.subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+    viewInfo.subresourceRange.baseMipLevel = 0;
+    viewInfo.subresourceRange.levelCount = 1;
+    viewInfo.subresourceRange.baseArrayLayer = 0;
+    viewInfo.subresourceRange.layerCount = 1;
+
+    if (vkCreateImageView(device, &viewInfo, hostAllocator(VK_OBJECT_TYPE_IMAGE_VIEW), &target.view) != VK_SUCCESS) {
+        throw std::runtime_error("failed to create batch render target view!");
+    }
+
+    target.extent = extent;
+    target.lastUse = 0;
+    targetsCreated++;
+}
+// --------------------------------------------------------------------------------
+
+void BatchRenderer::destroyTarget(RenderTarget& target) {
+    // The cached framebuffer goes first, and everything waits for the last job
+    // that used the image
+    if (target.view != VK_NULL_HANDLE) {
+        objectCache.invalidateImageViews({target.view}, *deletionQueue);
+        deletionQueue->destroy(VK_OBJECT_TYPE_IMAGE_VIEW, target.view, target.lastUse);
+    }
+    if (target.image != VK_NULL_HANDLE) {
+        deletionQueue->destroy(VK_OBJECT_TYPE_IMAGE, target.image, target.lastUse);
+    }
+    if (target.memory != VK_NULL_HANDLE) {
+        deletionQueue->destroy(VK_OBJECT_TYPE_DEVICE_MEMORY, target.memory, target.lastUse);
+    }
+    target = RenderTarget{};
+}
+// --------------------------------------------------------------------------------
+
+void BatchRenderer::recordJob(VkCommandBuffer commandBuffer,
+                              const RenderJob& job,
+                              const SceneDesc& scene,
+                              RenderTarget& target) {
+    VkExtent2D extent = target.extent;
+
+    // The last job to use the image only copied from it, and the clear
+    // discards the contents, so only that copy has to finish first
+    VkImageMemoryBarrier2 barrier{};
+    barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER_2;
+    barrier.srcStageMask = VK_PIPELINE_STAGE_2_COPY_BIT;
+    barrier.srcAccessMask = VK_ACCESS_2_NONE;
+    barrier.dstStageMask = VK_PIPELINE_STAGE_2_COLOR_ATTACHMENT_OUTPUT_BIT;
+    barrier.dstAccessMask = VK_ACCESS_2_COLOR_ATTACHMENT_WRITE_BIT;
+    barrier.oldLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+    barrier.newLayout = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
+    barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    barrier.image = target.image;
+    barrier.subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+    barrier.subresourceRange.levelCount = 1;
+    barrier.subresourceRange.layerCount = 1;
+
+    VkDependencyInfo dependency{};
+    dependency.sType = VK_STRUCTURE_TYPE_DEPENDENCY_INFO;
+    dependency.imageMemoryBarrierCount = 1;
+    dependency.pImageMemoryBarriers = &barrier;
+    vkCmdPipelineBarrier2(commandBuffer, &dependency);
+
+    FramebufferDesc framebufferDesc;
+    framebufferDesc.renderPass = pipeline->getRenderPass();
+    framebufferDesc.attachments[0] = target.view;
+    framebufferDesc.attachmentCount = 1;
+    framebufferDesc.extent = extent;
+
+    VkRenderPassBeginInfo renderPassInfo{};
+    renderPassInfo.sType = VK_STRUCTURE_TYPE_RENDER_PASS_BEGIN_INFO;
+    renderPassInfo.renderPass = pipeline->getRenderPass();
+    renderPassInfo.framebuffer = objectCache.getFramebuffer(framebufferDesc);
+    renderPassInfo.renderArea.offset = {0, 0};
+    renderPassInfo.renderArea.extent = extent;
+
+    VkClearValue clearColor = {{{0.0f, 0.0f, 0.0f, 1.0f}}};
+    renderPassInfo.clearValueCount = 1;
+    renderPassInfo.pClearValues = &clearColor;
+
+    vkCmdBeginRenderPass(commandBuffer, &renderPassInfo, VK_SUBPASS_CONTENTS_INLINE);
+
+    VkViewport viewport{};
+    viewport.x = 0.0f;
+    viewport.y = 0.0f;
+    viewport.width = static_cast<float>(extent.width);
+    viewport.height = static_cast<float>(extent.height);
+    viewport.minDepth = 0.0f;
+    viewport.maxDepth = 1.0f;
+    vkCmdSetViewport(commandBuffer, 0, 1, &viewport);
+
+    VkRect2D scissor{};
+    scissor.offset = {0, 0};
+    scissor.extent = extent;
+    vkCmdSetScissor(commandBuffer, 0, 1, &scissor);
+
+    // The camera moves its center to the origin and then zooms
+    FrameUniforms frameUniforms{};
+    for (uint32_t i = 0; i < 4; i++) {
+        frameUniforms.tint[i] = scene.tint[i];
+    }
+    for (uint32_t i = 0; i < MAX_VIEW_COUNT; i++) {
+        frameUniforms.views[i][2] = 1.0f;
+    }
+    frameUniforms.views[0][0] = -job.camera.x * job.camera.zoom;
+    frameUniforms.views[0][1] = -job.camera.y * job.camera.zoom;
+    frameUniforms.views[0][2] = job.camera.zoom;
+    uint32_t frameOffset = uniformBuffer->push(frameUniforms);
+
+    DrawItem item{};
+    item.pipeline = pipeline->getPipeline();
+    item.layout = pipeline->getPipelineLayout();
+    item.descriptorSet = uniformBuffer->getDescriptorSet();
+    item.dynamicOffset = frameOffset;
+    item.hasDynamicOffset = true;
+    item.vertexCount = 3;
+    for (const SceneTriangle& triangle : scene.triangles) {
+        DrawPushConstants pushConstants{};
+        pushConstants.offset[0] = triangle.offset[0];
+        pushConstants.offset[1] = triangle.offset[1];
+        pushConstants.scale = triangle.scale;
+        renderQueue.submit(item, &pushConstants, sizeof(DrawPushConstants),
+                           VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT);
+    }
+    renderQueue.flush(commandBuffer);
+    vkCmdEndRenderPass(commandBuffer);
+
+    barrier.srcStageMask = VK_PIPELINE_STAGE_2_COLOR_ATTACHMENT_OUTPUT_BIT;
+    barrier.srcAccessMask = VK_ACCESS_2_COLOR_ATTACHMENT_WRITE_BIT;
+    barrier.dstStageMask = VK_PIPELINE_STAGE_2_COPY_BIT;
+    barrier.dstAccessMask = VK_ACCESS_2_TRANSFER_READ_BIT;
+    barrier.oldLayout = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
+    barrier.newLayout = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL;
+    vkCmdPipelineBarrier2(commandBuffer, &dependency);
+
+    // run() waited for a free readback slot before recording
+    CaptureFormat fileFormat = isRawOutput(job.outputPath) ? CaptureFormat::Raw : CaptureFormat::Png;
+    if (!readback->record(commandBuffer, target.image, BATCH_RENDER_FORMAT, extent, job.outputPath, fileFormat)) {
+        throw std::runtime_error("batch renderer has no free readback slot!");
+    }
+}
+// ================================================================================
+// ================================================================================
+// eof
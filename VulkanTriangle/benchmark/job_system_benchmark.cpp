@@ -0,0 +1,134 @@
+// ================================================================================
+// ================================================================================
+// - File:    job_system_benchmark.cpp
+// - Purpose: This file compares the JobSystem with std::async and serial
+//            execution for fine-grained tasks
+//
+// Source Metadata
+// - Author:  Jonathan A. Webb
+// - Date:    October 18, 2026
+// - Version: 1.0
+// - Copyright: Copyright 2022, Jon Webb Inc.
+// ================================================================================
+// ================================================================================
+// Include modules here
+
+#include "../include/job_system.hpp"
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <future>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+// ================================================================================
+// ================================================================================
+
+/**
+ * @brief A small amount of arithmetic standing in for one fine-grained task,
+ * such as culling one object
+ */
+static float taskBody(uint32_t index, uint32_t work) {
+    float value = static_cast<float>(index);
+    for (uint32_t i = 0; i < work; i++) {
+        value = std::sqrt(value + static_cast<float>(i));
+    }
+    return value;
+}
+// --------------------------------------------------------------------------------
+
+/**
+ * @brief Runs a benchmark several times and reports the best time per task
+ */
+template <typename Fn>
+static void report(const std::string& name, uint32_t tasks, uint32_t repetitions, Fn&& fn) {
+    double best = 1e30;
+    for (uint32_t r = 0; r < repetitions; r++) {
+        auto start = std::chrono::steady_clock::now();
+        fn();
+        std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+        best = std::min(best, elapsed.count());
+    }
+    std::cout << std::left << std::setw(28) << name
+              << std::right << std::setw(10) << tasks << " tasks "
+              << std::setw(12) << std::fixed << std::setprecision(1) << best / tasks << " ns/task"
+              << std::setw(12) << std::setprecision(3) << best / 1e6 << " ms" << std::endl;
+}
+// ================================================================================
+// ================================================================================
+
+int main(int argc, const char* argv[]) {
+    const uint32_t tasks = argc > 1 ? static_cast<uint32_t>(std::atoi(argv[1])) : 100000;
+    const uint32_t work = argc > 2 ? static_cast<uint32_t>(std::atoi(argv[2])) : 64;
+    const uint32_t repetitions = 5;
+
+    // std::async launches a thread per task, so it only gets a fraction of the load
+    const uint32_t asyncTasks = std::min(tasks, 10000u);
+
+    std::vector<float> results(tasks);
+    JobSystem jobs;
+
+    std::cout << "Threads: " << jobs.getThreadCount()
+              << ", work per task: " << work << " iterations" << std::endl;
+
+    report("serial", tasks, repetitions, [&]() {
+        for (uint32_t i = 0; i < tasks; i++) {
+            results[i] = taskBody(i, work);
+        }
+    });
+
+    report("std::async per task", asyncTasks, repetitions, [&]() {
+        std::vector<std::future<void>> futures;
+        futures.reserve(asyncTasks);
+        for (uint32_t i = 0; i < asyncTasks; i++) {
+            futures.push_back(std::async(std::launch::async, [&results, i, work]() {
+                results[i] = taskBody(i, work);
+            }));
+        }
+        for (auto& future : futures) {
+            future.wait();
+        }
+    });
+
+    report("JobSystem::run per task", tasks, repetitions, [&]() {
+        JobCounter counter;
+        for (uint32_t i = 0; i < tasks; i++) {
+            jobs.run([&results, i, work]() { results[i] = taskBody(i, work); }, &counter);
+        }
+        jobs.wait(counter);
+    });
+
+    report("JobSystem::parallelFor(64)", tasks, repetitions, [&]() {
+        jobs.parallelFor(tasks, 64, [&results, work](uint32_t begin, uint32_t end) {
+            for (uint32_t i = begin; i < end; i++) {
+                results[i] = taskBody(i, work);
+            }
+        });
+    });
+
+    report("JobSystem::parallelFor", tasks, repetitions, [&]() {
+        jobs.parallelFor(tasks, [&results, work](uint32_t i) { results[i] = taskBody(i, work); });
+    });
+
+    // Dependent stages: every task of the second stage reads the first stage
+    report("JobSystem::runAfter", tasks, repetitions, [&]() {
+        JobCounter first;
+        JobCounter second;
+        uint32_t half = tasks / 2;
+        for (uint32_t i = 0; i < half; i++) {
+            jobs.run([&results, i, work]() { results[i] = taskBody(i, work); }, &first);
+        }
+        for (uint32_t i = half; i < tasks; i++) {
+            jobs.runAfter(first, [&results, i, half, work]() {
+                results[i] = results[i - half] + taskBody(i, work);
+            }, &second);
+        }
+        jobs.wait(second);
+    });
+
+    return 0;
+}
+// ================================================================================
+// ================================================================================
+// eof
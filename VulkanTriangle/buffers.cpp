@@ -0,0 +1,332 @@
+// ================================================================================
+// ================================================================================
+// - File:    buffers.cpp
+// - Purpose: Contains the implementation for buffers.hpp
+//
+// Source Metadata
+// - Author:  Jonathan A. Webb
+// - Date:    October 18, 2026
+// - Version: 1.0
+// - Copyright: Copyright 2022, Jon Webb Inc.
+// ================================================================================
+// ================================================================================
+// Include modules here
+
+#include "include/buffers.hpp"
+#include "include/host_allocator.hpp"
+#include <stdexcept>
+#include <algorithm>
+// ================================================================================
+// ================================================================================
+
+uint32_t findMemoryType(VkPhysicalDevice physicalDevice,
+                        uint32_t typeFilter,
+                        VkMemoryPropertyFlags properties) {
+    VkPhysicalDeviceMemoryProperties memProperties;
+    vkGetPhysicalDeviceMemoryProperties(physicalDevice, &memProperties);
+
+    for (uint32_t i = 0; i < memProperties.memoryTypeCount; i++) {
+        if ((typeFilter & (1 << i)) &&
+            (memProperties.memoryTypes[i].propertyFlags & properties) == properties) {
+            return i;
+        }
+    }
+
+    throw std::runtime_error("failed to find suitable memory type!");
+}
+// --------------------------------------------------------------------------------
+
+void createBuffer(VkDevice device,
+                  VkPhysicalDevice physicalDevice,
+                  VkDeviceSize size,
+                  VkBufferUsageFlags usage,
+                  VkMemoryPropertyFlags properties,
+                  VkBuffer& buffer,
+                  VkDeviceMemory& bufferMemory) {
+    VkBufferCreateInfo bufferInfo{};
+    bufferInfo.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+    bufferInfo.size = size;
+    bufferInfo.usage = usage;
+    bufferInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+
+    if (vkCreateBuffer(device, &bufferInfo, hostAllocator(VK_OBJECT_TYPE_BUFFER), &buffer) != VK_SUCCESS) {
+        throw std::runtime_error("failed to create buffer!");
+    }
+
+    VkMemoryRequirements memRequirements;
+    vkGetBufferMemoryRequirements(device, buffer, &memRequirements);
+
+    VkMemoryAllocateInfo allocInfo{};
+    allocInfo.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
+    allocInfo.allocationSize = memRequirements.size;
+    allocInfo.memoryTypeIndex = findMemoryType(physicalDevice, memRequirements.memoryTypeBits, properties);
+
+    if (vkAllocateMemory(device, &allocInfo, hostAllocator(VK_OBJECT_TYPE_DEVICE_MEMORY), &bufferMemory) != VK_SUCCESS) {
+        vkDestroyBuffer(device, buffer, hostAllocator(VK_OBJECT_TYPE_BUFFER));
+        buffer = VK_NULL_HANDLE;
+        throw std::runtime_error("failed to allocate buffer memory!");
+    }
+
+    vkBindBufferMemory(device, buffer, bufferMemory, 0);
+}
+// ================================================================================
+// ================================================================================
+
+UniformRingBuffer::UniformRingBuffer(VkDevice device,
+                                     VkPhysicalDevice physicalDevice,
+                                     VkDeviceSize frameRegionSize,
+                                     uint32_t framesInFlight,
+                                     VkDeviceSize maxAllocationSize)
+    : device(device),
+      physicalDevice(physicalDevice),
+      frameRegionSize(frameRegionSize),
+      framesInFlight(framesInFlight),
+      maxAllocationSize(maxAllocationSize) {
+    VkPhysicalDeviceProperties properties;
+    vkGetPhysicalDeviceProperties(physicalDevice, &properties);
+    alignment = properties.limits.minUniformBufferOffsetAlignment;
+
+    if (maxAllocationSize > properties.limits.maxUniformBufferRange) {
+        throw std::runtime_error("uniform ring allocation size exceeds maxUniformBufferRange!");
+    }
+
+    // Round each region up so that every region starts on an aligned offset
+    this->frameRegionSize = (frameRegionSize + alignment - 1) & ~(alignment - 1);
+
+    createRingBuffer();
+    createDescriptors();
+}
+// --------------------------------------------------------------------------------
+
+UniformRingBuffer::~UniformRingBuffer() {
+    if (descriptorPool != VK_NULL_HANDLE) {
+        vkDestroyDescriptorPool(device, descriptorPool, hostAllocator(VK_OBJECT_TYPE_DESCRIPTOR_POOL));
+    }
+    if (descriptorSetLayout != VK_NULL_HANDLE) {
+        vkDestroyDescriptorSetLayout(device, descriptorSetLayout, hostAllocator(VK_OBJECT_TYPE_DESCRIPTOR_SET_LAYOUT));
+    }
+    if (mapped != nullptr) {
+        vkUnmapMemory(device, bufferMemory);
+    }
+    if (buffer != VK_NULL_HANDLE) {
+        vkDestroyBuffer(device, buffer, hostAllocator(VK_OBJECT_TYPE_BUFFER));
+    }
+    if (bufferMemory != VK_NULL_HANDLE) {
+        vkFreeMemory(device, bufferMemory, hostAllocator(VK_OBJECT_TYPE_DEVICE_MEMORY));
+    }
+}
+// --------------------------------------------------------------------------------
+
+void UniformRingBuffer::beginFrame(uint32_t frameIndex) {
+    regionBegin = static_cast<VkDeviceSize>(frameIndex % framesInFlight) * frameRegionSize;
+    head = 0;
+}
+// --------------------------------------------------------------------------------
+
+UniformAllocation UniformRingBuffer::allocate(VkDeviceSize size) {
+    if (size > maxAllocationSize) {
+        throw std::runtime_error("uniform ring allocation is larger than the descriptor range!");
+    }
+
+    VkDeviceSize offset = (head + alignment - 1) & ~(alignment - 1);
+    if (offset + size > frameRegionSize) {
+        throw std::runtime_error("uniform ring frame region exhausted!");
+    }
+    head = offset + size;
+
+    UniformAllocation allocation;
+    allocation.data = mapped + regionBegin + offset;
+    allocation.dynamicOffset = static_cast<uint32_t>(regionBegin + offset);
+    return allocation;
+}
+// --------------------------------------------------------------------------------
+
+void UniformRingBuffer::bind(VkCommandBuffer commandBuffer,
+                             VkPipelineLayout layout,
+                             uint32_t set,
+                             uint32_t dynamicOffset) const {
+    vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, layout,
+                            set, 1, &descriptorSet, 1, &dynamicOffset);
+}
+// --------------------------------------------------------------------------------
+
+VkDescriptorSetLayout UniformRingBuffer::getDescriptorSetLayout() const {
+    return descriptorSetLayout;
+}
+// --------------------------------------------------------------------------------
+
+VkDescriptorSet UniformRingBuffer::getDescriptorSet() const {
+    return descriptorSet;
+}
+// --------------------------------------------------------------------------------
+
+VkDeviceSize UniformRingBuffer::getAlignment() const {
+    return alignment;
+}
+// --------------------------------------------------------------------------------
+
+VkDeviceSize UniformRingBuffer::getBytesUsed() const {
+    return head;
+}
+// ================================================================================
+
+void UniformRingBuffer::createRingBuffer() {
+    // The descriptor always reads maxAllocationSize bytes past the dynamic offset,
+    // so pad the tail to keep the last allocation of the last region in bounds
+    VkDeviceSize size = frameRegionSize * framesInFlight + maxAllocationSize;
+
+    createBuffer(device, physicalDevice, size,
+                 VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT,
+                 VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
+                 buffer, bufferMemory);
+
+    void* data = nullptr;
+    if (vkMapMemory(device, bufferMemory, 0, size, 0, &data) != VK_SUCCESS) {
+        throw std::runtime_error("failed to map uniform ring buffer!");
+    }
+    mapped = static_cast<char*>(data);
+}
+// --------------------------------------------------------------------------------
+
+void UniformRingBuffer::createDescriptors() {
+    VkDescriptorSetLayoutBinding uboLayoutBinding{};
+    uboLayoutBinding.binding = 0;
+    uboLayoutBinding.descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC;
+    uboLayoutBinding.descriptorCount = 1;
+    uboLayoutBinding.stageFlags = VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT;
+    uboLayoutBinding.pImmutableSamplers = nullptr;
+
+    VkDescriptorSetLayoutCreateInfo layoutInfo{};
+    layoutInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
+    layoutInfo.bindingCount = 1;
+    layoutInfo.pBindings = &uboLayoutBinding;
+
+    if (vkCreateDescriptorSetLayout(device, &layoutInfo, hostAllocator(VK_OBJECT_TYPE_DESCRIPTOR_SET_LAYOUT), &descriptorSetLayout) != VK_SUCCESS) {
+        throw std::runtime_error("failed to create descriptor set layout!");
+    }
+
+    VkDescriptorPoolSize poolSize{};
+    poolSize.type = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC;
+    poolSize.descriptorCount = 1;
+
+    VkDescriptorPoolCreateInfo poolInfo{};
+    poolInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
+    poolInfo.poolSizeCount = 1;
+    poolInfo.pPoolSizes = &poolSize;
+    poolInfo.maxSets = 1;
+
+    if (vkCreateDescriptorPool(device, &poolInfo, hostAllocator(VK_OBJECT_TYPE_DESCRIPTOR_POOL), &descriptorPool) != VK_SUCCESS) {
+        throw std::runtime_error("failed to create descriptor pool!");
+    }
+
+    VkDescriptorSetAllocateInfo allocInfo{};
+    allocInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+    allocInfo.descriptorPool = descriptorPool;
+    allocInfo.descriptorSetCount = 1;
+    allocInfo.pSetLayouts = &descriptorSetLayout;
+
+    if (vkAllocateDescriptorSets(device, &allocInfo, &descriptorSet) != VK_SUCCESS) {
+        throw std::runtime_error("failed to allocate descriptor set!");
+    }
+
+    // The descriptor is written exactly once; per-draw data only changes the dynamic offset
+    VkDescriptorBufferInfo bufferInfo{};
+    bufferInfo.buffer = buffer;
+    bufferInfo.offset = 0;
+    bufferInfo.range = maxAllocationSize;
+
+    VkWriteDescriptorSet descriptorWrite{};
+    descriptorWrite.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+    descriptorWrite.dstSet = descriptorSet;
+    descriptorWrite.dstBinding = 0;
+    descriptorWrite.dstArrayElement = 0;
+    descriptorWrite.descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC;
+    descriptorWrite.descriptorCount = 1;
+    descriptorWrite.pBufferInfo = &bufferInfo;
+
+    vkUpdateDescriptorSets(device, 1, &descriptorWrite, 0, nullptr);
+}
+// ================================================================================
+// ================================================================================
+
+StagingRing::StagingRing(VkDevice device, VkPhysicalDevice physicalDevice, VkDeviceSize size)
+    : device(device),
+      size((size + STAGING_RING_MAX_ALIGNMENT - 1) & ~(STAGING_RING_MAX_ALIGNMENT - 1)) {
+    createBuffer(device, physicalDevice, this->size,
+                 VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
+                 VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
+                 buffer, bufferMemory);
+
+    void* data = nullptr;
+    if (vkMapMemory(device, bufferMemory, 0, this->size, 0, &data) != VK_SUCCESS) {
+        throw std::runtime_error("failed to map staging ring buffer!");
+    }
+    mapped = static_cast<char*>(data);
+}
+// --------------------------------------------------------------------------------
+
+StagingRing::~StagingRing() {
+    if (mapped != nullptr) {
+        vkUnmapMemory(device, bufferMemory);
+    }
+    if (buffer != VK_NULL_HANDLE) {
+        vkDestroyBuffer(device, buffer, hostAllocator(VK_OBJECT_TYPE_BUFFER));
+    }
+    if (bufferMemory != VK_NULL_HANDLE) {
+        vkFreeMemory(device, bufferMemory, hostAllocator(VK_OBJECT_TYPE_DEVICE_MEMORY));
+    }
+}
+// --------------------------------------------------------------------------------
+
+bool StagingRing::allocate(VkDeviceSize bytes, VkDeviceSize alignment, StagingAllocation& allocation) {
+    if (alignment > STAGING_RING_MAX_ALIGNMENT || (alignment & (alignment - 1)) != 0) {
+        throw std::runtime_error("staging ring alignment must be a power of two no larger than 256!");
+    }
+    alignment = alignment == 0 ? 1 : alignment;
+
+    // The size is a multiple of every permitted alignment, so aligning the
+    // monotonic position also aligns the offset within the buffer
+    uint64_t start = (head + alignment - 1) & ~(static_cast<uint64_t>(alignment) - 1);
+    VkDeviceSize offset = start % size;
+    if (offset + bytes > size) {
+        // Skip the tail of the buffer rather than split the allocation
+        start += size - offset;
+        offset = 0;
+    }
+    if (start + bytes - tail > size) {
+        return false;
+    }
+    head = start + bytes;
+
+    allocation.data = mapped + offset;
+    allocation.offset = offset;
+    return true;
+}
+// --------------------------------------------------------------------------------
+
+uint64_t StagingRing::getHead() const {
+    return head;
+}
+// --------------------------------------------------------------------------------
+
+void StagingRing::release(uint64_t position) {
+    tail = std::max(tail, std::min(position, head));
+}
+// --------------------------------------------------------------------------------
+
+VkBuffer StagingRing::getBuffer() const {
+    return buffer;
+}
+// --------------------------------------------------------------------------------
+
+VkDeviceSize StagingRing::getSize() const {
+    return size;
+}
+// --------------------------------------------------------------------------------
+
+VkDeviceSize StagingRing::getBytesInUse() const {
+    return head - tail;
+}
+// ================================================================================
+// ================================================================================
+// eof
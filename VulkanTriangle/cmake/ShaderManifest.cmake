@@ -0,0 +1,40 @@
+# ================================================================================
+# ================================================================================
+# - File:    ShaderManifest.cmake
+# - Purpose: Script that joins the per-variant rows into the shader manifest
+#
+# Source Metadata
+# - Author:  Jonathan A. Webb
+# - Date:    October 18, 2026
+# - Version: 1.0
+# - Copyright: Copyright 2024, Jonathan A. Webb Inc.
+# ================================================================================
+# ================================================================================
+# Run with cmake -P.  Expects STATS_FILES, a comma separated list of rows
+# written by ShaderStats.cmake, and OUTPUT.
+
+string(REPLACE "," ";" STATS_FILES "${STATS_FILES}")
+
+set(MANIFEST "variant\tsource\tdefines\tspec_constants\t")
+string(APPEND MANIFEST "input_bytes\tinput_instructions\toutput_bytes\toutput_instructions\n")
+
+set(TOTAL_BEFORE 0)
+set(TOTAL_AFTER 0)
+foreach(STATS ${STATS_FILES})
+    file(READ ${STATS} ROW)
+    string(APPEND MANIFEST "${ROW}")
+
+    string(REPLACE "\t" ";" FIELDS "${ROW}")
+    list(GET FIELDS 4 BEFORE)
+    list(GET FIELDS 6 AFTER)
+    math(EXPR TOTAL_BEFORE "${TOTAL_BEFORE} + ${BEFORE}")
+    math(EXPR TOTAL_AFTER "${TOTAL_AFTER} + ${AFTER}")
+endforeach()
+
+file(WRITE ${OUTPUT} "${MANIFEST}")
+
+list(LENGTH STATS_FILES COUNT)
+message(STATUS "${COUNT} shader variants, ${TOTAL_BEFORE} bytes of SPIR-V reduced to ${TOTAL_AFTER}")
+# ================================================================================
+# ================================================================================
+# eof
@@ -0,0 +1,64 @@
+# ================================================================================
+# ================================================================================
+# - File:    ShaderStats.cmake
+# - Purpose: Script that measures one shader variant for the shader manifest
+#
+# Source Metadata
+# - Author:  Jonathan A. Webb
+# - Date:    October 18, 2026
+# - Version: 1.0
+# - Copyright: Copyright 2024, Jonathan A. Webb Inc.
+# ================================================================================
+# ================================================================================
+# Run with cmake -P.  Expects VARIANT, SOURCE, DEFINES, SPEC_CONSTANTS,
+# UNOPTIMIZED, SPIRV and OUTPUT, and writes one manifest row to OUTPUT.
+
+# Sets <prefix>_BYTES and <prefix>_INSTRUCTIONS for a SPIR-V file.  The word
+# count of each instruction is in the upper half of its first word.
+function(measure_spirv FILE PREFIX)
+    file(SIZE ${FILE} BYTES)
+    file(READ ${FILE} CONTENTS HEX)
+
+    string(SUBSTRING "${CONTENTS}" 0 8 MAGIC)
+    if(NOT MAGIC STREQUAL "03022307")
+        message(FATAL_ERROR "${FILE} is not little-endian SPIR-V")
+    endif()
+
+    # Skip the five word header
+    set(OFFSET 40)
+    string(LENGTH "${CONTENTS}" LENGTH)
+    set(INSTRUCTIONS 0)
+    while(OFFSET LESS LENGTH)
+        math(EXPR HIGH_OFFSET "${OFFSET} + 6")
+        math(EXPR LOW_OFFSET "${OFFSET} + 4")
+        string(SUBSTRING "${CONTENTS}" ${HIGH_OFFSET} 2 HIGH)
+        string(SUBSTRING "${CONTENTS}" ${LOW_OFFSET} 2 LOW)
+        math(EXPR WORDS "0x${HIGH}${LOW}")
+        if(WORDS EQUAL 0)
+            message(FATAL_ERROR "${FILE} contains an instruction with no words")
+        endif()
+        math(EXPR OFFSET "${OFFSET} + ${WORDS} * 8")
+        math(EXPR INSTRUCTIONS "${INSTRUCTIONS} + 1")
+    endwhile()
+
+    set(${PREFIX}_BYTES ${BYTES} PARENT_SCOPE)
+    set(${PREFIX}_INSTRUCTIONS ${INSTRUCTIONS} PARENT_SCOPE)
+endfunction()
+# --------------------------------------------------------------------------------
+
+measure_spirv(${UNOPTIMIZED} BEFORE)
+measure_spirv(${SPIRV} AFTER)
+
+if(NOT DEFINES)
+    set(DEFINES "-")
+endif()
+if(NOT SPEC_CONSTANTS)
+    set(SPEC_CONSTANTS "-")
+endif()
+
+file(WRITE ${OUTPUT}
+     "${VARIANT}\t${SOURCE}\t${DEFINES}\t${SPEC_CONSTANTS}\t"
+     "${BEFORE_BYTES}\t${BEFORE_INSTRUCTIONS}\t${AFTER_BYTES}\t${AFTER_INSTRUCTIONS}\n")
+# ================================================================================
+# ================================================================================
+# eof
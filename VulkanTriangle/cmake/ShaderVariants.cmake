@@ -0,0 +1,199 @@
+# ================================================================================
+# ================================================================================
+# - File:    ShaderVariants.cmake
+# - Purpose: Compiles GLSL shaders and their variants to SPIR-V
+#
+# Source Metadata
+# - Author:  Jonathan A. Webb
+# - Date:    October 18, 2026
+# - Version: 1.0
+# - Copyright: Copyright 2024, Jonathan A. Webb Inc.
+# ================================================================================
+# ================================================================================
+# Every variant is compiled with glslangValidator.  In Release and MinSizeRel
+# builds it is then run through spirv-opt -O with debug information stripped,
+# which gives the driver less to compile at startup.  Each variant's size and
+# instruction count, before and after optimization, is written to a manifest.
+# Everything is written to the build directory, so the source tree stays clean
+# and separate build directories do not overwrite each other's shaders.
+
+find_program(SPIRV_OPT spirv-opt HINTS "$ENV{VULKAN_SDK}/bin")
+
+option(SHADER_OPTIMIZE "Optimize and strip SPIR-V in release builds" ON)
+
+if(SHADER_OPTIMIZE AND CMAKE_BUILD_TYPE MATCHES "^(Release|MinSizeRel)$")
+    if(SPIRV_OPT)
+        set(SHADER_OPTIMIZE_ENABLED ON)
+        message(STATUS "Found spirv-opt: ${SPIRV_OPT}")
+    else()
+        message(WARNING "spirv-opt was not found; shaders will not be optimized")
+    endif()
+endif()
+
+set(SHADER_OUTPUT_DIR ${CMAKE_BINARY_DIR}/shaders)
+set(SHADER_INTERMEDIATE_DIR ${CMAKE_BINARY_DIR}/shaders/intermediate)
+set(SHADER_MANIFEST ${CMAKE_BINARY_DIR}/shader_manifest.tsv)
+set(SHADER_SCRIPT_DIR ${CMAKE_CURRENT_LIST_DIR})
+# --------------------------------------------------------------------------------
+
+# add_shader_variants(<source>
+#                     [DEFINES <NAME>=<value>|<value>...]...
+#                     [SPEC_CONSTANTS <id>=<value>|<value>...]...)
+#
+# Compiles <source> to <source>.spv in SHADER_OUTPUT_DIR, plus one variant for every
+# combination of the listed values.  DEFINES are passed to the preprocessor,
+# so the shader must give each one a default with #ifndef.  SPEC_CONSTANTS
+# replace the default of a specialization constant, which lets spirv-opt fold
+# it away; they always need spirv-opt.  A variant's file name lists its
+# values, e.g. particles.comp.WORKGROUP_SIZE_64.spv or shader.frag.SPEC0_1.spv.
+function(add_shader_variants SOURCE)
+    cmake_parse_arguments(SHADER "" "" "DEFINES;SPEC_CONSTANTS" ${ARGN})
+
+    if(SHADER_SPEC_CONSTANTS AND NOT SPIRV_OPT)
+        message(FATAL_ERROR "${SOURCE} has specialization constant variants, which need spirv-opt")
+    endif()
+
+    # Build the cross product of every axis.  A combination is a comma
+    # separated string of D:<name>=<value> and S:<id>=<value> entries.
+    set(COMBINATIONS "")
+    set(AXES "")
+    foreach(AXIS ${SHADER_DEFINES})
+        list(APPEND AXES "D:${AXIS}")
+    endforeach()
+    foreach(AXIS ${SHADER_SPEC_CONSTANTS})
+        list(APPEND AXES "S:${AXIS}")
+    endforeach()
+    foreach(AXIS ${AXES})
+        string(REGEX MATCH "^(.:[^=]+)=(.+)$" MATCHED "${AXIS}")
+        if(NOT MATCHED)
+            message(FATAL_ERROR "Shader variant axis '${AXIS}' must look like NAME=value|value")
+        endif()
+        set(AXIS_NAME ${CMAKE_MATCH_1})
+        string(REPLACE "|" ";" AXIS_VALUES "${CMAKE_MATCH_2}")
+
+        set(EXTENDED "")
+        foreach(VALUE ${AXIS_VALUES})
+            if(COMBINATIONS)
+                foreach(COMBINATION ${COMBINATIONS})
+                    list(APPEND EXTENDED "${COMBINATION},${AXIS_NAME}=${VALUE}")
+                endforeach()
+            else()
+                list(APPEND EXTENDED "${AXIS_NAME}=${VALUE}")
+            endif()
+        endforeach()
+        set(COMBINATIONS ${EXTENDED})
+    endforeach()
+
+    # The unsuffixed file, built from the shader's own defaults, always exists
+    _add_shader_variant(${SOURCE} "")
+    foreach(COMBINATION ${COMBINATIONS})
+        _add_shader_variant(${SOURCE} "${COMBINATION}")
+    endforeach()
+endfunction()
+# --------------------------------------------------------------------------------
+
+function(_add_shader_variant SOURCE COMBINATION)
+    get_filename_component(FILE_NAME ${SOURCE} NAME)
+
+    set(SUFFIX "")
+    set(DEFINE_FLAGS "")
+    set(SPEC_VALUES "")
+    set(DEFINE_LABEL "")
+    set(SPEC_LABEL "")
+    string(REPLACE "," ";" ENTRIES "${COMBINATION}")
+    foreach(ENTRY ${ENTRIES})
+        string(REGEX MATCH "^(.):([^=]+)=(.+)$" MATCHED "${ENTRY}")
+        if(CMAKE_MATCH_1 STREQUAL "D")
+            string(APPEND SUFFIX ".${CMAKE_MATCH_2}_${CMAKE_MATCH_3}")
+            list(APPEND DEFINE_FLAGS "-D${CMAKE_MATCH_2}=${CMAKE_MATCH_3}")
+            list(APPEND DEFINE_LABEL "${CMAKE_MATCH_2}=${CMAKE_MATCH_3}")
+        else()
+            string(APPEND SUFFIX ".SPEC${CMAKE_MATCH_2}_${CMAKE_MATCH_3}")
+            list(APPEND SPEC_VALUES "${CMAKE_MATCH_2}:${CMAKE_MATCH_3}")
+            list(APPEND SPEC_LABEL "${CMAKE_MATCH_2}=${CMAKE_MATCH_3}")
+        endif()
+    endforeach()
+
+    set(VARIANT ${FILE_NAME}${SUFFIX})
+    set(SPIRV ${SHADER_OUTPUT_DIR}/${VARIANT}.spv)
+    set(STATS ${SHADER_INTERMEDIATE_DIR}/${VARIANT}.tsv)
+
+    if(SHADER_OPTIMIZE_ENABLED OR SPEC_VALUES)
+        set(UNOPTIMIZED ${SHADER_INTERMEDIATE_DIR}/${VARIANT}.unoptimized.spv)
+        set(OPT_FLAGS "")
+        if(SPEC_VALUES)
+            string(REPLACE ";" " " SPEC_ARGUMENT "${SPEC_VALUES}")
+            list(APPEND OPT_FLAGS "--set-spec-const-default-value" "${SPEC_ARGUMENT}")
+        endif()
+        if(SHADER_OPTIMIZE_ENABLED)
+            list(APPEND OPT_FLAGS -O --strip-debug)
+        endif()
+
+        add_custom_command(
+            OUTPUT ${SPIRV}
+            COMMAND ${CMAKE_COMMAND} -E make_directory ${SHADER_INTERMEDIATE_DIR}
+            COMMAND ${GLSLANG_VALIDATOR} -V ${DEFINE_FLAGS} ${SOURCE} -o ${UNOPTIMIZED}
+            COMMAND ${SPIRV_OPT} ${OPT_FLAGS} ${UNOPTIMIZED} -o ${SPIRV}
+            DEPENDS ${SOURCE}
+            COMMENT "Compiling ${VARIANT} to optimized SPIR-V"
+            VERBATIM
+        )
+    else()
+        set(UNOPTIMIZED ${SPIRV})
+        add_custom_command(
+            OUTPUT ${SPIRV}
+            COMMAND ${CMAKE_COMMAND} -E make_directory ${SHADER_OUTPUT_DIR}
+            COMMAND ${GLSLANG_VALIDATOR} -V ${DEFINE_FLAGS} ${SOURCE} -o ${SPIRV}
+            DEPENDS ${SOURCE}
+            COMMENT "Compiling ${VARIANT} to SPIR-V"
+            VERBATIM
+        )
+    endif()
+
+    string(REPLACE ";" "," DEFINE_LABEL "${DEFINE_LABEL}")
+    string(REPLACE ";" "," SPEC_LABEL "${SPEC_LABEL}")
+    add_custom_command(
+        OUTPUT ${STATS}
+        COMMAND ${CMAKE_COMMAND}
+                -DVARIANT=${VARIANT}
+                -DSOURCE=${SOURCE}
+                -DDEFINES=${DEFINE_LABEL}
+                -DSPEC_CONSTANTS=${SPEC_LABEL}
+                -DUNOPTIMIZED=${UNOPTIMIZED}
+                -DSPIRV=${SPIRV}
+                -DOUTPUT=${STATS}
+                -P ${SHADER_SCRIPT_DIR}/ShaderStats.cmake
+        DEPENDS ${SPIRV} ${SHADER_SCRIPT_DIR}/ShaderStats.cmake
+        VERBATIM
+    )
+
+    set_property(GLOBAL APPEND PROPERTY SHADER_SPIRV_FILES ${SPIRV})
+    set_property(GLOBAL APPEND PROPERTY SHADER_STATS_FILES ${STATS})
+endfunction()
+# --------------------------------------------------------------------------------
+
+# add_shader_target(<target>)
+#
+# Adds a target that builds every variant declared so far and writes their
+# statistics to shader_manifest.tsv in the build directory.
+function(add_shader_target TARGET)
+    get_property(SPIRV_FILES GLOBAL PROPERTY SHADER_SPIRV_FILES)
+    get_property(STATS_FILES GLOBAL PROPERTY SHADER_STATS_FILES)
+
+    string(REPLACE ";" "," STATS_LIST "${STATS_FILES}")
+    add_custom_command(
+        OUTPUT ${SHADER_MANIFEST}
+        COMMAND ${CMAKE_COMMAND}
+                -DSTATS_FILES=${STATS_LIST}
+                -DOUTPUT=${SHADER_MANIFEST}
+                -P ${SHADER_SCRIPT_DIR}/ShaderManifest.cmake
+        DEPENDS ${STATS_FILES} ${SHADER_SCRIPT_DIR}/ShaderManifest.cmake
+        COMMENT "Writing shader manifest ${SHADER_MANIFEST}"
+        VERBATIM
+    )
+
+    add_custom_target(${TARGET} ALL DEPENDS ${SPIRV_FILES} ${SHADER_MANIFEST})
+endfunction()
+# ================================================================================
+# ================================================================================
+# eof
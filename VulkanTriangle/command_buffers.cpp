@@ -0,0 +1,87 @@
+// ================================================================================
+// ================================================================================
+// - File:    command_buffers.cpp
+// - Purpose: Contains the implementation for command_buffers.hpp
+//
+// Source Metadata
+// - Author:  Jonathan A. Webb
+// - Date:    October 18, 2026
+// - Version: 1.0
+// - Copyright: Copyright 2022, Jon Webb Inc.
+// ================================================================================
+// ================================================================================
+// Include modules here
+
+#include "include/command_buffers.hpp"
+#include "include/queues.hpp"
+#include "include/host_allocator.hpp"
+#include <stdexcept>
+// ================================================================================
+// ================================================================================
+
+CommandBufferManager::CommandBufferManager(VkDevice device,
+                                           VkPhysicalDevice physicalDevice,
+                                           VkSurfaceKHR surface,
+                                           uint32_t count)
+    : device(device),
+      queueFamilyIndex(QueueFamily::findQueueFamilies(physicalDevice, surface).graphicsFamily.value()) {
+    createCommandPool();
+    createCommandBuffers(count);
+}
+// --------------------------------------------------------------------------------
+
+CommandBufferManager::CommandBufferManager(VkDevice device,
+                                           uint32_t queueFamilyIndex,
+                                           uint32_t count)
+    : device(device),
+      queueFamilyIndex(queueFamilyIndex) {
+    createCommandPool();
+    createCommandBuffers(count);
+}
+// --------------------------------------------------------------------------------
+
+CommandBufferManager::~CommandBufferManager() {
+    if (commandPool != VK_NULL_HANDLE) {
+        vkDestroyCommandPool(device, commandPool, hostAllocator(VK_OBJECT_TYPE_COMMAND_POOL));
+    }
+}
+// --------------------------------------------------------------------------------
+
+VkCommandBuffer CommandBufferManager::getCommandBuffer(uint32_t index) const {
+    return commandBuffers[index];
+}
+// --------------------------------------------------------------------------------
+
+VkCommandPool CommandBufferManager::getCommandPool() const {
+    return commandPool;
+}
+// ================================================================================
+
+void CommandBufferManager::createCommandPool() {
+    VkCommandPoolCreateInfo poolInfo{};
+    poolInfo.sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO;
+    poolInfo.flags = VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT;
+    poolInfo.queueFamilyIndex = queueFamilyIndex;
+
+    if (vkCreateCommandPool(device, &poolInfo, hostAllocator(VK_OBJECT_TYPE_COMMAND_POOL), &commandPool) != VK_SUCCESS) {
+        throw std::runtime_error("failed to create command pool!");
+    }
+}
+// --------------------------------------------------------------------------------
+
+void CommandBufferManager::createCommandBuffers(uint32_t count) {
+    commandBuffers.resize(count);
+
+    VkCommandBufferAllocateInfo allocInfo{};
+    allocInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
+    allocInfo.commandPool = commandPool;
+    allocInfo.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+    allocInfo.commandBufferCount = count;
+
+    if (vkAllocateCommandBuffers(device, &allocInfo, commandBuffers.data()) != VK_SUCCESS) {
+        throw std::runtime_error("failed to allocate command buffers!");
+    }
+}
+// ================================================================================
+// ================================================================================
+// eof
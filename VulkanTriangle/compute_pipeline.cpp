@@ -0,0 +1,77 @@
+// ================================================================================
+// ================================================================================
+// - File:    compute_pipeline.cpp
+// - Purpose: Contains the implementation for compute_pipeline.hpp
+//
+// Source Metadata
+// - Author:  Jonathan A. Webb
+// - Date:    October 18, 2026
+// - Version: 1.0
+// - Copyright: Copyright 2022, Jon Webb Inc.
+// ================================================================================
+// ================================================================================
+// Include modules here
+
+#include "include/compute_pipeline.hpp"
+#include "include/host_allocator.hpp"
+#include <stdexcept>
+// ================================================================================
+// ================================================================================
+
+ComputePipeline::ComputePipeline(VkDevice device,
+                                 const std::string& computeShader,
+                                 const std::vector<VkDescriptorSetLayout>& descriptorSetLayouts,
+                                 uint32_t pushConstantSize,
+                                 PipelineStateCache& pipelineCache)
+    : device(device),
+      pipelineCache(pipelineCache),
+      computeShader(computeShader) {
+    createPipelineLayout(descriptorSetLayouts, pushConstantSize);
+    computePipeline = pipelineCache.getComputePipeline(computeShader, pipelineLayout);
+}
+// --------------------------------------------------------------------------------
+
+ComputePipeline::~ComputePipeline() {
+    // The pipeline is owned by the cache
+    if (pipelineLayout != VK_NULL_HANDLE) {
+        vkDestroyPipelineLayout(device, pipelineLayout, hostAllocator(VK_OBJECT_TYPE_PIPELINE_LAYOUT));
+    }
+}
+// --------------------------------------------------------------------------------
+
+VkPipeline ComputePipeline::getPipeline() const {
+    return computePipeline;
+}
+// --------------------------------------------------------------------------------
+
+VkPipelineLayout ComputePipeline::getPipelineLayout() const {
+    return pipelineLayout;
+}
+// --------------------------------------------------------------------------------
+
+void ComputePipeline::refreshPipeline() {
+    computePipeline = pipelineCache.getComputePipeline(computeShader, pipelineLayout);
+}
+// ================================================================================
+
+void ComputePipeline::createPipelineLayout(const std::vector<VkDescriptorSetLayout>& descriptorSetLayouts,
+                                           uint32_t pushConstantSize) {
+    VkPushConstantRange pushConstantRange{};
+    pushConstantRange.stageFlags = VK_SHADER_STAGE_COMPUTE_BIT;
+    pushConstantRange.offset = 0;
+    pushConstantRange.size = pushConstantSize;
+
+    VkPipelineLayoutCreateInfo pipelineLayoutInfo{};
+    pipelineLayoutInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
+    pipelineLayoutInfo.setLayoutCount = static_cast<uint32_t>(descriptorSetLayouts.size());
+    pipelineLayoutInfo.pSetLayouts = descriptorSetLayouts.data();
+    pipelineLayoutInfo.pushConstantRangeCount = pushConstantSize > 0 ? 1 : 0;
+    pipelineLayoutInfo.pPushConstantRanges = &pushConstantRange;
+
+    if (vkCreatePipelineLayout(device, &pipelineLayoutInfo, hostAllocator(VK_OBJECT_TYPE_PIPELINE_LAYOUT), &pipelineLayout) != VK_SUCCESS) {
+        throw std::runtime_error("failed to create compute pipeline layout!");
+    }
+}
+// ================================================================================
+// ================================================================================
+// eof
@@ -0,0 +1,143 @@
+// ================================================================================
+// ================================================================================
+// - File:    deletion_queue.cpp
+// - Purpose: Contains the implementation for deletion_queue.hpp
+//
+// Source Metadata
+// - Author:  Jonathan A. Webb
+// - Date:    October 18, 2026
+// - Version: 1.0
+// - Copyright: Copyright 2022, Jon Webb Inc.
+// ================================================================================
+// ================================================================================
+// Include modules here
+
+#include "include/deletion_queue.hpp"
+#include "include/host_allocator.hpp"
+#include <algorithm>
+#include <stdexcept>
+// ================================================================================
+// ================================================================================
+
+DeletionQueue::DeletionQueue(VkDevice device, const TimelineSemaphore& timeline)
+    : device(device), timeline(timeline) {}
+// --------------------------------------------------------------------------------
+
+DeletionQueue::~DeletionQueue() {
+    // Owners may hand handles back to the queue from their destructors, so the
+    // loop runs until nothing is left
+    while (!entries.empty()) {
+        std::vector<Entry> remaining;
+        remaining.swap(entries);
+        for (Entry& entry : remaining) {
+            destroyEntry(entry);
+        }
+    }
+}
+// --------------------------------------------------------------------------------
+
+void DeletionQueue::collect(std::pmr::memory_resource* scratch) {
+    if (entries.empty()) {
+        return;
+    }
+
+    // Destroying an entry may queue new ones, so finished entries are moved
+    // out before any is destroyed.  The pending entries are compacted in
+    // place, which keeps them in order without a temporary buffer.
+    std::pmr::vector<Entry> finished(scratch);
+    size_t kept = 0;
+    for (size_t i = 0; i < entries.size(); i++) {
+        if (timeline.isComplete(entries[i].lastUse)) {
+            finished.push_back(std::move(entries[i]));
+        } else {
+            if (kept != i) {
+                entries[kept] = std::move(entries[i]);
+            }
+            kept++;
+        }
+    }
+    entries.erase(entries.begin() + static_cast<std::ptrdiff_t>(kept), entries.end());
+
+    for (Entry& entry : finished) {
+        destroyEntry(entry);
+    }
+}
+// --------------------------------------------------------------------------------
+
+size_t DeletionQueue::size() const {
+    return entries.size();
+}
+// ================================================================================
+
+void DeletionQueue::push(VkObjectType type, uint64_t handle, uint64_t lastUse) {
+    if (handle == 0) {
+        return;
+    }
+    switch (type) {
+        case VK_OBJECT_TYPE_BUFFER:
+        case VK_OBJECT_TYPE_IMAGE:
+        case VK_OBJECT_TYPE_IMAGE_VIEW:
+        case VK_OBJECT_TYPE_DEVICE_MEMORY:
+        case VK_OBJECT_TYPE_FRAMEBUFFER:
+        case VK_OBJECT_TYPE_PIPELINE:
+        case VK_OBJECT_TYPE_SAMPLER:
+        case VK_OBJECT_TYPE_SEMAPHORE:
+        case VK_OBJECT_TYPE_QUERY_POOL:
+        case VK_OBJECT_TYPE_DESCRIPTOR_POOL:
+        case VK_OBJECT_TYPE_COMMAND_POOL:
+        case VK_OBJECT_TYPE_SWAPCHAIN_KHR:
+            entries.push_back({lastUse, type, handle, nullptr});
+            break;
+        default:
+            throw std::runtime_error("object type cannot be queued for deferred destruction!");
+    }
+}
+// --------------------------------------------------------------------------------
+
+void DeletionQueue::destroyEntry(Entry& entry) {
+    switch (entry.type) {
+        case VK_OBJECT_TYPE_BUFFER:
+            vkDestroyBuffer(device, (VkBuffer)entry.handle, hostAllocator(entry.type));
+            break;
+        case VK_OBJECT_TYPE_IMAGE:
+            vkDestroyImage(device, (VkImage)entry.handle, hostAllocator(entry.type));
+            break;
+        case VK_OBJECT_TYPE_IMAGE_VIEW:
+            vkDestroyImageView(device, (VkImageView)entry.handle, hostAllocator(entry.type));
+            break;
+        case VK_OBJECT_TYPE_DEVICE_MEMORY:
+            vkFreeMemory(device, (VkDeviceMemory)entry.handle, hostAllocator(entry.type));
+            break;
+        case VK_OBJECT_TYPE_FRAMEBUFFER:
+            vkDestroyFramebuffer(device, (VkFramebuffer)entry.handle, hostAllocator(entry.type));
+            break;
+        case VK_OBJECT_TYPE_PIPELINE:
+            vkDestroyPipeline(device, (VkPipeline)entry.handle, hostAllocator(entry.type));
+            break;
+        case VK_OBJECT_TYPE_SAMPLER:
+            vkDestroySampler(device, (VkSampler)entry.handle, hostAllocator(entry.type));
+            break;
+        case VK_OBJECT_TYPE_SEMAPHORE:
+            vkDestroySemaphore(device, (VkSemaphore)entry.handle, hostAllocator(entry.type));
+            break;
+        case VK_OBJECT_TYPE_QUERY_POOL:
+            vkDestroyQueryPool(device, (VkQueryPool)entry.handle, hostAllocator(entry.type));
+            break;
+        case VK_OBJECT_TYPE_DESCRIPTOR_POOL:
+            vkDestroyDescriptorPool(device, (VkDescriptorPool)entry.handle, hostAllocator(entry.type));
+            break;
+        case VK_OBJECT_TYPE_COMMAND_POOL:
+            vkDestroyCommandPool(device, (VkCommandPool)entry.handle, hostAllocator(entry.type));
+            break;
+        case VK_OBJECT_TYPE_SWAPCHAIN_KHR:
+            vkDestroySwapchainKHR(device, (VkSwapchainKHR)entry.handle, hostAllocator(entry.type));
+            break;
+        default:
+            // Owned objects run their destructor when the last reference goes
+            entry.owner.reset();
+            break;
+    }
+}
+// ================================================================================
+// ================================================================================
+// eof
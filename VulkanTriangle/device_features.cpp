@@ -0,0 +1,131 @@
+// ================================================================================
+// ================================================================================
+// - File:    device_features.cpp
+// - Purpose: Contains the implementation for device_features.hpp
+//
+// Source Metadata
+// - Author:  Jonathan A. Webb
+// - Date:    October 18, 2026
+// - Version: 1.0
+// - Copyright: Copyright 2022, Jon Webb Inc.
+// ================================================================================
+// ================================================================================
+// Include modules here
+
+#include "include/device_features.hpp"
+#include <cstring>
+// ================================================================================
+// ================================================================================
+
+DeviceFeatureChain::DeviceFeatureChain(VkPhysicalDevice physicalDevice,
+                                       const std::vector<const char*>& extensions) {
+    for (const char* extension : extensions) {
+        if (std::strcmp(extension, VK_EXT_MEMORY_PRIORITY_EXTENSION_NAME) == 0) {
+            memoryPriorityLinked = true;
+        }
+    }
+    link(supported);
+    link(enabled);
+    vkGetPhysicalDeviceFeatures2(physicalDevice, &supported.core);
+}
+// --------------------------------------------------------------------------------
+
+bool DeviceFeatureChain::isSupported(DeviceFeature feature) const {
+    return allSet(fieldsOf<const Chain, const VkBool32>(supported, feature));
+}
+// --------------------------------------------------------------------------------
+
+bool DeviceFeatureChain::enable(DeviceFeature feature) {
+    if (!isSupported(feature)) {
+        return false;
+    }
+    for (VkBool32* field : fieldsOf<Chain, VkBool32>(enabled, feature)) {
+        *field = VK_TRUE;
+    }
+    return true;
+}
+// --------------------------------------------------------------------------------
+
+bool DeviceFeatureChain::isEnabled(DeviceFeature feature) const {
+    return allSet(fieldsOf<const Chain, const VkBool32>(enabled, feature));
+}
+// --------------------------------------------------------------------------------
+
+const void* DeviceFeatureChain::getEnabledChain() const {
+    return &enabled.core;
+}
+// --------------------------------------------------------------------------------
+
+const char* DeviceFeatureChain::getName(DeviceFeature feature) {
+    switch (feature) {
+        case DeviceFeature::TextureCompressionBC: return "textureCompressionBC";
+        case DeviceFeature::TimelineSemaphore: return "timelineSemaphore";
+        case DeviceFeature::Synchronization2: return "synchronization2";
+        case DeviceFeature::DescriptorIndexing: return "descriptorIndexing";
+        case DeviceFeature::PipelineCreationCacheControl: return "pipelineCreationCacheControl";
+        case DeviceFeature::MemoryPriority: return "memoryPriority";
+        case DeviceFeature::Multiview: return "multiview";
+    }
+    return "unknown";
+}
+// ================================================================================
+
+void DeviceFeatureChain::link(Chain& chain) const {
+    chain.core.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2;
+    chain.core.pNext = &chain.vulkan11;
+    chain.vulkan11.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_1_FEATURES;
+    chain.vulkan11.pNext = &chain.vulkan12;
+    chain.vulkan12.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_2_FEATURES;
+    chain.vulkan12.pNext = &chain.vulkan13;
+    chain.vulkan13.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_3_FEATURES;
+    chain.vulkan13.pNext = memoryPriorityLinked ? &chain.memoryPriority : nullptr;
+    chain.memoryPriority.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_MEMORY_PRIORITY_FEATURES_EXT;
+    chain.memoryPriority.pNext = nullptr;
+}
+// --------------------------------------------------------------------------------
+
+template <typename ChainType, typename Bool>
+std::vector<Bool*> DeviceFeatureChain::fieldsOf(ChainType& chain, DeviceFeature feature) const {
+    switch (feature) {
+        case DeviceFeature::TextureCompressionBC:
+            return {&chain.core.features.textureCompressionBC};
+        case DeviceFeature::TimelineSemaphore:
+            return {&chain.vulkan12.timelineSemaphore};
+        case DeviceFeature::Synchronization2:
+            return {&chain.vulkan13.synchronization2};
+        case DeviceFeature::DescriptorIndexing:
+            // The subset a bindless texture table needs
+            return {&chain.vulkan12.descriptorIndexing,
+                    &chain.vulkan12.runtimeDescriptorArray,
+                    &chain.vulkan12.descriptorBindingPartiallyBound,
+                    &chain.vulkan12.descriptorBindingVariableDescriptorCount,
+                    &chain.vulkan12.descriptorBindingSampledImageUpdateAfterBind,
+                    &chain.vulkan12.shaderSampledImageArrayNonUniformIndexing};
+        case DeviceFeature::PipelineCreationCacheControl:
+            return {&chain.vulkan13.pipelineCreationCacheControl};
+        case DeviceFeature::MemoryPriority:
+            if (!memoryPriorityLinked) {
+                return {};
+            }
+            return {&chain.memoryPriority.memoryPriority};
+        case DeviceFeature::Multiview:
+            return {&chain.vulkan11.multiview};
+    }
+    return {};
+}
+// --------------------------------------------------------------------------------
+
+bool DeviceFeatureChain::allSet(const std::vector<const VkBool32*>& fields) {
+    if (fields.empty()) {
+        return false;
+    }
+    for (const VkBool32* field : fields) {
+        if (!*field) {
+            return false;
+        }
+    }
+    return true;
+}
+// ================================================================================
+// ================================================================================
+// eof
@@ -15,16 +15,20 @@
 #include "include/devices.hpp"
 #include "include/queues.hpp"
 #include "include/constants.hpp"
+#include "include/host_allocator.hpp"
 #include <stdexcept>
 #include <vector>
 #include <set>
 #include <limits>
 #include <algorithm>
+#include <cstring>
 // ================================================================================
 // ================================================================================
 
-VulkanPhysicalDevice::VulkanPhysicalDevice(VkInstance& instance, VkSurfaceKHR surface) 
-    : instance(instance), surface(surface) {
+VulkanPhysicalDevice::VulkanPhysicalDevice(VkInstance& instance,
+                                           VkSurfaceKHR surface,
+                                           const std::vector<const char*>& extensions)
+    : instance(instance), surface(surface), extensions(extensions) {
     uint32_t deviceCount = 0;
     vkEnumeratePhysicalDevices(instance, &deviceCount, nullptr);
 
@@ -54,17 +58,34 @@ VkPhysicalDevice VulkanPhysicalDevice::getPhysicalDevice() const {
 // --------------------------------------------------------------------------------
 
 bool VulkanPhysicalDevice::isDeviceSuitable(const VkPhysicalDevice device) {
+    // Submission and barriers use the core 1.3 entry points, and the feature
+    // chain below names the 1.3 feature structure, which an older device must
+    // not be queried with
+    VkPhysicalDeviceProperties properties;
+    vkGetPhysicalDeviceProperties(device, &properties);
+    if (properties.apiVersion < VK_API_VERSION_1_3) {
+        return false;
+    }
+
     QueueFamilyIndices indices = QueueFamily::findQueueFamilies(device, surface);
 
     bool extensionsSupported = checkDeviceExtensionSupport(device);
 
-    bool swapChainAdequate = false;
-    if (extensionsSupported) {
+    // A headless device renders offscreen and never needs a swap chain
+    bool swapChainAdequate = surface == VK_NULL_HANDLE;
+    if (extensionsSupported && !swapChainAdequate) {
         SwapChainSupportDetails swapChainSupport = SwapChain::querySwapChainSupport(device, surface);
         swapChainAdequate = !swapChainSupport.formats.empty() && !swapChainSupport.presentModes.empty();
     }
 
-    return indices.isComplete() && extensionsSupported && swapChainAdequate;
+    // Required features never depend on an optional extension
+    bool featuresSupported = true;
+    DeviceFeatureChain features(device, extensions);
+    for (DeviceFeature feature : requiredDeviceFeatures) {
+        featuresSupported = featuresSupported && features.isSupported(feature);
+    }
+
+    return indices.isComplete() && extensionsSupported && swapChainAdequate && featuresSupported;
 }
 // --------------------------------------------------------------------------------
 
@@ -75,7 +96,7 @@ bool VulkanPhysicalDevice::checkDeviceExtensionSupport(const VkPhysicalDevice& d
     std::vector<VkExtensionProperties> availableExtensions(extensionCount);
     vkEnumerateDeviceExtensionProperties(device, nullptr, &extensionCount, availableExtensions.data());
 
-    std::set<std::string> requiredExtensions(deviceExtensions.begin(), deviceExtensions.end());
+    std::set<std::string> requiredExtensions(extensions.begin(), extensions.end());
 
     for (const auto& extension : availableExtensions) {
         requiredExtensions.erase(extension.extensionName);
@@ -89,18 +110,39 @@ bool VulkanPhysicalDevice::checkDeviceExtensionSupport(const VkPhysicalDevice& d
 VulkanLogicalDevice::VulkanLogicalDevice(VkPhysicalDevice physicalDevice, 
                                          const std::vector<const char*>& validationLayers,
                                          VkSurfaceKHR surface,
-                                         const std::vector<const char*>& deviceExtensions)
+                                         const std::vector<const char*>& deviceExtensions,
+                                         const std::vector<const char*>& optionalExtensions,
+                                         const std::vector<DeviceFeature>& requiredFeatures,
+                                         const std::vector<DeviceFeature>& optionalFeatures)
     : physicalDevice(physicalDevice), 
       validationLayers(validationLayers),
       surface(surface),
-      deviceExtensions(deviceExtensions){
+      deviceExtensions(deviceExtensions),
+      enabledExtensions(deviceExtensions),
+      requiredFeatures(requiredFeatures),
+      optionalFeatures(optionalFeatures) {
+    uint32_t extensionCount;
+    vkEnumerateDeviceExtensionProperties(physicalDevice, nullptr, &extensionCount, nullptr);
+
+    std::vector<VkExtensionProperties> availableExtensions(extensionCount);
+    vkEnumerateDeviceExtensionProperties(physicalDevice, nullptr, &extensionCount, availableExtensions.data());
+
+    for (const char* name : optionalExtensions) {
+        for (const auto& extension : availableExtensions) {
+            if (std::strcmp(extension.extensionName, name) == 0) {
+                enabledExtensions.push_back(name);
+                break;
+            }
+        }
+    }
     createLogicalDevice();
 }
 // --------------------------------------------------------------------------------
 
 VulkanLogicalDevice::~VulkanLogicalDevice() {
+    timelines.clear();
     if (device != VK_NULL_HANDLE) {
-        vkDestroyDevice(device, nullptr);
+        vkDestroyDevice(device, hostAllocator(VK_OBJECT_TYPE_DEVICE));
     }
 }
 // --------------------------------------------------------------------------------
@@ -118,6 +160,51 @@ VkQueue VulkanLogicalDevice::getGraphicsQueue() const {
 VkQueue VulkanLogicalDevice::getPresentQueue() const {
     return presentQueue;
 }
+// --------------------------------------------------------------------------------
+
+VkQueue VulkanLogicalDevice::getTransferQueue() const {
+    return transferQueue;
+}
+// --------------------------------------------------------------------------------
+
+VkQueue VulkanLogicalDevice::getComputeQueue() const {
+    return computeQueue;
+}
+// --------------------------------------------------------------------------------
+
+TimelineSemaphore& VulkanLogicalDevice::getGraphicsTimeline() const {
+    return *graphicsTimeline;
+}
+// --------------------------------------------------------------------------------
+
+TimelineSemaphore& VulkanLogicalDevice::getTransferTimeline() const {
+    return *transferTimeline;
+}
+// --------------------------------------------------------------------------------
+
+TimelineSemaphore& VulkanLogicalDevice::getComputeTimeline() const {
+    return *computeTimeline;
+}
+// --------------------------------------------------------------------------------
+
+const QueueFamilyIndices& VulkanLogicalDevice::getQueueFamilyIndices() const {
+    return queueFamilyIndices;
+}
+// --------------------------------------------------------------------------------
+
+const DeviceCapabilities& VulkanLogicalDevice::getCapabilities() const {
+    return capabilities;
+}
+// --------------------------------------------------------------------------------
+
+bool VulkanLogicalDevice::isExtensionEnabled(const char* name) const {
+    for (const char* extension : enabledExtensions) {
+        if (std::strcmp(extension, name) == 0) {
+            return true;
+        }
+    }
+    return false;
+}
 // ================================================================================
 
 void VulkanLogicalDevice::createLogicalDevice() {
@@ -128,7 +215,10 @@ void VulkanLogicalDevice::createLogicalDevice() {
     } 
 
     std::vector<VkDeviceQueueCreateInfo> queueCreateInfos;
-    std::set<uint32_t> uniqueQueueFamilies = {indices.graphicsFamily.value(), indices.presentFamily.value()};
+    std::set<uint32_t> uniqueQueueFamilies = {indices.graphicsFamily.value(),
+                                              indices.presentFamily.value(),
+                                              indices.transferFamily.value(),
+                                              indices.computeFamily.value()};
 
     float queuePriority = 1.0f;
     for (uint32_t queueFamily : uniqueQueueFamilies) {
@@ -140,16 +230,45 @@ void VulkanLogicalDevice::createLogicalDevice() {
         queueCreateInfos.push_back(queueCreateInfo);
     }
 
-    VkPhysicalDeviceFeatures deviceFeatures{};
+    // Features are negotiated against the extensions chosen above; optional
+    // ones are simply left off when unsupported
+    DeviceFeatureChain features(physicalDevice, enabledExtensions);
+    for (DeviceFeature feature : requiredFeatures) {
+        if (!features.enable(feature)) {
+            throw std::runtime_error(std::string("device does not support required feature ") +
+                                     DeviceFeatureChain::getName(feature) + "!");
+        }
+    }
+    for (DeviceFeature feature : optionalFeatures) {
+        features.enable(feature);
+    }
+
+    // An extension whose feature went unused would only cost driver overhead
+    if (isExtensionEnabled(VK_EXT_MEMORY_PRIORITY_EXTENSION_NAME) && !features.isEnabled(DeviceFeature::MemoryPriority)) {
+        enabledExtensions.erase(std::find_if(enabledExtensions.begin(), enabledExtensions.end(),
+                                             [](const char* name) {
+                                                 return std::strcmp(name, VK_EXT_MEMORY_PRIORITY_EXTENSION_NAME) == 0;
+                                             }));
+    }
+
+    capabilities.textureCompressionBC = features.isEnabled(DeviceFeature::TextureCompressionBC);
+    capabilities.timelineSemaphore = features.isEnabled(DeviceFeature::TimelineSemaphore);
+    capabilities.synchronization2 = features.isEnabled(DeviceFeature::Synchronization2);
+    capabilities.descriptorIndexing = features.isEnabled(DeviceFeature::DescriptorIndexing);
+    capabilities.pipelineCreationCacheControl = features.isEnabled(DeviceFeature::PipelineCreationCacheControl);
+    capabilities.memoryPriority = features.isEnabled(DeviceFeature::MemoryPriority);
+    capabilities.memoryBudget = isExtensionEnabled(VK_EXT_MEMORY_BUDGET_EXTENSION_NAME);
+    capabilities.multiview = features.isEnabled(DeviceFeature::Multiview);
 
     VkDeviceCreateInfo createInfo{};
     createInfo.sType = VK_STRUCTURE_TYPE_DEVICE_CREATE_INFO;
+    createInfo.pNext = features.getEnabledChain();
     createInfo.queueCreateInfoCount = static_cast<uint32_t>(queueCreateInfos.size());
     createInfo.pQueueCreateInfos = queueCreateInfos.data();
-    createInfo.pEnabledFeatures = &deviceFeatures;
+    createInfo.pEnabledFeatures = nullptr;
 
-     createInfo.enabledExtensionCount = static_cast<uint32_t>(deviceExtensions.size());
-    createInfo.ppEnabledExtensionNames = deviceExtensions.data();
+    createInfo.enabledExtensionCount = static_cast<uint32_t>(enabledExtensions.size());
+    createInfo.ppEnabledExtensionNames = enabledExtensions.data();
 
     if (!validationLayers.empty()) {
         createInfo.enabledLayerCount = static_cast<uint32_t>(validationLayers.size());
@@ -158,12 +277,31 @@ void VulkanLogicalDevice::createLogicalDevice() {
         createInfo.enabledLayerCount = 0;
     }
 
-    if (vkCreateDevice(physicalDevice, &createInfo, nullptr, &device) != VK_SUCCESS) {
+    if (vkCreateDevice(physicalDevice, &createInfo, hostAllocator(VK_OBJECT_TYPE_DEVICE), &device) != VK_SUCCESS) {
         throw std::runtime_error("failed to create logical device!");
     }
 
     vkGetDeviceQueue(device, indices.graphicsFamily.value(), 0, &graphicsQueue);
     vkGetDeviceQueue(device, indices.presentFamily.value(), 0, &presentQueue);
+    vkGetDeviceQueue(device, indices.transferFamily.value(), 0, &transferQueue);
+    vkGetDeviceQueue(device, indices.computeFamily.value(), 0, &computeQueue);
+    queueFamilyIndices = indices;
+
+    // Queues that share a family share a VkQueue, and so share a timeline
+    std::vector<std::pair<VkQueue, TimelineSemaphore*>> queueTimelines;
+    auto timelineFor = [this, &queueTimelines](VkQueue queue) {
+        for (const auto& entry : queueTimelines) {
+            if (entry.first == queue) {
+                return entry.second;
+            }
+        }
+        timelines.push_back(std::make_unique<TimelineSemaphore>(device));
+        queueTimelines.emplace_back(queue, timelines.back().get());
+        return timelines.back().get();
+    };
+    graphicsTimeline = timelineFor(graphicsQueue);
+    transferTimeline = timelineFor(transferQueue);
+    computeTimeline = timelineFor(computeQueue);
 }
 // ================================================================================
 // ================================================================================
@@ -183,7 +321,22 @@ SwapChain::SwapChain(VkDevice device,
 
 SwapChain::~SwapChain() {
     cleanupImageViews();
-    vkDestroySwapchainKHR(device, swapChain, nullptr);
+    vkDestroySwapchainKHR(device, swapChain, hostAllocator(VK_OBJECT_TYPE_SWAPCHAIN_KHR));
+}
+// --------------------------------------------------------------------------------
+
+void SwapChain::recreateSwapChain(DeletionQueue& deletionQueue) {
+    for (VkImageView imageView : swapChainImageViews) {
+        deletionQueue.destroy(VK_OBJECT_TYPE_IMAGE_VIEW, imageView);
+    }
+    swapChainImageViews.clear();
+
+    // The retired swap chain must still be destroyed once its replacement
+    // exists and no frame in flight presents from it
+    VkSwapchainKHR oldSwapChain = swapChain;
+    createSwapChain();
+    deletionQueue.destroy(VK_OBJECT_TYPE_SWAPCHAIN_KHR, oldSwapChain);
+    createImageViews();
 }
 // --------------------------------------------------------------------------------
 
@@ -202,6 +355,11 @@ VkExtent2D SwapChain::getSwapChainExtent() const {
 }
 // --------------------------------------------------------------------------------
 
+VkImageUsageFlags SwapChain::getSwapChainImageUsage() const {
+    return swapChainImageUsage;
+}
+// --------------------------------------------------------------------------------
+
 const std::vector<VkImage>& SwapChain::getSwapChainImages() const {
     return swapChainImages;
 }
@@ -258,7 +416,23 @@ void SwapChain::createSwapChain() {
     createInfo.imageColorSpace = surfaceFormat.colorSpace;
     createInfo.imageExtent = extent;
     createInfo.imageArrayLayers = 1;
-    createInfo.imageUsage = VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT;
+    // Transfer usage is optional; it is only requested where the surface allows it
+    VkImageUsageFlags supportedUsage = swapChainSupport.capabilities.supportedUsageFlags;
+    swapChainImageUsage = VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT;
+    if (ENABLE_SWAPCHAIN_CAPTURE) {
+        swapChainImageUsage |= supportedUsage & VK_IMAGE_USAGE_TRANSFER_SRC_BIT;
+    }
+    if (ENABLE_OFFSCREEN_RENDERING) {
+        if (!(supportedUsage & VK_IMAGE_USAGE_TRANSFER_DST_BIT)) {
+            throw std::runtime_error("surface does not support copying offscreen frames to the swap chain!");
+        }
+        swapChainImageUsage |= VK_IMAGE_USAGE_TRANSFER_DST_BIT;
+    }
+    if (MULTIVIEW_VIEW_COUNT > 1) {
+        // The views are tiled in with copies; without them only one view is shown
+        swapChainImageUsage |= supportedUsage & VK_IMAGE_USAGE_TRANSFER_DST_BIT;
+    }
+    createInfo.imageUsage = swapChainImageUsage;
 
     QueueFamilyIndices indices = QueueFamily::findQueueFamilies(physicalDevice, surface);
     uint32_t queueFamilyIndices[] = {indices.graphicsFamily.value(), indices.presentFamily.value()};
@@ -275,11 +449,13 @@ void SwapChain::createSwapChain() {
     createInfo.compositeAlpha = VK_COMPOSITE_ALPHA_OPAQUE_BIT_KHR;
     createInfo.presentMode = presentMode;
     createInfo.clipped = VK_TRUE;
-    createInfo.oldSwapchain = VK_NULL_HANDLE;
+    createInfo.oldSwapchain = swapChain;
 
-    if (vkCreateSwapchainKHR(device, &createInfo, nullptr, &swapChain) != VK_SUCCESS) {
+    VkSwapchainKHR newSwapChain;
+    if (vkCreateSwapchainKHR(device, &createInfo, hostAllocator(VK_OBJECT_TYPE_SWAPCHAIN_KHR), &newSwapChain) != VK_SUCCESS) {
         throw std::runtime_error("failed to create swap chain!");
     }
+    swapChain = newSwapChain;
 
     vkGetSwapchainImagesKHR(device, swapChain, &imageCount, nullptr);
     swapChainImages.resize(imageCount);
@@ -309,7 +485,7 @@ void SwapChain::createImageViews() {
         createInfo.subresourceRange.baseArrayLayer = 0;
         createInfo.subresourceRange.layerCount = 1;
 
-        if (vkCreateImageView(device, &createInfo, nullptr, &swapChainImageViews[i]) != VK_SUCCESS) {
+        if (vkCreateImageView(device, &createInfo, hostAllocator(VK_OBJECT_TYPE_IMAGE_VIEW), &swapChainImageViews[i]) != VK_SUCCESS) {
             throw std::runtime_error("failed to create image views!");
         }
     }
@@ -318,8 +494,9 @@ void SwapChain::createImageViews() {
 
 void SwapChain::cleanupImageViews() {
     for (auto imageView : swapChainImageViews) {
-        vkDestroyImageView(device, imageView, nullptr);
+        vkDestroyImageView(device, imageView, hostAllocator(VK_OBJECT_TYPE_IMAGE_VIEW));
     }
+    swapChainImageViews.clear();
 }
 // --------------------------------------------------------------------------------
 
@@ -0,0 +1,85 @@
+// ================================================================================
+// ================================================================================
+// - File:    frame_arena.cpp
+// - Purpose: Contains the implementation for frame_arena.hpp
+//
+// Source Metadata
+// - Author:  Jonathan A. Webb
+// - Date:    October 18, 2026
+// - Version: 1.0
+// - Copyright: Copyright 2022, Jon Webb Inc.
+// ================================================================================
+// ================================================================================
+// Include modules here
+
+#include "include/frame_arena.hpp"
+#include <algorithm>
+// ================================================================================
+// ================================================================================
+
+FrameArena::FrameArena(size_t initialCapacity) {
+    addBlock(std::max<size_t>(initialCapacity, 1));
+}
+// --------------------------------------------------------------------------------
+
+void FrameArena::reset() {
+    stats.peakFrameBytes = std::max(stats.peakFrameBytes, stats.frameBytes);
+
+    // A frame that spilled into extra blocks gets one block that holds it all
+    if (blocks.size() > 1) {
+        size_t total = stats.capacity;
+        blocks.clear();
+        stats.capacity = 0;
+        addBlock(total);
+    }
+    offset = 0;
+    stats.frameBytes = 0;
+}
+// --------------------------------------------------------------------------------
+
+const FrameArenaStats& FrameArena::getStats() const {
+    return stats;
+}
+// ================================================================================
+
+void FrameArena::addBlock(size_t size) {
+    // operator new[] only guarantees fundamental alignment, which do_allocate
+    // pads past for anything stricter
+    blocks.push_back({std::make_unique<std::byte[]>(size), size});
+    stats.capacity += size;
+    stats.blockAllocations++;
+    offset = 0;
+}
+// --------------------------------------------------------------------------------
+
+void* FrameArena::do_allocate(size_t bytes, size_t alignment) {
+    Block* block = &blocks.back();
+    uintptr_t base = reinterpret_cast<uintptr_t>(block->memory.get());
+    uintptr_t aligned = (base + offset + alignment - 1) & ~(static_cast<uintptr_t>(alignment) - 1);
+
+    if (aligned + bytes > base + block->size) {
+        // Doubling keeps the number of extra blocks in one frame logarithmic
+        addBlock(std::max(block->size * 2, bytes + alignment));
+        block = &blocks.back();
+        base = reinterpret_cast<uintptr_t>(block->memory.get());
+        aligned = (base + alignment - 1) & ~(static_cast<uintptr_t>(alignment) - 1);
+    }
+
+    size_t used = aligned + bytes - base;
+    stats.frameBytes += used - offset;
+    offset = used;
+    return reinterpret_cast<void*>(aligned);
+}
+// --------------------------------------------------------------------------------
+
+void FrameArena::do_deallocate(void*, size_t, size_t) {
+    // Everything is released together by reset()
+}
+// --------------------------------------------------------------------------------
+
+bool FrameArena::do_is_equal(const std::pmr::memory_resource& other) const noexcept {
+    return this == &other;
+}
+// ================================================================================
+// ================================================================================
+// eof
@@ -0,0 +1,360 @@
+// ================================================================================
+// ================================================================================
+// - File:    frame_capture.cpp
+// - Purpose: Contains the implementation for frame_capture.hpp
+//
+// Source Metadata
+// - Author:  Jonathan A. Webb
+// - Date:    October 18, 2026
+// - Version: 1.0
+// - Copyright: Copyright 2022, Jon Webb Inc.
+// ================================================================================
+// ================================================================================
+// Include modules here
+
+#include "include/frame_capture.hpp"
+#include "include/buffers.hpp"
+#include "include/host_allocator.hpp"
+#include "include/image_writer.hpp"
+#include <cstdio>
+#include <filesystem>
+#include <iostream>
+#include <stdexcept>
+// ================================================================================
+// ================================================================================
+
+FrameCapture::FrameCapture(VkDevice device,
+                           VkPhysicalDevice physicalDevice,
+                           JobSystem& jobs,
+                           const TimelineSemaphore& graphicsTimeline,
+                           uint32_t slotCount)
+    : device(device),
+      physicalDevice(physicalDevice),
+      jobs(jobs),
+      graphicsTimeline(graphicsTimeline) {
+    if (slotCount == 0) {
+        throw std::runtime_error("frame capture needs at least one readback slot!");
+    }
+    // Buffers are allocated on first use, sized to the frames actually captured
+    for (uint32_t i = 0; i < slotCount; i++) {
+        slots.push_back(std::make_unique<Slot>());
+    }
+}
+// --------------------------------------------------------------------------------
+
+FrameCapture::~FrameCapture() {
+    for (std::unique_ptr<Slot>& slot : slots) {
+        jobs.wait(slot->encoding);
+        destroySlot(*slot);
+    }
+}
+// --------------------------------------------------------------------------------
+
+void FrameCapture::start(const std::string& directory, CaptureFormat format, uint32_t frameCount) {
+    std::error_code error;
+    std::filesystem::create_directories(directory, error);
+    if (error) {
+        throw std::runtime_error("failed to create capture directory '" + directory + "'!");
+    }
+    this->directory = directory;
+    this->format = format;
+    remainingFrames = frameCount;
+    nextFileIndex = 0;
+}
+// --------------------------------------------------------------------------------
+
+bool FrameCapture::isActive() const {
+    return remainingFrames > 0;
+}
+// --------------------------------------------------------------------------------
+
+bool FrameCapture::record(VkCommandBuffer commandBuffer, VkImage image, VkFormat format, VkExtent2D extent) {
+    if (remainingFrames == 0) {
+        return false;
+    }
+    if (!isFormatSupported(format)) {
+        throw std::runtime_error("frames cannot be captured from this image format!");
+    }
+
+    // Waiting for a slot would stall the frame on the GPU or on the encoders
+    Slot* slot = findFreeSlot();
+    if (!slot) {
+        framesDropped++;
+        return false;
+    }
+
+    // Raw files have no header, so their names carry the dimensions
+    char name[64];
+    if (this->format == CaptureFormat::Png) {
+        std::snprintf(name, sizeof(name), "frame_%06llu.png",
+                      static_cast<unsigned long long>(nextFileIndex++));
+    } else {
+        std::snprintf(name, sizeof(name), "frame_%06llu_%ux%u.rgba",
+                      static_cast<unsigned long long>(nextFileIndex++), extent.width, extent.height);
+    }
+    slot->path = (std::filesystem::path(directory) / name).string();
+    slot->format = this->format;
+    recordCopy(*slot, commandBuffer, image, format, extent);
+
+    remainingFrames--;
+    return true;
+}
+// --------------------------------------------------------------------------------
+
+bool FrameCapture::record(VkCommandBuffer commandBuffer, VkImage image, VkFormat format, VkExtent2D extent,
+                          const std::string& path, CaptureFormat fileFormat) {
+    if (!isFormatSupported(format)) {
+        throw std::runtime_error("frames cannot be captured from this image format!");
+    }
+
+    Slot* slot = findFreeSlot();
+    if (!slot) {
+        return false;
+    }
+    slot->path = path;
+    slot->format = fileFormat;
+    recordCopy(*slot, commandBuffer, image, format, extent);
+    return true;
+}
+// --------------------------------------------------------------------------------
+
+void FrameCapture::submitted(uint64_t timelineValue) {
+    for (std::unique_ptr<Slot>& slot : slots) {
+        if (slot->state == SlotState::Recorded) {
+            slot->timelineValue = timelineValue;
+            slot->state = SlotState::InFlight;
+        }
+    }
+}
+// --------------------------------------------------------------------------------
+
+void FrameCapture::poll() {
+    for (std::unique_ptr<Slot>& slot : slots) {
+        if (slot->state == SlotState::Encoding && slot->encoding.isDone()) {
+            slot->state = SlotState::Free;
+        }
+        if (slot->state != SlotState::InFlight || !graphicsTimeline.isComplete(slot->timelineValue)) {
+            continue;
+        }
+
+        if (!slot->coherent) {
+            VkMappedMemoryRange range{};
+            range.sType = VK_STRUCTURE_TYPE_MAPPED_MEMORY_RANGE;
+            range.memory = slot->memory;
+            range.offset = 0;
+            range.size = VK_WHOLE_SIZE;
+            if (vkInvalidateMappedMemoryRanges(device, 1, &range) != VK_SUCCESS) {
+                throw std::runtime_error("failed to invalidate frame capture memory!");
+            }
+        }
+
+        slot->state = SlotState::Encoding;
+        Slot* target = slot.get();
+        jobs.run([this, target]() { encode(*target); }, &slot->encoding);
+    }
+}
+// --------------------------------------------------------------------------------
+
+void FrameCapture::waitForFreeSlot() {
+    poll();
+    while (!findFreeSlot()) {
+        waitForBusySlot();
+        poll();
+    }
+}
+// --------------------------------------------------------------------------------
+
+void FrameCapture::flush() {
+    poll();
+    for (;;) {
+        bool busy = false;
+        for (std::unique_ptr<Slot>& slot : slots) {
+            if (slot->state == SlotState::Recorded) {
+                throw std::runtime_error("frame capture flushed before its copies were submitted!");
+            }
+            busy = busy || slot->state != SlotState::Free;
+        }
+        if (!busy) {
+            return;
+        }
+        waitForBusySlot();
+        poll();
+    }
+}
+// --------------------------------------------------------------------------------
+
+FrameCaptureStats FrameCapture::getStats() const {
+    FrameCaptureStats stats;
+    stats.framesRecorded = framesRecorded;
+    stats.framesDropped = framesDropped;
+    stats.framesWritten = framesWritten;
+    stats.writeFailures = writeFailures;
+    return stats;
+}
+// --------------------------------------------------------------------------------
+
+bool FrameCapture::isFormatSupported(VkFormat format) {
+    switch (format) {
+        case VK_FORMAT_R8G8B8A8_UNORM:
+        case VK_FORMAT_R8G8B8A8_SRGB:
+        case VK_FORMAT_B8G8R8A8_UNORM:
+        case VK_FORMAT_B8G8R8A8_SRGB:
+            return true;
+        default:
+            return false;
+    }
+}
+// ================================================================================
+
+void FrameCapture::allocateSlot(Slot& slot, VkDeviceSize size) {
+    // Only free slots are reallocated, and a slot is only freed once the GPU and
+    // its encoder are done with it
+    destroySlot(slot);
+
+    // Uncached memory is write-combined, which makes the CPU's reads very slow
+    try {
+        createBuffer(device, physicalDevice, size, VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+                     VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_CACHED_BIT,
+                     slot.buffer, slot.memory);
+        slot.coherent = false;
+    } catch (const std::runtime_error&) {
+        createBuffer(device, physicalDevice, size, VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+                     VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
+                     slot.buffer, slot.memory);
+        slot.coherent = true;
+    }
+
+    void* mapped = nullptr;
+    if (vkMapMemory(device, slot.memory, 0, VK_WHOLE_SIZE, 0, &mapped) != VK_SUCCESS) {
+        destroySlot(slot);
+        throw std::runtime_error("failed to map frame capture memory!");
+    }
+    slot.mapped = static_cast<const uint8_t*>(mapped);
+    slot.capacity = size;
+}
+// --------------------------------------------------------------------------------
+
+FrameCapture::Slot* FrameCapture::findFreeSlot() {
+    for (std::unique_ptr<Slot>& slot : slots) {
+        if (slot->state == SlotState::Free) {
+            return slot.get();
+        }
+    }
+    return nullptr;
+}
+// --------------------------------------------------------------------------------
+
+void FrameCapture::recordCopy(Slot& slot, VkCommandBuffer commandBuffer, VkImage image, VkFormat format, VkExtent2D extent) {
+    VkDeviceSize size = static_cast<VkDeviceSize>(extent.width) * extent.height * 4;
+    if (slot.capacity < size) {
+        allocateSlot(slot, size);
+    }
+
+    VkBufferImageCopy region{};
+    region.bufferOffset = 0;
+    region.bufferRowLength = 0;
+    region.bufferImageHeight = 0;
+    region.imageSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+    region.imageSubresource.mipLevel = 0;
+    region.imageSubresource.baseArrayLayer = 0;
+    region.imageSubresource.layerCount = 1;
+    region.imageOffset = {0, 0, 0};
+    region.imageExtent = {extent.width, extent.height, 1};
+    vkCmdCopyImageToBuffer(commandBuffer, image, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, slot.buffer, 1, &region);
+
+    // Makes the copy visible to the host once the timeline value is observed
+    VkBufferMemoryBarrier2 barrier{};
+    barrier.sType = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER_2;
+    barrier.srcStageMask = VK_PIPELINE_STAGE_2_COPY_BIT;
+    barrier.srcAccessMask = VK_ACCESS_2_TRANSFER_WRITE_BIT;
+    barrier.dstStageMask = VK_PIPELINE_STAGE_2_HOST_BIT;
+    barrier.dstAccessMask = VK_ACCESS_2_HOST_READ_BIT;
+    barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    barrier.buffer = slot.buffer;
+    barrier.offset = 0;
+    barrier.size = size;
+
+    VkDependencyInfo dependency{};
+    dependency.sType = VK_STRUCTURE_TYPE_DEPENDENCY_INFO;
+    dependency.bufferMemoryBarrierCount = 1;
+    dependency.pBufferMemoryBarriers = &barrier;
+    vkCmdPipelineBarrier2(commandBuffer, &dependency);
+
+    slot.extent = extent;
+    slot.swizzle = format == VK_FORMAT_B8G8R8A8_UNORM || format == VK_FORMAT_B8G8R8A8_SRGB;
+    slot.state = SlotState::Recorded;
+    framesRecorded++;
+}
+// --------------------------------------------------------------------------------
+
+void FrameCapture::waitForBusySlot() {
+    // The slot the GPU will finish first has the lowest timeline value; only
+    // when none is in flight do the encoders hold everything up
+    Slot* oldest = nullptr;
+    for (std::unique_ptr<Slot>& slot : slots) {
+        if (slot->state == SlotState::InFlight && (!oldest || slot->timelineValue < oldest->timelineValue)) {
+            oldest = slot.get();
+        }
+    }
+    if (oldest) {
+        graphicsTimeline.wait(oldest->timelineValue);
+        return;
+    }
+    for (std::unique_ptr<Slot>& slot : slots) {
+        if (slot->state == SlotState::Encoding) {
+            jobs.wait(slot->encoding);
+            return;
+        }
+    }
+    throw std::runtime_error("frame capture waited with no copy submitted!");
+}
+// --------------------------------------------------------------------------------
+
+void FrameCapture::destroySlot(Slot& slot) {
+    if (slot.buffer != VK_NULL_HANDLE) {
+        vkDestroyBuffer(device, slot.buffer, hostAllocator(VK_OBJECT_TYPE_BUFFER));
+        slot.buffer = VK_NULL_HANDLE;
+    }
+    if (slot.memory != VK_NULL_HANDLE) {
+        vkFreeMemory(device, slot.memory, hostAllocator(VK_OBJECT_TYPE_DEVICE_MEMORY));
+        slot.memory = VK_NULL_HANDLE;
+    }
+    slot.mapped = nullptr;
+    slot.capacity = 0;
+}
+// --------------------------------------------------------------------------------
+
+void FrameCapture::encode(Slot& slot) {
+    size_t size = static_cast<size_t>(slot.extent.width) * slot.extent.height * 4;
+    const uint8_t* pixels = slot.mapped;
+
+    // Swizzling reads the mapped memory once; the writers then work from the copy
+    std::vector<uint8_t> rgba;
+    if (slot.swizzle) {
+        rgba.resize(size);
+        for (size_t i = 0; i < size; i += 4) {
+            rgba[i + 0] = pixels[i + 2];
+            rgba[i + 1] = pixels[i + 1];
+            rgba[i + 2] = pixels[i + 0];
+            rgba[i + 3] = pixels[i + 3];
+        }
+        pixels = rgba.data();
+    }
+
+    try {
+        if (slot.format == CaptureFormat::Png) {
+            writePng(slot.path, slot.extent.width, slot.extent.height, pixels);
+        } else {
+            writeRaw(slot.path, slot.extent.width, slot.extent.height, pixels);
+        }
+        framesWritten++;
+    } catch (const std::runtime_error& error) {
+        // A full disk must not take the render thread down with it
+        std::cerr << "Frame capture: " << error.what() << std::endl;
+        writeFailures++;
+    }
+}
+// ================================================================================
+// ================================================================================
+// eof
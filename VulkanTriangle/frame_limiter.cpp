@@ -0,0 +1,66 @@
+// ================================================================================
+// ================================================================================
+// - File:    frame_limiter.cpp
+// - Purpose: Contains the implementation for frame_limiter.hpp
+//
+// Source Metadata
+// - Author:  Jonathan A. Webb
+// - Date:    October 18, 2026
+// - Version: 1.0
+// - Copyright: Copyright 2022, Jon Webb Inc.
+// ================================================================================
+// ================================================================================
+// Include modules here
+
+#include "include/frame_limiter.hpp"
+#include <thread>
+// ================================================================================
+// ================================================================================
+
+FrameLimiter::FrameLimiter(double targetFps, std::chrono::microseconds spinThreshold)
+    : spinThreshold(spinThreshold) {
+    setTargetFps(targetFps);
+}
+// --------------------------------------------------------------------------------
+
+void FrameLimiter::wait() {
+    if (period == Clock::duration::zero()) {
+        return;
+    }
+
+    Clock::time_point now = Clock::now();
+    if (now - nextFrame > period) {
+        nextFrame = now + period;
+        return;
+    }
+
+    if (nextFrame - now > spinThreshold) {
+        std::this_thread::sleep_until(nextFrame - spinThreshold);
+    }
+    while (Clock::now() < nextFrame) {
+        std::this_thread::yield();
+    }
+    nextFrame += period;
+}
+// --------------------------------------------------------------------------------
+
+void FrameLimiter::setTargetFps(double targetFps) {
+    this->targetFps = targetFps;
+    period = targetFps > 0.0
+        ? std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(1.0 / targetFps))
+        : Clock::duration::zero();
+    reset();
+}
+// --------------------------------------------------------------------------------
+
+void FrameLimiter::reset() {
+    nextFrame = Clock::now() + period;
+}
+// --------------------------------------------------------------------------------
+
+double FrameLimiter::getTargetFps() const {
+    return targetFps;
+}
+// ================================================================================
+// ================================================================================
+// eof
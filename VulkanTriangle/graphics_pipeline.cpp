@@ -13,31 +13,47 @@
 // Include modules here
 
 #include "include/graphics_pipeline.hpp"
+#include "include/constants.hpp"
+#include "include/host_allocator.hpp"
 #include <stdexcept>
-#include <iostream>
-#include <fstream>
-#include <filesystem>
+#include <string>
 #include <vector>
 #include <vulkan/vulkan.h>
 // ================================================================================
 // ================================================================================
 
-GraphicsPipeline::GraphicsPipeline(VkDevice device, VkExtent2D swapChainExtent, VkFormat swapChainImageFormat)
-    : device(device) {
+static const std::string VERTEX_SHADER = std::string(SHADER_BINARY_DIRECTORY) + "/shader.vert.spv";
+static const std::string FRAGMENT_SHADER = std::string(SHADER_BINARY_DIRECTORY) + "/shader.frag.spv";
+// Compiled from shader.vert with MULTIVIEW=1, which reads gl_ViewIndex
+static const std::string MULTIVIEW_VERTEX_SHADER = std::string(SHADER_BINARY_DIRECTORY) + "/shader.vert.MULTIVIEW_1.spv";
+// ================================================================================
+// ================================================================================
+
+GraphicsPipeline::GraphicsPipeline(VkDevice device, 
+                                   VkExtent2D swapChainExtent, 
+                                   VkFormat swapChainImageFormat,
+                                   VkDescriptorSetLayout descriptorSetLayout,
+                                   PipelineStateCache& pipelineCache,
+                                   ObjectCache& objectCache,
+                                   uint32_t viewCount)
+    : device(device), 
+      descriptorSetLayout(descriptorSetLayout),
+      pipelineCache(pipelineCache),
+      objectCache(objectCache),
+      viewCount(viewCount) {
+    if (viewCount == 0 || viewCount > MAX_VIEW_COUNT) {
+        throw std::runtime_error("graphics pipeline view count must be between 1 and MAX_VIEW_COUNT!");
+    }
     createRenderPass(swapChainImageFormat);
-    createGraphicsPipeline();
+    createPipelineLayout();
+    createGraphicsPipeline(swapChainImageFormat);
 }
 // --------------------------------------------------------------------------------
 
 GraphicsPipeline::~GraphicsPipeline() {
-    if (graphicsPipeline != VK_NULL_HANDLE) {
-        vkDestroyPipeline(device, graphicsPipeline, nullptr);
-    }
+    // The pipelines and render pass are owned by their caches
     if (pipelineLayout != VK_NULL_HANDLE) {
-        vkDestroyPipelineLayout(device, pipelineLayout, nullptr);
-    }
-    if (renderPass != VK_NULL_HANDLE) {
-        vkDestroyRenderPass(device, renderPass, nullptr);
+        vkDestroyPipelineLayout(device, pipelineLayout, hostAllocator(VK_OBJECT_TYPE_PIPELINE_LAYOUT));
     }
 }
 // --------------------------------------------------------------------------------
@@ -47,187 +63,97 @@ VkPipeline GraphicsPipeline::getPipeline() const {
 }
 // --------------------------------------------------------------------------------
 
-VkPipelineLayout GraphicsPipeline::getPipelineLayout() const {
-    return pipelineLayout;
+VkPipeline GraphicsPipeline::getPipeline(const PipelineDesc& desc) {
+    return pipelineCache.getPipeline(desc, pipelineLayout, renderPass);
 }
-// ================================================================================
-
-VkShaderModule GraphicsPipeline::createShaderModule(const std::vector<char>& code) {
-    VkShaderModuleCreateInfo createInfo{};
-    createInfo.sType = VK_STRUCTURE_TYPE_SHADER_MODULE_CREATE_INFO;
-    createInfo.codeSize = code.size();
-    createInfo.pCode = reinterpret_cast<const uint32_t*>(code.data());
-
-    VkShaderModule shaderModule;
-    if (vkCreateShaderModule(device, &createInfo, nullptr, &shaderModule) != VK_SUCCESS) {
-        throw std::runtime_error("failed to create shader module!");
-    }
+// --------------------------------------------------------------------------------
 
-    return shaderModule;
+const PipelineDesc& GraphicsPipeline::getPipelineDesc() const {
+    return pipelineDesc;
 }
 // --------------------------------------------------------------------------------
 
-std::vector<char> GraphicsPipeline::readFile(const std::string& filename) {
-    std::ifstream file(filename, std::ios::ate | std::ios::binary);
-
-    if (!file.is_open()) {
-        std::cerr << "Current working directory: " << std::filesystem::current_path() << std::endl;
-        throw std::runtime_error("failed to open file!");
-    }
+VkPipelineLayout GraphicsPipeline::getPipelineLayout() const {
+    return pipelineLayout;
+}
+// --------------------------------------------------------------------------------
 
-    size_t fileSize = (size_t) file.tellg();
-    std::vector<char> buffer(fileSize);
+VkRenderPass GraphicsPipeline::getRenderPass() const {
+    return renderPass;
+}
+// --------------------------------------------------------------------------------
 
-    file.seekg(0);
-    file.read(buffer.data(), fileSize);
+uint32_t GraphicsPipeline::getViewCount() const {
+    return viewCount;
+}
+// --------------------------------------------------------------------------------
 
-    file.close();
+void GraphicsPipeline::setColorFormat(VkFormat swapChainImageFormat) {
+    createRenderPass(swapChainImageFormat);
+    createGraphicsPipeline(swapChainImageFormat);
+}
+// --------------------------------------------------------------------------------
 
-    return buffer;
+void GraphicsPipeline::refreshPipeline() {
+    graphicsPipeline = pipelineCache.getPipeline(pipelineDesc, pipelineLayout, renderPass);
 }
 // --------------------------------------------------------------------------------
 
-void GraphicsPipeline::createGraphicsPipeline() {
-
-    auto vertShaderCode = readFile("../../shaders/shader.vert.spv");
-    auto fragShaderCode = readFile("../../shaders/shader.frag.spv");
-
-    VkShaderModule vertShaderModule = createShaderModule(vertShaderCode);
-    VkShaderModule fragShaderModule = createShaderModule(fragShaderCode);
-
-    VkPipelineShaderStageCreateInfo vertShaderStageInfo{};
-    vertShaderStageInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
-    vertShaderStageInfo.stage = VK_SHADER_STAGE_VERTEX_BIT;
-    vertShaderStageInfo.module = vertShaderModule;
-    vertShaderStageInfo.pName = "main";
-
-    VkPipelineShaderStageCreateInfo fragShaderStageInfo{};
-    fragShaderStageInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
-    fragShaderStageInfo.stage = VK_SHADER_STAGE_FRAGMENT_BIT;
-    fragShaderStageInfo.module = fragShaderModule;
-    fragShaderStageInfo.pName = "main";
-
-    VkPipelineShaderStageCreateInfo shaderStages[] = {vertShaderStageInfo, fragShaderStageInfo};
-
-    VkPipelineVertexInputStateCreateInfo vertexInputInfo{};
-    vertexInputInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_VERTEX_INPUT_STATE_CREATE_INFO;
-    vertexInputInfo.vertexBindingDescriptionCount = 0;
-    vertexInputInfo.vertexAttributeDescriptionCount = 0;
-
-    VkPipelineInputAssemblyStateCreateInfo inputAssembly{};
-    inputAssembly.sType = VK_STRUCTURE_TYPE_PIPELINE_INPUT_ASSEMBLY_STATE_CREATE_INFO;
-    inputAssembly.topology = VK_PRIMITIVE_TOPOLOGY_TRIANGLE_LIST;
-    inputAssembly.primitiveRestartEnable = VK_FALSE;
-
-    VkPipelineViewportStateCreateInfo viewportState{};
-    viewportState.sType = VK_STRUCTURE_TYPE_PIPELINE_VIEWPORT_STATE_CREATE_INFO;
-    viewportState.viewportCount = 1;
-    viewportState.scissorCount = 1;
-
-    VkPipelineRasterizationStateCreateInfo rasterizer{};
-    rasterizer.sType = VK_STRUCTURE_TYPE_PIPELINE_RASTERIZATION_STATE_CREATE_INFO;
-    rasterizer.depthClampEnable = VK_FALSE;
-    rasterizer.rasterizerDiscardEnable = VK_FALSE;
-    rasterizer.polygonMode = VK_POLYGON_MODE_FILL;
-    rasterizer.lineWidth = 1.0f;
-    rasterizer.cullMode = VK_CULL_MODE_BACK_BIT;
-    rasterizer.frontFace = VK_FRONT_FACE_CLOCKWISE;
-    rasterizer.depthBiasEnable = VK_FALSE;
-
-    VkPipelineMultisampleStateCreateInfo multisampling{};
-    multisampling.sType = VK_STRUCTURE_TYPE_PIPELINE_MULTISAMPLE_STATE_CREATE_INFO;
-    multisampling.sampleShadingEnable = VK_FALSE;
-    multisampling.rasterizationSamples = VK_SAMPLE_COUNT_1_BIT;
-
-    VkPipelineColorBlendAttachmentState colorBlendAttachment{};
-    colorBlendAttachment.colorWriteMask = VK_COLOR_COMPONENT_R_BIT | VK_COLOR_COMPONENT_G_BIT | VK_COLOR_COMPONENT_B_BIT | VK_COLOR_COMPONENT_A_BIT;
-    colorBlendAttachment.blendEnable = VK_FALSE;
-
-    VkPipelineColorBlendStateCreateInfo colorBlending{};
-    colorBlending.sType = VK_STRUCTURE_TYPE_PIPELINE_COLOR_BLEND_STATE_CREATE_INFO;
-    colorBlending.logicOpEnable = VK_FALSE;
-    colorBlending.logicOp = VK_LOGIC_OP_COPY;
-    colorBlending.attachmentCount = 1;
-    colorBlending.pAttachments = &colorBlendAttachment;
-    colorBlending.blendConstants[0] = 0.0f;
-    colorBlending.blendConstants[1] = 0.0f;
-    colorBlending.blendConstants[2] = 0.0f;
-    colorBlending.blendConstants[3] = 0.0f;
-
-    std::vector<VkDynamicState> dynamicStates = {
-        VK_DYNAMIC_STATE_VIEWPORT,
-        VK_DYNAMIC_STATE_SCISSOR
-    };
-    VkPipelineDynamicStateCreateInfo dynamicState{};
-    dynamicState.sType = VK_STRUCTURE_TYPE_PIPELINE_DYNAMIC_STATE_CREATE_INFO;
-    dynamicState.dynamicStateCount = static_cast<uint32_t>(dynamicStates.size());
-    dynamicState.pDynamicStates = dynamicStates.data();
+std::vector<std::string> GraphicsPipeline::getShaderPaths(uint32_t viewCount) {
+    return {viewCount > 1 ? MULTIVIEW_VERTEX_SHADER : VERTEX_SHADER, FRAGMENT_SHADER};
+}
+// ================================================================================
+
+void GraphicsPipeline::createPipelineLayout() {
+    VkPushConstantRange pushConstantRange{};
+    pushConstantRange.stageFlags = VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT;
+    pushConstantRange.offset = 0;
+    pushConstantRange.size = sizeof(DrawPushConstants);
 
     VkPipelineLayoutCreateInfo pipelineLayoutInfo{};
     pipelineLayoutInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
-    pipelineLayoutInfo.setLayoutCount = 0;
-    pipelineLayoutInfo.pushConstantRangeCount = 0;
+    pipelineLayoutInfo.setLayoutCount = descriptorSetLayout != VK_NULL_HANDLE ? 1 : 0;
+    pipelineLayoutInfo.pSetLayouts = &descriptorSetLayout;
+    pipelineLayoutInfo.pushConstantRangeCount = 1;
+    pipelineLayoutInfo.pPushConstantRanges = &pushConstantRange;
 
-    if (vkCreatePipelineLayout(device, &pipelineLayoutInfo, nullptr, &pipelineLayout) != VK_SUCCESS) {
+    if (vkCreatePipelineLayout(device, &pipelineLayoutInfo, hostAllocator(VK_OBJECT_TYPE_PIPELINE_LAYOUT), &pipelineLayout) != VK_SUCCESS) {
         throw std::runtime_error("failed to create pipeline layout!");
     }
+}
+// --------------------------------------------------------------------------------
 
-    VkGraphicsPipelineCreateInfo pipelineInfo{};
-    pipelineInfo.sType = VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_CREATE_INFO;
-    pipelineInfo.stageCount = 2;
-    pipelineInfo.pStages = shaderStages;
-    pipelineInfo.pVertexInputState = &vertexInputInfo;
-    pipelineInfo.pInputAssemblyState = &inputAssembly;
-    pipelineInfo.pViewportState = &viewportState;
-    pipelineInfo.pRasterizationState = &rasterizer;
-    pipelineInfo.pMultisampleState = &multisampling;
-    pipelineInfo.pColorBlendState = &colorBlending;
-    pipelineInfo.pDynamicState = &dynamicState;
-    pipelineInfo.layout = pipelineLayout;
-    pipelineInfo.renderPass = renderPass;
-    pipelineInfo.subpass = 0;
-    pipelineInfo.basePipelineHandle = VK_NULL_HANDLE;
-
-    if (vkCreateGraphicsPipelines(device, VK_NULL_HANDLE, 1, &pipelineInfo, nullptr, &graphicsPipeline) != VK_SUCCESS) {
-        throw std::runtime_error("failed to create graphics pipeline!");
-    }
+void GraphicsPipeline::createGraphicsPipeline(VkFormat swapChainImageFormat) {
+    // Every other fixed-function setting keeps the PipelineDesc default
+    pipelineDesc.vertexShader = viewCount > 1 ? MULTIVIEW_VERTEX_SHADER : VERTEX_SHADER;
+    pipelineDesc.fragmentShader = FRAGMENT_SHADER;
+    pipelineDesc.colorFormats = {swapChainImageFormat};
 
-    vkDestroyShaderModule(device, fragShaderModule, nullptr);
-    vkDestroyShaderModule(device, vertShaderModule, nullptr); 
+    graphicsPipeline = pipelineCache.getPipeline(pipelineDesc, pipelineLayout, renderPass);
 }
 // --------------------------------------------------------------------------------
 
- void GraphicsPipeline::createRenderPass(VkFormat swapChainImageFormat) {
-    VkAttachmentDescription colorAttachment{};
+void GraphicsPipeline::createRenderPass(VkFormat swapChainImageFormat) {
+    AttachmentDesc colorAttachment{};
     colorAttachment.format = swapChainImageFormat;
     colorAttachment.samples = VK_SAMPLE_COUNT_1_BIT;
     colorAttachment.loadOp = VK_ATTACHMENT_LOAD_OP_CLEAR;
     colorAttachment.storeOp = VK_ATTACHMENT_STORE_OP_STORE;
-    colorAttachment.stencilLoadOp = VK_ATTACHMENT_LOAD_OP_DONT_CARE;
-    colorAttachment.stencilStoreOp = VK_ATTACHMENT_STORE_OP_DONT_CARE;
-    colorAttachment.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
-    colorAttachment.finalLayout = VK_IMAGE_LAYOUT_PRESENT_SRC_KHR;
-
-    VkAttachmentReference colorAttachmentRef{};
-    colorAttachmentRef.attachment = 0;
-    colorAttachmentRef.layout = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
-
-    VkSubpassDescription subpass{};
-    subpass.pipelineBindPoint = VK_PIPELINE_BIND_POINT_GRAPHICS;
-    subpass.colorAttachmentCount = 1;
-    subpass.pColorAttachments = &colorAttachmentRef;
-
-    VkRenderPassCreateInfo renderPassInfo{};
-    renderPassInfo.sType = VK_STRUCTURE_TYPE_RENDER_PASS_CREATE_INFO;
-    renderPassInfo.attachmentCount = 1;
-    renderPassInfo.pAttachments = &colorAttachment;
-    renderPassInfo.subpassCount = 1;
-    renderPassInfo.pSubpasses = &subpass;
-
-    if (vkCreateRenderPass(device, &renderPassInfo, nullptr, &renderPass) != VK_SUCCESS) {
-            throw std::runtime_error("failed to create render pass!");
+    // The render graph transitions the image in and out of the attachment layout
+    colorAttachment.initialLayout = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
+    colorAttachment.finalLayout = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
+
+    RenderPassDesc renderPassDesc;
+    renderPassDesc.colorAttachments.push_back(colorAttachment);
+    if (viewCount > 1) {
+        // Draw into layers 0 to viewCount - 1 at once.  Only the eyes of a
+        // stereo pair see nearly the same image; split-screen players do not.
+        renderPassDesc.viewMask = (1u << viewCount) - 1;
+        renderPassDesc.correlationMask = viewCount == 2 ? renderPassDesc.viewMask : 0;
     }
- }
+
+    renderPass = objectCache.getRenderPass(renderPassDesc);
+}
 // ================================================================================
 // ================================================================================
 // eof
@@ -0,0 +1,503 @@
+// ================================================================================
+// ================================================================================
+// - File:    host_allocator.cpp
+// - Purpose: Contains the implementation for host_allocator.hpp
+//
+// Source Metadata
+// - Author:  Jonathan A. Webb
+// - Date:    October 18, 2026
+// - Version: 1.0
+// - Copyright: Copyright 2022, Jon Webb Inc.
+// ================================================================================
+// ================================================================================
+// Include modules here
+
+#include "include/host_allocator.hpp"
+#include "include/constants.hpp"
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
+// ================================================================================
+// ================================================================================
+
+/**
+ * @brief Precedes every allocation handed to the driver
+ */
+struct AllocationHeader {
+    void* tag;               // The TypeTag of the callbacks that made the allocation
+    SmallBlockPool* pool;    // The pool that owns the block, if any
+    uint64_t size;           // The size requested by the driver
+    uint32_t baseOffset;     // Distance back to the malloc result or pool block
+    uint8_t scope;
+    uint8_t sizeClass;
+    uint16_t reserved;
+};
+static_assert(sizeof(AllocationHeader) == 32, "allocation header must keep blocks 16 byte aligned");
+// --------------------------------------------------------------------------------
+
+// The bytes of each chunk a pool carves into blocks
+static const size_t POOL_CHUNK_SIZE = 64 * 1024;
+
+// The strictest alignment a pooled block satisfies
+static const size_t POOL_ALIGNMENT = 16;
+// --------------------------------------------------------------------------------
+
+static AllocationHeader* headerOf(void* memory) {
+    return reinterpret_cast<AllocationHeader*>(static_cast<char*>(memory) - sizeof(AllocationHeader));
+}
+// --------------------------------------------------------------------------------
+
+static void* baseOf(void* memory) {
+    return static_cast<char*>(memory) - headerOf(memory)->baseOffset;
+}
+// --------------------------------------------------------------------------------
+
+static void updatePeak(std::atomic<uint64_t>& peak, uint64_t value) {
+    uint64_t previous = peak.load(std::memory_order_relaxed);
+    while (value > previous &&
+           !peak.compare_exchange_weak(previous, value, std::memory_order_relaxed)) {
+    }
+}
+// --------------------------------------------------------------------------------
+
+static const char* scopeName(uint32_t scope) {
+    switch (scope) {
+        case VK_SYSTEM_ALLOCATION_SCOPE_COMMAND: return "command";
+        case VK_SYSTEM_ALLOCATION_SCOPE_OBJECT: return "object";
+        case VK_SYSTEM_ALLOCATION_SCOPE_CACHE: return "cache";
+        case VK_SYSTEM_ALLOCATION_SCOPE_DEVICE: return "device";
+        case VK_SYSTEM_ALLOCATION_SCOPE_INSTANCE: return "instance";
+        default: return "unknown";
+    }
+}
+// --------------------------------------------------------------------------------
+
+static const char* objectTypeName(VkObjectType type) {
+    switch (type) {
+        case VK_OBJECT_TYPE_INSTANCE: return "instance";
+        case VK_OBJECT_TYPE_DEVICE: return "device";
+        case VK_OBJECT_TYPE_SEMAPHORE: return "semaphore";
+        case VK_OBJECT_TYPE_FENCE: return "fence";
+        case VK_OBJECT_TYPE_DEVICE_MEMORY: return "device memory";
+        case VK_OBJECT_TYPE_BUFFER: return "buffer";
+        case VK_OBJECT_TYPE_IMAGE: return "image";
+        case VK_OBJECT_TYPE_QUERY_POOL: return "query pool";
+        case VK_OBJECT_TYPE_IMAGE_VIEW: return "image view";
+        case VK_OBJECT_TYPE_SHADER_MODULE: return "shader module";
+        case VK_OBJECT_TYPE_PIPELINE_CACHE: return "pipeline cache";
+        case VK_OBJECT_TYPE_PIPELINE_LAYOUT: return "pipeline layout";
+        case VK_OBJECT_TYPE_RENDER_PASS: return "render pass";
+        case VK_OBJECT_TYPE_PIPELINE: return "pipeline";
+        case VK_OBJECT_TYPE_DESCRIPTOR_SET_LAYOUT: return "descriptor set layout";
+        case VK_OBJECT_TYPE_SAMPLER: return "sampler";
+        case VK_OBJECT_TYPE_DESCRIPTOR_POOL: return "descriptor pool";
+        case VK_OBJECT_TYPE_FRAMEBUFFER: return "framebuffer";
+        case VK_OBJECT_TYPE_COMMAND_POOL: return "command pool";
+        case VK_OBJECT_TYPE_SURFACE_KHR: return "surface";
+        case VK_OBJECT_TYPE_SWAPCHAIN_KHR: return "swap chain";
+        case VK_OBJECT_TYPE_DEBUG_UTILS_MESSENGER_EXT: return "debug messenger";
+        default: return "other";
+    }
+}
+// ================================================================================
+// ================================================================================
+
+SmallBlockPool::SmallBlockPool(size_t blockOverhead) : blockOverhead(blockOverhead) {}
+// --------------------------------------------------------------------------------
+
+SmallBlockPool::~SmallBlockPool() {
+    for (void* chunk : chunks) {
+        std::free(chunk);
+    }
+}
+// --------------------------------------------------------------------------------
+
+uint32_t SmallBlockPool::sizeClassFor(size_t size) {
+    for (uint32_t i = 0; i < SIZE_CLASS_COUNT; i++) {
+        if (size <= SIZE_CLASSES[i]) {
+            return i;
+        }
+    }
+    return SIZE_CLASS_COUNT;
+}
+// --------------------------------------------------------------------------------
+
+void* SmallBlockPool::allocate(uint32_t sizeClass) {
+    FreeBlock* block = freeLists[sizeClass];
+    if (block == nullptr) {
+        // Take every block other threads have returned in one exchange
+        block = remoteFrees[sizeClass].exchange(nullptr, std::memory_order_acquire);
+    }
+    if (block != nullptr) {
+        freeLists[sizeClass] = block->next;
+        return block;
+    }
+
+    size_t blockSize = blockOverhead + SIZE_CLASSES[sizeClass];
+    if (chunkCursor == nullptr || static_cast<size_t>(chunkEnd - chunkCursor) < blockSize) {
+        // The tail of the previous chunk is abandoned; it is smaller than one block
+        char* chunk = static_cast<char*>(std::malloc(POOL_CHUNK_SIZE));
+        if (chunk == nullptr) {
+            return nullptr;
+        }
+        chunks.push_back(chunk);
+        chunkCursor = chunk;
+        chunkEnd = chunk + POOL_CHUNK_SIZE;
+    }
+    void* result = chunkCursor;
+    chunkCursor += blockSize;
+    return result;
+}
+// --------------------------------------------------------------------------------
+
+void SmallBlockPool::release(void* block, uint32_t sizeClass) {
+    FreeBlock* freeBlock = static_cast<FreeBlock*>(block);
+    freeBlock->next = freeLists[sizeClass];
+    freeLists[sizeClass] = freeBlock;
+}
+// --------------------------------------------------------------------------------
+
+void SmallBlockPool::releaseRemote(void* block, uint32_t sizeClass) {
+    // The owner only ever takes the whole stack, so there is no ABA hazard
+    FreeBlock* freeBlock = static_cast<FreeBlock*>(block);
+    freeBlock->next = remoteFrees[sizeClass].load(std::memory_order_relaxed);
+    while (!remoteFrees[sizeClass].compare_exchange_weak(freeBlock->next, freeBlock,
+                                                         std::memory_order_release,
+                                                         std::memory_order_relaxed)) {
+    }
+}
+// ================================================================================
+// ================================================================================
+
+/**
+ * @brief Ties a pool to the lifetime of the thread that owns it
+ */
+struct ThreadPoolHandle {
+    SmallBlockPool* pool = nullptr;
+// --------------------------------------------------------------------------------
+
+    ~ThreadPoolHandle() {
+        if (pool != nullptr) {
+            HostAllocator::instance().retirePool(pool);
+        }
+    }
+};
+// --------------------------------------------------------------------------------
+
+static thread_local ThreadPoolHandle currentPool;
+// ================================================================================
+// ================================================================================
+
+HostAllocator& HostAllocator::instance() {
+    static HostAllocator allocator;
+    return allocator;
+}
+// --------------------------------------------------------------------------------
+
+HostAllocator::HostAllocator() : poolRouting(HOST_ALLOCATOR_USE_POOLS) {}
+// --------------------------------------------------------------------------------
+
+const VkAllocationCallbacks* HostAllocator::getCallbacks(VkObjectType type) {
+    std::lock_guard<std::mutex> lock(tagMutex);
+
+    auto it = tagsByType.find(static_cast<int32_t>(type));
+    if (it != tagsByType.end()) {
+        return &it->second->callbacks;
+    }
+
+    auto tag = std::make_unique<TypeTag>();
+    tag->owner = this;
+    tag->type = type;
+    tag->callbacks.pUserData = tag.get();
+    tag->callbacks.pfnAllocation = &HostAllocator::allocationCallback;
+    tag->callbacks.pfnReallocation = &HostAllocator::reallocationCallback;
+    tag->callbacks.pfnFree = &HostAllocator::freeCallback;
+    tag->callbacks.pfnInternalAllocation = &HostAllocator::internalAllocationCallback;
+    tag->callbacks.pfnInternalFree = &HostAllocator::internalFreeCallback;
+
+    TypeTag* result = tag.get();
+    tagsByType[static_cast<int32_t>(type)] = result;
+    tags.push_back(std::move(tag));
+    return &result->callbacks;
+}
+// --------------------------------------------------------------------------------
+
+void HostAllocator::setPoolRouting(bool enabled) {
+    poolRouting.store(enabled, std::memory_order_relaxed);
+}
+// --------------------------------------------------------------------------------
+
+HostAllocationStats HostAllocator::getScopeStats(VkSystemAllocationScope scope) const {
+    uint32_t index = static_cast<uint32_t>(scope);
+    if (index >= SCOPE_COUNT) {
+        return {};
+    }
+    return scopeCounters[index].snapshot();
+}
+// --------------------------------------------------------------------------------
+
+HostAllocationStats HostAllocator::getTypeStats(VkObjectType type) const {
+    std::lock_guard<std::mutex> lock(tagMutex);
+    auto it = tagsByType.find(static_cast<int32_t>(type));
+    if (it == tagsByType.end()) {
+        return {};
+    }
+    return it->second->counters.snapshot();
+}
+// --------------------------------------------------------------------------------
+
+void HostAllocator::printReport(std::ostream& out) const {
+    auto printRow = [&out](const char* name, const HostAllocationStats& stats) {
+        out << "  " << std::left << std::setw(24) << name << std::right
+            << std::setw(10) << stats.allocations
+            << std::setw(10) << stats.reallocations
+            << std::setw(10) << stats.frees
+            << std::setw(10) << stats.pooledAllocations
+            << std::setw(14) << stats.bytesCurrent
+            << std::setw(14) << stats.bytesPeak
+            << std::setw(14) << stats.internalBytesPeak << "\n";
+    };
+    auto printHeader = [&out](const char* title) {
+        out << title << "\n  " << std::left << std::setw(24) << "" << std::right
+            << std::setw(10) << "allocs"
+            << std::setw(10) << "reallocs"
+            << std::setw(10) << "frees"
+            << std::setw(10) << "pooled"
+            << std::setw(14) << "live bytes"
+            << std::setw(14) << "peak bytes"
+            << std::setw(14) << "internal peak" << "\n";
+    };
+
+    printHeader("Host allocations by scope");
+    for (uint32_t scope = 0; scope < SCOPE_COUNT; scope++) {
+        printRow(scopeName(scope), scopeCounters[scope].snapshot());
+    }
+
+    printHeader("Host allocations by object type");
+    std::lock_guard<std::mutex> lock(tagMutex);
+    for (const auto& tag : tags) {
+        printRow(objectTypeName(tag->type), tag->counters.snapshot());
+    }
+    out.flush();
+}
+// ================================================================================
+
+HostAllocationStats HostAllocator::Counters::snapshot() const {
+    HostAllocationStats stats;
+    stats.allocations = allocations.load(std::memory_order_relaxed);
+    stats.reallocations = reallocations.load(std::memory_order_relaxed);
+    stats.frees = frees.load(std::memory_order_relaxed);
+    stats.pooledAllocations = pooledAllocations.load(std::memory_order_relaxed);
+    stats.bytesCurrent = bytesCurrent.load(std::memory_order_relaxed);
+    stats.bytesPeak = bytesPeak.load(std::memory_order_relaxed);
+    stats.internalBytesCurrent = internalBytesCurrent.load(std::memory_order_relaxed);
+    stats.internalBytesPeak = internalBytesPeak.load(std::memory_order_relaxed);
+    return stats;
+}
+// --------------------------------------------------------------------------------
+
+void* HostAllocator::allocate(TypeTag& tag, size_t size, size_t alignment, VkSystemAllocationScope scope) {
+    if (size == 0) {
+        return nullptr;
+    }
+    alignment = std::max(alignment, POOL_ALIGNMENT);
+
+    void* memory = nullptr;
+    AllocationHeader header{};
+    header.size = size;
+    header.tag = &tag;
+    header.scope = static_cast<uint8_t>(scope);
+    header.sizeClass = static_cast<uint8_t>(SmallBlockPool::SIZE_CLASS_COUNT);
+
+    bool poolable = scope == VK_SYSTEM_ALLOCATION_SCOPE_COMMAND || scope == VK_SYSTEM_ALLOCATION_SCOPE_OBJECT;
+    uint32_t sizeClass = SmallBlockPool::sizeClassFor(size);
+    if (poolable && alignment == POOL_ALIGNMENT && sizeClass < SmallBlockPool::SIZE_CLASS_COUNT &&
+        poolRouting.load(std::memory_order_relaxed)) {
+        SmallBlockPool* pool = threadPool();
+        void* block = pool->allocate(sizeClass);
+        if (block != nullptr) {
+            header.pool = pool;
+            header.baseOffset = sizeof(AllocationHeader);
+            header.sizeClass = static_cast<uint8_t>(sizeClass);
+            memory = static_cast<char*>(block) + sizeof(AllocationHeader);
+        }
+    }
+
+    if (memory == nullptr) {
+        // Over-allocate so the header and the aligned user block always fit
+        void* base = std::malloc(size + alignment + sizeof(AllocationHeader));
+        if (base == nullptr) {
+            return nullptr;
+        }
+        uintptr_t start = reinterpret_cast<uintptr_t>(base) + sizeof(AllocationHeader);
+        start = (start + alignment - 1) & ~(static_cast<uintptr_t>(alignment) - 1);
+        header.baseOffset = static_cast<uint32_t>(start - reinterpret_cast<uintptr_t>(base));
+        memory = reinterpret_cast<void*>(start);
+    }
+    *headerOf(memory) = header;
+
+    for (Counters* counters : {&countersFor(scope), &tag.counters}) {
+        counters->allocations.fetch_add(1, std::memory_order_relaxed);
+        if (header.pool != nullptr) {
+            counters->pooledAllocations.fetch_add(1, std::memory_order_relaxed);
+        }
+        uint64_t current = counters->bytesCurrent.fetch_add(size, std::memory_order_relaxed) + size;
+        updatePeak(counters->bytesPeak, current);
+    }
+    return memory;
+}
+// --------------------------------------------------------------------------------
+
+void* HostAllocator::reallocate(TypeTag& tag, void* original, size_t size, size_t alignment,
+                                VkSystemAllocationScope scope) {
+    if (original == nullptr) {
+        return allocate(tag, size, alignment, scope);
+    }
+    if (size == 0) {
+        free(original);
+        return nullptr;
+    }
+
+    AllocationHeader* header = headerOf(original);
+    for (Counters* counters : {&countersFor(static_cast<VkSystemAllocationScope>(header->scope)),
+                               &tag.counters}) {
+        counters->reallocations.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    // A pooled block already large enough is resized in place
+    if (header->pool != nullptr && alignment <= POOL_ALIGNMENT &&
+        size <= SmallBlockPool::SIZE_CLASSES[header->sizeClass] &&
+        header->tag == &tag && header->scope == static_cast<uint8_t>(scope)) {
+        for (Counters* counters : {&countersFor(scope), &tag.counters}) {
+            uint64_t current = counters->bytesCurrent.fetch_add(size - header->size, std::memory_order_relaxed) +
+                               (size - header->size);
+            updatePeak(counters->bytesPeak, current);
+        }
+        header->size = size;
+        return original;
+    }
+
+    void* memory = allocate(tag, size, alignment, scope);
+    if (memory == nullptr) {
+        // The original allocation must be left untouched on failure
+        return nullptr;
+    }
+    std::memcpy(memory, original, std::min<size_t>(size, header->size));
+    free(original);
+    return memory;
+}
+// --------------------------------------------------------------------------------
+
+void HostAllocator::free(void* memory) {
+    if (memory == nullptr) {
+        return;
+    }
+
+    AllocationHeader* header = headerOf(memory);
+    TypeTag* tag = static_cast<TypeTag*>(header->tag);
+    for (Counters* counters : {&countersFor(static_cast<VkSystemAllocationScope>(header->scope)),
+                               &tag->counters}) {
+        counters->frees.fetch_add(1, std::memory_order_relaxed);
+        counters->bytesCurrent.fetch_sub(header->size, std::memory_order_relaxed);
+    }
+
+    if (header->pool == nullptr) {
+        std::free(baseOf(memory));
+    } else if (header->pool == currentPool.pool) {
+        header->pool->release(baseOf(memory), header->sizeClass);
+    } else {
+        header->pool->releaseRemote(baseOf(memory), header->sizeClass);
+    }
+}
+// --------------------------------------------------------------------------------
+
+void HostAllocator::onInternalAllocation(TypeTag& tag, size_t size, VkSystemAllocationScope scope) {
+    for (Counters* counters : {&countersFor(scope), &tag.counters}) {
+        uint64_t current = counters->internalBytesCurrent.fetch_add(size, std::memory_order_relaxed) + size;
+        updatePeak(counters->internalBytesPeak, current);
+    }
+}
+// --------------------------------------------------------------------------------
+
+void HostAllocator::onInternalFree(TypeTag& tag, size_t size, VkSystemAllocationScope scope) {
+    for (Counters* counters : {&countersFor(scope), &tag.counters}) {
+        counters->internalBytesCurrent.fetch_sub(size, std::memory_order_relaxed);
+    }
+}
+// --------------------------------------------------------------------------------
+
+SmallBlockPool* HostAllocator::threadPool() {
+    if (currentPool.pool != nullptr) {
+        return currentPool.pool;
+    }
+
+    std::lock_guard<std::mutex> lock(poolMutex);
+    if (!retiredPools.empty()) {
+        // Adopt the pool of a thread that has exited, along with its free blocks
+        currentPool.pool = retiredPools.back();
+        retiredPools.pop_back();
+    } else {
+        pools.push_back(std::make_unique<SmallBlockPool>(sizeof(AllocationHeader)));
+        currentPool.pool = pools.back().get();
+    }
+    return currentPool.pool;
+}
+// --------------------------------------------------------------------------------
+
+void HostAllocator::retirePool(SmallBlockPool* pool) {
+    std::lock_guard<std::mutex> lock(poolMutex);
+    retiredPools.push_back(pool);
+}
+// --------------------------------------------------------------------------------
+
+HostAllocator::Counters& HostAllocator::countersFor(VkSystemAllocationScope scope) {
+    return scopeCounters[std::min(static_cast<uint32_t>(scope), SCOPE_COUNT - 1)];
+}
+// ================================================================================
+
+void* VKAPI_PTR HostAllocator::allocationCallback(void* userData, size_t size, size_t alignment,
+                                                  VkSystemAllocationScope scope) {
+    TypeTag* tag = static_cast<TypeTag*>(userData);
+    return tag->owner->allocate(*tag, size, alignment, scope);
+}
+// --------------------------------------------------------------------------------
+
+void* VKAPI_PTR HostAllocator::reallocationCallback(void* userData, void* original, size_t size,
+                                                    size_t alignment, VkSystemAllocationScope scope) {
+    TypeTag* tag = static_cast<TypeTag*>(userData);
+    return tag->owner->reallocate(*tag, original, size, alignment, scope);
+}
+// --------------------------------------------------------------------------------
+
+void VKAPI_PTR HostAllocator::freeCallback(void* userData, void* memory) {
+    static_cast<TypeTag*>(userData)->owner->free(memory);
+}
+// --------------------------------------------------------------------------------
+
+void VKAPI_PTR HostAllocator::internalAllocationCallback(void* userData, size_t size,
+                                                         VkInternalAllocationType type,
+                                                         VkSystemAllocationScope scope) {
+    TypeTag* tag = static_cast<TypeTag*>(userData);
+    tag->owner->onInternalAllocation(*tag, size, scope);
+}
+// --------------------------------------------------------------------------------
+
+void VKAPI_PTR HostAllocator::internalFreeCallback(void* userData, size_t size,
+                                                   VkInternalAllocationType type,
+                                                   VkSystemAllocationScope scope) {
+    TypeTag* tag = static_cast<TypeTag*>(userData);
+    tag->owner->onInternalFree(*tag, size, scope);
+}
+// ================================================================================
+// ================================================================================
+
+const VkAllocationCallbacks* hostAllocator(VkObjectType type) {
+    if (!ENABLE_HOST_ALLOCATION_TRACKING) {
+        return nullptr;
+    }
+    return HostAllocator::instance().getCallbacks(type);
+}
+// ================================================================================
+// ================================================================================
+// eof
@@ -0,0 +1,163 @@
+// ================================================================================
+// ================================================================================
+// - File:    image_writer.cpp
+// - Purpose: Contains the implementation for image_writer.hpp
+//
+// Source Metadata
+// - Author:  Jonathan A. Webb
+// - Date:    October 18, 2026
+// - Version: 1.0
+// - Copyright: Copyright 2022, Jon Webb Inc.
+// ================================================================================
+// ================================================================================
+// Include modules here
+
+#include "include/image_writer.hpp"
+#include <algorithm>
+#include <array>
+#include <fstream>
+#include <stdexcept>
+// ================================================================================
+// ================================================================================
+
+// The largest payload of a stored deflate block
+static const size_t DEFLATE_STORED_BLOCK_SIZE = 65535;
+// --------------------------------------------------------------------------------
+
+static const std::array<uint32_t, 256>& crcTable() {
+    static const std::array<uint32_t, 256> table = [] {
+        std::array<uint32_t, 256> entries{};
+        for (uint32_t n = 0; n < 256; n++) {
+            uint32_t c = n;
+            for (int k = 0; k < 8; k++) {
+                c = (c & 1) ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+            }
+            entries[n] = c;
+        }
+        return entries;
+    }();
+    return table;
+}
+// --------------------------------------------------------------------------------
+
+static void appendU32(std::vector<uint8_t>& out, uint32_t value) {
+    out.push_back(static_cast<uint8_t>(value >> 24));
+    out.push_back(static_cast<uint8_t>(value >> 16));
+    out.push_back(static_cast<uint8_t>(value >> 8));
+    out.push_back(static_cast<uint8_t>(value));
+}
+// --------------------------------------------------------------------------------
+
+/**
+ * @brief Appends a length-prefixed chunk and the CRC of its type and data
+ */
+static void appendChunk(std::vector<uint8_t>& out, const char* type, const std::vector<uint8_t>& data) {
+    appendU32(out, static_cast<uint32_t>(data.size()));
+    size_t crcStart = out.size();
+    out.insert(out.end(), type, type + 4);
+    out.insert(out.end(), data.begin(), data.end());
+
+    const std::array<uint32_t, 256>& table = crcTable();
+    uint32_t crc = 0xFFFFFFFFu;
+    for (size_t i = crcStart; i < out.size(); i++) {
+        crc = table[(crc ^ out[i]) & 0xFF] ^ (crc >> 8);
+    }
+    appendU32(out, crc ^ 0xFFFFFFFFu);
+}
+// --------------------------------------------------------------------------------
+
+static void writeFile(const std::string& path, const uint8_t* data, size_t size) {
+    std::ofstream file(path, std::ios::binary);
+    if (!file) {
+        throw std::runtime_error("failed to open '" + path + "' for writing!");
+    }
+    file.write(reinterpret_cast<const char*>(data), static_cast<std::streamsize>(size));
+    if (!file) {
+        throw std::runtime_error("failed to write '" + path + "'!");
+    }
+}
+// ================================================================================
+// ================================================================================
+
+std::vector<uint8_t> encodePng(uint32_t width, uint32_t height, const uint8_t* rgba) {
+    size_t rowSize = static_cast<size_t>(width) * 4;
+
+    // Every row is prefixed with its filter type.  Up stores the difference to
+    // the row above, which is zero across flat regions of a rendered frame.
+    std::vector<uint8_t> filtered((rowSize + 1) * height);
+    for (uint32_t y = 0; y < height; y++) {
+        uint8_t* out = filtered.data() + (rowSize + 1) * y;
+        const uint8_t* row = rgba + rowSize * y;
+        out[0] = 2;
+        if (y == 0) {
+            std::copy(row, row + rowSize, out + 1);
+        } else {
+            const uint8_t* above = row - rowSize;
+            for (size_t i = 0; i < rowSize; i++) {
+                out[1 + i] = static_cast<uint8_t>(row[i] - above[i]);
+            }
+        }
+    }
+
+    // zlib header, stored blocks and the Adler-32 of the uncompressed data
+    std::vector<uint8_t> zlib;
+    size_t blockCount = std::max<size_t>(1, (filtered.size() + DEFLATE_STORED_BLOCK_SIZE - 1) / DEFLATE_STORED_BLOCK_SIZE);
+    zlib.reserve(filtered.size() + blockCount * 5 + 6);
+    zlib.push_back(0x78);
+    zlib.push_back(0x01);
+    for (size_t offset = 0, block = 0; block < blockCount; block++) {
+        size_t length = std::min(DEFLATE_STORED_BLOCK_SIZE, filtered.size() - offset);
+        zlib.push_back(block + 1 == blockCount ? 1 : 0);
+        zlib.push_back(static_cast<uint8_t>(length));
+        zlib.push_back(static_cast<uint8_t>(length >> 8));
+        zlib.push_back(static_cast<uint8_t>(~length));
+        zlib.push_back(static_cast<uint8_t>(~length >> 8));
+        zlib.insert(zlib.end(), filtered.begin() + offset, filtered.begin() + offset + length);
+        offset += length;
+    }
+
+    uint32_t a = 1;
+    uint32_t b = 0;
+    for (size_t i = 0; i < filtered.size();) {
+        // 5552 bytes is the most that can be summed before the modulo is needed
+        size_t end = std::min(filtered.size(), i + 5552);
+        for (; i < end; i++) {
+            a += filtered[i];
+            b += a;
+        }
+        a %= 65521;
+        b %= 65521;
+    }
+    appendU32(zlib, (b << 16) | a);
+
+    std::vector<uint8_t> header;
+    appendU32(header, width);
+    appendU32(header, height);
+    header.push_back(8);  // Bit depth
+    header.push_back(6);  // Color type RGBA
+    header.push_back(0);  // Compression method
+    header.push_back(0);  // Filter method
+    header.push_back(0);  // No interlacing
+
+    static const uint8_t signature[] = {0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n'};
+    std::vector<uint8_t> png(signature, signature + sizeof(signature));
+    png.reserve(zlib.size() + 64);
+    appendChunk(png, "IHDR", header);
+    appendChunk(png, "IDAT", zlib);
+    appendChunk(png, "IEND", {});
+    return png;
+}
+// --------------------------------------------------------------------------------
+
+void writePng(const std::string& path, uint32_t width, uint32_t height, const uint8_t* rgba) {
+    std::vector<uint8_t> png = encodePng(width, height, rgba);
+    writeFile(path, png.data(), png.size());
+}
+// --------------------------------------------------------------------------------
+
+void writeRaw(const std::string& path, uint32_t width, uint32_t height, const uint8_t* rgba) {
+    writeFile(path, rgba, static_cast<size_t>(width) * height * 4);
+}
+// ================================================================================
+// ================================================================================
+// eof
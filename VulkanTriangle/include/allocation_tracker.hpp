@@ -0,0 +1,116 @@
+// ================================================================================
+// ================================================================================
+// - File:    allocation_tracker.hpp
+// - Purpose: This file contains counters for heap allocations and a budget
+//            that reports allocations made where none are expected
+//
+// Source Metadata
+// - Author:  Jonathan A. Webb
+// - Date:    October 18, 2026
+// - Version: 1.0
+// - Copyright: Copyright 2022, Jon Webb Inc.
+// ================================================================================
+// ================================================================================
+// Include modules here
+
+#ifndef allocation_tracker_HPP
+#define allocation_tracker_HPP
+
+#include <cstdint>
+// ================================================================================
+// ================================================================================
+
+/**
+ * @brief Allocation counts for one thread or the whole process
+ */
+struct AllocationCounters {
+    uint64_t allocations = 0;
+    uint64_t bytes = 0;
+};
+// --------------------------------------------------------------------------------
+
+/**
+ * @brief What happens when an AllocationBudget is exceeded
+ */
+enum class AllocationViolation {
+    Count,  // Only count the allocation
+    Log,    // Print the allocation size and a stack trace
+    Abort   // Print the stack trace and abort
+};
+// ================================================================================
+// ================================================================================
+
+/**
+ * @class AllocationTracker
+ * @brief Counts every allocation made through the global operator new.
+ *
+ * The counting operator new and delete are only compiled when TRACK_ALLOCATIONS
+ * is defined, which the TRACK_ALLOCATIONS CMake option does.  Otherwise
+ * isEnabled() returns false and every counter stays at zero.  malloc called
+ * directly, for example by a driver, is not counted.
+ */
+class AllocationTracker {
+public:
+    /**
+     * @brief Returns true if allocations are being counted
+     */
+    static bool isEnabled();
+// --------------------------------------------------------------------------------
+
+    /**
+     * @brief Returns the allocations made by the calling thread
+     */
+    static AllocationCounters getThreadCounters();
+// --------------------------------------------------------------------------------
+
+    /**
+     * @brief Returns the allocations made by every thread
+     */
+    static AllocationCounters getTotalCounters();
+};
+// ================================================================================
+// ================================================================================
+
+/**
+ * @class AllocationBudget
+ * @brief Limits the allocations the calling thread may make while the object
+ * is alive.
+ *
+ * A frame is wrapped in a budget, usually of zero, once warm-up is over; each
+ * allocation past the budget is reported as the budget's action says.  Budgets
+ * nest, and only the innermost one applies.  Nothing is reported when
+ * allocations are not tracked.
+ */
+class AllocationBudget {
+public:
+    /**
+     * @param budget The number of allocations allowed
+     * @param action What happens on each allocation past the budget
+     */
+    AllocationBudget(uint64_t budget, AllocationViolation action);
+// --------------------------------------------------------------------------------
+
+    ~AllocationBudget();
+// --------------------------------------------------------------------------------
+
+    AllocationBudget(const AllocationBudget&) = delete;
+    AllocationBudget& operator=(const AllocationBudget&) = delete;
+// --------------------------------------------------------------------------------
+
+    /**
+     * @brief Returns the allocations the thread has made since the budget began
+     */
+    uint64_t getAllocations() const;
+// ================================================================================
+private:
+    uint64_t start;
+    uint64_t previousLimit;
+    AllocationViolation previousAction;
+};
+// ================================================================================
+// ================================================================================
+
+#endif /* allocation_tracker_HPP */
+// ================================================================================
+// ================================================================================
+// eof
@@ -21,10 +21,30 @@
 #include "validation_layers.hpp"
 #include "devices.hpp"
 #include "graphics_pipeline.hpp"
+#include "buffers.hpp"
+#include "command_buffers.hpp"
+#include "synchronization.hpp"
+#include "render_graph.hpp"
+#include "residency_manager.hpp"
+#include "job_system.hpp"
+#include "texture_streamer.hpp"
+#include "upload_manager.hpp"
+#include "particle_system.hpp"
+#include "frame_capture.hpp"
+#include "shader_watcher.hpp"
+#include "constants.hpp"
+#include "frame_limiter.hpp"
+#include "render_queue.hpp"
+#include "frame_arena.hpp"
+#include "allocation_tracker.hpp"
 
 #include <iostream>
 #include <vector>
 #include <memory>
+#include <atomic>
+#include <mutex>
+#include <string>
+#include <chrono>
 // ================================================================================
 // ================================================================================
 
@@ -107,6 +127,37 @@ private:
 // ================================================================================
 // ================================================================================
 
+/**
+ * @brief Creates an instance of Vulkan with no window or surface, for
+ * rendering offscreen on machines without a display
+ */
+class HeadlessVulkanInstance : public CreateVulkanInstance {
+public:
+    /**
+     * @param validationLayers The validation layers, created with a null window
+     */
+    explicit HeadlessVulkanInstance(std::unique_ptr<ValidationLayers>& validationLayers);
+// --------------------------------------------------------------------------------
+
+    ~HeadlessVulkanInstance() override;
+// --------------------------------------------------------------------------------
+
+    VkInstance* getInstance() override;
+// --------------------------------------------------------------------------------
+
+    /**
+     * @brief Returns VK_NULL_HANDLE; nothing is presented
+     */
+    VkSurfaceKHR getSurface() const override;
+// ================================================================================
+private:
+    std::unique_ptr<ValidationLayers>& validationLayers;
+    VkInstance instance = VK_NULL_HANDLE;
+};
+// ================================================================================
+// ================================================================================
+
+
 
 /**
  * @brief This class represents the main application for rendering a triangle using Vulkan.
@@ -122,12 +173,22 @@ public:
      * 
      * @param window A reference to a Window object that the application will use.
      * @param vulkanInstanceCreator A reference to a CreateVulkanInstance object for creating the Vulkan instance.
+     * @param residency The manager that keeps device memory within budget
+     * @param jobs The job system background work such as texture reads runs on
+     * @param uniformBuffer The per-frame uniform ring buffer bound at set 0 of the pipeline
+     * @param pipelineCache The cache that owns every compiled pipeline
+     * @param objectCache The cache that owns render passes, framebuffers and samplers
      */
     HelloTriangleApplication(std::unique_ptr<Window> window, 
                              std::unique_ptr<CreateVulkanInstance> vulkanInstanceCreator,
                              std::unique_ptr<VulkanPhysicalDevice> physicalDevice,
                              std::unique_ptr<VulkanLogicalDevice> logicalDevice,
+                             std::unique_ptr<ResidencyManager> residency,
+                             std::unique_ptr<JobSystem> jobs,
                              std::unique_ptr<SwapChain> swapChain,
+                             std::unique_ptr<UniformRingBuffer> uniformBuffer,
+                             std::unique_ptr<PipelineStateCache> pipelineCache,
+                             std::unique_ptr<ObjectCache> objectCache,
                              std::unique_ptr<GraphicsPipeline> pipeline);
 // --------------------------------------------------------------------------------
 
@@ -140,10 +201,65 @@ public:
     /**
      * @brief Runs the main application loop.
      * 
-     * This method starts the main rendering loop of the application, polling window events
-     * and rendering frames until the window is closed.
+     * This method starts a render thread and then processes window events on the
+     * calling thread until the window is closed.  The two threads only share a
+     * lock-free event queue, so a blocked event loop does not stall rendering.
+     * Must be called from the thread that created the window.
      */
     void run();
+// --------------------------------------------------------------------------------
+
+    /**
+     * @brief Switches between recording a command buffer every frame and
+     * replaying one pre-recorded command buffer per swap chain image.
+     *
+     * @param enabled True to replay pre-recorded command buffers
+     */
+    void setStaticFrames(bool enabled);
+// --------------------------------------------------------------------------------
+
+    /**
+     * @brief Forces the pre-recorded command buffers to be re-recorded before the
+     * next frame.  Call this after any change to the scene.
+     */
+    void markFramesDirty();
+// --------------------------------------------------------------------------------
+
+    /**
+     * @brief Returns the number of frames that replayed a pre-recorded command
+     * buffer instead of recording a new one
+     */
+    uint64_t getSkippedRecordCount() const;
+// --------------------------------------------------------------------------------
+
+    /**
+     * @brief Sets the frame rate the main loop is paced to
+     *
+     * @param targetFps The target frame rate, or zero to render as fast as possible
+     */
+    void setTargetFps(double targetFps);
+// --------------------------------------------------------------------------------
+
+    /**
+     * @brief Starts streaming a DDS or KTX2 texture.  Must be called before run().
+     *
+     * @param path The texture file
+     * @return A handle to the texture
+     */
+    TextureHandle loadTexture(const std::string& path);
+// --------------------------------------------------------------------------------
+
+    /**
+     * @brief Writes the next rendered frames to image files.  May be called from
+     * any thread; the capture starts with the next frame and replaces any capture
+     * in progress.  Frames are dropped rather than stalling the GPU when the
+     * encoders fall behind.
+     *
+     * @param directory The directory files are written to; created if missing
+     * @param format The file format
+     * @param frameCount The number of frames to capture
+     */
+    void captureFrames(const std::string& directory, CaptureFormat format, uint32_t frameCount);
 // ================================================================================
 private:
     // Utilizing smart pointers so I can control the order of destruction
@@ -151,11 +267,175 @@ private:
     std::unique_ptr<CreateVulkanInstance> vulkanInstanceCreator;
     std::unique_ptr<VulkanPhysicalDevice> physicalDevice;
     std::unique_ptr<VulkanLogicalDevice> logicalDevice;
+    std::unique_ptr<DeletionQueue> deletionQueue;
+    std::unique_ptr<ResidencyManager> residency;
+    std::unique_ptr<JobSystem> jobs;
+    std::unique_ptr<TextureStreamer> textureStreamer;
+    std::unique_ptr<UploadManager> uploads;
     std::unique_ptr<SwapChain> swapChain;
+    std::unique_ptr<UniformRingBuffer> uniformBuffer;
+    std::unique_ptr<PipelineStateCache> pipelineCache;
+    std::unique_ptr<ObjectCache> objectCache;
     std::unique_ptr<GraphicsPipeline> pipeline;
+    std::unique_ptr<ParticleSystem> particles;
+    VkPipeline particlePipeline = VK_NULL_HANDLE;
+    std::unique_ptr<FrameCapture> frameCapture;
+    std::unique_ptr<ShaderWatcher> shaderWatcher;
+    std::unique_ptr<CommandBufferManager> commandBuffers;
+    std::unique_ptr<CommandBufferManager> staticCommandBuffers;
+    std::unique_ptr<SyncObjects> syncObjects;
+    std::unique_ptr<RenderGraph> renderGraph;
+    RenderGraphResource backbuffer = 0;
+    RenderGraphResource colorTarget = 0;
+    bool captureInGraph = false;
+
+    // With multiview, each layer of colorTarget is one view, tiled into the
+    // backbuffer in a grid this many views wide.  Otherwise viewExtent is the
+    // swap chain extent.
+    VkExtent2D viewExtent{0, 0};
+    uint32_t viewColumns = 1;
 
     VkQueue graphicsQueue;
     VkQueue presentQueue;
+    uint32_t currentFrame = 0;
+    uint64_t frameNumber = 0;
+    bool staticFrames = ENABLE_STATIC_FRAMES;
+    std::chrono::steady_clock::time_point lastFrameTime;
+    std::atomic<bool> framesDirty{true};
+    std::atomic<uint64_t> skippedRecordCount{0};
+    FrameLimiter frameLimiter{TARGET_FPS, std::chrono::microseconds(FRAME_LIMITER_SPIN_MICROSECONDS)};
+    RenderQueue renderQueue;
+    FrameArena frameArena{FRAME_ARENA_SIZE};
+    uint64_t budgetedFrames = 0;
+    uint64_t framesOverBudget = 0;
+
+    // Settings requested from any thread and applied by the render thread
+    // between frames
+    std::atomic<bool> requestedStaticFrames{ENABLE_STATIC_FRAMES};
+    std::atomic<double> requestedTargetFps{TARGET_FPS};
+    std::mutex captureRequestMutex;
+    bool captureRequested = false;
+    std::string captureDirectory;
+    CaptureFormat captureFormat = CaptureFormat::Png;
+    uint32_t captureFrameCount = 0;
+
+    // Written by the event thread, read by the render thread
+    WindowEventQueue windowEvents;
+    std::atomic<bool> stopRendering{false};
+
+    // Owned by the render thread and only updated from the window between frames
+    uint32_t framebufferWidth = 0;
+    uint32_t framebufferHeight = 0;
+    bool framebufferResized = false;
+    bool minimized = false;
+// --------------------------------------------------------------------------------
+
+    /**
+     * @brief The body of the render thread.  Drains window events, renders and
+     * paces frames until stopRendering is set.
+     */
+    void renderLoop();
+// --------------------------------------------------------------------------------
+
+    /**
+     * @brief Applies every input event queued by the event thread and picks
+     * up the latest framebuffer size and iconified state
+     */
+    void processWindowEvents();
+// --------------------------------------------------------------------------------
+
+    /**
+     * @brief Applies settings requested through the public setters
+     */
+    void applyRequestedSettings();
+// --------------------------------------------------------------------------------
+
+    /**
+     * @brief Starts rebuilding the pipelines of recompiled shaders and swaps in
+     * the rebuilds that have finished.  Called between frames; never waits for
+     * a compile.
+     */
+    void reloadShaders();
+// --------------------------------------------------------------------------------
+
+    /**
+     * @brief Acquires a swap chain image, records the frame and presents it
+     */
+    void drawFrame();
+// --------------------------------------------------------------------------------
+
+    /**
+     * @brief Records the draw commands for one swap chain image
+     *
+     * @param commandBuffer The command buffer to record into
+     * @param imageIndex The index of the swap chain image being rendered
+     * @param usage The usage flags passed to vkBeginCommandBuffer
+     */
+    void recordCommandBuffer(VkCommandBuffer commandBuffer,
+                             uint32_t imageIndex,
+                             VkCommandBufferUsageFlags usage = 0);
+// --------------------------------------------------------------------------------
+
+    /**
+     * @brief Waits for every frame in flight and re-records the command buffer
+     * of every swap chain image
+     */
+    void recordStaticCommandBuffers();
+// --------------------------------------------------------------------------------
+
+    /**
+     * @brief Records the render pass that draws the triangle into the color
+     * target, which is the backbuffer unless rendering offscreen or with
+     * multiview
+     *
+     * @param commandBuffer The command buffer to record into
+     * @param graph The render graph, used to look up the current target view
+     */
+    void recordMainPass(VkCommandBuffer commandBuffer, const RenderGraph& graph);
+// --------------------------------------------------------------------------------
+
+    /**
+     * @brief Captures the offscreen color target if a capture is active and
+     * copies it to the backbuffer
+     *
+     * @param commandBuffer The command buffer to record into
+     * @param graph The render graph, used to look up both images
+     */
+    void recordPresentCopy(VkCommandBuffer commandBuffer, const RenderGraph& graph);
+// --------------------------------------------------------------------------------
+
+    /**
+     * @brief Copies each view rendered by multiview into its tile of the
+     * backbuffer, clearing the pixels no tile covers
+     *
+     * @param commandBuffer The command buffer to record into
+     * @param graph The render graph, used to look up both images
+     */
+    void recordComposeViews(VkCommandBuffer commandBuffer, const RenderGraph& graph);
+// --------------------------------------------------------------------------------
+
+    /**
+     * @brief Returns true if captures read the backbuffer, which then needs a
+     * capture pass and transfer source usage.  Only a single offscreen view is
+     * captured before it reaches the backbuffer.
+     */
+    bool capturesFromBackbuffer() const;
+// --------------------------------------------------------------------------------
+
+    /**
+     * @brief Declares the frame's passes and compiles the render graph.  Called
+     * again whenever the swap chain is recreated, and when a capture starts or
+     * ends while rendering straight to the backbuffer.
+     */
+    void buildRenderGraph();
+// --------------------------------------------------------------------------------
+
+    /**
+     * @brief Rebuilds the swap chain after a resize, reusing cached objects.
+     * Objects the frames in flight still use go through the deletion queue, so
+     * the GPU is never idled.
+     */
+    void recreateSwapChain();
 // --------------------------------------------------------------------------------
 
     /**
@@ -0,0 +1,196 @@
+// ================================================================================
+// ================================================================================
+// - File:    batch_renderer.hpp
+// - Purpose: This file contains a headless renderer that works through a queue
+//            of offline render jobs and writes each image to disk
+//
+// Source Metadata
+// - Author:  Jonathan A. Webb
+// - Date:    October 18, 2026
+// - Version: 1.0
+// - Copyright: Copyright 2022, Jon Webb Inc.
+// ================================================================================
+// ================================================================================
+// Include modules here
+
+#ifndef batch_renderer_HPP
+#define batch_renderer_HPP
+
+#include <vulkan/vulkan.h>
+#include "buffers.hpp"
+#include "command_buffers.hpp"
+#include "deletion_queue.hpp"
+#include "frame_capture.hpp"
+#include "graphics_pipeline.hpp"
+#include "job_system.hpp"
+#include "object_cache.hpp"
+#include "pipeline_cache.hpp"
+#include "queues.hpp"
+#include "render_job.hpp"
+#include "render_queue.hpp"
+#include "synchronization.hpp"
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+// ================================================================================
+// ================================================================================
+
+/**
+ * @brief Figures reported by BatchRenderer::run()
+ */
+struct BatchRenderStats {
+    uint64_t jobsRendered = 0;    // Jobs submitted to the GPU
+    uint64_t jobsFailed = 0;      // Jobs skipped because their scene could not be loaded
+    uint64_t filesWritten = 0;    // Images written to disk
+    uint64_t writeFailures = 0;   // Images that could not be written
+    uint64_t targetsCreated = 0;  // Offscreen images created; the rest were reused
+    double seconds = 0.0;         // From the first job until the last file was written
+// --------------------------------------------------------------------------------
+
+    double getJobsPerSecond() const {
+        return seconds > 0.0 ? static_cast<double>(filesWritten) / seconds : 0.0;
+    }
+};
+// ================================================================================
+// ================================================================================
+
+/**
+ * @class BatchRenderer
+ * @brief Renders a queue of jobs into pooled offscreen images and writes each
+ * one to disk, without a window or a swap chain.
+ *
+ * Up to jobsInFlight jobs are on the GPU at once, each with its own command
+ * buffer and uniform ring region.  Every job renders into an image taken from a
+ * pool of targets that is matched on size, so a queue of equal sized
+ * thumbnails creates its images once.  The readback goes through FrameCapture:
+ * the copy is recorded in the job's own submission, and the file is encoded on
+ * a worker thread while the GPU renders the following jobs.
+ *
+ * Every member function must be called from the thread that created the
+ * renderer, which is the only thread submitting to the graphics queue.
+ */
+class BatchRenderer {
+public:
+    /**
+     * @param device The logical device
+     * @param physicalDevice The physical device the images and readback buffers come from
+     * @param queueFamilies The queue families the device was created with
+     * @param graphicsQueue The queue the jobs are submitted to
+     * @param graphicsTimeline The timeline signaled by submissions to graphicsQueue
+     * @param jobs The job system images are encoded on
+     * @param pipelineCache The cache that compiles the pipeline
+     * @param objectCache The cache that owns the render pass and framebuffers
+     * @param jobsInFlight The number of jobs that may be on the GPU at once
+     * @param targetPoolSize The most offscreen images kept for reuse; at least jobsInFlight
+     * @param readbackSlots The number of images that may be read back or encoded at once
+     */
+    BatchRenderer(VkDevice device,
+                  VkPhysicalDevice physicalDevice,
+                  const QueueFamilyIndices& queueFamilies,
+                  VkQueue graphicsQueue,
+                  TimelineSemaphore& graphicsTimeline,
+                  JobSystem& jobs,
+                  PipelineStateCache& pipelineCache,
+                  ObjectCache& objectCache,
+                  uint32_t jobsInFlight,
+                  uint32_t targetPoolSize,
+                  uint32_t readbackSlots);
+// --------------------------------------------------------------------------------
+
+    /**
+     * @brief Waits for the jobs in flight and destroys the pooled images
+     */
+    ~BatchRenderer();
+// --------------------------------------------------------------------------------
+
+    BatchRenderer(const BatchRenderer&) = delete;
+    BatchRenderer& operator=(const BatchRenderer&) = delete;
+// --------------------------------------------------------------------------------
+
+    /**
+     * @brief Adds a job to the end of the queue
+     */
+    void enqueue(const RenderJob& job);
+// --------------------------------------------------------------------------------
+
+    size_t getQueuedJobCount() const;
+// --------------------------------------------------------------------------------
+
+    /**
+     * @brief Renders every queued job and returns once all of the files have
+     * been written.  A job whose scene cannot be loaded is reported and skipped.
+     *
+     * @return The figures for this call
+     */
+    BatchRenderStats run();
+// ================================================================================
+private:
+    /**
+     * @brief A pooled offscreen image and the timeline value of its last use
+     */
+    struct RenderTarget {
+        VkImage image = VK_NULL_HANDLE;
+        VkDeviceMemory memory = VK_NULL_HANDLE;
+        VkImageView view = VK_NULL_HANDLE;
+        VkExtent2D extent{0, 0};
+        uint64_t lastUse = 0;
+    };
+// --------------------------------------------------------------------------------
+
+    VkDevice device;
+    VkPhysicalDevice physicalDevice;
+    VkQueue graphicsQueue;
+    TimelineSemaphore& graphicsTimeline;
+    ObjectCache& objectCache;
+    uint32_t targetPoolSize;
+
+    std::unique_ptr<UniformRingBuffer> uniformBuffer;
+    std::unique_ptr<GraphicsPipeline> pipeline;
+    std::unique_ptr<CommandBufferManager> commandBuffers;
+    std::unique_ptr<FrameCapture> readback;
+    std::unique_ptr<DeletionQueue> deletionQueue;
+    std::vector<uint64_t> slotValues;
+    uint32_t nextSlot = 0;
+
+    std::vector<RenderTarget> targets;
+    std::deque<RenderJob> queue;
+    std::unordered_map<std::string, SceneDesc> scenes;
+    RenderQueue renderQueue;
+    uint64_t targetsCreated = 0;
+// --------------------------------------------------------------------------------
+
+    /**
+     * @brief Returns the cached scene, loading it on first use
+     */
+    const SceneDesc& getScene(const std::string& path);
+// --------------------------------------------------------------------------------
+
+    /**
+     * @brief Returns an idle target of the given size, reusing a pooled image
+     * when one matches and replacing the least recently used one otherwise
+     */
+    RenderTarget& acquireTarget(VkExtent2D extent);
+// --------------------------------------------------------------------------------
+
+    void createTarget(RenderTarget& target, VkExtent2D extent);
+// --------------------------------------------------------------------------------
+
+    void destroyTarget(RenderTarget& target);
+// --------------------------------------------------------------------------------
+
+    /**
+     * @brief Records the scene into a target and the copy of the target into
+     * a readback slot
+     */
+    void recordJob(VkCommandBuffer commandBuffer, const RenderJob& job, const SceneDesc& scene, RenderTarget& target);
+};
+// ================================================================================
+// ================================================================================
+
+#endif /* batch_renderer_HPP */
+// ================================================================================
+// ================================================================================
+// eof
@@ -0,0 +1,308 @@
+// ================================================================================
+// ================================================================================
+// - File:    buffers.hpp
+// - Purpose: This file contains helper functions and classes for creating and
+//            sub-allocating Vulkan buffers
+//
+// Source Metadata
+// - Author:  Jonathan A. Webb
+// - Date:    October 18, 2026
+// - Version: 1.0
+// - Copyright: Copyright 2022, Jon Webb Inc.
+// ================================================================================
+// ================================================================================
+// Include modules here
+
+#ifndef buffers_HPP
+#define buffers_HPP
+
+#include <vulkan/vulkan.h>
+#include <vector>
+#include <cstring>
+// ================================================================================
+// ================================================================================
+
+/**
+ * @brief Finds a memory type that satisfies both a type filter and a set of properties
+ *
+ * @param physicalDevice The physical device that will own the memory
+ * @param typeFilter A bit field of acceptable memory types, typically taken from
+ *                   VkMemoryRequirements::memoryTypeBits
+ * @param properties The memory properties that the memory type must have
+ * @return The index of the first memory type that satisfies the request
+ */
+uint32_t findMemoryType(VkPhysicalDevice physicalDevice,
+                        uint32_t typeFilter,
+                        VkMemoryPropertyFlags properties);
+// --------------------------------------------------------------------------------
+
+/**
+ * @brief Creates a buffer and binds it to a freshly allocated block of device memory
+ *
+ * @param device The logical device
+ * @param physicalDevice The physical device used to select the memory type
+ * @param size The size of the buffer in bytes
+ * @param usage The usage flags of the buffer
+ * @param properties The required memory properties
+ * @param buffer Where the buffer handle will be stored
+ * @param bufferMemory Where the memory handle will be stored
+ */
+void createBuffer(VkDevice device,
+                  VkPhysicalDevice physicalDevice,
+                  VkDeviceSize size,
+                  VkBufferUsageFlags usage,
+                  VkMemoryPropertyFlags properties,
+                  VkBuffer& buffer,
+                  VkDeviceMemory& bufferMemory);
+// --------------------------------------------------------------------------------
+
+/**
+ * @brief The largest alignment a StagingRing allocation may request.  The ring
+ * size is rounded up to a multiple of it.
+ */
+const VkDeviceSize STAGING_RING_MAX_ALIGNMENT = 256;
+// ================================================================================
+// ================================================================================
+
+/**
+ * @brief Describes a single sub-allocation from the UniformRingBuffer
+ */
+struct UniformAllocation {
+    void* data;              ///< Host pointer to the start of the allocation
+    uint32_t dynamicOffset;  ///< The offset to pass to vkCmdBindDescriptorSets
+};
+// ================================================================================
+// ================================================================================
+
+/**
+ * @class UniformRingBuffer
+ * @brief A persistently mapped, host coherent uniform buffer with one region per
+ * frame in flight.
+ *
+ * Each frame linearly sub-allocates from its own region, and every allocation is
+ * aligned to minUniformBufferOffsetAlignment.  The buffer is exposed through a
+ * single VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC descriptor that is written once
+ * at construction, so per-draw data only requires a new dynamic offset instead
+ * of a new buffer or a call to vkUpdateDescriptorSets.
+ */
+class UniformRingBuffer {
+public:
+    /**
+     * @brief Constructs the ring buffer, its descriptor set layout and its descriptor set
+     *
+     * @param device The logical device
+     * @param physicalDevice The physical device used to query alignment limits
+     * @param frameRegionSize The number of bytes available to each frame
+     * @param framesInFlight The number of frame regions in the buffer
+     * @param maxAllocationSize The range of the dynamic descriptor, which is also
+     *                          the largest allocation that can be made
+     */
+    UniformRingBuffer(VkDevice device,
+                      VkPhysicalDevice physicalDevice,
+                      VkDeviceSize frameRegionSize,
+                      uint32_t framesInFlight,
+                      VkDeviceSize maxAllocationSize);
+// --------------------------------------------------------------------------------
+
+    /**
+     * @brief Unmaps and destroys the buffer and its descriptor objects
+     */
+    ~UniformRingBuffer();
+// --------------------------------------------------------------------------------
+
+    /**
+     * @brief Rewinds the region owned by a frame.
+     *
+     * The caller must ensure the GPU has finished with the previous use of this
+     * region, typically by waiting on the frame's timeline value.
+     *
+     * @param frameIndex The index of the frame in flight
+     */
+    void beginFrame(uint32_t frameIndex);
+// --------------------------------------------------------------------------------
+
+    /**
+     * @brief Sub-allocates an aligned block from the current frame region
+     *
+     * @param size The number of bytes to allocate
+     * @return The host pointer and the dynamic offset of the allocation
+     */
+    UniformAllocation allocate(VkDeviceSize size);
+// --------------------------------------------------------------------------------
+
+    /**
+     * @brief Copies a value into the current frame region
+     *
+     * @param value The data to copy
+     * @return The dynamic offset of the copied data
+     */
+    template <typename T>
+    uint32_t push(const T& value) {
+        UniformAllocation allocation = allocate(sizeof(T));
+        std::memcpy(allocation.data, &value, sizeof(T));
+        return allocation.dynamicOffset;
+    }
+// --------------------------------------------------------------------------------
+
+    /**
+     * @brief Binds the ring buffer descriptor set with a dynamic offset
+     *
+     * @param commandBuffer The command buffer being recorded
+     * @param layout A pipeline layout compatible with getDescriptorSetLayout()
+     * @param set The set number the ring buffer is bound to
+     * @param dynamicOffset An offset returned by allocate() or push()
+     */
+    void bind(VkCommandBuffer commandBuffer,
+              VkPipelineLayout layout,
+              uint32_t set,
+              uint32_t dynamicOffset) const;
+// --------------------------------------------------------------------------------
+
+    /**
+     * @brief Returns the descriptor set layout containing the dynamic uniform binding
+     */
+    VkDescriptorSetLayout getDescriptorSetLayout() const;
+// --------------------------------------------------------------------------------
+
+    /**
+     * @brief Returns the descriptor set that points at the ring buffer
+     */
+    VkDescriptorSet getDescriptorSet() const;
+// --------------------------------------------------------------------------------
+
+    /**
+     * @brief Returns the alignment applied to every allocation
+     */
+    VkDeviceSize getAlignment() const;
+// --------------------------------------------------------------------------------
+
+    /**
+     * @brief Returns the number of bytes used in the current frame region
+     */
+    VkDeviceSize getBytesUsed() const;
+// ================================================================================
+private:
+    VkDevice device;
+    VkPhysicalDevice physicalDevice;
+    VkDeviceSize frameRegionSize;
+    uint32_t framesInFlight;
+    VkDeviceSize maxAllocationSize;
+    VkDeviceSize alignment;
+
+    VkBuffer buffer = VK_NULL_HANDLE;
+    VkDeviceMemory bufferMemory = VK_NULL_HANDLE;
+    char* mapped = nullptr;
+
+    VkDescriptorSetLayout descriptorSetLayout = VK_NULL_HANDLE;
+    VkDescriptorPool descriptorPool = VK_NULL_HANDLE;
+    VkDescriptorSet descriptorSet = VK_NULL_HANDLE;
+
+    VkDeviceSize regionBegin = 0;
+    VkDeviceSize head = 0;
+// --------------------------------------------------------------------------------
+
+    /**
+     * @brief Creates and persistently maps the backing buffer
+     */
+    void createRingBuffer();
+// --------------------------------------------------------------------------------
+
+    /**
+     * @brief Creates the descriptor set layout, pool and set and writes the
+     * descriptor once
+     */
+    void createDescriptors();
+};
+// ================================================================================
+// ================================================================================
+
+/**
+ * @brief Describes a single sub-allocation from the StagingRing
+ */
+struct StagingAllocation {
+    void* data;           ///< Host pointer to the start of the allocation
+    VkDeviceSize offset;  ///< The offset of the allocation in getBuffer()
+};
+// ================================================================================
+// ================================================================================
+
+/**
+ * @class StagingRing
+ * @brief A persistently mapped, host coherent transfer source buffer that is
+ * sub-allocated as a ring.
+ *
+ * Allocations are carved from the head in order and never straddle the end of
+ * the buffer.  Positions returned by getHead() are monotonic, so the owner can
+ * record the head when it submits a batch of copies and pass it to release()
+ * once that batch's timeline value has signaled.  Everything allocated before the
+ * recorded position then becomes available again.
+ */
+class StagingRing {
+public:
+    /**
+     * @brief Creates and maps the staging buffer
+     *
+     * @param device The logical device
+     * @param physicalDevice The physical device used to select the memory type
+     * @param size The capacity of the ring in bytes
+     */
+    StagingRing(VkDevice device, VkPhysicalDevice physicalDevice, VkDeviceSize size);
+// --------------------------------------------------------------------------------
+
+    /**
+     * @brief Unmaps and destroys the buffer.  The GPU must be done with it.
+     */
+    ~StagingRing();
+// --------------------------------------------------------------------------------
+
+    /**
+     * @brief Allocates an aligned block
+     *
+     * @param size The number of bytes to allocate
+     * @param alignment A power of two no larger than STAGING_RING_MAX_ALIGNMENT
+     * @param allocation Receives the host pointer and buffer offset
+     * @return false if the ring does not have room until more is released
+     */
+    bool allocate(VkDeviceSize size, VkDeviceSize alignment, StagingAllocation& allocation);
+// --------------------------------------------------------------------------------
+
+    /**
+     * @brief Returns the position just past the most recent allocation
+     */
+    uint64_t getHead() const;
+// --------------------------------------------------------------------------------
+
+    /**
+     * @brief Makes every allocation made before a position returned by
+     * getHead() available again
+     */
+    void release(uint64_t position);
+// --------------------------------------------------------------------------------
+
+    VkBuffer getBuffer() const;
+// --------------------------------------------------------------------------------
+
+    VkDeviceSize getSize() const;
+// --------------------------------------------------------------------------------
+
+    /**
+     * @brief Returns the number of bytes allocated and not yet released
+     */
+    VkDeviceSize getBytesInUse() const;
+// ================================================================================
+private:
+    VkDevice device;
+    VkDeviceSize size;
+    VkBuffer buffer = VK_NULL_HANDLE;
+    VkDeviceMemory bufferMemory = VK_NULL_HANDLE;
+    char* mapped = nullptr;
+    uint64_t head = 0;
+    uint64_t tail = 0;
+};
+// ================================================================================
+// ================================================================================
+
+#endif /* buffers_HPP */
+// ================================================================================
+// ================================================================================
+// eof
@@ -0,0 +1,92 @@
+// ================================================================================
+// ================================================================================
+// - File:    command_buffers.hpp
+// - Purpose: This file contains a class that manages the command pool and the
+//            command buffers used to record each frame
+//
+// Source Metadata
+// - Author:  Jonathan A. Webb
+// - Date:    October 18, 2026
+// - Version: 1.0
+// - Copyright: Copyright 2022, Jon Webb Inc.
+// ================================================================================
+// ================================================================================
+// Include modules here
+
+#ifndef command_buffers_HPP
+#define command_buffers_HPP
+
+#include <vulkan/vulkan.h>
+#include <vector>
+// ================================================================================
+// ================================================================================
+
+/**
+ * @class CommandBufferManager
+ * @brief Owns a command pool on one queue family, the graphics family by
+ * default, and a set of primary command buffers allocated from it.
+ */
+class CommandBufferManager {
+public:
+    /**
+     * @brief Creates the command pool and allocates the command buffers
+     *
+     * @param device The logical device
+     * @param physicalDevice The physical device used to find the graphics queue family
+     * @param surface The surface used to find the queue families
+     * @param count The number of command buffers to allocate
+     */
+    CommandBufferManager(VkDevice device,
+                         VkPhysicalDevice physicalDevice,
+                         VkSurfaceKHR surface,
+                         uint32_t count);
+// --------------------------------------------------------------------------------
+
+    /**
+     * @brief Creates the command pool on an explicit queue family
+     *
+     * @param device The logical device
+     * @param queueFamilyIndex The queue family the command buffers are submitted to
+     * @param count The number of command buffers to allocate
+     */
+    CommandBufferManager(VkDevice device,
+                         uint32_t queueFamilyIndex,
+                         uint32_t count);
+// --------------------------------------------------------------------------------
+
+    /**
+     * @brief Destroys the command pool, which frees its command buffers
+     */
+    ~CommandBufferManager();
+// --------------------------------------------------------------------------------
+
+    /**
+     * @brief Returns the command buffer at the given index
+     */
+    VkCommandBuffer getCommandBuffer(uint32_t index) const;
+// --------------------------------------------------------------------------------
+
+    /**
+     * @brief Returns the command pool
+     */
+    VkCommandPool getCommandPool() const;
+// ================================================================================
+private:
+    VkDevice device;
+    uint32_t queueFamilyIndex;
+    VkCommandPool commandPool = VK_NULL_HANDLE;
+    std::vector<VkCommandBuffer> commandBuffers;
+// --------------------------------------------------------------------------------
+
+    void createCommandPool();
+// --------------------------------------------------------------------------------
+
+    void createCommandBuffers(uint32_t count);
+};
+// ================================================================================
+// ================================================================================
+
+#endif /* command_buffers_HPP */
+// ================================================================================
+// ================================================================================
+// eof
@@ -0,0 +1,85 @@
+// ================================================================================
+// ================================================================================
+// - File:    compute_pipeline.hpp
+// - Purpose: This file contains the compute counterpart of GraphicsPipeline
+//
+// Source Metadata
+// - Author:  Jonathan A. Webb
+// - Date:    October 18, 2026
+// - Version: 1.0
+// - Copyright: Copyright 2022, Jon Webb Inc.
+// ================================================================================
+// ================================================================================
+// Include modules here
+
+#ifndef compute_pipeline_HPP
+#define compute_pipeline_HPP
+
+#include <vulkan/vulkan.h>
+#include "pipeline_cache.hpp"
+#include <string>
+#include <vector>
+// ================================================================================
+// ================================================================================
+
+/**
+ * @class ComputePipeline
+ * @brief Owns the layout of a compute pipeline and requests the pipeline itself
+ * from a PipelineStateCache, following the same lifecycle as GraphicsPipeline.
+ */
+class ComputePipeline {
+public:
+    /**
+     * @brief Creates the pipeline layout and requests the compute pipeline
+     *
+     * @param device The logical device
+     * @param computeShader The path to the SPIR-V compute shader
+     * @param descriptorSetLayouts The layouts bound at sets 0 and up
+     * @param pushConstantSize The size of the push constant block visible to
+     *                         the compute stage, or zero for none
+     * @param pipelineCache The cache that compiles and owns the pipeline
+     */
+    ComputePipeline(VkDevice device,
+                    const std::string& computeShader,
+                    const std::vector<VkDescriptorSetLayout>& descriptorSetLayouts,
+                    uint32_t pushConstantSize,
+                    PipelineStateCache& pipelineCache);
+// --------------------------------------------------------------------------------
+
+    ~ComputePipeline();
+// --------------------------------------------------------------------------------
+
+    ComputePipeline(const ComputePipeline&) = delete;
+    ComputePipeline& operator=(const ComputePipeline&) = delete;
+// --------------------------------------------------------------------------------
+
+    VkPipeline getPipeline() const;
+// --------------------------------------------------------------------------------
+
+    VkPipelineLayout getPipelineLayout() const;
+// --------------------------------------------------------------------------------
+
+    /**
+     * @brief Requests the pipeline from the cache again, picking up a version
+     * swapped in by PipelineStateCache::swapRebuiltPipelines()
+     */
+    void refreshPipeline();
+// ================================================================================
+private:
+    VkDevice device;
+    PipelineStateCache& pipelineCache;
+    std::string computeShader;
+    VkPipeline computePipeline = VK_NULL_HANDLE;
+    VkPipelineLayout pipelineLayout = VK_NULL_HANDLE;
+// --------------------------------------------------------------------------------
+
+    void createPipelineLayout(const std::vector<VkDescriptorSetLayout>& descriptorSetLayouts,
+                              uint32_t pushConstantSize);
+};
+// ================================================================================
+// ================================================================================
+
+#endif /* compute_pipeline_HPP */
+// ================================================================================
+// ================================================================================
+// eof
@@ -1,14 +1,348 @@
 #ifndef vulkan_constants_HPP
-#define vulkan_constants_HPP 
+#define vulkan_constants_HPP
 
 #include <vector>
 #include <vulkan/vulkan.hpp>
+#include "device_features.hpp"
+#include "allocation_tracker.hpp"
 // ================================================================================
 // ================================================================================
 
 const std::vector<const char*> deviceExtensions = {
     VK_KHR_SWAPCHAIN_EXTENSION_NAME
 };
+// --------------------------------------------------------------------------------
+
+/**
+ * @brief Device extensions the headless batch renderer needs.  Nothing is
+ * presented, so the swap chain extension is not required.
+ */
+const std::vector<const char*> headlessDeviceExtensions = {};
+// --------------------------------------------------------------------------------
+
+/**
+ * @brief Device extensions that are enabled when the device supports them
+ */
+const std::vector<const char*> optionalDeviceExtensions = {
+    VK_EXT_MEMORY_BUDGET_EXTENSION_NAME,
+    VK_EXT_MEMORY_PRIORITY_EXTENSION_NAME
+};
+// --------------------------------------------------------------------------------
+
+/**
+ * @brief Device features the renderer cannot run without.  Devices lacking any
+ * of them are skipped during physical device selection.
+ */
+const std::vector<DeviceFeature> requiredDeviceFeatures = {
+    DeviceFeature::TimelineSemaphore,
+    DeviceFeature::Synchronization2
+};
+// --------------------------------------------------------------------------------
+
+/**
+ * @brief Device features that are enabled when supported.  Each one is reported
+ * through DeviceCapabilities so the code using it can fall back without it.
+ */
+const std::vector<DeviceFeature> optionalDeviceFeatures = {
+    DeviceFeature::TextureCompressionBC,
+    DeviceFeature::DescriptorIndexing,
+    DeviceFeature::PipelineCreationCacheControl,
+    DeviceFeature::MemoryPriority,
+    DeviceFeature::Multiview
+};
+// --------------------------------------------------------------------------------
+
+/**
+ * @brief The number of frames the CPU may record ahead of the GPU
+ */
+const uint32_t MAX_FRAMES_IN_FLIGHT = 2;
+// --------------------------------------------------------------------------------
+
+/**
+ * @brief The number of bytes reserved for each frame in the uniform ring buffer
+ */
+const VkDeviceSize UNIFORM_RING_FRAME_SIZE = 64 * 1024;
+// --------------------------------------------------------------------------------
+
+/**
+ * @brief The largest single allocation that can be bound through the dynamic
+ * uniform buffer descriptor
+ */
+const VkDeviceSize UNIFORM_RING_MAX_ALLOCATION = 256;
+// --------------------------------------------------------------------------------
+
+/**
+ * @brief When true, one command buffer per swap chain image is recorded once and
+ * resubmitted until the frame is marked dirty
+ */
+const bool ENABLE_STATIC_FRAMES = true;
+// --------------------------------------------------------------------------------
+
+/**
+ * @brief The frame rate the frame limiter paces presentation to.  Zero disables
+ * the limiter.
+ */
+const double TARGET_FPS = 60.0;
+// --------------------------------------------------------------------------------
+
+/**
+ * @brief The portion of each frame wait, in microseconds, that is spun rather
+ * than slept to absorb scheduler wake-up latency
+ */
+const int64_t FRAME_LIMITER_SPIN_MICROSECONDS = 2000;
+// --------------------------------------------------------------------------------
+
+/**
+ * @brief How long, in seconds, a minimized window sleeps waiting for events
+ * before checking its state again
+ */
+const double IDLE_EVENT_TIMEOUT = 0.25;
+// --------------------------------------------------------------------------------
+
+/**
+ * @brief How long, in milliseconds, the render thread sleeps between checks of
+ * the event queue while there is nothing to render
+ */
+const int64_t RENDER_IDLE_SLEEP_MILLISECONDS = 10;
+// --------------------------------------------------------------------------------
+
+/**
+ * @brief When true, every Vulkan object is created with instrumented allocation
+ * callbacks and a report of driver host allocations is printed at shutdown
+ */
+const bool ENABLE_HOST_ALLOCATION_TRACKING = true;
+// --------------------------------------------------------------------------------
+
+/**
+ * @brief When true, small COMMAND and OBJECT scope host allocations are served
+ * from thread-local pools rather than malloc
+ */
+const bool HOST_ALLOCATOR_USE_POOLS = true;
+// --------------------------------------------------------------------------------
+
+/**
+ * @brief The number of frames between queries of the device memory budget
+ */
+const uint64_t RESIDENCY_BUDGET_POLL_FRAMES = 30;
+// --------------------------------------------------------------------------------
+
+/**
+ * @brief The fraction of each heap's budget the residency manager fills before
+ * it starts evicting, leaving headroom for driver and swap chain allocations
+ */
+const double RESIDENCY_BUDGET_HEADROOM = 0.9;
+// --------------------------------------------------------------------------------
+
+/**
+ * @brief The fraction of each heap assumed to be available when
+ * VK_EXT_memory_budget is not supported
+ */
+const double RESIDENCY_FALLBACK_BUDGET_FRACTION = 0.8;
+// --------------------------------------------------------------------------------
+
+/**
+ * @brief The device memory, in bytes, streamed textures may occupy in total
+ */
+const VkDeviceSize TEXTURE_STREAMING_BUDGET = 256 * 1024 * 1024;
+// --------------------------------------------------------------------------------
+
+/**
+ * @brief Mip levels no larger than this many pixels on a side form a texture's
+ * tail, which is uploaded first and stays resident while the texture exists
+ */
+const uint32_t TEXTURE_STREAMING_TAIL_SIZE = 64;
+// --------------------------------------------------------------------------------
+
+/**
+ * @brief The capacity of the staging ring textures are uploaded through.  It
+ * also caps the resolution a texture can be streamed at.
+ */
+const VkDeviceSize TEXTURE_STAGING_RING_SIZE = 32 * 1024 * 1024;
+// --------------------------------------------------------------------------------
+
+/**
+ * @brief The number of upload batches that may be in flight on the transfer
+ * queue at once
+ */
+const uint32_t TEXTURE_UPLOAD_BATCH_COUNT = 3;
+// --------------------------------------------------------------------------------
+
+/**
+ * @brief The capacity of the staging ring buffer writes are uploaded through.
+ * Writes that do not fit wait for the batches of earlier frames to retire.
+ */
+const VkDeviceSize UPLOAD_STAGING_RING_SIZE = 4 * 1024 * 1024;
+// --------------------------------------------------------------------------------
+
+/**
+ * @brief The number of buffer upload batches that may be in flight.  One more
+ * than the frames in flight, so a frame always finds a free batch.
+ */
+const uint32_t UPLOAD_BATCH_COUNT = MAX_FRAMES_IN_FLIGHT + 1;
+// --------------------------------------------------------------------------------
+
+/**
+ * @brief The number of mip chains that may be read from disk at once
+ */
+const uint32_t TEXTURE_STREAMING_MAX_PENDING_LOADS = 4;
+// --------------------------------------------------------------------------------
+
+/**
+ * @brief When true, a GPU particle simulation runs on the compute queue and is
+ * drawn over the triangle.  Every frame then changes, so static frames are not
+ * replayed while it runs.
+ */
+const bool ENABLE_PARTICLE_SIMULATION = false;
+// --------------------------------------------------------------------------------
+
+/**
+ * @brief The number of particles simulated when ENABLE_PARTICLE_SIMULATION is set
+ */
+const uint32_t PARTICLE_COUNT = 1u << 20;
+// --------------------------------------------------------------------------------
+
+/**
+ * @brief The invocations per workgroup of particles.comp; must match its
+ * local_size_x
+ */
+const uint32_t PARTICLE_WORKGROUP_SIZE = 256;
+// --------------------------------------------------------------------------------
+
+/**
+ * @brief When true, the scene is rendered into an offscreen image that is copied
+ * to the swap chain image each frame.  The offscreen image can be captured
+ * whether or not the surface allows swap chain images to be read.
+ */
+const bool ENABLE_OFFSCREEN_RENDERING = false;
+// --------------------------------------------------------------------------------
+
+/**
+ * @brief When true, swap chain images are created with transfer source usage
+ * when the surface supports it, so frames can be captured straight from the
+ * backbuffer.  The extra usage may disable compression on some drivers.
+ */
+const bool ENABLE_SWAPCHAIN_CAPTURE = true;
+// --------------------------------------------------------------------------------
+
+/**
+ * @brief The number of views rendered in one pass with multiview.  One renders
+ * a single view; two renders a stereo pair side by side; three or four render
+ * split-screen quadrants.  The views are drawn into the layers of one image and
+ * tiled into the swap chain image.  Falls back to one view when the device
+ * lacks the multiview feature or the surface cannot be copied to.
+ */
+const uint32_t MULTIVIEW_VIEW_COUNT = 1;
+// --------------------------------------------------------------------------------
+
+/**
+ * @brief The horizontal offset between the eyes of a stereo pair, in clip space
+ */
+const float STEREO_EYE_SEPARATION = 0.06f;
+// --------------------------------------------------------------------------------
+
+/**
+ * @brief The number of readback buffers captured frames rotate through.  A frame
+ * is dropped rather than stalling the GPU when every buffer is still in flight
+ * or being encoded.
+ */
+const uint32_t FRAME_CAPTURE_SLOT_COUNT = 3;
+// --------------------------------------------------------------------------------
+
+/**
+ * @brief The number of jobs the batch renderer keeps on the GPU at once
+ */
+const uint32_t BATCH_JOBS_IN_FLIGHT = 3;
+// --------------------------------------------------------------------------------
+
+/**
+ * @brief The most offscreen images the batch renderer keeps for reuse.  Jobs of
+ * more distinct sizes than this recreate images as they alternate.
+ */
+const uint32_t BATCH_TARGET_POOL_SIZE = 6;
+// --------------------------------------------------------------------------------
+
+/**
+ * @brief The number of batch images that may be read back or encoded at once.
+ * Rendering waits for a free buffer when the encoders fall behind.
+ */
+const uint32_t BATCH_READBACK_SLOTS = 6;
+// --------------------------------------------------------------------------------
+
+/**
+ * @brief The format batch jobs are rendered in, which FrameCapture writes as is
+ */
+const VkFormat BATCH_RENDER_FORMAT = VK_FORMAT_R8G8B8A8_UNORM;
+// --------------------------------------------------------------------------------
+
+/**
+ * @brief The initial size of the arena that per-frame scratch data is taken
+ * from.  A frame that needs more grows it once, so this only sets the size
+ * at startup.
+ */
+const size_t FRAME_ARENA_SIZE = 64 * 1024;
+// --------------------------------------------------------------------------------
+
+/**
+ * @brief The frames drawn before the allocation budget applies, which covers
+ * caches and arrays reaching their steady-state size
+ */
+const uint64_t ALLOCATION_WARMUP_FRAMES = 120;
+// --------------------------------------------------------------------------------
+
+/**
+ * @brief The heap allocations a frame may make after warm-up, and what happens
+ * when it makes more.  Only checked when built with TRACK_ALLOCATIONS.
+ */
+const uint64_t FRAME_ALLOCATION_BUDGET = 0;
+const AllocationViolation FRAME_ALLOCATION_VIOLATION = AllocationViolation::Log;
+// --------------------------------------------------------------------------------
+
+/**
+ * @brief The file the driver pipeline cache is loaded from at startup and saved
+ * to at shutdown, relative to the working directory
+ */
+const char* const PIPELINE_CACHE_FILE = "pipeline_cache.bin";
+// --------------------------------------------------------------------------------
+
+/**
+ * @brief When true, GLSL files in SHADER_SOURCE_DIRECTORY are recompiled when
+ * they are saved and the pipelines using them are rebuilt in the background
+ */
+const bool ENABLE_SHADER_HOT_RELOAD = true;
+// --------------------------------------------------------------------------------
+
+/**
+ * @brief The directory of GLSL sources watched for shader changes.  The build
+ * passes its absolute path; otherwise it is relative to the working directory.
+ */
+#ifdef SHADER_SOURCE_DIR
+const char* const SHADER_SOURCE_DIRECTORY = SHADER_SOURCE_DIR;
+#else
+const char* const SHADER_SOURCE_DIRECTORY = "../../shaders";
+#endif
+// --------------------------------------------------------------------------------
+
+/**
+ * @brief The directory the build compiles every shader variant into, which the
+ * pipelines load from and hot reload writes to.  The build passes its absolute
+ * path; otherwise it is relative to the working directory.
+ */
+#ifdef SHADER_BINARY_DIR
+const char* const SHADER_BINARY_DIRECTORY = SHADER_BINARY_DIR;
+#else
+const char* const SHADER_BINARY_DIRECTORY = "shaders";
+#endif
+// --------------------------------------------------------------------------------
+
+/**
+ * @brief The compiler run on a changed shader.  The build passes the
+ * glslangValidator it found; otherwise it is looked up on the PATH.
+ */
+#ifdef GLSLANG_VALIDATOR_PATH
+const char* const SHADER_COMPILER = GLSLANG_VALIDATOR_PATH;
+#else
+const char* const SHADER_COMPILER = "glslangValidator";
+#endif
 // ================================================================================
 // ================================================================================
 #endif /* vulkan_constants_HPP */
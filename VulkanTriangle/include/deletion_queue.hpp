@@ -0,0 +1,155 @@
+// ================================================================================
+// ================================================================================
+// - File:    deletion_queue.hpp
+// - Purpose: This file contains a queue that defers the destruction of Vulkan
+//            objects until the GPU has finished the work that used them
+//
+// Source Metadata
+// - Author:  Jonathan A. Webb
+// - Date:    October 18, 2026
+// - Version: 1.0
+// - Copyright: Copyright 2022, Jon Webb Inc.
+// ================================================================================
+// ================================================================================
+// Include modules here
+
+#ifndef deletion_queue_HPP
+#define deletion_queue_HPP
+
+#include <vulkan/vulkan.h>
+#include "synchronization.hpp"
+#include <cstdint>
+#include <memory>
+#include <memory_resource>
+#include <vector>
+// ================================================================================
+// ================================================================================
+
+/**
+ * @class DeletionQueue
+ * @brief Destroys objects once a timeline has passed the value of their last use.
+ *
+ * Objects replaced while frames are in flight, such as the swap chain and its
+ * views on a resize, are handed to the queue instead of being destroyed after
+ * a vkDeviceWaitIdle.  Each entry carries the timeline value of the last
+ * submission that may use it, by default every submission made so far, and
+ * collect() destroys the entries the GPU has passed.
+ *
+ * Raw handles are destroyed according to their VkObjectType.  Objects that
+ * own several handles are passed as a std::unique_ptr and their destructor
+ * runs instead.  Every member function must be called from the thread that
+ * submits to the timeline's queue.
+ */
+class DeletionQueue {
+public:
+    /**
+     * @param device The logical device the objects belong to
+     * @param timeline The timeline the last-use values refer to
+     */
+    DeletionQueue(VkDevice device, const TimelineSemaphore& timeline);
+// --------------------------------------------------------------------------------
+
+    /**
+     * @brief Destroys every remaining entry.  The GPU must be idle.
+     */
+    ~DeletionQueue();
+// --------------------------------------------------------------------------------
+
+    DeletionQueue(const DeletionQueue&) = delete;
+    DeletionQueue& operator=(const DeletionQueue&) = delete;
+// --------------------------------------------------------------------------------
+
+    /**
+     * @brief Destroys a handle once the GPU has passed a timeline value
+     *
+     * @param type The type of the handle, which selects the vkDestroy function
+     * @param handle The handle to destroy; VK_NULL_HANDLE is ignored
+     * @param lastUse The value signaled by the last submission that uses the handle
+     */
+    template <typename Handle>
+    void destroy(VkObjectType type, Handle handle, uint64_t lastUse) {
+        // Non-dispatchable handles are pointers on 64-bit platforms and
+        // integers elsewhere, and both convert with a C-style cast
+        push(type, (uint64_t)handle, lastUse);
+    }
+// --------------------------------------------------------------------------------
+
+    /**
+     * @brief Destroys a handle once every submission made so far has finished
+     */
+    template <typename Handle>
+    void destroy(VkObjectType type, Handle handle) {
+        destroy(type, handle, timeline.getPendingValue());
+    }
+// --------------------------------------------------------------------------------
+
+    /**
+     * @brief Runs an object's destructor once the GPU has passed a timeline value
+     */
+    template <typename T>
+    void release(std::unique_ptr<T> object, uint64_t lastUse) {
+        if (object) {
+            entries.push_back({lastUse, VK_OBJECT_TYPE_UNKNOWN, 0, std::shared_ptr<void>(std::move(object))});
+        }
+    }
+// --------------------------------------------------------------------------------
+
+    /**
+     * @brief Runs an object's destructor once every submission made so far has
+     * finished
+     */
+    template <typename T>
+    void release(std::unique_ptr<T> object) {
+        release(std::move(object), timeline.getPendingValue());
+    }
+// --------------------------------------------------------------------------------
+
+    /**
+     * @brief Destroys the entries the GPU has finished with.  Call once per
+     * frame; it only queries the timeline when something is queued.
+     *
+     * @param scratch Memory for the list of finished entries, such as a
+     *        FrameArena
+     */
+    void collect(std::pmr::memory_resource* scratch = std::pmr::get_default_resource());
+// --------------------------------------------------------------------------------
+
+    /**
+     * @brief Returns the number of entries waiting to be destroyed
+     */
+    size_t size() const;
+// ================================================================================
+private:
+    struct Entry {
+        uint64_t lastUse;
+        VkObjectType type;
+        uint64_t handle;
+        std::shared_ptr<void> owner;
+    };
+// --------------------------------------------------------------------------------
+
+    VkDevice device;
+    const TimelineSemaphore& timeline;
+    std::vector<Entry> entries;
+// --------------------------------------------------------------------------------
+
+    /**
+     * @brief Queues a raw handle
+     *
+     * @throws std::runtime_error if the type has no deferred destroy function
+     */
+    void push(VkObjectType type, uint64_t handle, uint64_t lastUse);
+// --------------------------------------------------------------------------------
+
+    /**
+     * @brief Destroys an entry's handle or releases its owner
+     */
+    void destroyEntry(Entry& entry);
+};
+// ================================================================================
+// ================================================================================
+
+#endif /* deletion_queue_HPP */
+// ================================================================================
+// ================================================================================
+// eof
@@ -0,0 +1,145 @@
+// ================================================================================
+// ================================================================================
+// - File:    device_features.hpp
+// - Purpose: This file contains the device features the renderer can use and a
+//            class that negotiates them through the pNext feature chains
+//
+// Source Metadata
+// - Author:  Jonathan A. Webb
+// - Date:    October 18, 2026
+// - Version: 1.0
+// - Copyright: Copyright 2022, Jon Webb Inc.
+// ================================================================================
+// ================================================================================
+// Include modules here
+
+#ifndef device_features_HPP
+#define device_features_HPP
+
+#include <vulkan/vulkan.h>
+#include <vector>
+// ================================================================================
+// ================================================================================
+
+/**
+ * @brief A device capability that is enabled through a feature structure.  Some
+ * map to several feature bits, which are only enabled together.
+ */
+enum class DeviceFeature {
+    TextureCompressionBC,          // BC1-BC7 textures
+    TimelineSemaphore,             // Timeline semaphores for queue and frame sync
+    Synchronization2,              // vkCmdPipelineBarrier2 and vkQueueSubmit2
+    DescriptorIndexing,            // Partially bound, non-uniformly indexed image arrays
+    PipelineCreationCacheControl,  // Externally synchronized pipeline caches
+    MemoryPriority,                // Allocation priorities; needs VK_EXT_memory_priority
+    Multiview                      // Several views rendered by one render pass instance
+};
+// --------------------------------------------------------------------------------
+
+/**
+ * @brief Flags for every optional capability the logical device was created
+ * with.  Code checks these to switch its fast paths on.
+ */
+struct DeviceCapabilities {
+    bool textureCompressionBC = false;
+    bool timelineSemaphore = false;
+    bool synchronization2 = false;
+    bool descriptorIndexing = false;
+    bool pipelineCreationCacheControl = false;
+    bool memoryPriority = false;
+    bool memoryBudget = false;
+    bool multiview = false;
+};
+// ================================================================================
+// ================================================================================
+
+/**
+ * @class DeviceFeatureChain
+ * @brief Queries which features a physical device supports and builds the
+ * pNext chain that enables a chosen subset at device creation.
+ *
+ * Two copies of the same chain are kept: one filled by
+ * vkGetPhysicalDeviceFeatures2 and one holding only the bits that were
+ * enabled.  Structures that belong to an extension are only linked when the
+ * extension is in the list given to the constructor, so the chain never names
+ * a structure the driver is not expecting.
+ */
+class DeviceFeatureChain {
+public:
+    /**
+     * @brief Queries the supported features
+     *
+     * @param physicalDevice The physical device, which must support Vulkan 1.3
+     * @param extensions The device extensions that will be enabled
+     */
+    DeviceFeatureChain(VkPhysicalDevice physicalDevice, const std::vector<const char*>& extensions);
+// --------------------------------------------------------------------------------
+
+    DeviceFeatureChain(const DeviceFeatureChain&) = delete;
+    DeviceFeatureChain& operator=(const DeviceFeatureChain&) = delete;
+// --------------------------------------------------------------------------------
+
+    /**
+     * @brief Returns true if the device supports every bit of a feature
+     */
+    bool isSupported(DeviceFeature feature) const;
+// --------------------------------------------------------------------------------
+
+    /**
+     * @brief Enables a feature if it is supported
+     *
+     * @return True if the feature is now enabled
+     */
+    bool enable(DeviceFeature feature);
+// --------------------------------------------------------------------------------
+
+    bool isEnabled(DeviceFeature feature) const;
+// --------------------------------------------------------------------------------
+
+    /**
+     * @brief Returns the chain for VkDeviceCreateInfo::pNext.  It carries the
+     * core features too, so pEnabledFeatures must be null.
+     */
+    const void* getEnabledChain() const;
+// --------------------------------------------------------------------------------
+
+    /**
+     * @brief Returns a readable name for error messages and logs
+     */
+    static const char* getName(DeviceFeature feature);
+// ================================================================================
+private:
+    struct Chain {
+        VkPhysicalDeviceFeatures2 core{};
+        VkPhysicalDeviceVulkan11Features vulkan11{};
+        VkPhysicalDeviceVulkan12Features vulkan12{};
+        VkPhysicalDeviceVulkan13Features vulkan13{};
+        VkPhysicalDeviceMemoryPriorityFeaturesEXT memoryPriority{};
+    };
+
+    Chain supported;
+    Chain enabled;
+    bool memoryPriorityLinked = false;
+// --------------------------------------------------------------------------------
+
+    void link(Chain& chain) const;
+// --------------------------------------------------------------------------------
+
+    /**
+     * @brief Returns the bits of a chain that make up a feature, or nothing if
+     * the structure holding them is not linked.  ChainType is Chain or const
+     * Chain, and Bool carries the matching constness.
+     */
+    template <typename ChainType, typename Bool>
+    std::vector<Bool*> fieldsOf(ChainType& chain, DeviceFeature feature) const;
+// --------------------------------------------------------------------------------
+
+    static bool allSet(const std::vector<const VkBool32*>& fields);
+};
+// ================================================================================
+// ================================================================================
+
+#endif /* device_features_HPP */
+// ================================================================================
+// ================================================================================
+// eof
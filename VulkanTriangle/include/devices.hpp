@@ -17,6 +17,9 @@
 
 #include <vulkan/vulkan.h>
 #include "queues.hpp"
+#include "synchronization.hpp"
+#include "deletion_queue.hpp"
+#include "device_features.hpp"
 #include "window.hpp"
 #include <memory>
 #include <vector>
@@ -39,8 +42,13 @@ public:
      * from the available devices that support Vulkan.
      * 
      * @param instance A reference to the Vulkan instance.
+     * @param surface The surface to present to, or VK_NULL_HANDLE for a
+     *        headless device, which skips the swap chain checks
+     * @param extensions The device extensions the device must support
      */
-    VulkanPhysicalDevice(VkInstance& instance, VkSurfaceKHR surface);
+    VulkanPhysicalDevice(VkInstance& instance,
+                         VkSurfaceKHR surface,
+                         const std::vector<const char*>& extensions);
 // --------------------------------------------------------------------------------
 
     /**
@@ -55,6 +63,7 @@ private:
     VkPhysicalDevice physicalDevice = VK_NULL_HANDLE;
     VkInstance& instance;
     VkSurfaceKHR surface;
+    const std::vector<const char*>& extensions;
 // --------------------------------------------------------------------------------
     
     /**
@@ -89,12 +98,21 @@ public:
      * 
      * @param physicalDevice A reference to the Vulkan physical device.
      * @param validationLayers A vector containing the names of the validation layers to be enabled.
-     * @param surface A VkSurfaceKHR data type
+     * @param surface A VkSurfaceKHR data type, or VK_NULL_HANDLE for a device
+     *        that never presents
+     * @param deviceExtensions Extensions the device must support
+     * @param optionalExtensions Extensions that are enabled only if supported
+     * @param requiredFeatures Features the device must support
+     * @param optionalFeatures Features that are enabled only if supported
+     * @throws std::runtime_error if a required feature is missing
      */
     VulkanLogicalDevice(VkPhysicalDevice physicalDevice, 
                         const std::vector<const char*>& validationLayers,
                         VkSurfaceKHR surface,
-                        const std::vector<const char*>& deviceExtensions);
+                        const std::vector<const char*>& deviceExtensions,
+                        const std::vector<const char*>& optionalExtensions = {},
+                        const std::vector<DeviceFeature>& requiredFeatures = {},
+                        const std::vector<DeviceFeature>& optionalFeatures = {});
 // --------------------------------------------------------------------------------
     
     /**
@@ -127,15 +145,83 @@ public:
      * @return The vulkan queue handle
      */
     VkQueue getPresentQueue() const;
+// --------------------------------------------------------------------------------
+
+    /**
+     * @brief Retrieves the queue used for uploads.  This is the graphics queue
+     * when the device has no separate transfer family.
+     *
+     * @return The vulkan queue handle
+     */
+    VkQueue getTransferQueue() const;
+// --------------------------------------------------------------------------------
+
+    /**
+     * @brief Retrieves the queue used for async compute.  This is the graphics
+     * queue when the device has no separate compute family.
+     *
+     * @return The vulkan queue handle
+     */
+    VkQueue getComputeQueue() const;
+// --------------------------------------------------------------------------------
+
+    /**
+     * @brief Returns the timeline signaled by every submission to the graphics
+     * queue
+     */
+    TimelineSemaphore& getGraphicsTimeline() const;
+// --------------------------------------------------------------------------------
+
+    /**
+     * @brief Returns the timeline of the transfer queue.  This is the graphics
+     * timeline when both share a queue.
+     */
+    TimelineSemaphore& getTransferTimeline() const;
+// --------------------------------------------------------------------------------
+
+    /**
+     * @brief Returns the timeline of the compute queue.  This is the graphics
+     * timeline when both share a queue.
+     */
+    TimelineSemaphore& getComputeTimeline() const;
+// --------------------------------------------------------------------------------
+
+    /**
+     * @brief Returns the queue families the device was created with
+     */
+    const QueueFamilyIndices& getQueueFamilyIndices() const;
+// --------------------------------------------------------------------------------
+
+    /**
+     * @brief Returns the optional capabilities the device was created with
+     */
+    const DeviceCapabilities& getCapabilities() const;
+// --------------------------------------------------------------------------------
+
+    /**
+     * @brief Returns true if an extension, required or optional, was enabled
+     */
+    bool isExtensionEnabled(const char* name) const;
 // ================================================================================
 private:
     VkDevice device = VK_NULL_HANDLE;
     VkQueue graphicsQueue;
     VkQueue presentQueue;
+    VkQueue transferQueue;
+    VkQueue computeQueue;
+    QueueFamilyIndices queueFamilyIndices;
+    std::vector<std::unique_ptr<TimelineSemaphore>> timelines;
+    TimelineSemaphore* graphicsTimeline = nullptr;
+    TimelineSemaphore* transferTimeline = nullptr;
+    TimelineSemaphore* computeTimeline = nullptr;
     VkPhysicalDevice physicalDevice;  // Changed to reference
     const std::vector<const char*>& validationLayers;
     VkSurfaceKHR surface;
     const std::vector<const char*>& deviceExtensions; 
+    std::vector<const char*> enabledExtensions;
+    std::vector<DeviceFeature> requiredFeatures;
+    std::vector<DeviceFeature> optionalFeatures;
+    DeviceCapabilities capabilities;
 // --------------------------------------------------------------------------------
 
     /**
@@ -171,6 +257,13 @@ public:
     VkExtent2D getSwapChainExtent() const;
 // --------------------------------------------------------------------------------
 
+    /**
+     * @brief Returns the usage the swap chain images were created with.  Transfer
+     * source usage is only present when the surface supports it.
+     */
+    VkImageUsageFlags getSwapChainImageUsage() const;
+// --------------------------------------------------------------------------------
+
     const std::vector<VkImage>& getSwapChainImages() const;
 // --------------------------------------------------------------------------------
 
@@ -178,6 +271,19 @@ public:
 // --------------------------------------------------------------------------------
 
     static SwapChainSupportDetails querySwapChainSupport(VkPhysicalDevice device, VkSurfaceKHR surface);
+// --------------------------------------------------------------------------------
+
+    /**
+     * @brief Rebuilds the swap chain and its image views after a resize.
+     *
+     * The old swap chain is handed to the driver as oldSwapchain so resources can
+     * be recycled.  Frames in flight may still render to or present the old
+     * images, so the old swap chain and views are destroyed through the deletion
+     * queue.  The caller should evict anything that references the views first.
+     *
+     * @param deletionQueue The queue that destroys the old swap chain and views
+     */
+    void recreateSwapChain(DeletionQueue& deletionQueue);
 // ================================================================================
 private:
     VkDevice device;
@@ -188,6 +294,7 @@ private:
     VkSwapchainKHR swapChain = VK_NULL_HANDLE;
     VkFormat swapChainImageFormat;
     VkExtent2D swapChainExtent;
+    VkImageUsageFlags swapChainImageUsage = 0;
     std::vector<VkImage> swapChainImages;
     std::vector<VkImageView> swapChainImageViews;
 // --------------------------------------------------------------------------------
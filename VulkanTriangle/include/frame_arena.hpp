@@ -0,0 +1,101 @@
+// ================================================================================
+// ================================================================================
+// - File:    frame_arena.hpp
+// - Purpose: This file contains a bump allocator for CPU-side data that only
+//            lives for one frame
+//
+// Source Metadata
+// - Author:  Jonathan A. Webb
+// - Date:    October 18, 2026
+// - Version: 1.0
+// - Copyright: Copyright 2022, Jon Webb Inc.
+// ================================================================================
+// ================================================================================
+// Include modules here
+
+#ifndef frame_arena_HPP
+#define frame_arena_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <memory_resource>
+#include <vector>
+// ================================================================================
+// ================================================================================
+
+/**
+ * @brief Usage counters for a FrameArena
+ */
+struct FrameArenaStats {
+    size_t capacity = 0;           // Bytes reserved across every block
+    size_t frameBytes = 0;         // Bytes handed out since the last reset
+    size_t peakFrameBytes = 0;     // The most bytes handed out in one frame
+    uint64_t blockAllocations = 0; // Blocks requested from the heap, including the first
+};
+// --------------------------------------------------------------------------------
+
+/**
+ * @class FrameArena
+ * @brief A std::pmr::memory_resource that hands out memory by bumping a
+ * pointer, and takes it all back at once when the frame starts.
+ *
+ * Scratch containers on the per-frame path, such as std::pmr::vector, take
+ * the arena instead of the heap, so a frame in steady state never calls
+ * malloc.  Deallocation does nothing.  When a frame needs more than the
+ * current block, another block is allocated, and the next reset replaces all
+ * of them with one block large enough for the whole frame.
+ *
+ * Memory from the arena is only valid until the next reset().  The arena is
+ * not thread-safe; only the render thread may use it.
+ */
+class FrameArena : public std::pmr::memory_resource {
+public:
+    /**
+     * @param initialCapacity The size of the first block in bytes
+     */
+    explicit FrameArena(size_t initialCapacity);
+// --------------------------------------------------------------------------------
+
+    FrameArena(const FrameArena&) = delete;
+    FrameArena& operator=(const FrameArena&) = delete;
+// --------------------------------------------------------------------------------
+
+    /**
+     * @brief Releases everything handed out since the last reset.  Call at the
+     * start of each frame.
+     */
+    void reset();
+// --------------------------------------------------------------------------------
+
+    const FrameArenaStats& getStats() const;
+// ================================================================================
+private:
+    struct Block {
+        std::unique_ptr<std::byte[]> memory;
+        size_t size;
+    };
+
+    std::vector<Block> blocks;
+    size_t offset = 0;
+    FrameArenaStats stats;
+// --------------------------------------------------------------------------------
+
+    void addBlock(size_t size);
+// --------------------------------------------------------------------------------
+
+    void* do_allocate(size_t bytes, size_t alignment) override;
+// --------------------------------------------------------------------------------
+
+    void do_deallocate(void* pointer, size_t bytes, size_t alignment) override;
+// --------------------------------------------------------------------------------
+
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override;
+};
+// ================================================================================
+// ================================================================================
+
+#endif /* frame_arena_HPP */
+// ================================================================================
+// ================================================================================
+// eof
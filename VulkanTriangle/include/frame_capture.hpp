@@ -0,0 +1,257 @@
+// ================================================================================
+// ================================================================================
+// - File:    frame_capture.hpp
+// - Purpose: This file contains a class that copies rendered frames into a ring
+//            of host readable buffers and encodes them to image files on
+//            worker threads
+//
+// Source Metadata
+// - Author:  Jonathan A. Webb
+// - Date:    October 18, 2026
+// - Version: 1.0
+// - Copyright: Copyright 2022, Jon Webb Inc.
+// ================================================================================
+// ================================================================================
+// Include modules here
+
+#ifndef frame_capture_HPP
+#define frame_capture_HPP
+
+#include <vulkan/vulkan.h>
+#include "job_system.hpp"
+#include "synchronization.hpp"
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+// ================================================================================
+// ================================================================================
+
+/**
+ * @brief The file format captured frames are written in
+ */
+enum class CaptureFormat {
+    Png,  // Uncompressed PNG, readable by any image viewer
+    Raw   // Tightly packed RGBA8 with no header, the cheapest to write
+};
+// --------------------------------------------------------------------------------
+
+/**
+ * @brief Running totals reported by FrameCapture::getStats()
+ */
+struct FrameCaptureStats {
+    uint64_t framesRecorded = 0;  // Copies recorded into a readback buffer
+    uint64_t framesDropped = 0;   // Frames skipped because no buffer was free
+    uint64_t framesWritten = 0;   // Files written by the worker threads
+    uint64_t writeFailures = 0;   // Files that could not be written
+};
+// ================================================================================
+// ================================================================================
+
+/**
+ * @class FrameCapture
+ * @brief Reads rendered frames back to the CPU without stalling the GPU.
+ *
+ * Each captured frame is copied into one slot of a ring of host visible
+ * buffers, preferring host cached memory since the CPU reads every byte.  The
+ * slot is tagged with the graphics timeline value of the frame that copied
+ * into it, and poll() hands it to a worker thread once that value is reached.
+ * The worker converts the pixels to RGBA and writes the file; the slot is
+ * reused when the worker finishes.  Nothing ever waits on the GPU, so a frame
+ * that finds every slot busy is dropped and counted instead.
+ *
+ * Every method must be called from the render thread, or after it has stopped.
+ */
+class FrameCapture {
+public:
+    /**
+     * @param device The logical device
+     * @param physicalDevice The physical device the readback memory comes from
+     * @param jobs The job system frames are encoded on
+     * @param graphicsTimeline The timeline of the queue the copies are submitted to
+     * @param slotCount The number of frames that may be in flight or encoding at once
+     */
+    FrameCapture(VkDevice device,
+                 VkPhysicalDevice physicalDevice,
+                 JobSystem& jobs,
+                 const TimelineSemaphore& graphicsTimeline,
+                 uint32_t slotCount);
+// --------------------------------------------------------------------------------
+
+    /**
+     * @brief Waits for the frames being encoded and destroys the buffers.  The
+     * GPU must have finished every copy recorded by this object.
+     */
+    ~FrameCapture();
+// --------------------------------------------------------------------------------
+
+    FrameCapture(const FrameCapture&) = delete;
+    FrameCapture& operator=(const FrameCapture&) = delete;
+// --------------------------------------------------------------------------------
+
+    /**
+     * @brief Starts capturing the next frames.  Replaces any capture in progress;
+     * frames already recorded are still written.
+     *
+     * @param directory The directory files are written to; created if missing
+     * @param format The file format
+     * @param frameCount The number of frames to capture
+     * @throws std::runtime_error if the directory cannot be created
+     */
+    void start(const std::string& directory, CaptureFormat format, uint32_t frameCount);
+// --------------------------------------------------------------------------------
+
+    /**
+     * @brief Returns true while frames remain to be captured
+     */
+    bool isActive() const;
+// --------------------------------------------------------------------------------
+
+    /**
+     * @brief Records a copy of an image into a free slot
+     *
+     * @param commandBuffer The command buffer to record into
+     * @param image The image, in VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL
+     * @param format The format of the image; see isFormatSupported()
+     * @param extent The size of the image
+     * @return False if the frame was dropped or no capture is active
+     */
+    bool record(VkCommandBuffer commandBuffer, VkImage image, VkFormat format, VkExtent2D extent);
+// --------------------------------------------------------------------------------
+
+    /**
+     * @brief Records a copy of an image into a free slot, to be written to a
+     * named file.  Works whether or not a capture is active.
+     *
+     * @param commandBuffer The command buffer to record into
+     * @param image The image, in VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL
+     * @param format The format of the image; see isFormatSupported()
+     * @param extent The size of the image
+     * @param path The file to write
+     * @param fileFormat The format of the file
+     * @return False if every slot is busy; see waitForFreeSlot()
+     */
+    bool record(VkCommandBuffer commandBuffer, VkImage image, VkFormat format, VkExtent2D extent,
+                const std::string& path, CaptureFormat fileFormat);
+// --------------------------------------------------------------------------------
+
+    /**
+     * @brief Tags the copies recorded since the last call with the timeline value
+     * their submission signals.  Call after every submit.
+     */
+    void submitted(uint64_t timelineValue);
+// --------------------------------------------------------------------------------
+
+    /**
+     * @brief Starts encoding the copies the GPU has finished and recycles the
+     * slots whose files have been written.  Never blocks.
+     */
+    void poll();
+// --------------------------------------------------------------------------------
+
+    /**
+     * @brief Blocks until a slot is free, waiting on the GPU or on the encoders.
+     * For offline rendering, where every frame must be written.
+     */
+    void waitForFreeSlot();
+// --------------------------------------------------------------------------------
+
+    /**
+     * @brief Blocks until every recorded copy has been written to disk.  The
+     * copies must have been submitted.
+     */
+    void flush();
+// --------------------------------------------------------------------------------
+
+    FrameCaptureStats getStats() const;
+// --------------------------------------------------------------------------------
+
+    /**
+     * @brief Returns true for the 8-bit RGBA and BGRA formats frames can be
+     * captured from
+     */
+    static bool isFormatSupported(VkFormat format);
+// ================================================================================
+private:
+    enum class SlotState {
+        Free,      // Available to record()
+        Recorded,  // Copy recorded, submission not yet tagged
+        InFlight,  // Waiting for the GPU to reach timelineValue
+        Encoding   // A worker owns the pixels
+    };
+
+    struct Slot {
+        SlotState state = SlotState::Free;
+        VkBuffer buffer = VK_NULL_HANDLE;
+        VkDeviceMemory memory = VK_NULL_HANDLE;
+        VkDeviceSize capacity = 0;
+        bool coherent = false;
+        const uint8_t* mapped = nullptr;
+        uint64_t timelineValue = 0;
+
+        VkExtent2D extent{0, 0};
+        bool swizzle = false;
+        std::string path;
+        CaptureFormat format = CaptureFormat::Png;
+
+        // Counters cannot move, which is why slots are held by pointer
+        JobCounter encoding;
+    };
+
+    VkDevice device;
+    VkPhysicalDevice physicalDevice;
+    JobSystem& jobs;
+    const TimelineSemaphore& graphicsTimeline;
+    std::vector<std::unique_ptr<Slot>> slots;
+
+    std::string directory;
+    CaptureFormat format = CaptureFormat::Png;
+    uint32_t remainingFrames = 0;
+    uint64_t nextFileIndex = 0;
+
+    uint64_t framesRecorded = 0;
+    uint64_t framesDropped = 0;
+    std::atomic<uint64_t> framesWritten{0};
+    std::atomic<uint64_t> writeFailures{0};
+// --------------------------------------------------------------------------------
+
+    /**
+     * @brief Replaces a slot's buffer with one of at least size bytes
+     */
+    void allocateSlot(Slot& slot, VkDeviceSize size);
+// --------------------------------------------------------------------------------
+
+    void destroySlot(Slot& slot);
+// --------------------------------------------------------------------------------
+
+    /**
+     * @brief Returns a free slot, or null if every slot is busy
+     */
+    Slot* findFreeSlot();
+// --------------------------------------------------------------------------------
+
+    /**
+     * @brief Records the copy into a slot and marks it recorded
+     */
+    void recordCopy(Slot& slot, VkCommandBuffer commandBuffer, VkImage image, VkFormat format, VkExtent2D extent);
+// --------------------------------------------------------------------------------
+
+    /**
+     * @brief Blocks until the oldest busy slot makes progress
+     */
+    void waitForBusySlot();
+// --------------------------------------------------------------------------------
+
+    /**
+     * @brief Converts and writes one slot's pixels.  Runs on a worker thread.
+     */
+    void encode(Slot& slot);
+};
+// ================================================================================
+// ================================================================================
+
+#endif /* frame_capture_HPP */
+// ================================================================================
+// ================================================================================
+// eof
@@ -0,0 +1,81 @@
+// ================================================================================
+// ================================================================================
+// - File:    frame_limiter.hpp
+// - Purpose: This file contains a frame limiter that paces frames to a target
+//            rate with a hybrid of sleeping and spinning
+//
+// Source Metadata
+// - Author:  Jonathan A. Webb
+// - Date:    October 18, 2026
+// - Version: 1.0
+// - Copyright: Copyright 2022, Jon Webb Inc.
+// ================================================================================
+// ================================================================================
+// Include modules here
+
+#ifndef frame_limiter_HPP
+#define frame_limiter_HPP
+
+#include <chrono>
+// ================================================================================
+// ================================================================================
+
+/**
+ * @class FrameLimiter
+ * @brief Paces a loop to a target frame rate.
+ *
+ * The OS sleep is only accurate to within a scheduler tick, so wait() sleeps
+ * until shortly before the deadline and spins for the remainder.  Deadlines
+ * advance by a fixed period so pacing does not drift, but a frame that falls
+ * more than a period behind resets the schedule instead of rendering a burst
+ * of catch-up frames.
+ */
+class FrameLimiter {
+public:
+    using Clock = std::chrono::steady_clock;
+// --------------------------------------------------------------------------------
+
+    /**
+     * @brief Creates a limiter
+     *
+     * @param targetFps The target frame rate, or zero for no limit
+     * @param spinThreshold The portion of each wait that is spun instead of slept
+     */
+    FrameLimiter(double targetFps, std::chrono::microseconds spinThreshold);
+// --------------------------------------------------------------------------------
+
+    /**
+     * @brief Blocks until the next frame is due
+     */
+    void wait();
+// --------------------------------------------------------------------------------
+
+    /**
+     * @brief Changes the target frame rate and restarts the schedule
+     *
+     * @param targetFps The target frame rate, or zero for no limit
+     */
+    void setTargetFps(double targetFps);
+// --------------------------------------------------------------------------------
+
+    /**
+     * @brief Restarts the schedule from now, e.g. after the loop has been idle
+     */
+    void reset();
+// --------------------------------------------------------------------------------
+
+    double getTargetFps() const;
+// ================================================================================
+private:
+    double targetFps;
+    Clock::duration period{0};
+    std::chrono::microseconds spinThreshold;
+    Clock::time_point nextFrame;
+};
+// ================================================================================
+// ================================================================================
+
+#endif /* frame_limiter_HPP */
+// ================================================================================
+// ================================================================================
+// eof
@@ -16,14 +16,72 @@
 #define graphics_pipeline_HPP
 
 #include <vulkan/vulkan.h>
+#include "pipeline_cache.hpp"
+#include "object_cache.hpp"
 #include <vector>
 #include <string>
 // ================================================================================
 // ================================================================================
 
+/**
+ * @brief The push constant block shared by the vertex and fragment stages.
+ *
+ * Push constants are reserved for the smallest per-draw payloads; anything
+ * larger belongs in the UniformRingBuffer.  The size must stay within the 128
+ * bytes guaranteed by maxPushConstantsSize.
+ */
+struct DrawPushConstants {
+    float offset[2];
+    float scale;
+    float padding;
+};
+// --------------------------------------------------------------------------------
+
+/**
+ * @brief The most views a multiview pipeline renders; the size of
+ * FrameUniforms::views
+ */
+const uint32_t MAX_VIEW_COUNT = 4;
+// --------------------------------------------------------------------------------
+
+/**
+ * @brief The per-frame uniform block read from the UniformRingBuffer at set 0,
+ * binding 0.  The layout must match FrameUniforms in shader.vert and
+ * particle.vert.
+ */
+struct FrameUniforms {
+    float tint[4];
+    // Per view transform indexed by gl_ViewIndex: the offset in x and y and
+    // the scale in z.  Only the first entry is read without multiview.
+    float views[MAX_VIEW_COUNT][4];
+};
+// ================================================================================
+// ================================================================================
+
 class GraphicsPipeline {
 public:
-    GraphicsPipeline(VkDevice device, VkExtent2D swapChainExtent, VkFormat swapChainImageFormat);
+    /**
+     * @brief Requests the render pass and creates the pipeline layout and graphics pipeline
+     *
+     * @param device The logical device
+     * @param swapChainExtent The extent of the swap chain images
+     * @param swapChainImageFormat The format of the swap chain images
+     * @param descriptorSetLayout The layout bound at set 0, such as the one
+     *                            provided by UniformRingBuffer
+     * @param pipelineCache The cache that compiles and owns the pipelines
+     * @param objectCache The cache that creates and owns the render pass
+     * @param viewCount The number of views rendered by each draw.  Above one,
+     *                  the render pass uses multiview, its color attachment
+     *                  needs that many layers, and the multiview shader
+     *                  variants are used.
+     */
+    GraphicsPipeline(VkDevice device, 
+                     VkExtent2D swapChainExtent, 
+                     VkFormat swapChainImageFormat,
+                     VkDescriptorSetLayout descriptorSetLayout,
+                     PipelineStateCache& pipelineCache,
+                     ObjectCache& objectCache,
+                     uint32_t viewCount = 1);
 // --------------------------------------------------------------------------------
 
     ~GraphicsPipeline();
@@ -32,22 +90,77 @@ public:
     VkPipeline getPipeline() const;
 // --------------------------------------------------------------------------------
 
+    /**
+     * @brief Returns a pipeline for a variant of the default description.
+     *
+     * The variant is compiled against this object's layout and render pass, and
+     * is only compiled the first time the description is requested.
+     *
+     * @param desc The pipeline description, typically a modified copy of getPipelineDesc()
+     */
+    VkPipeline getPipeline(const PipelineDesc& desc);
+// --------------------------------------------------------------------------------
+
+    /**
+     * @brief Returns the description the default pipeline was built from
+     */
+    const PipelineDesc& getPipelineDesc() const;
+// --------------------------------------------------------------------------------
+
     VkPipelineLayout getPipelineLayout() const;
+// --------------------------------------------------------------------------------
+
+    VkRenderPass getRenderPass() const;
+// --------------------------------------------------------------------------------
+
+    /**
+     * @brief Returns the number of views the render pass renders
+     */
+    uint32_t getViewCount() const;
+// --------------------------------------------------------------------------------
+
+    /**
+     * @brief Retargets the pipeline at a new swap chain image format.
+     *
+     * Both the render pass and the pipeline come from their caches, so returning
+     * to a previously used format does not create any new objects.
+     *
+     * @param swapChainImageFormat The format of the recreated swap chain images
+     */
+    void setColorFormat(VkFormat swapChainImageFormat);
+// --------------------------------------------------------------------------------
+
+    /**
+     * @brief Requests the default pipeline from the cache again, picking up a
+     * version swapped in by PipelineStateCache::swapRebuiltPipelines()
+     */
+    void refreshPipeline();
+// --------------------------------------------------------------------------------
+
+    /**
+     * @brief Returns the SPIR-V files the default pipeline is compiled from, so
+     * they can be read before the pipeline is created
+     *
+     * @param viewCount The view count the pipeline will be created with
+     */
+    static std::vector<std::string> getShaderPaths(uint32_t viewCount = 1);
 // ================================================================================
 private:
     VkDevice device;
-    VkPipeline graphicsPipeline;
-    VkPipelineLayout pipelineLayout;
-    VkRenderPass renderPass;
-// --------------------------------------------------------------------------------
-
-    VkShaderModule createShaderModule(const std::vector<char>& code);
+    VkDescriptorSetLayout descriptorSetLayout;
+    PipelineStateCache& pipelineCache;
+    ObjectCache& objectCache;
+    uint32_t viewCount;
+    PipelineDesc pipelineDesc;
+    VkPipeline graphicsPipeline = VK_NULL_HANDLE;
+    VkPipelineLayout pipelineLayout = VK_NULL_HANDLE;
+    VkRenderPass renderPass = VK_NULL_HANDLE;
 // --------------------------------------------------------------------------------
 
-    std::vector<char> readFile(const std::string& filename);
+    void createPipelineLayout();
 // --------------------------------------------------------------------------------
 
-    void createGraphicsPipeline();
+    void createGraphicsPipeline(VkFormat swapChainImageFormat);
 // --------------------------------------------------------------------------------
 
     void createRenderPass(VkFormat swapChainImageFormat);
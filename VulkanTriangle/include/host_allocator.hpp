@@ -0,0 +1,277 @@
+// ================================================================================
+// ================================================================================
+// - File:    host_allocator.hpp
+// - Purpose: This file contains an instrumented VkAllocationCallbacks
+//            implementation that counts driver host allocations per scope and
+//            object type and can route short lived allocations to thread-local
+//            pools
+//
+// Source Metadata
+// - Author:  Jonathan A. Webb
+// - Date:    October 18, 2026
+// - Version: 1.0
+// - Copyright: Copyright 2022, Jon Webb Inc.
+// ================================================================================
+// ================================================================================
+// Include modules here
+
+#ifndef host_allocator_HPP
+#define host_allocator_HPP
+
+#include <vulkan/vulkan.h>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <unordered_map>
+#include <vector>
+// ================================================================================
+// ================================================================================
+
+/**
+ * @brief A snapshot of the host allocations made through a HostAllocator
+ */
+struct HostAllocationStats {
+    uint64_t allocations = 0;
+    uint64_t reallocations = 0;
+    uint64_t frees = 0;
+    uint64_t pooledAllocations = 0;
+    uint64_t bytesCurrent = 0;
+    uint64_t bytesPeak = 0;
+    uint64_t internalBytesCurrent = 0;
+    uint64_t internalBytesPeak = 0;
+};
+// ================================================================================
+// ================================================================================
+
+class HostAllocator;
+
+/**
+ * @class SmallBlockPool
+ * @brief Fixed size blocks carved from large chunks, owned by one thread.
+ *
+ * The owning thread allocates and frees through plain free lists.  Blocks freed
+ * by any other thread are pushed onto a lock-free stack per size class, which
+ * the owner takes over in one exchange once its own free list runs dry.
+ */
+class SmallBlockPool {
+public:
+    /**
+     * @brief The block sizes, in bytes, served by a pool
+     */
+    static constexpr uint32_t SIZE_CLASSES[] = {16, 32, 64, 128, 256, 512};
+    static constexpr uint32_t SIZE_CLASS_COUNT = sizeof(SIZE_CLASSES) / sizeof(SIZE_CLASSES[0]);
+// --------------------------------------------------------------------------------
+
+    /**
+     * @param blockOverhead The bytes reserved in front of every block
+     */
+    explicit SmallBlockPool(size_t blockOverhead);
+// --------------------------------------------------------------------------------
+
+    /**
+     * @brief Returns every chunk to the system
+     */
+    ~SmallBlockPool();
+// --------------------------------------------------------------------------------
+
+    SmallBlockPool(const SmallBlockPool&) = delete;
+    SmallBlockPool& operator=(const SmallBlockPool&) = delete;
+// --------------------------------------------------------------------------------
+
+    /**
+     * @brief Returns the smallest size class that holds a number of bytes, or
+     * SIZE_CLASS_COUNT if the size is too large for any class
+     */
+    static uint32_t sizeClassFor(size_t size);
+// --------------------------------------------------------------------------------
+
+    /**
+     * @brief Takes a block of a size class.  Owner only.
+     *
+     * @return The start of the block, including its overhead
+     */
+    void* allocate(uint32_t sizeClass);
+// --------------------------------------------------------------------------------
+
+    /**
+     * @brief Returns a block to the free list of its size class.  Owner only.
+     */
+    void release(void* block, uint32_t sizeClass);
+// --------------------------------------------------------------------------------
+
+    /**
+     * @brief Returns a block freed by a thread other than the owner
+     */
+    void releaseRemote(void* block, uint32_t sizeClass);
+// ================================================================================
+private:
+    struct FreeBlock {
+        FreeBlock* next;
+    };
+// --------------------------------------------------------------------------------
+
+    size_t blockOverhead;
+    FreeBlock* freeLists[SIZE_CLASS_COUNT] = {};
+    std::atomic<FreeBlock*> remoteFrees[SIZE_CLASS_COUNT] = {};
+    std::vector<void*> chunks;
+    char* chunkCursor = nullptr;
+    char* chunkEnd = nullptr;
+};
+// ================================================================================
+// ================================================================================
+
+/**
+ * @class HostAllocator
+ * @brief Counts every host allocation the driver makes through the callbacks.
+ *
+ * Vulkan tells an allocation callback the allocation scope but not the object
+ * being created, so getCallbacks() hands out one VkAllocationCallbacks per
+ * object type whose pUserData carries the type.  Every allocation is prefixed
+ * with a small header recording its size, scope, type and origin, which lets
+ * frees and reallocations be attributed without a lookup table.
+ *
+ * When pool routing is enabled, small COMMAND and OBJECT scope allocations are
+ * served from a SmallBlockPool owned by the calling thread instead of malloc.
+ * These scopes cover the temporary allocations of a single command and the
+ * bookkeeping of individual objects, which are the most frequent requests.
+ * Pools of threads that exit are handed to the next thread that needs one.
+ *
+ * The allocator is a process-wide singleton so that it outlives every Vulkan
+ * object and can report after the application has shut down.
+ */
+class HostAllocator {
+public:
+    /**
+     * @brief Returns the process-wide allocator
+     */
+    static HostAllocator& instance();
+// --------------------------------------------------------------------------------
+
+    HostAllocator(const HostAllocator&) = delete;
+    HostAllocator& operator=(const HostAllocator&) = delete;
+// --------------------------------------------------------------------------------
+
+    /**
+     * @brief Returns the callbacks used to create and destroy objects of a type.
+     * An object must be destroyed with the same callbacks it was created with.
+     */
+    const VkAllocationCallbacks* getCallbacks(VkObjectType type);
+// --------------------------------------------------------------------------------
+
+    /**
+     * @brief Enables or disables routing of COMMAND and OBJECT scope allocations
+     * to thread-local pools.  Existing allocations are freed correctly either way.
+     */
+    void setPoolRouting(bool enabled);
+// --------------------------------------------------------------------------------
+
+    HostAllocationStats getScopeStats(VkSystemAllocationScope scope) const;
+// --------------------------------------------------------------------------------
+
+    HostAllocationStats getTypeStats(VkObjectType type) const;
+// --------------------------------------------------------------------------------
+
+    /**
+     * @brief Writes the statistics of every scope and object type to a stream
+     */
+    void printReport(std::ostream& out) const;
+// ================================================================================
+private:
+    struct Counters {
+        std::atomic<uint64_t> allocations{0};
+        std::atomic<uint64_t> reallocations{0};
+        std::atomic<uint64_t> frees{0};
+        std::atomic<uint64_t> pooledAllocations{0};
+        std::atomic<uint64_t> bytesCurrent{0};
+        std::atomic<uint64_t> bytesPeak{0};
+        std::atomic<uint64_t> internalBytesCurrent{0};
+        std::atomic<uint64_t> internalBytesPeak{0};
+// --------------------------------------------------------------------------------
+
+        HostAllocationStats snapshot() const;
+    };
+// --------------------------------------------------------------------------------
+
+    // The pUserData of every callbacks struct handed out by getCallbacks()
+    struct TypeTag {
+        HostAllocator* owner;
+        VkObjectType type;
+        VkAllocationCallbacks callbacks;
+        Counters counters;
+    };
+// --------------------------------------------------------------------------------
+
+    static const uint32_t SCOPE_COUNT = 5;
+
+    Counters scopeCounters[SCOPE_COUNT];
+    std::atomic<bool> poolRouting;
+
+    mutable std::mutex tagMutex;
+    std::vector<std::unique_ptr<TypeTag>> tags;
+    std::unordered_map<int32_t, TypeTag*> tagsByType;
+
+    std::mutex poolMutex;
+    std::vector<std::unique_ptr<SmallBlockPool>> pools;
+    std::vector<SmallBlockPool*> retiredPools;
+// --------------------------------------------------------------------------------
+
+    HostAllocator();
+// --------------------------------------------------------------------------------
+
+    void* allocate(TypeTag& tag, size_t size, size_t alignment, VkSystemAllocationScope scope);
+// --------------------------------------------------------------------------------
+
+    void* reallocate(TypeTag& tag, void* original, size_t size, size_t alignment, VkSystemAllocationScope scope);
+// --------------------------------------------------------------------------------
+
+    void free(void* memory);
+// --------------------------------------------------------------------------------
+
+    void onInternalAllocation(TypeTag& tag, size_t size, VkSystemAllocationScope scope);
+// --------------------------------------------------------------------------------
+
+    void onInternalFree(TypeTag& tag, size_t size, VkSystemAllocationScope scope);
+// --------------------------------------------------------------------------------
+
+    SmallBlockPool* threadPool();
+// --------------------------------------------------------------------------------
+
+    void retirePool(SmallBlockPool* pool);
+// --------------------------------------------------------------------------------
+
+    Counters& countersFor(VkSystemAllocationScope scope);
+// --------------------------------------------------------------------------------
+
+    friend struct ThreadPoolHandle;
+// --------------------------------------------------------------------------------
+
+    static void* VKAPI_PTR allocationCallback(void* userData, size_t size, size_t alignment,
+                                              VkSystemAllocationScope scope);
+    static void* VKAPI_PTR reallocationCallback(void* userData, void* original, size_t size,
+                                                size_t alignment, VkSystemAllocationScope scope);
+    static void VKAPI_PTR freeCallback(void* userData, void* memory);
+    static void VKAPI_PTR internalAllocationCallback(void* userData, size_t size,
+                                                     VkInternalAllocationType type,
+                                                     VkSystemAllocationScope scope);
+    static void VKAPI_PTR internalFreeCallback(void* userData, size_t size,
+                                               VkInternalAllocationType type,
+                                               VkSystemAllocationScope scope);
+};
+// ================================================================================
+// ================================================================================
+
+/**
+ * @brief Returns the allocation callbacks to pass as pAllocator when creating or
+ * destroying an object of a type, or nullptr when host allocation tracking is
+ * disabled
+ */
+const VkAllocationCallbacks* hostAllocator(VkObjectType type);
+// ================================================================================
+// ================================================================================
+
+#endif /* host_allocator_HPP */
+// ================================================================================
+// ================================================================================
+// eof
@@ -0,0 +1,62 @@
+// ================================================================================
+// ================================================================================
+// - File:    image_writer.hpp
+// - Purpose: This file contains functions that write 8-bit RGBA pixels to PNG
+//            and raw image files
+//
+// Source Metadata
+// - Author:  Jonathan A. Webb
+// - Date:    October 18, 2026
+// - Version: 1.0
+// - Copyright: Copyright 2022, Jon Webb Inc.
+// ================================================================================
+// ================================================================================
+// Include modules here
+
+#ifndef image_writer_HPP
+#define image_writer_HPP
+
+#include <cstdint>
+#include <string>
+#include <vector>
+// ================================================================================
+// ================================================================================
+
+/**
+ * @brief Encodes tightly packed RGBA8 pixels as a PNG file image.
+ *
+ * Rows use the Up filter and the zlib stream uses stored deflate blocks, so
+ * encoding is a single pass over the pixels with no compression search.  The
+ * output is roughly the size of the pixels; it favors capture throughput over
+ * file size.
+ *
+ * @param width The width in pixels
+ * @param height The height in pixels
+ * @param rgba width * height * 4 bytes of pixel data, top row first
+ * @return The bytes of the PNG file
+ */
+std::vector<uint8_t> encodePng(uint32_t width, uint32_t height, const uint8_t* rgba);
+// --------------------------------------------------------------------------------
+
+/**
+ * @brief Writes tightly packed RGBA8 pixels to a PNG file
+ *
+ * @throws std::runtime_error if the file cannot be written
+ */
+void writePng(const std::string& path, uint32_t width, uint32_t height, const uint8_t* rgba);
+// --------------------------------------------------------------------------------
+
+/**
+ * @brief Writes tightly packed RGBA8 pixels to a file with no header.  The
+ * dimensions are left to the file name or the reader.
+ *
+ * @throws std::runtime_error if the file cannot be written
+ */
+void writeRaw(const std::string& path, uint32_t width, uint32_t height, const uint8_t* rgba);
+// ================================================================================
+// ================================================================================
+
+#endif /* image_writer_HPP */
+// ================================================================================
+// ================================================================================
+// eof
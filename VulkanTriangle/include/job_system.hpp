@@ -0,0 +1,273 @@
+// ================================================================================
+// ================================================================================
+// - File:    job_system.hpp
+// - Purpose: This file contains a work-stealing job scheduler with per-worker
+//            Chase-Lev deques, completion counters and parallel_for helpers
+//
+// Source Metadata
+// - Author:  Jonathan A. Webb
+// - Date:    October 18, 2026
+// - Version: 1.0
+// - Copyright: Copyright 2022, Jon Webb Inc.
+// ================================================================================
+// ================================================================================
+// Include modules here
+
+#ifndef job_system_HPP
+#define job_system_HPP
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include <deque>
+#include <memory>
+#include <algorithm>
+// ================================================================================
+// ================================================================================
+
+/**
+ * @brief The number of jobs each worker deque can hold before new jobs are run
+ * inline by the thread that submits them
+ */
+const int64_t JOB_DEQUE_CAPACITY = 4096;
+// ================================================================================
+// ================================================================================
+
+struct Job;
+class JobSystem;
+// --------------------------------------------------------------------------------
+
+/**
+ * @class JobCounter
+ * @brief Counts the unfinished jobs of a group.
+ *
+ * Every job submitted with a counter increments it and decrements it when the
+ * job finishes.  Jobs can be made to depend on a counter with
+ * JobSystem::runAfter(), in which case they are only scheduled once the
+ * counter reaches zero.
+ */
+class JobCounter {
+public:
+    /**
+     * @brief Returns true once every job submitted with this counter has finished
+     */
+    bool isDone() const {
+        return value.load(std::memory_order_acquire) == 0 &&
+               finishing.load(std::memory_order_acquire) == 0;
+    }
+// ================================================================================
+private:
+    friend class JobSystem;
+
+    std::atomic<uint32_t> value{0};
+
+    // Threads still touching the counter after decrementing it.  Keeps a waiter
+    // from destroying the counter while the last job drains its continuations.
+    std::atomic<uint32_t> finishing{0};
+    std::mutex continuationMutex;
+    std::vector<Job*> continuations;
+};
+// ================================================================================
+// ================================================================================
+
+/**
+ * @brief A unit of work owned by the JobSystem
+ */
+struct Job {
+    std::function<void()> task;
+    JobCounter* counter = nullptr;
+};
+// ================================================================================
+// ================================================================================
+
+/**
+ * @class WorkStealingDeque
+ * @brief A fixed capacity Chase-Lev deque.
+ *
+ * The owning worker pushes and pops at the bottom without contention; any
+ * other thread may steal from the top.  The only compare-and-swap happens when
+ * the owner and a thief race for the last job.
+ */
+class WorkStealingDeque {
+public:
+    /**
+     * @param capacity The number of jobs the deque can hold, a power of two
+     */
+    explicit WorkStealingDeque(int64_t capacity);
+// --------------------------------------------------------------------------------
+
+    /**
+     * @brief Pushes a job at the bottom.  Owner only.
+     *
+     * @return false if the deque is full
+     */
+    bool push(Job* job);
+// --------------------------------------------------------------------------------
+
+    /**
+     * @brief Pops the most recently pushed job.  Owner only.
+     *
+     * @return The job, or nullptr if the deque is empty
+     */
+    Job* pop();
+// --------------------------------------------------------------------------------
+
+    /**
+     * @brief Takes the oldest job.  Safe from any thread.
+     *
+     * @return The job, or nullptr if the deque is empty or the steal lost a race
+     */
+    Job* steal();
+// ================================================================================
+private:
+    alignas(64) std::atomic<int64_t> top{0};
+    alignas(64) std::atomic<int64_t> bottom{0};
+    alignas(64) std::vector<std::atomic<Job*>> buffer;
+    int64_t mask;
+};
+// ================================================================================
+// ================================================================================
+
+/**
+ * @class JobSystem
+ * @brief A work-stealing scheduler sized to the hardware thread count.
+ *
+ * The thread that constructs the system owns deque 0 and takes part in the work
+ * whenever it calls wait().  Each worker thread owns one more deque.  A worker
+ * runs the newest job from its own deque, which keeps caches warm.  When that
+ * deque is empty it steals the oldest job from a random victim.  Threads that
+ * are neither the owner nor a worker submit through a shared injection queue.
+ * Idle workers block on a condition variable, so an idle system uses no CPU.
+ *
+ * Jobs must not throw.  Every counter must be waited on before the system is
+ * destroyed.
+ */
+class JobSystem {
+public:
+    /**
+     * @brief Starts the worker threads
+     *
+     * @param threadCount The total number of threads that execute jobs,
+     *                    including the calling thread.  Zero selects
+     *                    std::thread::hardware_concurrency().  At least one
+     *                    worker is always started, even on a single core.
+     */
+    explicit JobSystem(uint32_t threadCount = 0);
+// --------------------------------------------------------------------------------
+
+    /**
+     * @brief Stops and joins the worker threads
+     */
+    ~JobSystem();
+// --------------------------------------------------------------------------------
+
+    JobSystem(const JobSystem&) = delete;
+    JobSystem& operator=(const JobSystem&) = delete;
+// --------------------------------------------------------------------------------
+
+    /**
+     * @brief Schedules a job
+     *
+     * @param task The work to perform
+     * @param counter An optional counter that tracks completion of the job
+     */
+    void run(std::function<void()> task, JobCounter* counter = nullptr);
+// --------------------------------------------------------------------------------
+
+    /**
+     * @brief Schedules a job once every job tracked by a dependency has finished
+     *
+     * @param dependency The counter that must reach zero first
+     * @param task The work to perform
+     * @param counter An optional counter that tracks completion of the job.  It
+     *                is incremented immediately, so waiting on it also waits
+     *                for the dependency.
+     */
+    void runAfter(JobCounter& dependency, std::function<void()> task, JobCounter* counter = nullptr);
+// --------------------------------------------------------------------------------
+
+    /**
+     * @brief Executes other jobs until every job tracked by a counter has finished
+     */
+    void wait(const JobCounter& counter);
+// --------------------------------------------------------------------------------
+
+    /**
+     * @brief Splits [0, count) into batches, runs them in parallel and waits
+     *
+     * @param count The number of iterations
+     * @param batchSize The number of iterations per job
+     * @param body Called as body(begin, end) for each batch
+     */
+    template <typename Body>
+    void parallelFor(uint32_t count, uint32_t batchSize, const Body& body) {
+        batchSize = std::max(batchSize, 1u);
+        JobCounter counter;
+        for (uint32_t begin = 0; begin < count; begin += batchSize) {
+            uint32_t end = std::min(count, begin + batchSize);
+            run([&body, begin, end]() { body(begin, end); }, &counter);
+        }
+        wait(counter);
+    }
+// --------------------------------------------------------------------------------
+
+    /**
+     * @brief Runs body(i) for every i in [0, count), choosing a batch size that
+     * gives each thread several batches to balance load
+     */
+    template <typename Body>
+    void parallelFor(uint32_t count, const Body& body) {
+        uint32_t batches = getThreadCount() * 4;
+        uint32_t batchSize = (count + batches - 1) / batches;
+        parallelFor(count, batchSize, [&body](uint32_t begin, uint32_t end) {
+            for (uint32_t i = begin; i < end; i++) {
+                body(i);
+            }
+        });
+    }
+// --------------------------------------------------------------------------------
+
+    /**
+     * @brief Returns the number of threads that execute jobs, including the owner
+     */
+    uint32_t getThreadCount() const;
+// ================================================================================
+private:
+    std::vector<std::unique_ptr<WorkStealingDeque>> deques;
+    std::vector<std::thread> workers;
+
+    std::mutex injectionMutex;
+    std::deque<Job*> injectionQueue;
+
+    std::mutex sleepMutex;
+    std::condition_variable sleepCondition;
+    std::atomic<int64_t> pendingJobs{0};
+    std::atomic<uint32_t> sleepingWorkers{0};
+    std::atomic<bool> stopping{false};
+// --------------------------------------------------------------------------------
+
+    void workerLoop(uint32_t index);
+// --------------------------------------------------------------------------------
+
+    void submit(Job* job);
+// --------------------------------------------------------------------------------
+
+    Job* findJob();
+// --------------------------------------------------------------------------------
+
+    void execute(Job* job);
+// --------------------------------------------------------------------------------
+
+    void finish(JobCounter* counter);
+};
+// ================================================================================
+// ================================================================================
+
+#endif /* job_system_HPP */
+// ================================================================================
+// ================================================================================
+// eof
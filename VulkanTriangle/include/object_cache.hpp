@@ -0,0 +1,235 @@
+// ================================================================================
+// ================================================================================
+// - File:    object_cache.hpp
+// - Purpose: This file contains hash-consed caches for immutable Vulkan objects
+//            such as render passes, framebuffers and samplers
+//
+// Source Metadata
+// - Author:  Jonathan A. Webb
+// - Date:    October 18, 2026
+// - Version: 1.0
+// - Copyright: Copyright 2022, Jon Webb Inc.
+// ================================================================================
+// ================================================================================
+// Include modules here
+
+#ifndef object_cache_HPP
+#define object_cache_HPP
+
+#include <vulkan/vulkan.h>
+#include "pipeline_cache.hpp"
+#include "deletion_queue.hpp"
+#include <vector>
+#include <array>
+#include <unordered_map>
+// ================================================================================
+// ================================================================================
+
+/**
+ * @brief The maximum number of attachments a cached framebuffer may reference
+ */
+const uint32_t MAX_FRAMEBUFFER_ATTACHMENTS = 8;
+// ================================================================================
+// ================================================================================
+
+/**
+ * @brief Describes a single render pass attachment
+ */
+struct AttachmentDesc {
+    VkFormat format = VK_FORMAT_UNDEFINED;
+    VkSampleCountFlagBits samples = VK_SAMPLE_COUNT_1_BIT;
+    VkAttachmentLoadOp loadOp = VK_ATTACHMENT_LOAD_OP_CLEAR;
+    VkAttachmentStoreOp storeOp = VK_ATTACHMENT_STORE_OP_STORE;
+    VkImageLayout initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+    VkImageLayout finalLayout = VK_IMAGE_LAYOUT_PRESENT_SRC_KHR;
+// --------------------------------------------------------------------------------
+
+    bool operator==(const AttachmentDesc& other) const {
+        return format == other.format && samples == other.samples &&
+               loadOp == other.loadOp && storeOp == other.storeOp &&
+               initialLayout == other.initialLayout && finalLayout == other.finalLayout;
+    }
+};
+// --------------------------------------------------------------------------------
+
+/**
+ * @brief Describes a single-subpass render pass by its attachment formats and
+ * load/store operations.
+ *
+ * A non-zero viewMask makes it a multiview render pass: every draw is broadcast
+ * to the attachment layers whose bits are set, and the shaders see the layer as
+ * gl_ViewIndex.  correlationMask marks views that are spatially close, such as
+ * a stereo pair, which some implementations render more efficiently.
+ */
+struct RenderPassDesc {
+    std::vector<AttachmentDesc> colorAttachments;
+    bool hasDepth = false;
+    AttachmentDesc depthAttachment;
+    uint32_t viewMask = 0;
+    uint32_t correlationMask = 0;
+// --------------------------------------------------------------------------------
+
+    size_t hash() const;
+// --------------------------------------------------------------------------------
+
+    bool operator==(const RenderPassDesc& other) const {
+        return colorAttachments == other.colorAttachments && hasDepth == other.hasDepth &&
+               (!hasDepth || depthAttachment == other.depthAttachment) &&
+               viewMask == other.viewMask && correlationMask == other.correlationMask;
+    }
+};
+// --------------------------------------------------------------------------------
+
+/**
+ * @brief Describes a framebuffer by its render pass, image views and extent.
+ *
+ * The attachments live in a fixed size array so that a lookup can be made every
+ * frame without touching the heap.
+ */
+struct FramebufferDesc {
+    VkRenderPass renderPass = VK_NULL_HANDLE;
+    std::array<VkImageView, MAX_FRAMEBUFFER_ATTACHMENTS> attachments{};
+    uint32_t attachmentCount = 0;
+    VkExtent2D extent{0, 0};
+    uint32_t layers = 1;
+// --------------------------------------------------------------------------------
+
+    size_t hash() const;
+// --------------------------------------------------------------------------------
+
+    bool operator==(const FramebufferDesc& other) const;
+// --------------------------------------------------------------------------------
+
+    /**
+     * @brief Returns true if the framebuffer references the given image view
+     */
+    bool references(VkImageView view) const;
+};
+// --------------------------------------------------------------------------------
+
+/**
+ * @brief Describes a sampler by the fields of VkSamplerCreateInfo
+ */
+struct SamplerDesc {
+    VkFilter magFilter = VK_FILTER_LINEAR;
+    VkFilter minFilter = VK_FILTER_LINEAR;
+    VkSamplerMipmapMode mipmapMode = VK_SAMPLER_MIPMAP_MODE_LINEAR;
+    VkSamplerAddressMode addressModeU = VK_SAMPLER_ADDRESS_MODE_REPEAT;
+    VkSamplerAddressMode addressModeV = VK_SAMPLER_ADDRESS_MODE_REPEAT;
+    VkSamplerAddressMode addressModeW = VK_SAMPLER_ADDRESS_MODE_REPEAT;
+    float mipLodBias = 0.0f;
+    VkBool32 anisotropyEnable = VK_FALSE;
+    float maxAnisotropy = 1.0f;
+    VkBool32 compareEnable = VK_FALSE;
+    VkCompareOp compareOp = VK_COMPARE_OP_ALWAYS;
+    float minLod = 0.0f;
+    float maxLod = 1000.0f;
+    VkBorderColor borderColor = VK_BORDER_COLOR_INT_OPAQUE_BLACK;
+// --------------------------------------------------------------------------------
+
+    size_t hash() const;
+// --------------------------------------------------------------------------------
+
+    bool operator==(const SamplerDesc& other) const;
+};
+// ================================================================================
+// ================================================================================
+
+/**
+ * @brief Hit and miss counters for one of the caches in ObjectCache
+ */
+struct CacheStats {
+    uint64_t hits = 0;
+    uint64_t misses = 0;
+    uint64_t evictions = 0;
+};
+// ================================================================================
+// ================================================================================
+
+/**
+ * @class ObjectCache
+ * @brief Hash-consed caches for render passes, framebuffers and samplers.
+ *
+ * Each getter returns an existing object when an identical description has been
+ * seen before, and creates one otherwise.  The cache owns every object it
+ * returns.  When swap chain image views are destroyed, invalidateImageViews()
+ * evicts only the framebuffers that reference them; render passes and samplers
+ * survive a resize untouched.
+ */
+class ObjectCache {
+public:
+    /**
+     * @brief Constructs an empty cache
+     *
+     * @param device The logical device
+     */
+    explicit ObjectCache(VkDevice device);
+// --------------------------------------------------------------------------------
+
+    /**
+     * @brief Destroys every cached object
+     */
+    ~ObjectCache();
+// --------------------------------------------------------------------------------
+
+    VkRenderPass getRenderPass(const RenderPassDesc& desc);
+// --------------------------------------------------------------------------------
+
+    VkFramebuffer getFramebuffer(const FramebufferDesc& desc);
+// --------------------------------------------------------------------------------
+
+    VkSampler getSampler(const SamplerDesc& desc);
+// --------------------------------------------------------------------------------
+
+    /**
+     * @brief Evicts every cached framebuffer that references one of the views.
+     *
+     * Call this before the image views are destroyed.  Frames in flight may
+     * still use the framebuffers, so they are destroyed through the deletion
+     * queue.
+     *
+     * @param imageViews The image views that are about to be destroyed
+     * @param deletionQueue The queue that destroys the evicted framebuffers
+     */
+    void invalidateImageViews(const std::vector<VkImageView>& imageViews, DeletionQueue& deletionQueue);
+// --------------------------------------------------------------------------------
+
+    const CacheStats& getRenderPassStats() const;
+// --------------------------------------------------------------------------------
+
+    const CacheStats& getFramebufferStats() const;
+// --------------------------------------------------------------------------------
+
+    const CacheStats& getSamplerStats() const;
+// ================================================================================
+private:
+    template <typename T>
+    struct DescHash {
+        size_t operator()(const T& desc) const { return desc.hash(); }
+    };
+// --------------------------------------------------------------------------------
+
+    VkDevice device;
+    std::unordered_map<RenderPassDesc, VkRenderPass, DescHash<RenderPassDesc>> renderPasses;
+    std::unordered_map<FramebufferDesc, VkFramebuffer, DescHash<FramebufferDesc>> framebuffers;
+    std::unordered_map<SamplerDesc, VkSampler, DescHash<SamplerDesc>> samplers;
+    CacheStats renderPassStats;
+    CacheStats framebufferStats;
+    CacheStats samplerStats;
+// --------------------------------------------------------------------------------
+
+    VkRenderPass createRenderPass(const RenderPassDesc& desc);
+// --------------------------------------------------------------------------------
+
+    VkFramebuffer createFramebuffer(const FramebufferDesc& desc);
+// --------------------------------------------------------------------------------
+
+    VkSampler createSampler(const SamplerDesc& desc);
+};
+// ================================================================================
+// ================================================================================
+
+#endif /* object_cache_HPP */
+// ================================================================================
+// ================================================================================
+// eof
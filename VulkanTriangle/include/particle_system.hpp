@@ -0,0 +1,224 @@
+// ================================================================================
+// ================================================================================
+// - File:    particle_system.hpp
+// - Purpose: This file contains a GPU particle simulation that is stepped by a
+//            compute shader on the compute queue and drawn as instanced points
+//
+// Source Metadata
+// - Author:  Jonathan A. Webb
+// - Date:    October 18, 2026
+// - Version: 1.0
+// - Copyright: Copyright 2022, Jon Webb Inc.
+// ================================================================================
+// ================================================================================
+// Include modules here
+
+#ifndef particle_system_HPP
+#define particle_system_HPP
+
+#include <vulkan/vulkan.h>
+#include "command_buffers.hpp"
+#include "compute_pipeline.hpp"
+#include "pipeline_cache.hpp"
+#include "queues.hpp"
+#include "residency_manager.hpp"
+#include "synchronization.hpp"
+#include "upload_manager.hpp"
+#include <memory>
+#include <string>
+#include <vector>
+// ================================================================================
+// ================================================================================
+
+/**
+ * @brief One particle as stored in the simulation buffers.  The layout must
+ * match Particle in particles.comp and the attributes of particle.vert.
+ */
+struct Particle {
+    float position[2];
+    float velocity[2];
+};
+// --------------------------------------------------------------------------------
+
+/**
+ * @brief The push constant block of particles.comp
+ */
+struct ParticlePushConstants {
+    float deltaTime;
+    uint32_t count;
+};
+// ================================================================================
+// ================================================================================
+
+/**
+ * @class ParticleSystem
+ * @brief Simulates particles in a pair of storage buffers.
+ *
+ * Each step reads one buffer and writes the other, and the buffer just written
+ * is drawn by the same frame.  Steps are submitted to the compute queue, which
+ * is a separate queue family when the device has one, so a step can run while
+ * the graphics queue is still drawing the previous frame from the other buffer.
+ * Each step signals the compute queue's timeline, and the graphics submission
+ * waits on the value returned by simulate() before it reads the vertices.
+ *
+ * When the compute family supports timestamps, the GPU time of every step is
+ * measured so the simulation doubles as a compute throughput benchmark.
+ */
+class ParticleSystem {
+public:
+    /**
+     * @param device The logical device
+     * @param physicalDevice The physical device, used for memory types and timestamps
+     * @param queueFamilies The queue families the device was created with
+     * @param computeQueue The queue steps are submitted to
+     * @param computeTimeline The timeline signaled by submissions to computeQueue
+     * @param uploads The manager the initial particle state is uploaded through
+     * @param residency The manager the particle buffers are allocated through
+     * @param pipelineCache The cache that compiles and owns the compute pipeline
+     * @param particleCount The number of particles to simulate
+     * @param framesInFlight The number of frames the CPU may record ahead of the GPU
+     */
+    ParticleSystem(VkDevice device,
+                   VkPhysicalDevice physicalDevice,
+                   const QueueFamilyIndices& queueFamilies,
+                   VkQueue computeQueue,
+                   TimelineSemaphore& computeTimeline,
+                   UploadManager& uploads,
+                   ResidencyManager& residency,
+                   PipelineStateCache& pipelineCache,
+                   uint32_t particleCount,
+                   uint32_t framesInFlight);
+// --------------------------------------------------------------------------------
+
+    /**
+     * @brief Destroys the buffers and descriptors.  The GPU must be idle.
+     */
+    ~ParticleSystem();
+// --------------------------------------------------------------------------------
+
+    ParticleSystem(const ParticleSystem&) = delete;
+    ParticleSystem& operator=(const ParticleSystem&) = delete;
+// --------------------------------------------------------------------------------
+
+    /**
+     * @brief Records and submits one simulation step
+     *
+     * The frame's previous submission must have finished, and the graphics
+     * submission of the same frame must wait on the returned value.
+     *
+     * @param frameIndex The index of the frame in flight
+     * @param deltaTime The simulated time step in seconds
+     * @return The compute timeline value signaled when the step has finished, to
+     *         be waited on at VK_PIPELINE_STAGE_2_VERTEX_ATTRIBUTE_INPUT_BIT
+     */
+    uint64_t simulate(uint32_t frameIndex, float deltaTime);
+// --------------------------------------------------------------------------------
+
+    /**
+     * @brief Returns the buffer written by the latest step.  It is drawn at
+     * vertex binding 0 as one point per instance, with a pipeline built from
+     * getPipelineDesc().
+     */
+    VkBuffer getVertexBuffer() const;
+// --------------------------------------------------------------------------------
+
+    /**
+     * @brief Returns the description of the pipeline that draws the particles
+     *
+     * @param base The description of the pipeline drawn in the same render pass
+     * @param viewCount The number of views the render pass renders
+     */
+    static PipelineDesc getPipelineDesc(const PipelineDesc& base, uint32_t viewCount = 1);
+// --------------------------------------------------------------------------------
+
+    /**
+     * @brief Picks up a rebuilt simulation pipeline after
+     * PipelineStateCache::swapRebuiltPipelines()
+     */
+    void refreshPipeline();
+// --------------------------------------------------------------------------------
+
+    /**
+     * @brief Returns the SPIR-V files the simulation and its draw pipeline are
+     * compiled from, so they can be read ahead of time
+     *
+     * @param viewCount The number of views the particles will be drawn to
+     */
+    static std::vector<std::string> getShaderPaths(uint32_t viewCount = 1);
+// --------------------------------------------------------------------------------
+
+    uint32_t getParticleCount() const;
+// --------------------------------------------------------------------------------
+
+    /**
+     * @brief Returns the number of steps whose GPU time has been measured
+     */
+    uint64_t getMeasuredStepCount() const;
+// --------------------------------------------------------------------------------
+
+    /**
+     * @brief Returns the mean GPU time of a step in microseconds, or zero if no
+     * step has been measured
+     */
+    double getAverageStepMicroseconds() const;
+// ================================================================================
+private:
+    VkDevice device;
+    VkPhysicalDevice physicalDevice;
+    VkQueue computeQueue;
+    TimelineSemaphore& computeTimeline;
+    ResidencyManager& residency;
+    uint32_t particleCount;
+    std::vector<uint32_t> sharingFamilies;
+
+    VkBuffer buffers[2] = {VK_NULL_HANDLE, VK_NULL_HANDLE};
+    VkDeviceMemory bufferMemory[2] = {VK_NULL_HANDLE, VK_NULL_HANDLE};
+    ResidencyHandle bufferResidency[2] = {0, 0};
+    uint32_t readIndex = 0;
+
+    VkDescriptorSetLayout descriptorSetLayout = VK_NULL_HANDLE;
+    VkDescriptorPool descriptorPool = VK_NULL_HANDLE;
+    VkDescriptorSet descriptorSets[2] = {VK_NULL_HANDLE, VK_NULL_HANDLE};
+    std::unique_ptr<ComputePipeline> computePipeline;
+    std::unique_ptr<CommandBufferManager> commandBuffers;
+
+    VkQueryPool timestampPool = VK_NULL_HANDLE;
+    uint64_t timestampMask = 0;
+    double timestampPeriod = 0.0;
+    // The timeline value of the step whose timestamps a frame slot holds, or
+    // zero once they have been read
+    std::vector<uint64_t> timestampValues;
+    uint64_t measuredSteps = 0;
+    double measuredMicroseconds = 0.0;
+// --------------------------------------------------------------------------------
+
+    void createBuffers();
+// --------------------------------------------------------------------------------
+
+    /**
+     * @brief Fills the first buffer with particles orbiting the origin
+     *
+     * @param uploads The manager the particles are staged through
+     * @param computeFamily The family of computeQueue
+     */
+    void uploadInitialState(UploadManager& uploads, uint32_t computeFamily);
+// --------------------------------------------------------------------------------
+
+    void createDescriptors();
+// --------------------------------------------------------------------------------
+
+    void createTimestampPool(uint32_t computeFamily, uint32_t framesInFlight);
+// --------------------------------------------------------------------------------
+
+    /**
+     * @brief Accumulates the GPU time of the step last submitted for a frame
+     */
+    void collectTimestamps(uint32_t frameIndex);
+};
+// ================================================================================
+// ================================================================================
+
+#endif /* particle_system_HPP */
+// ================================================================================
+// ================================================================================
+// eof
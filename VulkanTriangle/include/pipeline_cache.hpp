@@ -0,0 +1,364 @@
+// ================================================================================
+// ================================================================================
+// - File:    pipeline_cache.hpp
+// - Purpose: This file contains a declarative description of a graphics pipeline
+//            and a cache that only compiles a pipeline the first time its
+//            description is requested
+//
+// Source Metadata
+// - Author:  Jonathan A. Webb
+// - Date:    October 18, 2026
+// - Version: 1.0
+// - Copyright: Copyright 2022, Jon Webb Inc.
+// ================================================================================
+// ================================================================================
+// Include modules here
+
+#ifndef pipeline_cache_HPP
+#define pipeline_cache_HPP
+
+#include <vulkan/vulkan.h>
+#include "shader_library.hpp"
+#include "job_system.hpp"
+#include <memory>
+#include <mutex>
+#include <vector>
+#include <string>
+#include <unordered_map>
+#include <functional>
+// ================================================================================
+// ================================================================================
+
+/**
+ * @brief Mixes a value into a running hash
+ *
+ * @param seed The running hash, which is updated in place
+ * @param value The value to mix into the hash
+ */
+template <typename T>
+inline void hashCombine(size_t& seed, const T& value) {
+    seed ^= std::hash<T>{}(value) + 0x9e3779b97f4a7c15ULL + (seed << 6) + (seed >> 2);
+}
+// ================================================================================
+// ================================================================================
+
+/**
+ * @brief A hashable value type that describes every fixed-function setting of
+ * a graphics pipeline.
+ *
+ * Default values reproduce the state used to draw the triangle: a triangle
+ * list, back face culling with clockwise front faces, no depth testing, no
+ * blending and a dynamic viewport and scissor.
+ */
+struct PipelineDesc {
+    // Shaders
+    std::string vertexShader;
+    std::string fragmentShader;
+
+    // Vertex layout
+    std::vector<VkVertexInputBindingDescription> vertexBindings;
+    std::vector<VkVertexInputAttributeDescription> vertexAttributes;
+    VkPrimitiveTopology topology = VK_PRIMITIVE_TOPOLOGY_TRIANGLE_LIST;
+
+    // Raster state
+    VkPolygonMode polygonMode = VK_POLYGON_MODE_FILL;
+    VkCullModeFlags cullMode = VK_CULL_MODE_BACK_BIT;
+    VkFrontFace frontFace = VK_FRONT_FACE_CLOCKWISE;
+    VkSampleCountFlagBits samples = VK_SAMPLE_COUNT_1_BIT;
+
+    // Depth state
+    VkBool32 depthTestEnable = VK_FALSE;
+    VkBool32 depthWriteEnable = VK_FALSE;
+    VkCompareOp depthCompareOp = VK_COMPARE_OP_LESS;
+
+    // Blend state, applied to every color attachment
+    VkBool32 blendEnable = VK_FALSE;
+    VkBlendFactor srcColorBlendFactor = VK_BLEND_FACTOR_ONE;
+    VkBlendFactor dstColorBlendFactor = VK_BLEND_FACTOR_ZERO;
+    VkBlendOp colorBlendOp = VK_BLEND_OP_ADD;
+    VkBlendFactor srcAlphaBlendFactor = VK_BLEND_FACTOR_ONE;
+    VkBlendFactor dstAlphaBlendFactor = VK_BLEND_FACTOR_ZERO;
+    VkBlendOp alphaBlendOp = VK_BLEND_OP_ADD;
+    VkColorComponentFlags colorWriteMask = VK_COLOR_COMPONENT_R_BIT | VK_COLOR_COMPONENT_G_BIT |
+                                           VK_COLOR_COMPONENT_B_BIT | VK_COLOR_COMPONENT_A_BIT;
+
+    // Attachment formats
+    std::vector<VkFormat> colorFormats;
+    VkFormat depthFormat = VK_FORMAT_UNDEFINED;
+
+    std::vector<VkDynamicState> dynamicStates = {
+        VK_DYNAMIC_STATE_VIEWPORT,
+        VK_DYNAMIC_STATE_SCISSOR
+    };
+// --------------------------------------------------------------------------------
+
+    /**
+     * @brief Returns a hash of every field in the description
+     */
+    size_t hash() const;
+// --------------------------------------------------------------------------------
+
+    /**
+     * @brief Compares every field in the description
+     */
+    bool operator==(const PipelineDesc& other) const;
+// --------------------------------------------------------------------------------
+
+    bool operator!=(const PipelineDesc& other) const { return !(*this == other); }
+};
+// ================================================================================
+// ================================================================================
+
+class DeletionQueue;
+// --------------------------------------------------------------------------------
+
+/**
+ * @class PipelineStateCache
+ * @brief Returns an existing VkPipeline for a matching PipelineDesc and only
+ * compiles a new pipeline on a miss.
+ *
+ * Graphics pipelines are keyed on the description together with the layout,
+ * render pass and subpass they are compiled against.  Compute pipelines are
+ * keyed on their shader and layout.  Compiles go through a VkPipelineCache so
+ * the driver can also reuse work across distinct keys, and its contents can be
+ * saved so the next run starts warm.  Shader code comes from
+ * a ShaderLibrary, which may have been filled before the device existed.  The
+ * cache owns every pipeline it returns.
+ *
+ * When a shader changes, rebuildPipelines() compiles replacements for every
+ * pipeline that uses it on the job system, and swapRebuiltPipelines() puts
+ * them in place between frames.  Each rebuild compiles into a VkPipelineCache
+ * of its own, merged into the main one by the swap, so a rebuild never holds
+ * up a miss on the caller's thread.  Callers holding a handle must request it
+ * again after a swap.  Every other member function must be called from one
+ * thread.
+ */
+class PipelineStateCache {
+public:
+    /**
+     * @brief Creates the cache and its backing VkPipelineCache
+     *
+     * @param device The logical device
+     * @param shaders The shader code pipelines are compiled from; an empty
+     *        library is created when null
+     * @param initialData Data returned by loadCacheData().  The driver ignores
+     *        data written by a different driver or device.
+     * @param externallySynchronized Lets the driver skip locking the
+     *        VkPipelineCache.  Requires the pipelineCreationCacheControl
+     *        feature.
+     */
+    explicit PipelineStateCache(VkDevice device,
+                                std::unique_ptr<ShaderLibrary> shaders = nullptr,
+                                const std::vector<char>& initialData = {},
+                                bool externallySynchronized = false);
+// --------------------------------------------------------------------------------
+
+    /**
+     * @brief Destroys every cached pipeline and the VkPipelineCache
+     */
+    ~PipelineStateCache();
+// --------------------------------------------------------------------------------
+
+    /**
+     * @brief Returns the pipeline for a description, compiling it on a miss
+     *
+     * @param desc The fixed-function and shader description of the pipeline
+     * @param layout The pipeline layout
+     * @param renderPass A render pass compatible with desc.colorFormats and desc.depthFormat
+     * @param subpass The subpass index the pipeline is used in
+     * @return A pipeline owned by the cache
+     */
+    VkPipeline getPipeline(const PipelineDesc& desc,
+                           VkPipelineLayout layout,
+                           VkRenderPass renderPass,
+                           uint32_t subpass = 0);
+// --------------------------------------------------------------------------------
+
+    /**
+     * @brief Returns the compute pipeline for a shader, compiling it on a miss
+     *
+     * @param computeShader The path to the SPIR-V compute shader
+     * @param layout The pipeline layout
+     * @return A pipeline owned by the cache
+     */
+    VkPipeline getComputePipeline(const std::string& computeShader, VkPipelineLayout layout);
+// --------------------------------------------------------------------------------
+
+    /**
+     * @brief Compiles new versions of every cached pipeline that uses a shader
+     * on the job system.  The shader's code must already be updated in the
+     * ShaderLibrary.  Nothing changes until swapRebuiltPipelines() is called.
+     *
+     * @param shader The path of the SPIR-V file that changed
+     * @param jobs The job system the pipelines are compiled on
+     */
+    void rebuildPipelines(const std::string& shader, JobSystem& jobs);
+// --------------------------------------------------------------------------------
+
+    /**
+     * @brief Replaces pipelines with the finished rebuilds.  The replaced
+     * pipelines are handed to a deletion queue, so frames in flight may keep
+     * using them.  A rebuild that failed to compile is reported and the old
+     * pipelines are kept.  Never waits for a rebuild in progress.
+     *
+     * @param retired The queue that destroys the replaced pipelines
+     * @return The number of pipelines replaced
+     */
+    size_t swapRebuiltPipelines(DeletionQueue& retired);
+// --------------------------------------------------------------------------------
+
+    /**
+     * @brief Destroys every cached pipeline, waiting for rebuilds in progress.
+     * The caller must ensure none are in use.
+     */
+    void clear();
+// --------------------------------------------------------------------------------
+
+    /**
+     * @brief Returns the number of requests served from the cache
+     */
+    uint64_t getHits() const;
+// --------------------------------------------------------------------------------
+
+    /**
+     * @brief Returns the number of requests that required a compile
+     */
+    uint64_t getMisses() const;
+// --------------------------------------------------------------------------------
+
+    /**
+     * @brief Returns the number of pipelines currently held by the cache
+     */
+    size_t size() const;
+// --------------------------------------------------------------------------------
+
+    /**
+     * @brief Returns the driver pipeline cache used for misses.  Rebuilds are
+     * merged into it when they are swapped in.
+     */
+    VkPipelineCache getVkPipelineCache() const;
+// --------------------------------------------------------------------------------
+
+    ShaderLibrary& getShaderLibrary();
+// --------------------------------------------------------------------------------
+
+    /**
+     * @brief Writes the driver pipeline cache to a file.  Failures are reported
+     * but not thrown, since a missing cache only costs compile time.
+     *
+     * @param path The file to write
+     */
+    void saveCacheData(const std::string& path) const;
+// --------------------------------------------------------------------------------
+
+    /**
+     * @brief Reads a file written by saveCacheData().  Needs no device, so it can
+     * run while the device is being created.
+     *
+     * @param path The file to read
+     * @return The file contents, or nothing if the file does not exist
+     */
+    static std::vector<char> loadCacheData(const std::string& path);
+// ================================================================================
+private:
+    /**
+     * @brief The full key of a cached pipeline
+     */
+    struct Key {
+        PipelineDesc desc;
+        VkPipelineLayout layout;
+        VkRenderPass renderPass;
+        uint32_t subpass;
+// --------------------------------------------------------------------------------
+
+        bool operator==(const Key& other) const {
+            return layout == other.layout && renderPass == other.renderPass &&
+                   subpass == other.subpass && desc == other.desc;
+        }
+    };
+// --------------------------------------------------------------------------------
+
+    struct KeyHash {
+        size_t operator()(const Key& key) const {
+            size_t seed = key.desc.hash();
+            hashCombine(seed, key.layout);
+            hashCombine(seed, key.renderPass);
+            hashCombine(seed, key.subpass);
+            return seed;
+        }
+    };
+// --------------------------------------------------------------------------------
+
+    struct ComputeKey {
+        std::string computeShader;
+        VkPipelineLayout layout;
+// --------------------------------------------------------------------------------
+
+        bool operator==(const ComputeKey& other) const {
+            return layout == other.layout && computeShader == other.computeShader;
+        }
+    };
+// --------------------------------------------------------------------------------
+
+    struct ComputeKeyHash {
+        size_t operator()(const ComputeKey& key) const {
+            size_t seed = 0;
+            hashCombine(seed, key.computeShader);
+            hashCombine(seed, key.layout);
+            return seed;
+        }
+    };
+// --------------------------------------------------------------------------------
+
+    /**
+     * @brief The replacements compiled for one changed shader
+     */
+    struct Rebuild {
+        std::string shader;
+        uint64_t request;
+        std::vector<std::pair<Key, VkPipeline>> pipelines;
+        std::vector<std::pair<ComputeKey, VkPipeline>> computePipelines;
+        VkPipelineCache cache = VK_NULL_HANDLE;
+        std::string error;
+    };
+// --------------------------------------------------------------------------------
+
+    VkDevice device;
+    VkPipelineCache pipelineCache = VK_NULL_HANDLE;
+    bool externallySynchronized;
+    std::unique_ptr<ShaderLibrary> shaders;
+    std::unordered_map<Key, VkPipeline, KeyHash> pipelines;
+    std::unordered_map<ComputeKey, VkPipeline, ComputeKeyHash> computePipelines;
+    uint64_t hits = 0;
+    uint64_t misses = 0;
+
+    // The latest rebuild requested for each shader; older ones are discarded
+    std::unordered_map<std::string, uint64_t> latestRebuilds;
+    uint64_t rebuildRequests = 0;
+    JobCounter rebuildJobs;
+    std::mutex rebuildMutex;
+    std::vector<Rebuild> finishedRebuilds;
+// --------------------------------------------------------------------------------
+
+    /**
+     * @brief Destroys the pipelines of a rebuild that will not be swapped in,
+     * along with its VkPipelineCache
+     */
+    void discard(const Rebuild& rebuild);
+// --------------------------------------------------------------------------------
+
+    VkPipeline createPipeline(const Key& key, VkPipelineCache cache);
+// --------------------------------------------------------------------------------
+
+    VkPipeline createComputePipeline(const ComputeKey& key, VkPipelineCache cache);
+// --------------------------------------------------------------------------------
+
+    VkShaderModule createShaderModule(const std::vector<char>& code);
+};
+// ================================================================================
+// ================================================================================
+
+#endif /* pipeline_cache_HPP */
+// ================================================================================
+// ================================================================================
+// eof
@@ -23,6 +23,16 @@
 struct QueueFamilyIndices {
     std::optional<uint32_t> graphicsFamily;
     std::optional<uint32_t> presentFamily;
+
+    // A queue family for uploads; a family without graphics or compute support
+    // is preferred since it usually maps to the GPU's copy engine.  Falls back
+    // to the graphics family when no other family supports transfers.
+    std::optional<uint32_t> transferFamily;
+
+    // A queue family for async compute; a compute family without graphics
+    // support runs alongside the graphics queue.  Falls back to the graphics
+    // family, which always supports compute.
+    std::optional<uint32_t> computeFamily;
 // --------------------------------------------------------------------------------
 
     bool isComplete() const {
@@ -34,6 +44,13 @@ struct QueueFamilyIndices {
 
 class QueueFamily {
 public:
+    /**
+     * @brief Selects the queue families of a device
+     *
+     * @param device The physical device
+     * @param surface The surface presented to, or VK_NULL_HANDLE when rendering
+     *        headless, in which case the present family is the graphics family
+     */
     static QueueFamilyIndices findQueueFamilies(VkPhysicalDevice device, VkSurfaceKHR surface);
 };
 // ================================================================================
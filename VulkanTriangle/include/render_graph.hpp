@@ -0,0 +1,283 @@
+// ================================================================================
+// ================================================================================
+// - File:    render_graph.hpp
+// - Purpose: This file contains a frame graph that derives barriers from the
+//            declared inputs and outputs of each pass and aliases the memory of
+//            transient images whose lifetimes do not overlap
+//
+// Source Metadata
+// - Author:  Jonathan A. Webb
+// - Date:    October 18, 2026
+// - Version: 1.0
+// - Copyright: Copyright 2022, Jon Webb Inc.
+// ================================================================================
+// ================================================================================
+// Include modules here
+
+#ifndef render_graph_HPP
+#define render_graph_HPP
+
+#include <vulkan/vulkan.h>
+#include "residency_manager.hpp"
+#include <vector>
+#include <string>
+#include <functional>
+// ================================================================================
+// ================================================================================
+
+/**
+ * @brief A handle to an image declared in a RenderGraph
+ */
+using RenderGraphResource = uint32_t;
+// --------------------------------------------------------------------------------
+
+/**
+ * @brief The ways a pass may use an image.  Each usage maps onto one pipeline
+ * stage, access mask and image layout.
+ */
+enum class ResourceUsage {
+    ColorAttachment,
+    DepthAttachment,
+    SampledRead,
+    StorageRead,
+    StorageWrite,
+    TransferSrc,
+    TransferDst,
+    Present
+};
+// --------------------------------------------------------------------------------
+
+/**
+ * @brief The synchronization state of an image between two passes
+ */
+struct ResourceState {
+    VkPipelineStageFlags2 stages = VK_PIPELINE_STAGE_2_NONE;
+    VkAccessFlags2 access = VK_ACCESS_2_NONE;
+    VkImageLayout layout = VK_IMAGE_LAYOUT_UNDEFINED;
+};
+// --------------------------------------------------------------------------------
+
+/**
+ * @brief Describes an image whose contents only live for the duration of a
+ * frame.  An image with more than one layer gets a 2D array view, as a
+ * multiview render pass needs.
+ */
+struct TransientImageDesc {
+    VkFormat format = VK_FORMAT_UNDEFINED;
+    VkExtent2D extent{0, 0};
+    VkImageUsageFlags usage = 0;
+    VkImageAspectFlags aspect = VK_IMAGE_ASPECT_COLOR_BIT;
+    VkSampleCountFlagBits samples = VK_SAMPLE_COUNT_1_BIT;
+    uint32_t layers = 1;
+};
+// --------------------------------------------------------------------------------
+
+/**
+ * @brief A single image used by a pass
+ */
+struct PassResource {
+    RenderGraphResource resource;
+    ResourceUsage usage;
+};
+// --------------------------------------------------------------------------------
+
+/**
+ * @brief Figures reported by RenderGraph::compile().  The graph is recorded
+ * identically every frame, so these are also the per-frame figures.
+ */
+struct RenderGraphStats {
+    uint32_t passCount = 0;
+    uint32_t culledPassCount = 0;
+    uint32_t barrierCount = 0;
+    uint32_t barrierBatchCount = 0;
+    VkDeviceSize transientMemoryRequested = 0;
+    VkDeviceSize transientMemoryAllocated = 0;
+// --------------------------------------------------------------------------------
+
+    /**
+     * @brief Returns the number of bytes saved by aliasing transient images
+     */
+    VkDeviceSize memorySaved() const { return transientMemoryRequested - transientMemoryAllocated; }
+};
+// ================================================================================
+// ================================================================================
+
+/**
+ * @class RenderGraph
+ * @brief Schedules passes from their declared image usages.
+ *
+ * Passes are added in submission order together with the images they use.
+ * compile() culls passes whose results are never consumed, computes the
+ * lifetime of every transient image, packs transient images that are never
+ * alive at the same time into the same memory, and precomputes one batched
+ * vkCmdPipelineBarrier2 per pass.  execute() then replays the passes with
+ * their barriers every frame without further analysis.
+ *
+ * Imported images, such as swap chain images, are owned elsewhere and may be
+ * swapped with setImportedImage() between frames.  Transient images are owned
+ * by the graph.
+ */
+class RenderGraph {
+public:
+    using ExecuteFn = std::function<void(VkCommandBuffer, const RenderGraph&)>;
+// --------------------------------------------------------------------------------
+
+    /**
+     * @brief Creates an empty graph
+     *
+     * @param device The logical device
+     * @param physicalDevice The physical device used to select transient memory
+     * @param residency If not nullptr, transient memory is allocated through it
+     *                  at render target priority
+     */
+    RenderGraph(VkDevice device, VkPhysicalDevice physicalDevice, ResidencyManager* residency = nullptr);
+// --------------------------------------------------------------------------------
+
+    /**
+     * @brief Destroys every transient image and its memory
+     */
+    ~RenderGraph();
+// --------------------------------------------------------------------------------
+
+    /**
+     * @brief Declares an image that is owned outside the graph
+     *
+     * @param name A name used in error messages
+     * @param aspect The aspect of the image covered by barriers
+     * @param initialState The state of the image when the graph begins executing
+     * @param finalUsage The usage the image is transitioned to after the last pass
+     * @return A handle to the image
+     */
+    RenderGraphResource importImage(const std::string& name,
+                                    VkImageAspectFlags aspect,
+                                    ResourceState initialState,
+                                    ResourceUsage finalUsage);
+// --------------------------------------------------------------------------------
+
+    /**
+     * @brief Sets the image behind an imported handle, typically once per frame
+     */
+    void setImportedImage(RenderGraphResource resource, VkImage image, VkImageView view);
+// --------------------------------------------------------------------------------
+
+    /**
+     * @brief Declares an image that is created, owned and aliased by the graph
+     *
+     * @param name A name used in error messages
+     * @param desc The format, extent and usage of the image
+     * @return A handle to the image
+     */
+    RenderGraphResource createImage(const std::string& name, const TransientImageDesc& desc);
+// --------------------------------------------------------------------------------
+
+    /**
+     * @brief Appends a pass to the graph
+     *
+     * @param name A name used in error messages
+     * @param resources Every image the pass reads or writes, each listed once
+     * @param execute Records the commands of the pass
+     */
+    void addPass(const std::string& name,
+                 std::vector<PassResource> resources,
+                 ExecuteFn execute);
+// --------------------------------------------------------------------------------
+
+    /**
+     * @brief Culls unused passes, allocates transient memory and precomputes
+     * every barrier.  No resources or passes may be added afterwards.
+     */
+    void compile();
+// --------------------------------------------------------------------------------
+
+    /**
+     * @brief Records every live pass with its barriers into a command buffer
+     *
+     * @param commandBuffer A command buffer in the recording state
+     */
+    void execute(VkCommandBuffer commandBuffer);
+// --------------------------------------------------------------------------------
+
+    VkImage getImage(RenderGraphResource resource) const;
+// --------------------------------------------------------------------------------
+
+    VkImageView getImageView(RenderGraphResource resource) const;
+// --------------------------------------------------------------------------------
+
+    const RenderGraphStats& getStats() const;
+// --------------------------------------------------------------------------------
+
+    /**
+     * @brief Returns the stage, access mask and layout that a usage requires
+     */
+    static ResourceState stateFor(ResourceUsage usage);
+// ================================================================================
+private:
+    struct Resource {
+        std::string name;
+        bool imported = false;
+        TransientImageDesc desc;
+        VkImageAspectFlags aspect = VK_IMAGE_ASPECT_COLOR_BIT;
+        ResourceState initialState;
+        ResourceUsage finalUsage = ResourceUsage::Present;
+        VkImage image = VK_NULL_HANDLE;
+        VkImageView view = VK_NULL_HANDLE;
+
+        // Filled in by compile()
+        int firstPass = -1;
+        int lastPass = -1;
+        VkDeviceSize size = 0;
+        VkDeviceSize offset = 0;
+        std::vector<RenderGraphResource> aliases;
+    };
+// --------------------------------------------------------------------------------
+
+    struct Pass {
+        std::string name;
+        std::vector<PassResource> resources;
+        ExecuteFn execute;
+        bool live = false;
+    };
+// --------------------------------------------------------------------------------
+
+    struct Barrier {
+        RenderGraphResource resource;
+        ResourceState src;
+        ResourceState dst;
+    };
+// --------------------------------------------------------------------------------
+
+    VkDevice device;
+    VkPhysicalDevice physicalDevice;
+    std::vector<Resource> resources;
+    std::vector<Pass> passes;
+    std::vector<std::vector<Barrier>> passBarriers;
+    std::vector<Barrier> finalBarriers;
+    std::vector<VkImageMemoryBarrier2> scratchBarriers;
+    ResidencyManager* residency;
+    VkDeviceMemory transientMemory = VK_NULL_HANDLE;
+    ResidencyHandle transientResidency = 0;
+    RenderGraphStats stats;
+    bool compiled = false;
+// --------------------------------------------------------------------------------
+
+    void cullPasses();
+// --------------------------------------------------------------------------------
+
+    void computeLifetimes();
+// --------------------------------------------------------------------------------
+
+    void allocateTransientImages();
+// --------------------------------------------------------------------------------
+
+    void computeBarriers();
+// --------------------------------------------------------------------------------
+
+    void recordBarriers(VkCommandBuffer commandBuffer, const std::vector<Barrier>& barriers);
+};
+// ================================================================================
+// ================================================================================
+
+#endif /* render_graph_HPP */
+// ================================================================================
+// ================================================================================
+// eof
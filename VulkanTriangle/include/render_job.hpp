@@ -0,0 +1,121 @@
+// ================================================================================
+// ================================================================================
+// - File:    render_job.hpp
+// - Purpose: This file contains the descriptions of offline render jobs and the
+//            scenes they draw, and the parsers for their text files
+//
+// Source Metadata
+// - Author:  Jonathan A. Webb
+// - Date:    October 18, 2026
+// - Version: 1.0
+// - Copyright: Copyright 2022, Jon Webb Inc.
+// ================================================================================
+// ================================================================================
+// Include modules here
+
+#ifndef render_job_HPP
+#define render_job_HPP
+
+#include <cstdint>
+#include <istream>
+#include <string>
+#include <vector>
+// ================================================================================
+// ================================================================================
+
+/**
+ * @brief One triangle of a scene, placed the way DrawPushConstants places it
+ */
+struct SceneTriangle {
+    float offset[2] = {0.0f, 0.0f};
+    float scale = 1.0f;
+};
+// --------------------------------------------------------------------------------
+
+/**
+ * @brief Everything a scene file describes
+ */
+struct SceneDesc {
+    float tint[4] = {1.0f, 1.0f, 1.0f, 1.0f};
+    std::vector<SceneTriangle> triangles;
+};
+// --------------------------------------------------------------------------------
+
+/**
+ * @brief A 2D camera.  The view is centered on (x, y) and magnified by zoom.
+ */
+struct RenderCamera {
+    float x = 0.0f;
+    float y = 0.0f;
+    float zoom = 1.0f;
+};
+// --------------------------------------------------------------------------------
+
+/**
+ * @brief One image to render offline
+ */
+struct RenderJob {
+    std::string scenePath;
+    RenderCamera camera;
+    uint32_t width = 0;
+    uint32_t height = 0;
+
+    // Written as PNG, or as headerless RGBA when the name ends in .rgba
+    std::string outputPath;
+};
+// ================================================================================
+// ================================================================================
+
+/**
+ * @brief Parses a scene file.  Each line holds one command, and # starts a
+ * comment:
+ *
+ *     tint <r> <g> <b>
+ *     triangle <x> <y> <scale>
+ *
+ * @param input The file contents
+ * @param name The file name used in error messages
+ * @throws std::runtime_error naming the line of the first malformed command
+ */
+SceneDesc parseScene(std::istream& input, const std::string& name);
+// --------------------------------------------------------------------------------
+
+/**
+ * @brief Parses a job file.  Each line describes one job, and # starts a
+ * comment:
+ *
+ *     <scene> <width> <height> <camera x> <camera y> <zoom> <output>
+ *
+ * Relative scene and output paths are resolved against baseDirectory.
+ *
+ * @param input The file contents
+ * @param name The file name used in error messages
+ * @param baseDirectory The directory relative paths are resolved against
+ * @throws std::runtime_error naming the line of the first malformed job
+ */
+std::vector<RenderJob> parseRenderJobs(std::istream& input,
+                                       const std::string& name,
+                                       const std::string& baseDirectory);
+// --------------------------------------------------------------------------------
+
+/**
+ * @brief Reads and parses a scene file
+ *
+ * @throws std::runtime_error if the file cannot be read or is malformed
+ */
+SceneDesc loadScene(const std::string& path);
+// --------------------------------------------------------------------------------
+
+/**
+ * @brief Reads and parses a job file, resolving paths against its directory
+ *
+ * @throws std::runtime_error if the file cannot be read or is malformed
+ */
+std::vector<RenderJob> loadRenderJobs(const std::string& path);
+// ================================================================================
+// ================================================================================
+
+#endif /* render_job_HPP */
+// ================================================================================
+// ================================================================================
+// eof
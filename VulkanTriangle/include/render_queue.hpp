@@ -0,0 +1,229 @@
+// ================================================================================
+// ================================================================================
+// - File:    render_queue.hpp
+// - Purpose: This file contains a queue that sorts draws by their state before
+//            recording them, so each bind is only issued when it changes
+//
+// Source Metadata
+// - Author:  Jonathan A. Webb
+// - Date:    October 18, 2026
+// - Version: 1.0
+// - Copyright: Copyright 2022, Jon Webb Inc.
+// ================================================================================
+// ================================================================================
+// Include modules here
+
+#ifndef render_queue_HPP
+#define render_queue_HPP
+
+#include <vulkan/vulkan.h>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+// ================================================================================
+// ================================================================================
+
+/**
+ * @brief Everything needed to record one draw.  Handles left null are not
+ * bound, and the draw inherits whatever the previous draw bound.
+ */
+struct DrawItem {
+    // Draws with a lower pass are recorded first, e.g. opaque before blended
+    uint8_t pass = 0;
+
+    // Within a pass and state group, lower depths are drawn first, in [0, 1]
+    float depth = 0.0f;
+
+    VkPipeline pipeline = VK_NULL_HANDLE;
+    VkPipelineLayout layout = VK_NULL_HANDLE;
+
+    // Bound at set 0; a dynamic offset is passed when hasDynamicOffset is set
+    VkDescriptorSet descriptorSet = VK_NULL_HANDLE;
+    uint32_t dynamicOffset = 0;
+    bool hasDynamicOffset = false;
+
+    // Bound at binding 0
+    VkBuffer vertexBuffer = VK_NULL_HANDLE;
+    VkDeviceSize vertexOffset = 0;
+
+    uint32_t vertexCount = 0;
+    uint32_t instanceCount = 1;
+    uint32_t firstVertex = 0;
+    uint32_t firstInstance = 0;
+};
+// --------------------------------------------------------------------------------
+
+/**
+ * @brief State change counts for the draws recorded by RenderQueue.  A state
+ * change is any bind or push constant update.
+ */
+struct RenderQueueStats {
+    uint64_t flushes = 0;
+    uint64_t draws = 0;
+    uint64_t stateChanges = 0;
+
+    // The state changes the same draws would have needed in submission order
+    uint64_t unsortedStateChanges = 0;
+};
+// ================================================================================
+// ================================================================================
+
+/**
+ * @class RenderQueue
+ * @brief Collects the draws of a render pass and records them sorted by state.
+ *
+ * Each draw is given a 64-bit key, from the most significant bits down:
+ *
+ *   4 bits pass | 12 bits pipeline | 24 bits material | 24 bits depth
+ *
+ * Pipelines and materials, the descriptor set and vertex buffer a draw binds,
+ * are numbered in the order they are first seen since the last flush.  The
+ * keys are sorted with an LSD radix sort over a packed key and index array,
+ * and binds are only recorded when the state differs from the previous draw.
+ * The draws themselves are never moved.
+ *
+ * The queue keeps its arrays between flushes, and numbers are kept with the
+ * flush they belong to rather than cleared, so steady state submission does
+ * not allocate.  Every member function must be called from one thread.
+ */
+class RenderQueue {
+public:
+    /**
+     * @brief Queues a draw
+     *
+     * @param item The draw
+     * @param pushConstants Data pushed at offset 0 for the draw, or null
+     * @param pushConstantSize The size of the push constant data in bytes
+     * @param pushConstantStages The stages the push constants are visible to
+     * @throws std::runtime_error if the draw has no pipeline, or a flush uses
+     *         more pipelines or materials than its key can number
+     */
+    void submit(const DrawItem& item,
+                const void* pushConstants = nullptr,
+                uint32_t pushConstantSize = 0,
+                VkShaderStageFlags pushConstantStages = 0);
+// --------------------------------------------------------------------------------
+
+    /**
+     * @brief Sorts the queued draws, records them and empties the queue.  Must
+     * be called inside the render pass the draws belong to.
+     *
+     * @param commandBuffer The command buffer to record into
+     */
+    void flush(VkCommandBuffer commandBuffer);
+// --------------------------------------------------------------------------------
+
+    /**
+     * @brief Returns the number of draws waiting for flush()
+     */
+    size_t size() const;
+// --------------------------------------------------------------------------------
+
+    /**
+     * @brief Returns the counts of the most recent flush
+     */
+    const RenderQueueStats& getLastFlushStats() const;
+// --------------------------------------------------------------------------------
+
+    /**
+     * @brief Returns the counts summed over every flush
+     */
+    const RenderQueueStats& getTotalStats() const;
+// ================================================================================
+private:
+    /**
+     * @brief A draw as stored by the queue, with its push constants kept in a
+     * shared byte array
+     */
+    struct QueuedDraw {
+        DrawItem item;
+        uint32_t pushConstantOffset;
+        uint32_t pushConstantSize;
+        VkShaderStageFlags pushConstantStages;
+    };
+// --------------------------------------------------------------------------------
+
+    /**
+     * @brief The state a draw binds after its pipeline
+     */
+    struct Material {
+        VkPipelineLayout layout;
+        VkDescriptorSet descriptorSet;
+        uint32_t dynamicOffset;
+        bool hasDynamicOffset;
+        VkBuffer vertexBuffer;
+        VkDeviceSize vertexOffset;
+// --------------------------------------------------------------------------------
+
+        bool operator==(const Material& other) const;
+    };
+// --------------------------------------------------------------------------------
+
+    struct MaterialHash {
+        size_t operator()(const Material& material) const;
+    };
+// --------------------------------------------------------------------------------
+
+    struct SortEntry {
+        uint64_t key;
+        uint32_t index;
+    };
+// --------------------------------------------------------------------------------
+
+    /**
+     * @brief A pipeline or material number, valid only during the flush it was
+     * assigned in
+     */
+    struct KeyId {
+        uint32_t id;
+        uint64_t flush;
+    };
+// --------------------------------------------------------------------------------
+
+    std::vector<QueuedDraw> draws;
+    std::vector<uint8_t> pushConstantData;
+    std::vector<SortEntry> entries;
+    std::vector<SortEntry> scratch;
+    std::unordered_map<VkPipeline, KeyId> pipelineIds;
+    std::unordered_map<Material, KeyId, MaterialHash> materialIds;
+    uint32_t pipelineCount = 0;
+    uint32_t materialCount = 0;
+    RenderQueueStats lastFlush;
+    RenderQueueStats total;
+// --------------------------------------------------------------------------------
+
+    /**
+     * @brief Sorts entries by key, leaving the result in entries
+     */
+    void radixSort();
+// --------------------------------------------------------------------------------
+
+    /**
+     * @brief Returns the number of a pipeline or material in the current flush,
+     * assigning the next one if it has not been seen since the last flush
+     */
+    template <typename Map, typename Key>
+    uint32_t assignId(Map& ids, const Key& key, uint32_t& count);
+// --------------------------------------------------------------------------------
+
+    /**
+     * @brief Drops the pipelines and materials not used by the last flush once
+     * they outnumber the used ones, e.g. after pipelines are rebuilt
+     */
+    template <typename Map>
+    void pruneIds(Map& ids, uint32_t count);
+// --------------------------------------------------------------------------------
+
+    /**
+     * @brief Walks the draws in sorted or submission order and counts the state
+     * changes, recording the draws as well when a command buffer is given
+     */
+    uint64_t walk(VkCommandBuffer commandBuffer, bool sorted) const;
+};
+// ================================================================================
+// ================================================================================
+
+#endif /* render_queue_HPP */
+// ================================================================================
+// ================================================================================
+// eof
@@ -0,0 +1,242 @@
+// ================================================================================
+// ================================================================================
+// - File:    residency_manager.hpp
+// - Purpose: This file contains a manager that tracks device memory per heap
+//            against the budget reported by VK_EXT_memory_budget and evicts
+//            low priority resources before an allocation would fail
+//
+// Source Metadata
+// - Author:  Jonathan A. Webb
+// - Date:    October 18, 2026
+// - Version: 1.0
+// - Copyright: Copyright 2022, Jon Webb Inc.
+// ================================================================================
+// ================================================================================
+// Include modules here
+
+#ifndef residency_manager_HPP
+#define residency_manager_HPP
+
+#include <vulkan/vulkan.h>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+// ================================================================================
+// ================================================================================
+
+/**
+ * @brief Identifies an allocation tracked by a ResidencyManager.  Handles are
+ * never reused.
+ */
+using ResidencyHandle = uint64_t;
+// --------------------------------------------------------------------------------
+
+/**
+ * @brief Well known priorities.  Any value in [0, 1] may be used; higher values
+ * are evicted last and are passed to VK_EXT_memory_priority when it is enabled.
+ */
+const float RESIDENCY_PRIORITY_LOW = 0.25f;
+const float RESIDENCY_PRIORITY_NORMAL = 0.5f;
+const float RESIDENCY_PRIORITY_HIGH = 0.75f;
+const float RESIDENCY_PRIORITY_RENDER_TARGET = 1.0f;
+// --------------------------------------------------------------------------------
+
+/**
+ * @brief The budget and usage of one memory heap, in bytes
+ */
+struct HeapBudget {
+    VkDeviceSize size = 0;
+    VkDeviceSize budget = 0;
+    VkDeviceSize usage = 0;
+    VkDeviceSize tracked = 0;
+// --------------------------------------------------------------------------------
+
+    /**
+     * @brief Returns the bytes that can still be allocated within the budget
+     */
+    VkDeviceSize available() const { return usage < budget ? budget - usage : 0; }
+};
+// ================================================================================
+// ================================================================================
+
+/**
+ * @class ResidencyManager
+ * @brief Keeps device memory usage within the budget the driver grants us.
+ *
+ * When VK_EXT_memory_budget is enabled the budget and usage of every heap are
+ * read from the driver, so memory claimed by other processes on the same GPU
+ * shrinks our budget.  Without it the budget falls back to a fixed fraction
+ * of each heap and usage to the bytes allocated through the manager.  The
+ * figures are refreshed every few frames and adjusted by every allocation and
+ * free in between.
+ *
+ * Each allocation carries a priority and an optional eviction callback.  When
+ * an allocation would exceed the budget, or the budget shrinks below usage,
+ * resources on the same heap are offered for eviction in order of ascending
+ * priority and then least recent use.  A callback may release the whole
+ * resource or downgrade it, for example by dropping its largest mip levels, and
+ * returns the number of bytes the resource still holds.  Resources used within
+ * the frames in flight are never offered, so a callback may free memory
+ * immediately.
+ *
+ * Callbacks are invoked with the manager locked and must not call back into it.
+ */
+class ResidencyManager {
+public:
+    /**
+     * @brief Releases all or part of a resource
+     *
+     * @param bytesNeeded The number of bytes the manager is trying to free
+     * @return The number of bytes the resource holds afterwards; zero if it was
+     *         released entirely, in which case its memory must have been freed
+     */
+    using EvictFn = std::function<VkDeviceSize(VkDeviceSize bytesNeeded)>;
+// --------------------------------------------------------------------------------
+
+    /**
+     * @param physicalDevice The physical device whose heaps are tracked
+     * @param device The logical device allocations are made from
+     * @param memoryBudgetEnabled True if VK_EXT_memory_budget was enabled
+     * @param memoryPriorityEnabled True if VK_EXT_memory_priority was enabled
+     * @param framesInFlight The number of frames the GPU may lag behind
+     */
+    ResidencyManager(VkPhysicalDevice physicalDevice,
+                     VkDevice device,
+                     bool memoryBudgetEnabled,
+                     bool memoryPriorityEnabled,
+                     uint32_t framesInFlight);
+// --------------------------------------------------------------------------------
+
+    ResidencyManager(const ResidencyManager&) = delete;
+    ResidencyManager& operator=(const ResidencyManager&) = delete;
+// --------------------------------------------------------------------------------
+
+    /**
+     * @brief Advances the frame counter used to age resources.  Refreshes the
+     * budget periodically and trims heaps whose usage exceeds it.
+     */
+    void beginFrame(uint64_t frameNumber);
+// --------------------------------------------------------------------------------
+
+    /**
+     * @brief Reads the current budget and usage of every heap
+     */
+    void updateBudget();
+// --------------------------------------------------------------------------------
+
+    /**
+     * @brief Allocates device memory, evicting lower priority resources first if
+     * the allocation would not fit in the budget
+     *
+     * @param allocInfo The allocation to make; its pNext chain is preserved
+     * @param priority The priority of the new allocation in [0, 1]
+     * @param name A name used in reports
+     * @param evict Releases the resource when memory is needed elsewhere, or
+     *              nullptr if the resource must stay resident
+     * @param memory Receives the allocated memory
+     * @return A handle to the allocation
+     */
+    ResidencyHandle allocate(const VkMemoryAllocateInfo& allocInfo,
+                             float priority,
+                             const std::string& name,
+                             EvictFn evict,
+                             VkDeviceMemory& memory);
+// --------------------------------------------------------------------------------
+
+    /**
+     * @brief Frees memory returned by allocate().  Does nothing if the resource
+     * was evicted entirely, since its callback already freed the memory.
+     */
+    void free(ResidencyHandle handle, VkDeviceMemory memory);
+// --------------------------------------------------------------------------------
+
+    /**
+     * @brief Marks a resource as used by the current frame
+     */
+    void touch(ResidencyHandle handle);
+// --------------------------------------------------------------------------------
+
+    void setPriority(ResidencyHandle handle, float priority);
+// --------------------------------------------------------------------------------
+
+    /**
+     * @brief Returns false once a resource has been evicted entirely
+     */
+    bool isResident(ResidencyHandle handle) const;
+// --------------------------------------------------------------------------------
+
+    /**
+     * @brief Evicts resources from a heap until a number of bytes fit within its
+     * budget
+     *
+     * @return true if the bytes fit afterwards
+     */
+    bool makeRoom(uint32_t heapIndex, VkDeviceSize bytes);
+// --------------------------------------------------------------------------------
+
+    uint32_t getHeapCount() const;
+// --------------------------------------------------------------------------------
+
+    HeapBudget getHeapBudget(uint32_t heapIndex) const;
+// --------------------------------------------------------------------------------
+
+    uint32_t getHeapIndex(uint32_t memoryTypeIndex) const;
+// --------------------------------------------------------------------------------
+
+    uint64_t getEvictionCount() const;
+// ================================================================================
+private:
+    struct Allocation {
+        std::string name;
+        uint32_t heapIndex;
+        VkDeviceSize size;
+        float priority;
+        uint64_t lastUsedFrame;
+        EvictFn evict;
+    };
+// --------------------------------------------------------------------------------
+
+    VkPhysicalDevice physicalDevice;
+    VkDevice device;
+    bool memoryBudgetEnabled;
+    bool memoryPriorityEnabled;
+    uint32_t framesInFlight;
+
+    VkPhysicalDeviceMemoryProperties memoryProperties{};
+    std::vector<HeapBudget> heaps;
+
+    mutable std::mutex mutex;
+    std::unordered_map<ResidencyHandle, Allocation> allocations;
+    ResidencyHandle nextHandle = 1;
+    uint64_t currentFrame = 0;
+    uint64_t lastBudgetFrame = 0;
+    uint64_t evictionCount = 0;
+// --------------------------------------------------------------------------------
+
+    void updateBudgetLocked();
+// --------------------------------------------------------------------------------
+
+    bool makeRoomLocked(uint32_t heapIndex, VkDeviceSize bytes);
+// --------------------------------------------------------------------------------
+
+    /**
+     * @brief Offers resources on a heap for eviction until a number of bytes
+     * has been released
+     *
+     * @return The number of bytes released
+     */
+    VkDeviceSize evictLocked(uint32_t heapIndex, VkDeviceSize bytes);
+// --------------------------------------------------------------------------------
+
+    VkDeviceSize budgetLimit(const HeapBudget& heap) const;
+};
+// ================================================================================
+// ================================================================================
+
+#endif /* residency_manager_HPP */
+// ================================================================================
+// ================================================================================
+// eof
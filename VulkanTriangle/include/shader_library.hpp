@@ -0,0 +1,83 @@
+// ================================================================================
+// ================================================================================
+// - File:    shader_library.hpp
+// - Purpose: This file contains a thread-safe cache of SPIR-V files read from
+//            disk
+//
+// Source Metadata
+// - Author:  Jonathan A. Webb
+// - Date:    October 18, 2026
+// - Version: 1.0
+// - Copyright: Copyright 2022, Jon Webb Inc.
+// ================================================================================
+// ================================================================================
+// Include modules here
+
+#ifndef shader_library_HPP
+#define shader_library_HPP
+
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+// ================================================================================
+// ================================================================================
+
+/**
+ * @brief The contents of one SPIR-V file
+ */
+struct ShaderCode {
+    std::vector<char> code;
+    uint64_t hash = 0;  // FNV-1a of code, so a reloaded file can be compared cheaply
+};
+// ================================================================================
+// ================================================================================
+
+/**
+ * @class ShaderLibrary
+ * @brief Holds SPIR-V files keyed on their path.
+ *
+ * Files can be read ahead of time on any thread, for example while the device
+ * is still being created, and are then served from memory when pipelines are
+ * compiled.  Entries are shared, so code handed out stays valid even if the
+ * file is loaded again.
+ */
+class ShaderLibrary {
+public:
+    /**
+     * @brief Reads a file from disk, replacing any cached copy.  Thread-safe.
+     *
+     * @param path The SPIR-V file
+     * @return The file contents
+     * @throws std::runtime_error if the file cannot be read
+     */
+    std::shared_ptr<const ShaderCode> load(const std::string& path);
+// --------------------------------------------------------------------------------
+
+    /**
+     * @brief Returns the cached contents of a file, reading it on a miss.
+     * Thread-safe.
+     *
+     * @throws std::runtime_error if the file cannot be read
+     */
+    std::shared_ptr<const ShaderCode> get(const std::string& path);
+// --------------------------------------------------------------------------------
+
+    /**
+     * @brief Returns the number of cached files
+     */
+    size_t size() const;
+// ================================================================================
+private:
+    mutable std::mutex mutex;
+    std::unordered_map<std::string, std::shared_ptr<const ShaderCode>> shaders;
+};
+// ================================================================================
+// ================================================================================
+
+#endif /* shader_library_HPP */
+// ================================================================================
+// ================================================================================
+// eof
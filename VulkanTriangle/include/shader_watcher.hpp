@@ -0,0 +1,111 @@
+// ================================================================================
+// ================================================================================
+// - File:    shader_watcher.hpp
+// - Purpose: This file contains a class that recompiles GLSL shaders when they
+//            change on disk
+//
+// Source Metadata
+// - Author:  Jonathan A. Webb
+// - Date:    October 18, 2026
+// - Version: 1.0
+// - Copyright: Copyright 2022, Jon Webb Inc.
+// ================================================================================
+// ================================================================================
+// Include modules here
+
+#ifndef shader_watcher_HPP
+#define shader_watcher_HPP
+
+#include "shader_library.hpp"
+#include <atomic>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+// ================================================================================
+// ================================================================================
+
+/**
+ * @class ShaderWatcher
+ * @brief Watches a directory of GLSL shaders with inotify and recompiles a
+ * shader on a background thread when it is saved.
+ *
+ * A shader compiles to <source>.spv in the output directory.  The file is written
+ * under a temporary name and renamed, so a reader never sees a partial file.
+ * When the new code differs from the code in the ShaderLibrary, the library
+ * is updated and the SPIR-V path is reported by takeChangedShaders().  A
+ * failed compile leaves the previous file and library entry in place and
+ * prints the compiler output.
+ */
+class ShaderWatcher {
+public:
+    /**
+     * @brief Starts watching a directory
+     *
+     * @param directory The directory holding the GLSL sources
+     * @param outputDirectory The directory the SPIR-V is written to
+     * @param shaders The library updated with recompiled code
+     * @param compiler The glslangValidator executable
+     * @throws std::runtime_error if the directory cannot be watched
+     */
+    ShaderWatcher(const std::string& directory,
+                  const std::string& outputDirectory,
+                  ShaderLibrary& shaders,
+                  const std::string& compiler);
+// --------------------------------------------------------------------------------
+
+    /**
+     * @brief Stops the watcher thread, waiting for a compile in progress
+     */
+    ~ShaderWatcher();
+// --------------------------------------------------------------------------------
+
+    ShaderWatcher(const ShaderWatcher&) = delete;
+    ShaderWatcher& operator=(const ShaderWatcher&) = delete;
+// --------------------------------------------------------------------------------
+
+    /**
+     * @brief Returns the SPIR-V paths whose code changed since the last call.
+     * Thread-safe.
+     */
+    std::vector<std::string> takeChangedShaders();
+// --------------------------------------------------------------------------------
+
+    /**
+     * @brief Returns the compiler output of the last failed compile, or an
+     * empty string if the last compile succeeded.  Thread-safe.
+     */
+    std::string getLastError() const;
+// ================================================================================
+private:
+    std::string directory;
+    std::string outputDirectory;
+    ShaderLibrary& shaders;
+    std::string compiler;
+    int inotifyFd = -1;
+    std::atomic<bool> stopping{false};
+    std::thread thread;
+
+    mutable std::mutex mutex;
+    std::vector<std::string> changed;
+    std::string lastError;
+// --------------------------------------------------------------------------------
+
+    void watch();
+// --------------------------------------------------------------------------------
+
+    /**
+     * @brief Compiles one source file and reports its SPIR-V if it changed
+     */
+    void compile(const std::string& fileName);
+// --------------------------------------------------------------------------------
+
+    static bool isShaderSource(const std::string& fileName);
+};
+// ================================================================================
+// ================================================================================
+
+#endif /* shader_watcher_HPP */
+// ================================================================================
+// ================================================================================
+// eof
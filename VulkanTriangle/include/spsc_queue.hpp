@@ -0,0 +1,107 @@
+// ================================================================================
+// ================================================================================
+// - File:    spsc_queue.hpp
+// - Purpose: This file contains a lock-free, bounded, single-producer
+//            single-consumer queue
+//
+// Source Metadata
+// - Author:  Jonathan A. Webb
+// - Date:    October 18, 2026
+// - Version: 1.0
+// - Copyright: Copyright 2022, Jon Webb Inc.
+// ================================================================================
+// ================================================================================
+// Include modules here
+
+#ifndef spsc_queue_HPP
+#define spsc_queue_HPP
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+// ================================================================================
+// ================================================================================
+
+/**
+ * @brief The assumed size of a cache line, used to keep the producer and
+ * consumer indices from sharing one
+ */
+const size_t CACHE_LINE_SIZE = 64;
+// ================================================================================
+// ================================================================================
+
+/**
+ * @class SpscQueue
+ * @brief A bounded ring buffer for exactly one producer thread and one consumer
+ * thread.
+ *
+ * Neither side ever blocks or takes a lock.  Each side keeps a private copy of
+ * the other side's index and only reloads the shared atomic when its copy says
+ * the queue is full or empty, so the common case touches no shared cache line
+ * except its own.
+ *
+ * @tparam T The element type, which must be default constructible and copyable
+ * @tparam Capacity The number of elements, which must be a power of two
+ */
+template <typename T, size_t Capacity>
+class SpscQueue {
+    static_assert(Capacity > 0 && (Capacity & (Capacity - 1)) == 0,
+                  "SpscQueue capacity must be a power of two");
+public:
+    /**
+     * @brief Appends an element.  Must only be called from the producer thread.
+     *
+     * @param value The element to append
+     * @return false if the queue is full and the element was dropped
+     */
+    bool push(const T& value) {
+        const size_t currentTail = tail.load(std::memory_order_relaxed);
+        if (currentTail - cachedHead == Capacity) {
+            cachedHead = head.load(std::memory_order_acquire);
+            if (currentTail - cachedHead == Capacity) {
+                return false;
+            }
+        }
+        buffer[currentTail & (Capacity - 1)] = value;
+        tail.store(currentTail + 1, std::memory_order_release);
+        return true;
+    }
+// --------------------------------------------------------------------------------
+
+    /**
+     * @brief Removes the oldest element.  Must only be called from the consumer thread.
+     *
+     * @param value Where the element is written
+     * @return false if the queue is empty
+     */
+    bool pop(T& value) {
+        const size_t currentHead = head.load(std::memory_order_relaxed);
+        if (currentHead == cachedTail) {
+            cachedTail = tail.load(std::memory_order_acquire);
+            if (currentHead == cachedTail) {
+                return false;
+            }
+        }
+        value = buffer[currentHead & (Capacity - 1)];
+        head.store(currentHead + 1, std::memory_order_release);
+        return true;
+    }
+// ================================================================================
+private:
+    // Consumer side
+    alignas(CACHE_LINE_SIZE) std::atomic<size_t> head{0};
+    size_t cachedTail = 0;
+
+    // Producer side
+    alignas(CACHE_LINE_SIZE) std::atomic<size_t> tail{0};
+    size_t cachedHead = 0;
+
+    alignas(CACHE_LINE_SIZE) std::array<T, Capacity> buffer{};
+};
+// ================================================================================
+// ================================================================================
+
+#endif /* spsc_queue_HPP */
+// ================================================================================
+// ================================================================================
+// eof
@@ -0,0 +1,140 @@
+// ================================================================================
+// ================================================================================
+// - File:    startup_graph.hpp
+// - Purpose: This file contains a class that runs the independent steps of
+//            application startup concurrently and reports when each ran
+//
+// Source Metadata
+// - Author:  Jonathan A. Webb
+// - Date:    October 18, 2026
+// - Version: 1.0
+// - Copyright: Copyright 2022, Jon Webb Inc.
+// ================================================================================
+// ================================================================================
+// Include modules here
+
+#ifndef startup_graph_HPP
+#define startup_graph_HPP
+
+#include "job_system.hpp"
+#include <chrono>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+// ================================================================================
+// ================================================================================
+
+/**
+ * @class StartupGraph
+ * @brief Schedules startup steps on the job system and records a timeline.
+ *
+ * Steps that only touch files or thread-safe Vulkan entry points run on
+ * workers, grouped by JobCounter, while steps that must stay on the main
+ * thread, such as window creation, run in between with runHere().  join() is
+ * where the main thread waits for a group, which is the only place the order
+ * Vulkan requires is enforced.
+ *
+ * A step that throws does not take a worker down; the first exception is kept
+ * and rethrown by the next join(), and steps that have not started yet are
+ * skipped.  Counters passed to the graph must outlive it, since the destructor
+ * waits for them.
+ */
+class StartupGraph {
+public:
+    /**
+     * @param jobs The job system steps run on
+     */
+    explicit StartupGraph(JobSystem& jobs);
+// --------------------------------------------------------------------------------
+
+    /**
+     * @brief Waits for every step still running without rethrowing, so an
+     * exception on the main thread never unwinds state a worker still writes
+     */
+    ~StartupGraph();
+// --------------------------------------------------------------------------------
+
+    StartupGraph(const StartupGraph&) = delete;
+    StartupGraph& operator=(const StartupGraph&) = delete;
+// --------------------------------------------------------------------------------
+
+    /**
+     * @brief Runs a step on a worker
+     *
+     * @param name The name shown in the timeline
+     * @param step The work
+     * @param group The counter the step is added to
+     */
+    void run(const std::string& name, std::function<void()> step, JobCounter& group);
+// --------------------------------------------------------------------------------
+
+    /**
+     * @brief Runs a step on a worker once every step in another group finished
+     *
+     * @param dependency The group that must finish first
+     * @param name The name shown in the timeline
+     * @param step The work
+     * @param group The counter the step is added to
+     */
+    void runAfter(JobCounter& dependency, const std::string& name, std::function<void()> step, JobCounter& group);
+// --------------------------------------------------------------------------------
+
+    /**
+     * @brief Runs a step on the calling thread.  Exceptions propagate directly.
+     */
+    void runHere(const std::string& name, const std::function<void()>& step);
+// --------------------------------------------------------------------------------
+
+    /**
+     * @brief Waits for a group, helping with queued steps meanwhile
+     *
+     * @throws The first exception thrown by any worker step
+     */
+    void join(JobCounter& group);
+// --------------------------------------------------------------------------------
+
+    /**
+     * @brief Prints every step in start order with its thread and time span
+     */
+    void print(std::ostream& out) const;
+// ================================================================================
+private:
+    struct Step {
+        std::string name;
+        uint32_t thread;
+        double startMilliseconds;
+        double endMilliseconds;
+    };
+
+    JobSystem& jobs;
+    std::chrono::steady_clock::time_point origin;
+
+    mutable std::mutex mutex;
+    std::vector<Step> steps;
+    std::unordered_map<std::thread::id, uint32_t> threadIndices;
+    std::vector<JobCounter*> groups;
+    std::exception_ptr error;
+// --------------------------------------------------------------------------------
+
+    /**
+     * @brief Returns the step wrapped so that it is timed and cannot throw
+     */
+    std::function<void()> wrap(const std::string& name, std::function<void()> step);
+// --------------------------------------------------------------------------------
+
+    void record(const std::string& name,
+                std::chrono::steady_clock::time_point start,
+                std::chrono::steady_clock::time_point end);
+};
+// ================================================================================
+// ================================================================================
+
+#endif /* startup_graph_HPP */
+// ================================================================================
+// ================================================================================
+// eof
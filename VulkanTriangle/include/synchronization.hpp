@@ -0,0 +1,209 @@
+// ================================================================================
+// ================================================================================
+// - File:    synchronization.hpp
+// - Purpose: This file contains the timeline semaphores that order work between
+//            queues and the CPU, and a class that owns the semaphores used to
+//            pace frames between the CPU and GPU
+//
+// Source Metadata
+// - Author:  Jonathan A. Webb
+// - Date:    October 18, 2026
+// - Version: 1.0
+// - Copyright: Copyright 2022, Jon Webb Inc.
+// ================================================================================
+// ================================================================================
+// Include modules here
+
+#ifndef synchronization_HPP
+#define synchronization_HPP
+
+#include <vulkan/vulkan.h>
+#include <cstdint>
+#include <vector>
+// ================================================================================
+// ================================================================================
+
+class DeletionQueue;
+// --------------------------------------------------------------------------------
+
+/**
+ * @brief Fills a VkSemaphoreSubmitInfo for vkQueueSubmit2
+ *
+ * @param semaphore The semaphore to wait on or signal
+ * @param value The timeline value, ignored for binary semaphores
+ * @param stageMask The stages that wait, or that must finish before the signal
+ */
+VkSemaphoreSubmitInfo semaphoreSubmitInfo(VkSemaphore semaphore,
+                                          uint64_t value,
+                                          VkPipelineStageFlags2 stageMask);
+// ================================================================================
+// ================================================================================
+
+/**
+ * @class TimelineSemaphore
+ * @brief A timeline semaphore whose value counts the submissions to one queue.
+ *
+ * Every submission reserves the next value with reserve() and signals it, so
+ * the value of any piece of work tells other queues what to wait on and tells
+ * the CPU when the resources it used can be reused or destroyed.  Values must
+ * be submitted in the order they were reserved, which holds as long as one
+ * thread at a time submits to the queue.
+ */
+class TimelineSemaphore {
+public:
+    /**
+     * @param device The logical device
+     */
+    explicit TimelineSemaphore(VkDevice device);
+// --------------------------------------------------------------------------------
+
+    ~TimelineSemaphore();
+// --------------------------------------------------------------------------------
+
+    TimelineSemaphore(const TimelineSemaphore&) = delete;
+    TimelineSemaphore& operator=(const TimelineSemaphore&) = delete;
+// --------------------------------------------------------------------------------
+
+    VkSemaphore getSemaphore() const;
+// --------------------------------------------------------------------------------
+
+    /**
+     * @brief Returns the value the next submission must signal
+     */
+    uint64_t reserve();
+// --------------------------------------------------------------------------------
+
+    /**
+     * @brief Returns the most recently reserved value, which is signaled once
+     * every submission made so far has finished
+     */
+    uint64_t getPendingValue() const;
+// --------------------------------------------------------------------------------
+
+    /**
+     * @brief Returns true once the GPU has signaled a value.  Only queries the
+     * driver when the last observed value is not high enough.
+     */
+    bool isComplete(uint64_t value) const;
+// --------------------------------------------------------------------------------
+
+    /**
+     * @brief Blocks until the GPU has signaled a value
+     */
+    void wait(uint64_t value) const;
+// --------------------------------------------------------------------------------
+
+    /**
+     * @brief Returns a wait operation for vkQueueSubmit2
+     *
+     * @param value The value to wait for
+     * @param stageMask The stages that may not start before the value is signaled
+     */
+    VkSemaphoreSubmitInfo waitInfo(uint64_t value, VkPipelineStageFlags2 stageMask) const;
+// --------------------------------------------------------------------------------
+
+    /**
+     * @brief Returns a signal operation for vkQueueSubmit2
+     *
+     * @param value A value returned by reserve()
+     * @param stageMask The stages that must finish before the value is signaled
+     */
+    VkSemaphoreSubmitInfo signalInfo(uint64_t value, VkPipelineStageFlags2 stageMask) const;
+// ================================================================================
+private:
+    VkDevice device;
+    VkSemaphore semaphore = VK_NULL_HANDLE;
+    uint64_t pendingValue = 0;
+    mutable uint64_t completedValue = 0;
+};
+// ================================================================================
+// ================================================================================
+
+/**
+ * @class SyncObjects
+ * @brief Owns the per-frame synchronization primitives.
+ *
+ * One image-available semaphore exists per frame in flight.  Render-finished
+ * semaphores are created per swap chain image, since the presentation engine
+ * may still hold one when the frame index wraps.  Both stay binary because the
+ * swap chain only accepts binary semaphores.
+ *
+ * Frames are throttled on the graphics queue's timeline rather than on fences:
+ * each frame slot remembers the timeline value its last submission signals.
+ */
+class SyncObjects {
+public:
+    /**
+     * @brief Creates the semaphores
+     *
+     * @param device The logical device
+     * @param graphicsTimeline The timeline of the queue frames are submitted to
+     * @param framesInFlight The number of frames the CPU may record ahead of the GPU
+     * @param imageCount The number of swap chain images
+     */
+    SyncObjects(VkDevice device,
+                const TimelineSemaphore& graphicsTimeline,
+                uint32_t framesInFlight,
+                uint32_t imageCount);
+// --------------------------------------------------------------------------------
+
+    /**
+     * @brief Destroys all semaphores
+     */
+    ~SyncObjects();
+// --------------------------------------------------------------------------------
+
+    VkSemaphore getImageAvailableSemaphore(uint32_t frameIndex) const;
+// --------------------------------------------------------------------------------
+
+    VkSemaphore getRenderFinishedSemaphore(uint32_t imageIndex) const;
+// --------------------------------------------------------------------------------
+
+    /**
+     * @brief Replaces the render-finished semaphores after the swap chain image
+     * count changed.  Presents in flight may still wait on the old ones, so they
+     * are destroyed through the deletion queue.
+     *
+     * @param imageCount The number of swap chain images
+     * @param deletionQueue The queue that destroys the old semaphores
+     */
+    void setImageCount(uint32_t imageCount, DeletionQueue& deletionQueue);
+// --------------------------------------------------------------------------------
+
+    /**
+     * @brief Records the timeline value signaled by a frame's submission
+     */
+    void setFrameValue(uint32_t frameIndex, uint64_t value);
+// --------------------------------------------------------------------------------
+
+    /**
+     * @brief Blocks until the last submission of a frame slot has finished
+     */
+    void waitForFrame(uint32_t frameIndex) const;
+// --------------------------------------------------------------------------------
+
+    /**
+     * @brief Blocks until every frame in flight has finished
+     */
+    void waitForAllFrames() const;
+// ================================================================================
+private:
+    VkDevice device;
+    const TimelineSemaphore& graphicsTimeline;
+    std::vector<VkSemaphore> imageAvailableSemaphores;
+    std::vector<VkSemaphore> renderFinishedSemaphores;
+    std::vector<uint64_t> frameValues;
+// --------------------------------------------------------------------------------
+
+    void createSyncObjects(uint32_t framesInFlight, uint32_t imageCount);
+// --------------------------------------------------------------------------------
+
+    void createRenderFinishedSemaphores(uint32_t imageCount);
+};
+// ================================================================================
+// ================================================================================
+
+#endif /* synchronization_HPP */
+// ================================================================================
+// ================================================================================
+// eof
@@ -0,0 +1,125 @@
+// ================================================================================
+// ================================================================================
+// - File:    texture_file.hpp
+// - Purpose: This file contains a reader for DDS and KTX2 texture containers
+//            that parses the header once and reads mip levels on demand
+//
+// Source Metadata
+// - Author:  Jonathan A. Webb
+// - Date:    October 18, 2026
+// - Version: 1.0
+// - Copyright: Copyright 2022, Jon Webb Inc.
+// ================================================================================
+// ================================================================================
+// Include modules here
+
+#ifndef texture_file_HPP
+#define texture_file_HPP
+
+#include <vulkan/vulkan.h>
+#include <cstdint>
+#include <string>
+#include <vector>
+// ================================================================================
+// ================================================================================
+
+/**
+ * @brief The location and size of one mip level within a texture file
+ */
+struct TextureLevel {
+    uint32_t width;
+    uint32_t height;
+    uint64_t fileOffset;
+    uint64_t size;
+};
+// ================================================================================
+// ================================================================================
+
+/**
+ * @class TextureFile
+ * @brief A 2D texture stored in a DDS or KTX2 container.
+ *
+ * The constructor reads only the header and the location of every mip level.
+ * Levels are read later with readLevels(), which opens the file on every call
+ * and may therefore run on several threads at once.
+ *
+ * DDS files may use the legacy DXT1/DXT3/DXT5/ATI1/ATI2 codes, a DX10 header
+ * with a BC1-BC7 or RGBA8 format, or uncompressed 32 bit RGBA.  KTX2 files must
+ * not be supercompressed; Basis Universal and Zstandard payloads need a
+ * transcoder that is not part of this project.
+ */
+class TextureFile {
+public:
+    /**
+     * @brief Parses the header of a texture file
+     *
+     * @param path The file to open; the container is chosen by its contents
+     */
+    explicit TextureFile(const std::string& path);
+// --------------------------------------------------------------------------------
+
+    /**
+     * @brief Reads a contiguous run of mip levels into memory
+     *
+     * @param firstLevel The largest level to read
+     * @param levelCount The number of levels to read
+     * @param offsets Receives the offset of each level within the returned data
+     * @return The tightly packed data of every level, largest first
+     */
+    std::vector<uint8_t> readLevels(uint32_t firstLevel,
+                                    uint32_t levelCount,
+                                    std::vector<uint64_t>& offsets) const;
+// --------------------------------------------------------------------------------
+
+    const std::string& getPath() const;
+// --------------------------------------------------------------------------------
+
+    VkFormat getFormat() const;
+// --------------------------------------------------------------------------------
+
+    uint32_t getLevelCount() const;
+// --------------------------------------------------------------------------------
+
+    const TextureLevel& getLevel(uint32_t level) const;
+// --------------------------------------------------------------------------------
+
+    /**
+     * @brief Returns the bytes occupied by the levels from firstLevel to the end
+     */
+    uint64_t getSizeFrom(uint32_t firstLevel) const;
+// --------------------------------------------------------------------------------
+
+    /**
+     * @brief Returns the size of one texel block in bytes, or zero if the
+     * format is not supported
+     */
+    static uint32_t blockSize(VkFormat format);
+// --------------------------------------------------------------------------------
+
+    /**
+     * @brief Returns true for block compressed formats, whose texel blocks
+     * cover 4x4 pixels
+     */
+    static bool isBlockCompressed(VkFormat format);
+// ================================================================================
+private:
+    std::string path;
+    VkFormat format = VK_FORMAT_UNDEFINED;
+    std::vector<TextureLevel> levels;
+// --------------------------------------------------------------------------------
+
+    void parseDds(const std::vector<uint8_t>& header);
+// --------------------------------------------------------------------------------
+
+    void parseKtx2(const std::vector<uint8_t>& header);
+// --------------------------------------------------------------------------------
+
+    uint64_t levelSize(uint32_t width, uint32_t height) const;
+};
+// ================================================================================
+// ================================================================================
+
+#endif /* texture_file_HPP */
+// ================================================================================
+// ================================================================================
+// eof
@@ -0,0 +1,350 @@
+// ================================================================================
+// ================================================================================
+// - File:    texture_streamer.hpp
+// - Purpose: This file contains a subsystem that reads textures on background
+//            threads and streams their mip levels to the GPU through a staging
+//            ring on the transfer queue, within a device memory budget
+//
+// Source Metadata
+// - Author:  Jonathan A. Webb
+// - Date:    October 18, 2026
+// - Version: 1.0
+// - Copyright: Copyright 2022, Jon Webb Inc.
+// ================================================================================
+// ================================================================================
+// Include modules here
+
+#ifndef texture_streamer_HPP
+#define texture_streamer_HPP
+
+#include <vulkan/vulkan.h>
+#include "buffers.hpp"
+#include "command_buffers.hpp"
+#include "job_system.hpp"
+#include "queues.hpp"
+#include "residency_manager.hpp"
+#include "synchronization.hpp"
+#include "texture_file.hpp"
+#include <cstdint>
+#include <memory>
+#include <memory_resource>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+// ================================================================================
+// ================================================================================
+
+/**
+ * @brief Identifies a texture loaded by a TextureStreamer
+ */
+using TextureHandle = uint32_t;
+// --------------------------------------------------------------------------------
+
+/**
+ * @brief Counters describing the state of a TextureStreamer
+ */
+struct TextureStreamingStats {
+    uint32_t textureCount = 0;
+    uint32_t pendingLoads = 0;
+    uint32_t batchesInFlight = 0;
+    VkDeviceSize bytesResident = 0;
+    uint64_t bytesUploaded = 0;
+    uint64_t promotions = 0;
+    uint64_t demotions = 0;
+};
+// ================================================================================
+// ================================================================================
+
+/**
+ * @class TextureStreamer
+ * @brief Loads textures asynchronously and keeps the mip levels the screen
+ * needs resident within a memory budget.
+ *
+ * Each texture is held in up to two images.  The tail image holds the mip
+ * levels of at most TEXTURE_STREAMING_TAIL_SIZE pixels; it is read and
+ * uploaded as soon as the texture is loaded, so every texture has something to
+ * sample within a few frames, and it stays resident until shutdown.  The
+ * streamed image holds every level from the one the screen asks for down to the
+ * smallest.  It is replaced when a sharper level is wanted and released when
+ * the budget runs short, at which point sampling falls back to the tail.
+ *
+ * Files are parsed and read on the JobSystem.  Uploads are copied into a
+ * StagingRing, recorded in batches on the transfer queue family, and polled
+ * on the transfer queue's timeline, so the render thread never waits on
+ * either.  Replaced images are destroyed once the graphics timeline shows that
+ * no frame still in flight can sample them.  Images use
+ * concurrent sharing between the transfer and graphics families, which avoids
+ * queue ownership transfers.
+ *
+ * Streamed images are registered with the ResidencyManager at low priority, so
+ * device memory pressure from elsewhere evicts them before anything else.
+ *
+ * Every member function must be called from the render thread.
+ */
+class TextureStreamer {
+public:
+    /**
+     * @param device The logical device
+     * @param physicalDevice The physical device, used to check format support
+     * @param queueFamilies The queue families the device was created with
+     * @param transferQueue The queue uploads are submitted to
+     * @param transferTimeline The timeline signaled by submissions to transferQueue
+     * @param graphicsTimeline The timeline signaled by the frames that sample textures
+     * @param residency The manager device memory is allocated through
+     * @param jobs The job system files are read on
+     */
+    TextureStreamer(VkDevice device,
+                    VkPhysicalDevice physicalDevice,
+                    const QueueFamilyIndices& queueFamilies,
+                    VkQueue transferQueue,
+                    TimelineSemaphore& transferTimeline,
+                    const TimelineSemaphore& graphicsTimeline,
+                    ResidencyManager& residency,
+                    JobSystem& jobs);
+// --------------------------------------------------------------------------------
+
+    /**
+     * @brief Waits for outstanding reads and uploads and destroys every image.
+     * The GPU must no longer sample any texture.
+     */
+    ~TextureStreamer();
+// --------------------------------------------------------------------------------
+
+    TextureStreamer(const TextureStreamer&) = delete;
+    TextureStreamer& operator=(const TextureStreamer&) = delete;
+// --------------------------------------------------------------------------------
+
+    /**
+     * @brief Starts loading a DDS or KTX2 texture.  Returns immediately; the
+     * texture has no image view until its tail has been uploaded.
+     *
+     * @param path The texture file
+     * @return A handle to the texture
+     */
+    TextureHandle load(const std::string& path);
+// --------------------------------------------------------------------------------
+
+    /**
+     * @brief Sets the number of pixels the texture covers along its larger
+     * screen axis, which selects the sharpest mip level worth streaming.
+     * Textures without a request stream to full resolution.
+     */
+    void requestResolution(TextureHandle handle, uint32_t screenPixels);
+// --------------------------------------------------------------------------------
+
+    /**
+     * @brief Marks a texture as sampled by the current frame, which protects it
+     * from eviction while the frame is in flight
+     */
+    void markUsed(TextureHandle handle);
+// --------------------------------------------------------------------------------
+
+    /**
+     * @brief Retires finished uploads, submits new ones and rebalances mip
+     * residency against the budget.  Call once per frame after the frame
+     * slot's previous submission has been waited on.
+     *
+     * @param frameNumber A counter that increases by one every frame
+     * @param scratch Memory for lists that only live for the call, such as a
+     *        FrameArena
+     */
+    void update(uint64_t frameNumber, std::pmr::memory_resource* scratch = std::pmr::get_default_resource());
+// --------------------------------------------------------------------------------
+
+    /**
+     * @brief Returns a view of the sharpest resident mip levels, or
+     * VK_NULL_HANDLE if nothing has been uploaded yet.  The view changes as
+     * levels stream in and out and must be fetched again every frame.
+     */
+    VkImageView getImageView(TextureHandle handle) const;
+// --------------------------------------------------------------------------------
+
+    /**
+     * @brief Returns the sharpest resident mip level, or UINT32_MAX if nothing
+     * is resident
+     */
+    uint32_t getResidentMip(TextureHandle handle) const;
+// --------------------------------------------------------------------------------
+
+    TextureStreamingStats getStats() const;
+// --------------------------------------------------------------------------------
+
+    /**
+     * @brief Returns the sharpest mip level worth sampling when a texture
+     * covers a number of pixels on screen
+     *
+     * @param textureSize The size of mip level 0 along its larger axis
+     * @param screenPixels The pixels covered along the larger screen axis
+     */
+    static uint32_t mipForScreenSize(uint32_t textureSize, uint32_t screenPixels);
+// ================================================================================
+private:
+    /**
+     * @brief A GPU image holding a run of mip levels from firstMip down to the
+     * smallest level
+     */
+    struct StreamImage {
+        TextureHandle texture;
+        bool tail;
+        bool uploaded = false;
+        uint32_t firstMip;
+        VkImage image = VK_NULL_HANDLE;
+        VkImageView view = VK_NULL_HANDLE;
+        VkDeviceMemory memory = VK_NULL_HANDLE;
+        VkDeviceSize size = 0;
+        ResidencyHandle residencyHandle = 0;
+    };
+// --------------------------------------------------------------------------------
+
+    struct Texture {
+        std::string path;
+        std::shared_ptr<const TextureFile> file;
+        bool failed = false;
+        bool loading = true;
+        uint32_t requestedPixels = UINT32_MAX;
+        uint64_t lastUsedFrame = 0;
+        uint64_t tailImage = 0;
+        uint64_t streamedImage = 0;
+    };
+// --------------------------------------------------------------------------------
+
+    /**
+     * @brief Mip data read by a job and waiting to be uploaded
+     */
+    struct LoadResult {
+        TextureHandle texture;
+        bool tail;
+        uint32_t firstMip = 0;
+        std::shared_ptr<const TextureFile> file;
+        std::vector<uint8_t> data;
+        std::vector<uint64_t> offsets;
+        std::string error;
+    };
+// --------------------------------------------------------------------------------
+
+    struct UploadBatch {
+        VkCommandBuffer commandBuffer;
+        uint64_t timelineValue = 0;
+        bool inFlight = false;
+        uint64_t ringEnd = 0;
+        std::vector<uint64_t> images;
+    };
+// --------------------------------------------------------------------------------
+
+    VkDevice device;
+    VkPhysicalDevice physicalDevice;
+    VkQueue transferQueue;
+    TimelineSemaphore& transferTimeline;
+    const TimelineSemaphore& graphicsTimeline;
+    ResidencyManager& residency;
+    JobSystem& jobs;
+    std::vector<uint32_t> sharingFamilies;
+
+    std::unique_ptr<StagingRing> stagingRing;
+    std::unique_ptr<CommandBufferManager> commandBuffers;
+    std::vector<UploadBatch> batches;
+
+    std::vector<Texture> textures;
+    std::unordered_map<uint64_t, StreamImage> images;
+
+    // Image ids paired with the graphics timeline value after which no frame
+    // can sample them
+    std::vector<std::pair<uint64_t, uint64_t>> retiredImages;
+    std::vector<LoadResult> pendingUploads;
+    uint64_t nextImageId = 1;
+    uint64_t currentFrame = 0;
+    uint32_t pendingLoads = 0;
+    VkDeviceSize bytesResident = 0;
+    uint64_t bytesUploaded = 0;
+    uint64_t promotions = 0;
+    uint64_t demotions = 0;
+
+    // Filled by jobs, drained by update()
+    std::mutex completedMutex;
+    std::vector<LoadResult> completedLoads;
+    JobCounter loadCounter;
+// --------------------------------------------------------------------------------
+
+    /**
+     * @brief Reads mip levels from firstMip to the end of a file on the job
+     * system.  The file is parsed first if it has not been yet.
+     */
+    void startLoad(TextureHandle handle, bool tail, uint32_t firstMip);
+// --------------------------------------------------------------------------------
+
+    /**
+     * @brief Moves finished uploads into place and makes their staging memory
+     * available again
+     */
+    void retireBatches();
+// --------------------------------------------------------------------------------
+
+    /**
+     * @brief Destroys retired images the graphics queue has finished with
+     */
+    void destroyRetiredImages();
+// --------------------------------------------------------------------------------
+
+    /**
+     * @brief Copies pending loads into the staging ring and submits them
+     */
+    void submitUploads();
+// --------------------------------------------------------------------------------
+
+    /**
+     * @brief Creates the image for a load and records its upload
+     *
+     * @return false if the staging ring is full
+     */
+    bool recordUpload(LoadResult& load, UploadBatch& batch);
+// --------------------------------------------------------------------------------
+
+    /**
+     * @brief Starts loads for textures that need sharper levels and releases
+     * levels that are no longer needed, within the budget
+     */
+    void balanceResidency(std::pmr::memory_resource* scratch);
+// --------------------------------------------------------------------------------
+
+    /**
+     * @brief Returns the level a texture should be streamed at, limited by the
+     * staging ring capacity
+     */
+    uint32_t desiredMip(const Texture& texture) const;
+// --------------------------------------------------------------------------------
+
+    /**
+     * @brief Returns the first level of a texture's tail
+     */
+    static uint32_t tailMip(const TextureFile& file);
+// --------------------------------------------------------------------------------
+
+    /**
+     * @brief Detaches a texture's streamed image and schedules it for
+     * destruction once the GPU is done with it
+     */
+    void retireStreamedImage(Texture& texture);
+// --------------------------------------------------------------------------------
+
+    /**
+     * @brief Releases an idle streamed image on request of the residency manager
+     */
+    VkDeviceSize evictImage(uint64_t imageId);
+// --------------------------------------------------------------------------------
+
+    /**
+     * @brief Destroys an image and its view and frees its memory
+     *
+     * @param throughResidency False when called from an eviction callback, in
+     *                         which case the manager already dropped the memory
+     */
+    void destroyImage(StreamImage& image, bool throughResidency);
+};
+// ================================================================================
+// ================================================================================
+
+#endif /* texture_streamer_HPP */
+// ================================================================================
+// ================================================================================
+// eof
@@ -0,0 +1,229 @@
+// ================================================================================
+// ================================================================================
+// - File:    upload_manager.hpp
+// - Purpose: This file contains a manager that batches buffer writes into a
+//            staging ring and copies them once per frame on the transfer queue
+//
+// Source Metadata
+// - Author:  Jonathan A. Webb
+// - Date:    October 18, 2026
+// - Version: 1.0
+// - Copyright: Copyright 2022, Jon Webb Inc.
+// ================================================================================
+// ================================================================================
+// Include modules here
+
+#ifndef upload_manager_HPP
+#define upload_manager_HPP
+
+#include <vulkan/vulkan.h>
+#include "buffers.hpp"
+#include "command_buffers.hpp"
+#include "queues.hpp"
+#include "synchronization.hpp"
+#include "upload_plan.hpp"
+#include <cstdint>
+#include <memory>
+#include <vector>
+// ================================================================================
+// ================================================================================
+
+/**
+ * @brief What the graphics submission of a frame must include to use the
+ * buffers written by an upload batch
+ */
+struct UploadSubmission {
+    // Acquires the written ranges from the transfer family.  Null when both
+    // queues are in one family and no ownership transfer is needed.
+    VkCommandBuffer acquireCommandBuffer = VK_NULL_HANDLE;
+
+    // Waits for the batch's copies on the transfer timeline
+    VkSemaphoreSubmitInfo waitInfo{};
+};
+// --------------------------------------------------------------------------------
+
+/**
+ * @brief Counters for the writes handled by an UploadManager
+ */
+struct UploadStats {
+    uint64_t writes = 0;       // Calls to write() that were staged
+    uint64_t bytes = 0;        // Bytes staged
+    uint64_t copyRegions = 0;  // VkBufferCopy regions after coalescing
+    uint64_t submits = 0;      // Batches submitted to the transfer queue
+};
+// ================================================================================
+// ================================================================================
+
+/**
+ * @class UploadManager
+ * @brief Collects writes to device local buffers and uploads them in one
+ * transfer submission per frame.
+ *
+ * write() copies the data into a persistently mapped StagingRing right away.
+ * submit() groups and merges the writes with an UploadPlan and records one
+ * vkCmdCopyBuffer per destination buffer and group, with a barrier between
+ * groups so a later overlapping write always wins.
+ *
+ * When the transfer queue has its own family, the written ranges are released
+ * to the graphics family after the copies, and the command buffer returned in
+ * UploadSubmission acquires them on the graphics queue.  The destination
+ * buffers must either use exclusive sharing, in which case the previous
+ * contents of a written range are discarded, or be shared concurrently with
+ * the transfer family, in which case the ownership transfer has no effect.
+ *
+ * Frames upload with submit().  Bulk data written before the first frame, such
+ * as initial buffer contents, is uploaded with flush() instead.
+ *
+ * The caller must ensure the GPU is no longer reading a range when it is
+ * written, for example by writing into the region of the frame slot that was
+ * just waited on.  Every member function must be called from the render thread.
+ */
+class UploadManager {
+public:
+    /**
+     * @param device The logical device
+     * @param physicalDevice The physical device used to select the staging memory type
+     * @param queueFamilies The queue families the device was created with
+     * @param transferQueue The queue copies are submitted to
+     * @param transferTimeline The timeline signaled by submissions to transferQueue
+     * @param graphicsTimeline The timeline signaled by the frames that read the buffers
+     * @param stagingSize The capacity of the staging ring in bytes
+     * @param batchCount The number of batches that may be in flight at once
+     */
+    UploadManager(VkDevice device,
+                  VkPhysicalDevice physicalDevice,
+                  const QueueFamilyIndices& queueFamilies,
+                  VkQueue transferQueue,
+                  TimelineSemaphore& transferTimeline,
+                  const TimelineSemaphore& graphicsTimeline,
+                  VkDeviceSize stagingSize,
+                  uint32_t batchCount);
+// --------------------------------------------------------------------------------
+
+    /**
+     * @brief Waits for every batch in flight
+     */
+    ~UploadManager();
+// --------------------------------------------------------------------------------
+
+    UploadManager(const UploadManager&) = delete;
+    UploadManager& operator=(const UploadManager&) = delete;
+// --------------------------------------------------------------------------------
+
+    /**
+     * @brief Stages data to be copied into a buffer by the next submit()
+     *
+     * @param buffer The destination, created with VK_BUFFER_USAGE_TRANSFER_DST_BIT
+     * @param offset The offset of the write in the destination
+     * @param data The bytes to write
+     * @param size The number of bytes to write
+     * @return false if the staging ring is full; try again next frame
+     * @throws std::runtime_error if the write is empty or larger than the ring
+     */
+    bool write(VkBuffer buffer, VkDeviceSize offset, const void* data, VkDeviceSize size);
+// --------------------------------------------------------------------------------
+
+    /**
+     * @brief Records and submits the writes staged since the last submission.
+     * Call once per frame before the frame's graphics submission.
+     *
+     * @param submission Receives what the graphics submission must wait on and
+     *        execute
+     * @return false if nothing was submitted, because nothing was written or
+     *         every batch is still in flight
+     */
+    bool submit(UploadSubmission& submission);
+// --------------------------------------------------------------------------------
+
+    /**
+     * @brief Records the graphics timeline value of the frame that consumed the
+     * last batch returned by submit()
+     */
+    void submitted(uint64_t graphicsValue);
+// --------------------------------------------------------------------------------
+
+    /**
+     * @brief Submits the writes staged so far and blocks until the queue that
+     * reads them has them.  Only for uploads made before the first frame,
+     * while no batch is in flight.
+     *
+     * @param queue The queue that reads the written buffers next
+     * @param queueFamily The family of queue.  Unless it is the graphics
+     *        family, the buffers must be shared concurrently with the transfer
+     *        family.
+     * @param timeline The timeline signaled by submissions to queue
+     * @throws std::runtime_error if a batch is still in flight
+     */
+    void flush(VkQueue queue, uint32_t queueFamily, TimelineSemaphore& timeline);
+// --------------------------------------------------------------------------------
+
+    /**
+     * @brief Returns the capacity of the staging ring, the largest single write
+     */
+    VkDeviceSize getStagingSize() const;
+// --------------------------------------------------------------------------------
+
+    /**
+     * @brief Returns the number of writes waiting for submit()
+     */
+    size_t getPendingWriteCount() const;
+// --------------------------------------------------------------------------------
+
+    const UploadStats& getStats() const;
+// ================================================================================
+private:
+    struct UploadBatch {
+        VkCommandBuffer transferCommandBuffer = VK_NULL_HANDLE;
+        VkCommandBuffer acquireCommandBuffer = VK_NULL_HANDLE;
+        uint64_t transferValue = 0;
+        uint64_t graphicsValue = 0;
+        uint64_t ringEnd = 0;
+        bool inFlight = false;
+    };
+// --------------------------------------------------------------------------------
+
+    VkDevice device;
+    VkQueue transferQueue;
+    TimelineSemaphore& transferTimeline;
+    const TimelineSemaphore& graphicsTimeline;
+    uint32_t transferFamily;
+    uint32_t graphicsFamily;
+
+    std::unique_ptr<StagingRing> stagingRing;
+    std::unique_ptr<CommandBufferManager> transferCommandBuffers;
+    std::unique_ptr<CommandBufferManager> acquireCommandBuffers;
+    std::vector<UploadBatch> batches;
+    UploadBatch* lastSubmitted = nullptr;
+
+    // Kept between frames so steady state uploads do not allocate
+    UploadPlan plan;
+    std::vector<VkBufferMemoryBarrier2> ownershipBarriers;
+    UploadStats stats;
+// --------------------------------------------------------------------------------
+
+    /**
+     * @brief Makes batches the graphics queue has finished with available again
+     */
+    void retireBatches();
+// --------------------------------------------------------------------------------
+
+    /**
+     * @brief Records the coalesced copies and the release barriers into a
+     * transfer command buffer
+     */
+    void recordCopies(VkCommandBuffer commandBuffer);
+// --------------------------------------------------------------------------------
+
+    /**
+     * @brief Records ownershipBarriers as acquire operations into a graphics
+     * command buffer
+     */
+    void recordAcquire(VkCommandBuffer commandBuffer);
+};
+// ================================================================================
+// ================================================================================
+
+#endif /* upload_manager_HPP */
+// ================================================================================
+// ================================================================================
+// eof
@@ -0,0 +1,124 @@
+// ================================================================================
+// ================================================================================
+// - File:    upload_plan.hpp
+// - Purpose: This file contains the grouping and merging of staged buffer writes
+//            into the copy commands of one upload batch
+//
+// Source Metadata
+// - Author:  Jonathan A. Webb
+// - Date:    October 18, 2026
+// - Version: 1.0
+// - Copyright: Copyright 2022, Jon Webb Inc.
+// ================================================================================
+// ================================================================================
+// Include modules here
+
+#ifndef upload_plan_HPP
+#define upload_plan_HPP
+
+#include <vulkan/vulkan.h>
+#include <cstdint>
+#include <vector>
+// ================================================================================
+// ================================================================================
+
+/**
+ * @brief One vkCmdCopyBuffer of an upload batch
+ */
+struct UploadCopy {
+    VkBuffer buffer = VK_NULL_HANDLE;
+    uint32_t firstRegion = 0;   // Index of the first region in UploadPlan::getRegions()
+    uint32_t regionCount = 0;
+    bool barrierBefore = false; // The copies of the previous group must finish first
+};
+// ================================================================================
+// ================================================================================
+
+/**
+ * @class UploadPlan
+ * @brief Turns the writes staged for one upload batch into as few copy
+ * commands and regions as possible.
+ *
+ * Writes are sorted by destination, and writes that are adjacent in both the
+ * staging buffer and the destination are merged into one VkBufferCopy region.
+ * The regions of one vkCmdCopyBuffer may not overlap, so a write over a range
+ * of a buffer that the current group already wrote starts a new group.  Groups
+ * are copied in order with a barrier between them, so the later write always
+ * wins.
+ *
+ * Records no commands, so it needs no device.  The vectors are kept between
+ * batches, so steady state planning does not allocate.
+ */
+class UploadPlan {
+public:
+    /**
+     * @brief Adds a write whose data is already in the staging buffer
+     *
+     * @param buffer The destination buffer
+     * @param srcOffset The offset of the data in the staging buffer
+     * @param dstOffset The offset of the write in the destination
+     * @param size The number of bytes written
+     */
+    void add(VkBuffer buffer, VkDeviceSize srcOffset, VkDeviceSize dstOffset, VkDeviceSize size);
+// --------------------------------------------------------------------------------
+
+    /**
+     * @brief Sorts and merges the writes added since the last clear() into
+     * getCopies() and getRegions()
+     */
+    void build();
+// --------------------------------------------------------------------------------
+
+    /**
+     * @brief Forgets the writes and the commands built from them
+     */
+    void clear();
+// --------------------------------------------------------------------------------
+
+    /**
+     * @brief Returns the number of writes added since the last clear()
+     */
+    size_t getWriteCount() const;
+// --------------------------------------------------------------------------------
+
+    /**
+     * @brief Returns the copy commands in the order they must be recorded
+     */
+    const std::vector<UploadCopy>& getCopies() const;
+// --------------------------------------------------------------------------------
+
+    const std::vector<VkBufferCopy>& getRegions() const;
+// ================================================================================
+private:
+    struct PendingWrite {
+        VkBuffer buffer;
+        VkDeviceSize srcOffset;
+        VkDeviceSize dstOffset;
+        VkDeviceSize size;
+        uint32_t group;
+    };
+// --------------------------------------------------------------------------------
+
+    /**
+     * @brief The range of a buffer written by the current group
+     */
+    struct WrittenSpan {
+        VkBuffer buffer;
+        VkDeviceSize begin;
+        VkDeviceSize end;
+    };
+// --------------------------------------------------------------------------------
+
+    std::vector<PendingWrite> pendingWrites;
+    std::vector<WrittenSpan> groupSpans;
+    std::vector<UploadCopy> copies;
+    std::vector<VkBufferCopy> regions;
+    uint32_t currentGroup = 0;
+};
+// ================================================================================
+// ================================================================================
+
+#endif /* upload_plan_HPP */
+// ================================================================================
+// ================================================================================
+// eof
@@ -19,6 +19,7 @@
 #include <GLFW/glfw3.h>
 #include <vector>
 #include <memory>
+#include <mutex>
 #include "window.hpp"
 // ================================================================================
 // ================================================================================
@@ -110,6 +111,11 @@ public:
 
     /**
      * @brief Checks if the requested validation layers are available.
+     *
+     * Enumerating layers makes the loader read every layer manifest, so the
+     * result is computed once and cached.  Thread-safe, which lets the query run
+     * on a worker while the window is created.
+     *
      * @return True if all requested validation layers are available, false otherwise.
      */
     bool checkValidationLayerSupport();
@@ -148,6 +154,8 @@ private:
 // --------------------------------------------------------------------------------
 
     VkDebugUtilsMessengerEXT debugMessenger; ///< The Vulkan debug messenger handle.
+    std::once_flag layerSupportQueried; ///< Guards the one layer enumeration.
+    bool layerSupport = false; ///< The cached result of checkValidationLayerSupport().
     const std::vector<const char*> validationLayers = {
         "VK_LAYER_KHRONOS_validation"
     }; ///< The list of requested validation layers.
@@ -18,7 +18,42 @@
 
 #define GLFW_INCLUDE_VULKAN
 #include <GLFW/glfw3.h>
+#include "spsc_queue.hpp"
 #include <string>
+#include <atomic>
+#include <thread>
+// ================================================================================
+// ================================================================================ 
+
+/**
+ * @brief The kinds of input events forwarded to the render thread.  Window
+ * state such as the framebuffer size is read from the Window instead, since
+ * input may be dropped when the queue is full.
+ */
+enum class WindowEventType {
+    Key,
+    MouseButton,
+    CursorPosition
+};
+// --------------------------------------------------------------------------------
+
+/**
+ * @brief A window system event.  Only the fields relevant to the type are set.
+ */
+struct WindowEvent {
+    WindowEventType type = WindowEventType::Key;
+    int32_t key = 0;
+    int32_t action = 0;
+    int32_t mods = 0;
+    double x = 0.0;
+    double y = 0.0;
+};
+// --------------------------------------------------------------------------------
+
+/**
+ * @brief The queue that carries events from the event thread to the render thread
+ */
+using WindowEventQueue = SpscQueue<WindowEvent, 1024>;
 // ================================================================================
 // ================================================================================ 
 
@@ -52,6 +87,51 @@ public:
      */
     virtual void pollEvents() = 0; 
 // --------------------------------------------------------------------------------
+
+    /**
+     * @brief Blocks until an event arrives or the timeout expires, then processes events.
+     *
+     * This pure virtual method must be implemented by derived classes so that
+     * idle loops can sleep in the window system instead of spinning.
+     *
+     * @param timeout The maximum time to wait in seconds
+     */
+    virtual void waitEventsTimeout(double timeout) = 0;
+// --------------------------------------------------------------------------------
+
+    /**
+     * @brief Checks if the window cannot currently be seen.
+     *
+     * This pure virtual method must be implemented by derived classes to report
+     * whether the window is minimized or hidden, in which case rendering can stop.
+     *
+     * @return true if the window is minimized or hidden, false otherwise.
+     */
+    virtual bool isMinimized() = 0;
+// --------------------------------------------------------------------------------
+
+    /**
+     * @brief Checks if the window was iconified when the window system last
+     * reported a change.
+     *
+     * Unlike isMinimized(), this may be called from any thread.
+     *
+     * @return true if the window is iconified, false otherwise.
+     */
+    virtual bool isIconified() = 0;
+// --------------------------------------------------------------------------------
+
+    /**
+     * @brief Sets the queue that input events are forwarded to.
+     *
+     * The window pushes onto the queue from the thread that processes its
+     * events, which makes that thread the queue's only producer.  Input is
+     * dropped while the queue is full.
+     *
+     * @param queue The queue to push onto, or nullptr to stop forwarding events
+     */
+    virtual void setEventQueue(WindowEventQueue* queue) = 0;
+// --------------------------------------------------------------------------------
     
     /**
      * @brief Checks if the window instance is valid.
@@ -156,6 +236,39 @@ public:
     void pollEvents() override;
 // --------------------------------------------------------------------------------
 
+    /**
+     * @brief Waits for GLFW events with glfwWaitEventsTimeout.
+     *
+     * @param timeout The maximum time to wait in seconds
+     */
+    void waitEventsTimeout(double timeout) override;
+// --------------------------------------------------------------------------------
+
+    /**
+     * @brief Checks if the GLFW window is iconified or not visible.
+     *
+     * @return true if the window is minimized or hidden, false otherwise.
+     */
+    bool isMinimized() override;
+// --------------------------------------------------------------------------------
+
+    /**
+     * @brief Returns the state last reported by the GLFW iconify callback.
+     *
+     * @return true if the window is iconified, false otherwise.
+     */
+    bool isIconified() override;
+// --------------------------------------------------------------------------------
+
+    /**
+     * @brief Forwards key, mouse button and cursor events from the GLFW
+     * callbacks to a queue.
+     *
+     * @param queue The queue to push onto, or nullptr to stop forwarding events
+     */
+    void setEventQueue(WindowEventQueue* queue) override;
+// --------------------------------------------------------------------------------
+
     /**
      * @brief Checks if GLFW has been terminated.
      * 
@@ -195,6 +308,9 @@ public:
 
     /**
      * @brief This method retrives the size, in pixels, of hte framebuffer of the specified window
+     *
+     * GLFW only allows the query from the main thread.  On any other thread the
+     * size last reported by the framebuffer size callback is kept instead.
      */
     void getFrameBufferSize() override;
 // --------------------------------------------------------------------------------
@@ -212,9 +328,35 @@ public:
 // ================================================================================
 private:
 
-    uint32_t height;
-    uint32_t width;
+    std::atomic<uint32_t> height;
+    std::atomic<uint32_t> width;
+    std::atomic<bool> iconified{false};
     GLFWwindow* window;
+    std::thread::id mainThread;
+    WindowEventQueue* eventQueue = nullptr;
+// --------------------------------------------------------------------------------
+
+    /**
+     * @brief Pushes an event if a queue is attached.  Events are dropped if the
+     * render thread has fallen a full queue behind, which is why only input
+     * goes through the queue.
+     */
+    void forwardEvent(const WindowEvent& event);
+// --------------------------------------------------------------------------------
+
+    static void framebufferSizeCallback(GLFWwindow* window, int width, int height);
+// --------------------------------------------------------------------------------
+
+    static void iconifyCallback(GLFWwindow* window, int iconified);
+// --------------------------------------------------------------------------------
+
+    static void keyCallback(GLFWwindow* window, int key, int scancode, int action, int mods);
+// --------------------------------------------------------------------------------
+
+    static void mouseButtonCallback(GLFWwindow* window, int button, int action, int mods);
+// --------------------------------------------------------------------------------
+
+    static void cursorPositionCallback(GLFWwindow* window, double x, double y);
 // --------------------------------------------------------------------------------
 
     /**
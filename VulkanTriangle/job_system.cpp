@@ -0,0 +1,313 @@
+// ================================================================================
+// ================================================================================
+// - File:    job_system.cpp
+// - Purpose: Contains the implementation for job_system.hpp
+//
+// Source Metadata
+// - Author:  Jonathan A. Webb
+// - Date:    October 18, 2026
+// - Version: 1.0
+// - Copyright: Copyright 2022, Jon Webb Inc.
+// ================================================================================
+// ================================================================================
+// Include modules here
+
+#include "include/job_system.hpp"
+#include <stdexcept>
+// ================================================================================
+// ================================================================================
+
+// The job system and deque owned by the current thread, if any
+static thread_local JobSystem* currentSystem = nullptr;
+static thread_local uint32_t currentDeque = 0;
+static thread_local uint32_t stealSeed = 0x9e3779b9u;
+// --------------------------------------------------------------------------------
+
+// The number of failed searches a worker makes before it goes to sleep
+static const int WORKER_SPIN_COUNT = 64;
+// --------------------------------------------------------------------------------
+
+static uint32_t nextRandom() {
+    // xorshift32, only used to spread steals across victims
+    stealSeed ^= stealSeed << 13;
+    stealSeed ^= stealSeed >> 17;
+    stealSeed ^= stealSeed << 5;
+    return stealSeed;
+}
+// ================================================================================
+// ================================================================================
+
+WorkStealingDeque::WorkStealingDeque(int64_t capacity)
+    : buffer(static_cast<size_t>(capacity)), mask(capacity - 1) {
+    if (capacity <= 0 || (capacity & (capacity - 1)) != 0) {
+        throw std::runtime_error("work stealing deque capacity must be a power of two!");
+    }
+}
+// --------------------------------------------------------------------------------
+
+bool WorkStealingDeque::push(Job* job) {
+    int64_t b = bottom.load(std::memory_order_relaxed);
+    int64_t t = top.load(std::memory_order_acquire);
+    if (b - t > mask) {
+        return false;
+    }
+    buffer[static_cast<size_t>(b & mask)].store(job, std::memory_order_relaxed);
+    bottom.store(b + 1, std::memory_order_release);
+    return true;
+}
+// --------------------------------------------------------------------------------
+
+Job* WorkStealingDeque::pop() {
+    // The store to bottom and the load of top must not be reordered, or the
+    // owner and a thief could both take the last job
+    int64_t b = bottom.load(std::memory_order_relaxed) - 1;
+    bottom.store(b, std::memory_order_seq_cst);
+    int64_t t = top.load(std::memory_order_seq_cst);
+
+    if (t > b) {
+        bottom.store(b + 1, std::memory_order_relaxed);
+        return nullptr;
+    }
+
+    Job* job = buffer[static_cast<size_t>(b & mask)].load(std::memory_order_relaxed);
+    if (t == b) {
+        // Last job; race any thief for it
+        if (!top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) {
+            job = nullptr;
+        }
+        bottom.store(b + 1, std::memory_order_relaxed);
+    }
+    return job;
+}
+// --------------------------------------------------------------------------------
+
+Job* WorkStealingDeque::steal() {
+    int64_t t = top.load(std::memory_order_seq_cst);
+    int64_t b = bottom.load(std::memory_order_seq_cst);
+
+    if (t >= b) {
+        return nullptr;
+    }
+    Job* job = buffer[static_cast<size_t>(t & mask)].load(std::memory_order_relaxed);
+    if (!top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) {
+        return nullptr;
+    }
+    return job;
+}
+// ================================================================================
+// ================================================================================
+
+JobSystem::JobSystem(uint32_t threadCount) {
+    if (threadCount == 0) {
+        threadCount = std::thread::hardware_concurrency();
+    }
+
+    // The owner only runs jobs inside wait(), so jobs nobody waits on, such as
+    // texture loads and capture encodes, need at least one worker
+    threadCount = std::max(threadCount, 2u);
+
+    for (uint32_t i = 0; i < threadCount; i++) {
+        deques.push_back(std::make_unique<WorkStealingDeque>(JOB_DEQUE_CAPACITY));
+    }
+
+    // The constructing thread owns deque 0
+    currentSystem = this;
+    currentDeque = 0;
+
+    for (uint32_t i = 1; i < threadCount; i++) {
+        workers.emplace_back(&JobSystem::workerLoop, this, i);
+    }
+}
+// --------------------------------------------------------------------------------
+
+JobSystem::~JobSystem() {
+    {
+        std::lock_guard<std::mutex> lock(sleepMutex);
+        stopping = true;
+    }
+    sleepCondition.notify_all();
+    for (std::thread& worker : workers) {
+        worker.join();
+    }
+
+    // Jobs that were never waited on are discarded
+    for (auto& deque : deques) {
+        while (Job* job = deque->steal()) {
+            delete job;
+        }
+    }
+    for (Job* job : injectionQueue) {
+        delete job;
+    }
+
+    if (currentSystem == this) {
+        currentSystem = nullptr;
+    }
+}
+// --------------------------------------------------------------------------------
+
+void JobSystem::run(std::function<void()> task, JobCounter* counter) {
+    if (counter != nullptr) {
+        counter->value.fetch_add(1, std::memory_order_relaxed);
+    }
+    submit(new Job{std::move(task), counter});
+}
+// --------------------------------------------------------------------------------
+
+void JobSystem::runAfter(JobCounter& dependency, std::function<void()> task, JobCounter* counter) {
+    if (counter != nullptr) {
+        counter->value.fetch_add(1, std::memory_order_relaxed);
+    }
+    Job* job = new Job{std::move(task), counter};
+
+    {
+        // finish() drains the list under the same lock once the count reaches
+        // zero, so the job is either queued here or submitted immediately
+        std::lock_guard<std::mutex> lock(dependency.continuationMutex);
+        if (dependency.value.load(std::memory_order_acquire) != 0) {
+            dependency.continuations.push_back(job);
+            return;
+        }
+    }
+    submit(job);
+}
+// --------------------------------------------------------------------------------
+
+void JobSystem::wait(const JobCounter& counter) {
+    while (!counter.isDone()) {
+        if (Job* job = findJob()) {
+            execute(job);
+        } else {
+            std::this_thread::yield();
+        }
+    }
+}
+// --------------------------------------------------------------------------------
+
+uint32_t JobSystem::getThreadCount() const {
+    return static_cast<uint32_t>(deques.size());
+}
+// ================================================================================
+
+void JobSystem::workerLoop(uint32_t index) {
+    currentSystem = this;
+    currentDeque = index;
+    stealSeed ^= index * 0x85ebca6bu;
+
+    int idleSpins = 0;
+    while (!stopping.load(std::memory_order_relaxed)) {
+        if (Job* job = findJob()) {
+            execute(job);
+            idleSpins = 0;
+            continue;
+        }
+        if (++idleSpins < WORKER_SPIN_COUNT) {
+            std::this_thread::yield();
+            continue;
+        }
+
+        // Announce the sleep before checking for work so that a concurrent
+        // submit either sees the sleeper or is seen by it
+        std::unique_lock<std::mutex> lock(sleepMutex);
+        sleepingWorkers.fetch_add(1, std::memory_order_seq_cst);
+        sleepCondition.wait(lock, [this]() {
+            return stopping.load(std::memory_order_relaxed) ||
+                   pendingJobs.load(std::memory_order_seq_cst) > 0;
+        });
+        sleepingWorkers.fetch_sub(1, std::memory_order_relaxed);
+        idleSpins = 0;
+    }
+}
+// --------------------------------------------------------------------------------
+
+void JobSystem::submit(Job* job) {
+    bool queued;
+    if (currentSystem == this) {
+        queued = deques[currentDeque]->push(job);
+    } else {
+        std::lock_guard<std::mutex> lock(injectionMutex);
+        injectionQueue.push_back(job);
+        queued = true;
+    }
+
+    if (!queued) {
+        // The deque is full; running the job now is as good as any worker
+        execute(job);
+        return;
+    }
+
+    pendingJobs.fetch_add(1, std::memory_order_seq_cst);
+    if (sleepingWorkers.load(std::memory_order_seq_cst) > 0) {
+        std::lock_guard<std::mutex> lock(sleepMutex);
+        sleepCondition.notify_one();
+    }
+}
+// --------------------------------------------------------------------------------
+
+Job* JobSystem::findJob() {
+    Job* job = nullptr;
+
+    if (currentSystem == this) {
+        job = deques[currentDeque]->pop();
+    }
+
+    if (job == nullptr) {
+        std::lock_guard<std::mutex> lock(injectionMutex);
+        if (!injectionQueue.empty()) {
+            job = injectionQueue.front();
+            injectionQueue.pop_front();
+        }
+    }
+
+    if (job == nullptr) {
+        uint32_t count = static_cast<uint32_t>(deques.size());
+        uint32_t start = nextRandom() % count;
+        for (uint32_t i = 0; i < count && job == nullptr; i++) {
+            uint32_t victim = (start + i) % count;
+            if (currentSystem == this && victim == currentDeque) {
+                continue;
+            }
+            job = deques[victim]->steal();
+        }
+    }
+
+    if (job != nullptr) {
+        pendingJobs.fetch_sub(1, std::memory_order_relaxed);
+    }
+    return job;
+}
+// --------------------------------------------------------------------------------
+
+void JobSystem::execute(Job* job) {
+    job->task();
+    JobCounter* counter = job->counter;
+    delete job;
+    if (counter != nullptr) {
+        finish(counter);
+    }
+}
+// --------------------------------------------------------------------------------
+
+void JobSystem::finish(JobCounter* counter) {
+    counter->finishing.fetch_add(1, std::memory_order_relaxed);
+    if (counter->value.fetch_sub(1, std::memory_order_acq_rel) != 1) {
+        counter->finishing.fetch_sub(1, std::memory_order_release);
+        return;
+    }
+
+    std::vector<Job*> ready;
+    {
+        std::lock_guard<std::mutex> lock(counter->continuationMutex);
+        ready.swap(counter->continuations);
+    }
+
+    // The counter may be destroyed as soon as this store is visible
+    counter->finishing.fetch_sub(1, std::memory_order_release);
+
+    for (Job* job : ready) {
+        submit(job);
+    }
+}
+// ================================================================================
+// ================================================================================
+// eof
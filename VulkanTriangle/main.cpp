@@ -13,42 +13,265 @@
 // Include modules here
 
 #include "include/application.hpp"
+#include "include/batch_renderer.hpp"
 #include "include/window.hpp"
 #include "include/validation_layers.hpp"
 #include "include/constants.hpp"
 #include "include/graphics_pipeline.hpp"
+#include "include/host_allocator.hpp"
+#include "include/render_job.hpp"
+#include "include/shader_library.hpp"
+#include "include/startup_graph.hpp"
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
 #include <iostream>
 #include <stdexcept>
 
-int main(int argc, const char * argv[]) {
+/**
+ * @brief Renders the jobs in each job file without opening a window, then
+ * reports how long they took.  Invoked as: VulkanTriangle --batch <job file>...
+ */
+static int runBatch(int argc, const char* argv[]) {
     try {
-        std::unique_ptr<Window> window = std::make_unique<GlfwWindow>(650, 800, "Vulkan", false);
-        auto validationLayers = std::make_unique<ValidationLayers>(window);
-        std::unique_ptr<CreateVulkanInstance> vulkanInstanceCreator = std::make_unique<VulkanInstance>(window, validationLayers);
-        auto physicalDevice = std::make_unique<VulkanPhysicalDevice>(*vulkanInstanceCreator->getInstance(), 
-                                                                     vulkanInstanceCreator->getSurface());
-        auto logicalDevice = std::make_unique<VulkanLogicalDevice>(physicalDevice->getPhysicalDevice(), 
+        auto jobs = std::make_unique<JobSystem>();
+        std::unique_ptr<Window> window;
+        std::unique_ptr<ValidationLayers> validationLayers = std::make_unique<ValidationLayers>(window);
+        auto instance = std::make_unique<HeadlessVulkanInstance>(validationLayers);
+        auto physicalDevice = std::make_unique<VulkanPhysicalDevice>(*instance->getInstance(),
+                                                                     instance->getSurface(),
+                                                                     headlessDeviceExtensions);
+        auto logicalDevice = std::make_unique<VulkanLogicalDevice>(physicalDevice->getPhysicalDevice(),
                                                                    validationLayers->getValidationLayers(),
-                                                                   vulkanInstanceCreator->getSurface(),
-                                                                   deviceExtensions);
-        auto swapChain = std::make_unique<SwapChain>(logicalDevice->getDevice(), 
-                                                     vulkanInstanceCreator->getSurface(), 
-                                                     physicalDevice->getPhysicalDevice(), 
-                                                     window.get());
-        auto pipeline = std::make_unique<GraphicsPipeline>(logicalDevice->getDevice(), 
-                                                           swapChain->getSwapChainExtent(), 
-                                                           swapChain->getSwapChainImageFormat());
-        HelloTriangleApplication triangle(std::move(window), 
-                                          std::move(vulkanInstanceCreator), 
-                                          std::move(physicalDevice), 
-                                          std::move(logicalDevice),
-                                          std::move(swapChain),
-                                          std::move(pipeline));
-        triangle.run();
+                                                                   instance->getSurface(),
+                                                                   headlessDeviceExtensions,
+                                                                   optionalDeviceExtensions,
+                                                                   requiredDeviceFeatures,
+                                                                   optionalDeviceFeatures);
+        VkDevice device = logicalDevice->getDevice();
+        VkPhysicalDevice gpu = physicalDevice->getPhysicalDevice();
+
+        auto shaders = std::make_unique<ShaderLibrary>();
+        for (const std::string& path : GraphicsPipeline::getShaderPaths()) {
+            shaders->load(path);
+        }
+        auto pipelineCache = std::make_unique<PipelineStateCache>(device,
+                                                                  std::move(shaders),
+                                                                  PipelineStateCache::loadCacheData(PIPELINE_CACHE_FILE),
+                                                                  logicalDevice->getCapabilities().pipelineCreationCacheControl);
+        auto objectCache = std::make_unique<ObjectCache>(device);
+        auto renderer = std::make_unique<BatchRenderer>(device,
+                                                        gpu,
+                                                        logicalDevice->getQueueFamilyIndices(),
+                                                        logicalDevice->getGraphicsQueue(),
+                                                        logicalDevice->getGraphicsTimeline(),
+                                                        *jobs,
+                                                        *pipelineCache,
+                                                        *objectCache,
+                                                        BATCH_JOBS_IN_FLIGHT,
+                                                        BATCH_TARGET_POOL_SIZE,
+                                                        BATCH_READBACK_SLOTS);
+
+        for (int i = 2; i < argc; i++) {
+            for (const RenderJob& job : loadRenderJobs(argv[i])) {
+                renderer->enqueue(job);
+            }
+        }
+
+        BatchRenderStats stats = renderer->run();
+        std::cout << "Batch: " << stats.filesWritten << " images written, "
+                  << stats.jobsFailed << " jobs skipped, "
+                  << stats.writeFailures << " write failures, "
+                  << stats.targetsCreated << " render targets created in "
+                  << stats.seconds << " s (" << stats.getJobsPerSecond() << " jobs/s)" << std::endl;
+
+        renderer.reset();
+        pipelineCache->saveCacheData(PIPELINE_CACHE_FILE);
+        objectCache.reset();
+        pipelineCache.reset();
+        logicalDevice.reset();
+        physicalDevice.reset();
+        instance.reset();
+        if (stats.jobsFailed > 0 || stats.writeFailures > 0) {
+            return EXIT_FAILURE;
+        }
+    } catch(const std::exception& e) {
+        std::cerr << e.what() << "\n";
+        return EXIT_FAILURE;
+    }
+
+    if (ENABLE_HOST_ALLOCATION_TRACKING) {
+        HostAllocator::instance().printReport(std::cout);
+    }
+    return EXIT_SUCCESS;
+}
+// ================================================================================
+// ================================================================================
+
+int main(int argc, const char * argv[]) {
+    if (argc > 1 && std::strcmp(argv[1], "--batch") == 0) {
+        return runBatch(argc, argv);
+    }
+
+    try {
+        auto jobs = std::make_unique<JobSystem>();
+
+        // Everything a startup step writes is declared before the graph, so it
+        // outlives any step still running if startup fails
+        std::unique_ptr<Window> window;
+        std::unique_ptr<ValidationLayers> validationLayers = std::make_unique<ValidationLayers>(window);
+        std::unique_ptr<CreateVulkanInstance> vulkanInstanceCreator;
+        std::unique_ptr<VulkanPhysicalDevice> physicalDevice;
+        std::unique_ptr<VulkanLogicalDevice> logicalDevice;
+        std::unique_ptr<ResidencyManager> residency;
+        std::unique_ptr<SwapChain> swapChain;
+        std::unique_ptr<UniformRingBuffer> uniformBuffer;
+        std::unique_ptr<ShaderLibrary> shaders = std::make_unique<ShaderLibrary>();
+        std::vector<char> pipelineCacheData;
+        std::unique_ptr<PipelineStateCache> pipelineCache;
+        std::unique_ptr<ObjectCache> objectCache;
+        std::unique_ptr<GraphicsPipeline> pipeline;
+        JobCounter layerQuery;
+        JobCounter fileReads;
+        JobCounter deviceObjects;
+        StartupGraph startup(*jobs);
+
+        // Layer enumeration and file reads need neither the window nor an instance
+        startup.run("Enumerate instance layers", [&]() {
+            validationLayers->checkValidationLayerSupport();
+        }, layerQuery);
+
+        std::vector<std::string> shaderPaths = GraphicsPipeline::getShaderPaths(MULTIVIEW_VIEW_COUNT);
+        if (ENABLE_PARTICLE_SIMULATION) {
+            std::vector<std::string> particleShaders = ParticleSystem::getShaderPaths(MULTIVIEW_VIEW_COUNT);
+            shaderPaths.insert(shaderPaths.end(), particleShaders.begin(), particleShaders.end());
+        }
+        std::sort(shaderPaths.begin(), shaderPaths.end());
+        shaderPaths.erase(std::unique(shaderPaths.begin(), shaderPaths.end()), shaderPaths.end());
+        for (const std::string& path : shaderPaths) {
+            startup.run("Read " + std::filesystem::path(path).filename().string(), [&shaders, path]() {
+                shaders->load(path);
+            }, fileReads);
+        }
+        startup.run("Load pipeline cache", [&]() {
+            pipelineCacheData = PipelineStateCache::loadCacheData(PIPELINE_CACHE_FILE);
+        }, fileReads);
+
+        // GLFW only allows windows to be created on the main thread
+        startup.runHere("Create window", [&]() {
+            window = std::make_unique<GlfwWindow>(650, 800, "Vulkan", false);
+        });
+        startup.join(layerQuery);
+
+        // The instance, physical device and logical device each need the last
+        startup.runHere("Create instance and surface", [&]() {
+            vulkanInstanceCreator = std::make_unique<VulkanInstance>(window, validationLayers);
+        });
+        startup.runHere("Select physical device", [&]() {
+            physicalDevice = std::make_unique<VulkanPhysicalDevice>(*vulkanInstanceCreator->getInstance(),
+                                                                    vulkanInstanceCreator->getSurface(),
+                                                                    deviceExtensions);
+        });
+        startup.runHere("Create logical device", [&]() {
+            logicalDevice = std::make_unique<VulkanLogicalDevice>(physicalDevice->getPhysicalDevice(),
+                                                                  validationLayers->getValidationLayers(),
+                                                                  vulkanInstanceCreator->getSurface(),
+                                                                  deviceExtensions,
+                                                                  optionalDeviceExtensions,
+                                                                  requiredDeviceFeatures,
+                                                                  optionalDeviceFeatures);
+        });
+
+        // Creating objects on a device is thread-safe, so objects that do not
+        // depend on each other are created side by side.  The swap chain queries
+        // the window and stays on this thread.
+        VkDevice device = logicalDevice->getDevice();
+        VkPhysicalDevice gpu = physicalDevice->getPhysicalDevice();
+        const DeviceCapabilities& capabilities = logicalDevice->getCapabilities();
+        startup.run("Create residency manager", [&]() {
+            residency = std::make_unique<ResidencyManager>(gpu,
+                                                           device,
+                                                           capabilities.memoryBudget,
+                                                           capabilities.memoryPriority,
+                                                           MAX_FRAMES_IN_FLIGHT);
+        }, deviceObjects);
+        startup.run("Create uniform ring buffer", [&]() {
+            uniformBuffer = std::make_unique<UniformRingBuffer>(device,
+                                                                gpu,
+                                                                UNIFORM_RING_FRAME_SIZE,
+                                                                MAX_FRAMES_IN_FLIGHT,
+                                                                UNIFORM_RING_MAX_ALLOCATION);
+        }, deviceObjects);
+        startup.run("Create object cache", [&]() {
+            objectCache = std::make_unique<ObjectCache>(device);
+        }, deviceObjects);
+        startup.runAfter(fileReads, "Create pipeline cache", [&]() {
+            // Compiles are serialized inside the cache, including background rebuilds
+            pipelineCache = std::make_unique<PipelineStateCache>(device,
+                                                                 std::move(shaders),
+                                                                 pipelineCacheData,
+                                                                 capabilities.pipelineCreationCacheControl);
+        }, deviceObjects);
+        startup.runHere("Create swap chain", [&]() {
+            swapChain = std::make_unique<SwapChain>(device,
+                                                    vulkanInstanceCreator->getSurface(),
+                                                    gpu,
+                                                    window.get());
+        });
+        startup.join(deviceObjects);
+
+        // Every device with multiview supports at least six views, more than
+        // MAX_VIEW_COUNT, so only the feature and the tiling copies are checked
+        uint32_t viewCount = std::min(MULTIVIEW_VIEW_COUNT, MAX_VIEW_COUNT);
+        if (viewCount > 1 && !capabilities.multiview) {
+            std::cerr << "Multiview is not supported; rendering one view" << std::endl;
+            viewCount = 1;
+        }
+        if (viewCount > 1 && !(swapChain->getSwapChainImageUsage() & VK_IMAGE_USAGE_TRANSFER_DST_BIT)) {
+            std::cerr << "The surface cannot be copied to, so views cannot be tiled; rendering one view" << std::endl;
+            viewCount = 1;
+        }
+
+        startup.runHere("Compile graphics pipeline", [&]() {
+            pipeline = std::make_unique<GraphicsPipeline>(device,
+                                                          swapChain->getSwapChainExtent(),
+                                                          swapChain->getSwapChainImageFormat(),
+                                                          uniformBuffer->getDescriptorSetLayout(),
+                                                          *pipelineCache,
+                                                          *objectCache,
+                                                          viewCount);
+        });
+
+        std::unique_ptr<HelloTriangleApplication> triangle;
+        startup.runHere("Create application", [&]() {
+            triangle = std::make_unique<HelloTriangleApplication>(std::move(window),
+                                                                  std::move(vulkanInstanceCreator),
+                                                                  std::move(physicalDevice),
+                                                                  std::move(logicalDevice),
+                                                                  std::move(residency),
+                                                                  std::move(jobs),
+                                                                  std::move(swapChain),
+                                                                  std::move(uniformBuffer),
+                                                                  std::move(pipelineCache),
+                                                                  std::move(objectCache),
+                                                                  std::move(pipeline));
+        });
+        startup.print(std::cout);
+
+        // Any command line arguments name textures to stream
+        for (int i = 1; i < argc; i++) {
+            triangle->loadTexture(argv[i]);
+        }
+        triangle->run();
     } catch(const std::exception& e) {
         std::cerr << e.what() << "\n";
         return EXIT_FAILURE;
     }
+
+    // Every Vulkan object has been destroyed, so live bytes should read zero
+    if (ENABLE_HOST_ALLOCATION_TRACKING) {
+        HostAllocator::instance().printReport(std::cout);
+    }
     return EXIT_SUCCESS;
 }
 // ================================================================================
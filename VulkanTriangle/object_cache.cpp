@@ -0,0 +1,318 @@
+// ================================================================================
+// ================================================================================
+// - File:    object_cache.cpp
+// - Purpose: Contains the implementation for object_cache.hpp
+//
+// Source Metadata
+// - Author:  Jonathan A. Webb
+// - Date:    October 18, 2026
+// - Version: 1.0
+// - Copyright: Copyright 2022, Jon Webb Inc.
+// ================================================================================
+// ================================================================================
+// Include modules here
+
+#include "include/object_cache.hpp"
+#include "include/host_allocator.hpp"
+#include <stdexcept>
+#include <algorithm>
+// ================================================================================
+// ================================================================================
+
+size_t RenderPassDesc::hash() const {
+    size_t seed = 0;
+    auto hashAttachment = [&seed](const AttachmentDesc& attachment) {
+        hashCombine(seed, static_cast<uint32_t>(attachment.format));
+        hashCombine(seed, static_cast<uint32_t>(attachment.samples));
+        hashCombine(seed, static_cast<uint32_t>(attachment.loadOp));
+        hashCombine(seed, static_cast<uint32_t>(attachment.storeOp));
+        hashCombine(seed, static_cast<uint32_t>(attachment.initialLayout));
+        hashCombine(seed, static_cast<uint32_t>(attachment.finalLayout));
+    };
+
+    for (const auto& attachment : colorAttachments) {
+        hashAttachment(attachment);
+    }
+    hashCombine(seed, hasDepth);
+    if (hasDepth) {
+        hashAttachment(depthAttachment);
+    }
+    hashCombine(seed, viewMask);
+    hashCombine(seed, correlationMask);
+    return seed;
+}
+// --------------------------------------------------------------------------------
+
+size_t FramebufferDesc::hash() const {
+    size_t seed = 0;
+    hashCombine(seed, renderPass);
+    for (uint32_t i = 0; i < attachmentCount; i++) {
+        hashCombine(seed, attachments[i]);
+    }
+    hashCombine(seed, extent.width);
+    hashCombine(seed, extent.height);
+    hashCombine(seed, layers);
+    return seed;
+}
+// --------------------------------------------------------------------------------
+
+bool FramebufferDesc::operator==(const FramebufferDesc& other) const {
+    if (renderPass != other.renderPass || attachmentCount != other.attachmentCount ||
+        extent.width != other.extent.width || extent.height != other.extent.height ||
+        layers != other.layers) {
+        return false;
+    }
+    return std::equal(attachments.begin(), attachments.begin() + attachmentCount,
+                      other.attachments.begin());
+}
+// --------------------------------------------------------------------------------
+
+bool FramebufferDesc::references(VkImageView view) const {
+    return std::find(attachments.begin(), attachments.begin() + attachmentCount, view) !=
+           attachments.begin() + attachmentCount;
+}
+// --------------------------------------------------------------------------------
+
+size_t SamplerDesc::hash() const {
+    size_t seed = 0;
+    hashCombine(seed, static_cast<uint32_t>(magFilter));
+    hashCombine(seed, static_cast<uint32_t>(minFilter));
+    hashCombine(seed, static_cast<uint32_t>(mipmapMode));
+    hashCombine(seed, static_cast<uint32_t>(addressModeU));
+    hashCombine(seed, static_cast<uint32_t>(addressModeV));
+    hashCombine(seed, static_cast<uint32_t>(addressModeW));
+    hashCombine(seed, mipLodBias);
+    hashCombine(seed, anisotropyEnable);
+    hashCombine(seed, maxAnisotropy);
+    hashCombine(seed, compareEnable);
+    hashCombine(seed, static_cast<uint32_t>(compareOp));
+    hashCombine(seed, minLod);
+    hashCombine(seed, maxLod);
+    hashCombine(seed, static_cast<uint32_t>(borderColor));
+    return seed;
+}
+// --------------------------------------------------------------------------------
+
+bool SamplerDesc::operator==(const SamplerDesc& other) const {
+    return magFilter == other.magFilter && minFilter == other.minFilter &&
+           mipmapMode == other.mipmapMode && addressModeU == other.addressModeU &&
+           addressModeV == other.addressModeV && addressModeW == other.addressModeW &&
+           mipLodBias == other.mipLodBias && anisotropyEnable == other.anisotropyEnable &&
+           maxAnisotropy == other.maxAnisotropy && compareEnable == other.compareEnable &&
+           compareOp == other.compareOp && minLod == other.minLod &&
+           maxLod == other.maxLod && borderColor == other.borderColor;
+}
+// ================================================================================
+// ================================================================================
+
+ObjectCache::ObjectCache(VkDevice device)
+    : device(device) {}
+// --------------------------------------------------------------------------------
+
+ObjectCache::~ObjectCache() {
+    for (auto& entry : framebuffers) {
+        vkDestroyFramebuffer(device, entry.second, hostAllocator(VK_OBJECT_TYPE_FRAMEBUFFER));
+    }
+    for (auto& entry : renderPasses) {
+        vkDestroyRenderPass(device, entry.second, hostAllocator(VK_OBJECT_TYPE_RENDER_PASS));
+    }
+    for (auto& entry : samplers) {
+        vkDestroySampler(device, entry.second, hostAllocator(VK_OBJECT_TYPE_SAMPLER));
+    }
+}
+// --------------------------------------------------------------------------------
+
+VkRenderPass ObjectCache::getRenderPass(const RenderPassDesc& desc) {
+    auto it = renderPasses.find(desc);
+    if (it != renderPasses.end()) {
+        renderPassStats.hits++;
+        return it->second;
+    }
+
+    renderPassStats.misses++;
+    VkRenderPass renderPass = createRenderPass(desc);
+    renderPasses.emplace(desc, renderPass);
+    return renderPass;
+}
+// --------------------------------------------------------------------------------
+
+VkFramebuffer ObjectCache::getFramebuffer(const FramebufferDesc& desc) {
+    auto it = framebuffers.find(desc);
+    if (it != framebuffers.end()) {
+        framebufferStats.hits++;
+        return it->second;
+    }
+
+    framebufferStats.misses++;
+    VkFramebuffer framebuffer = createFramebuffer(desc);
+    framebuffers.emplace(desc, framebuffer);
+    return framebuffer;
+}
+// --------------------------------------------------------------------------------
+
+VkSampler ObjectCache::getSampler(const SamplerDesc& desc) {
+    auto it = samplers.find(desc);
+    if (it != samplers.end()) {
+        samplerStats.hits++;
+        return it->second;
+    }
+
+    samplerStats.misses++;
+    VkSampler sampler = createSampler(desc);
+    samplers.emplace(desc, sampler);
+    return sampler;
+}
+// --------------------------------------------------------------------------------
+
+void ObjectCache::invalidateImageViews(const std::vector<VkImageView>& imageViews, DeletionQueue& deletionQueue) {
+    for (auto it = framebuffers.begin(); it != framebuffers.end();) {
+        bool stale = std::any_of(imageViews.begin(), imageViews.end(),
+                                 [&it](VkImageView view) { return it->first.references(view); });
+        if (stale) {
+            deletionQueue.destroy(VK_OBJECT_TYPE_FRAMEBUFFER, it->second);
+            it = framebuffers.erase(it);
+            framebufferStats.evictions++;
+        } else {
+            ++it;
+        }
+    }
+}
+// --------------------------------------------------------------------------------
+
+const CacheStats& ObjectCache::getRenderPassStats() const {
+    return renderPassStats;
+}
+// --------------------------------------------------------------------------------
+
+const CacheStats& ObjectCache::getFramebufferStats() const {
+    return framebufferStats;
+}
+// --------------------------------------------------------------------------------
+
+const CacheStats& ObjectCache::getSamplerStats() const {
+    return samplerStats;
+}
+// ================================================================================
+
+VkRenderPass ObjectCache::createRenderPass(const RenderPassDesc& desc) {
+    std::vector<VkAttachmentDescription> attachments;
+    std::vector<VkAttachmentReference> colorAttachmentRefs;
+
+    auto describe = [](const AttachmentDesc& attachment) {
+        VkAttachmentDescription description{};
+        description.format = attachment.format;
+        description.samples = attachment.samples;
+        description.loadOp = attachment.loadOp;
+        description.storeOp = attachment.storeOp;
+        description.stencilLoadOp = VK_ATTACHMENT_LOAD_OP_DONT_CARE;
+        description.stencilStoreOp = VK_ATTACHMENT_STORE_OP_DONT_CARE;
+        description.initialLayout = attachment.initialLayout;
+        description.finalLayout = attachment.finalLayout;
+        return description;
+    };
+
+    for (const auto& attachment : desc.colorAttachments) {
+        VkAttachmentReference reference{};
+        reference.attachment = static_cast<uint32_t>(attachments.size());
+        reference.layout = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
+        colorAttachmentRefs.push_back(reference);
+        attachments.push_back(describe(attachment));
+    }
+
+    VkAttachmentReference depthAttachmentRef{};
+    if (desc.hasDepth) {
+        depthAttachmentRef.attachment = static_cast<uint32_t>(attachments.size());
+        depthAttachmentRef.layout = VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL;
+        attachments.push_back(describe(desc.depthAttachment));
+    }
+
+    VkSubpassDescription subpass{};
+    subpass.pipelineBindPoint = VK_PIPELINE_BIND_POINT_GRAPHICS;
+    subpass.colorAttachmentCount = static_cast<uint32_t>(colorAttachmentRefs.size());
+    subpass.pColorAttachments = colorAttachmentRefs.data();
+    subpass.pDepthStencilAttachment = desc.hasDepth ? &depthAttachmentRef : nullptr;
+
+    // Hold the layout transitions until the attachments are available
+    VkSubpassDependency dependency{};
+    dependency.srcSubpass = VK_SUBPASS_EXTERNAL;
+    dependency.dstSubpass = 0;
+    dependency.srcStageMask = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT | VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT;
+    dependency.srcAccessMask = 0;
+    dependency.dstStageMask = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT | VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT;
+    dependency.dstAccessMask = VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT |
+                               (desc.hasDepth ? VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT : 0);
+
+    VkRenderPassCreateInfo renderPassInfo{};
+    renderPassInfo.sType = VK_STRUCTURE_TYPE_RENDER_PASS_CREATE_INFO;
+    renderPassInfo.attachmentCount = static_cast<uint32_t>(attachments.size());
+    renderPassInfo.pAttachments = attachments.data();
+    renderPassInfo.subpassCount = 1;
+    renderPassInfo.pSubpasses = &subpass;
+    renderPassInfo.dependencyCount = 1;
+    renderPassInfo.pDependencies = &dependency;
+
+    // One subpass, so one view mask; the framebuffer keeps a single layer
+    VkRenderPassMultiviewCreateInfo multiviewInfo{};
+    multiviewInfo.sType = VK_STRUCTURE_TYPE_RENDER_PASS_MULTIVIEW_CREATE_INFO;
+    multiviewInfo.subpassCount = 1;
+    multiviewInfo.pViewMasks = &desc.viewMask;
+    multiviewInfo.correlationMaskCount = desc.correlationMask != 0 ? 1 : 0;
+    multiviewInfo.pCorrelationMasks = &desc.correlationMask;
+    if (desc.viewMask != 0) {
+        renderPassInfo.pNext = &multiviewInfo;
+    }
+
+    VkRenderPass renderPass;
+    if (vkCreateRenderPass(device, &renderPassInfo, hostAllocator(VK_OBJECT_TYPE_RENDER_PASS), &renderPass) != VK_SUCCESS) {
+        throw std::runtime_error("failed to create render pass!");
+    }
+    return renderPass;
+}
+// --------------------------------------------------------------------------------
+
+VkFramebuffer ObjectCache::createFramebuffer(const FramebufferDesc& desc) {
+    VkFramebufferCreateInfo framebufferInfo{};
+    framebufferInfo.sType = VK_STRUCTURE_TYPE_FRAMEBUFFER_CREATE_INFO;
+    framebufferInfo.renderPass = desc.renderPass;
+    framebufferInfo.attachmentCount = desc.attachmentCount;
+    framebufferInfo.pAttachments = desc.attachments.data();
+    framebufferInfo.width = desc.extent.width;
+    framebufferInfo.height = desc.extent.height;
+    framebufferInfo.layers = desc.layers;
+
+    VkFramebuffer framebuffer;
+    if (vkCreateFramebuffer(device, &framebufferInfo, hostAllocator(VK_OBJECT_TYPE_FRAMEBUFFER), &framebuffer) != VK_SUCCESS) {
+        throw std::runtime_error("failed to create framebuffer!");
+    }
+    return framebuffer;
+}
+// --------------------------------------------------------------------------------
+
+VkSampler ObjectCache::createSampler(const SamplerDesc& desc) {
+    VkSamplerCreateInfo samplerInfo{};
+    samplerInfo.sType = VK_STRUCTURE_TYPE_SAMPLER_CREATE_INFO;
+    samplerInfo.magFilter = desc.magFilter;
+    samplerInfo.minFilter = desc.minFilter;
+    samplerInfo.mipmapMode = desc.mipmapMode;
+    samplerInfo.addressModeU = desc.addressModeU;
+    samplerInfo.addressModeV = desc.addressModeV;
+    samplerInfo.addressModeW = desc.addressModeW;
+    samplerInfo.mipLodBias = desc.mipLodBias;
+    samplerInfo.anisotropyEnable = desc.anisotropyEnable;
+    samplerInfo.maxAnisotropy = desc.maxAnisotropy;
+    samplerInfo.compareEnable = desc.compareEnable;
+    samplerInfo.compareOp = desc.compareOp;
+    samplerInfo.minLod = desc.minLod;
+    samplerInfo.maxLod = desc.maxLod;
+    samplerInfo.borderColor = desc.borderColor;
+    samplerInfo.unnormalizedCoordinates = VK_FALSE;
+
+    VkSampler sampler;
+    if (vkCreateSampler(device, &samplerInfo, hostAllocator(VK_OBJECT_TYPE_SAMPLER), &sampler) != VK_SUCCESS) {
+        throw std::runtime_error("failed to create texture sampler!");
+    }
+    return sampler;
+}
+// ================================================================================
+// ================================================================================
+// eof
@@ -0,0 +1,430 @@
+// ================================================================================
+// ================================================================================
+// - File:    particle_system.cpp
+// - Purpose: Contains the implementation for particle_system.hpp
+//
+// Source Metadata
+// - Author:  Jonathan A. Webb
+// - Date:    October 18, 2026
+// - Version: 1.0
+// - Copyright: Copyright 2022, Jon Webb Inc.
+// ================================================================================
+// ================================================================================
+// Include modules here
+
+#include "include/particle_system.hpp"
+#include "include/buffers.hpp"
+#include "include/constants.hpp"
+#include "include/host_allocator.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstring>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+// ================================================================================
+// ================================================================================
+
+static const std::string COMPUTE_SHADER = std::string(SHADER_BINARY_DIRECTORY) + "/particles.comp.spv";
+static const std::string VERTEX_SHADER = std::string(SHADER_BINARY_DIRECTORY) + "/particle.vert.spv";
+static const std::string MULTIVIEW_VERTEX_SHADER = std::string(SHADER_BINARY_DIRECTORY) + "/particle.vert.MULTIVIEW_1.spv";
+static const std::string FRAGMENT_SHADER = std::string(SHADER_BINARY_DIRECTORY) + "/shader.frag.spv";
+// ================================================================================
+// ================================================================================
+
+ParticleSystem::ParticleSystem(VkDevice device,
+                               VkPhysicalDevice physicalDevice,
+                               const QueueFamilyIndices& queueFamilies,
+                               VkQueue computeQueue,
+                               TimelineSemaphore& computeTimeline,
+                               UploadManager& uploads,
+                               ResidencyManager& residency,
+                               PipelineStateCache& pipelineCache,
+                               uint32_t particleCount,
+                               uint32_t framesInFlight)
+    : device(device),
+      physicalDevice(physicalDevice),
+      computeQueue(computeQueue),
+      computeTimeline(computeTimeline),
+      residency(residency),
+      particleCount(particleCount) {
+    uint32_t graphicsFamily = queueFamilies.graphicsFamily.value();
+    uint32_t computeFamily = queueFamilies.computeFamily.value();
+    uint32_t transferFamily = queueFamilies.transferFamily.value();
+    sharingFamilies.push_back(graphicsFamily);
+    if (computeFamily != graphicsFamily) {
+        sharingFamilies.push_back(computeFamily);
+        // The copies of the initial state cannot be handed to the compute
+        // family, so the transfer family shares the buffers as well
+        if (transferFamily != graphicsFamily && transferFamily != computeFamily) {
+            sharingFamilies.push_back(transferFamily);
+        }
+    }
+
+    commandBuffers = std::make_unique<CommandBufferManager>(device,
+                                                            queueFamilies.computeFamily.value(),
+                                                            framesInFlight);
+    createBuffers();
+    uploadInitialState(uploads, computeFamily);
+    createDescriptors();
+    computePipeline = std::make_unique<ComputePipeline>(device,
+                                                        COMPUTE_SHADER,
+                                                        std::vector<VkDescriptorSetLayout>{descriptorSetLayout},
+                                                        static_cast<uint32_t>(sizeof(ParticlePushConstants)),
+                                                        pipelineCache);
+
+    createTimestampPool(queueFamilies.computeFamily.value(), framesInFlight);
+}
+// --------------------------------------------------------------------------------
+
+ParticleSystem::~ParticleSystem() {
+    if (timestampPool != VK_NULL_HANDLE) {
+        vkDestroyQueryPool(device, timestampPool, hostAllocator(VK_OBJECT_TYPE_QUERY_POOL));
+    }
+    computePipeline.reset();
+    if (descriptorPool != VK_NULL_HANDLE) {
+        vkDestroyDescriptorPool(device, descriptorPool, hostAllocator(VK_OBJECT_TYPE_DESCRIPTOR_POOL));
+    }
+    if (descriptorSetLayout != VK_NULL_HANDLE) {
+        vkDestroyDescriptorSetLayout(device, descriptorSetLayout, hostAllocator(VK_OBJECT_TYPE_DESCRIPTOR_SET_LAYOUT));
+    }
+    for (uint32_t i = 0; i < 2; i++) {
+        if (buffers[i] != VK_NULL_HANDLE) {
+            vkDestroyBuffer(device, buffers[i], hostAllocator(VK_OBJECT_TYPE_BUFFER));
+        }
+        if (bufferMemory[i] != VK_NULL_HANDLE) {
+            residency.free(bufferResidency[i], bufferMemory[i]);
+        }
+    }
+}
+// --------------------------------------------------------------------------------
+
+uint64_t ParticleSystem::simulate(uint32_t frameIndex, float deltaTime) {
+    collectTimestamps(frameIndex);
+
+    // The frame's previous graphics submission waited on this command buffer's
+    // previous step, so it can be reset
+    VkCommandBuffer commandBuffer = commandBuffers->getCommandBuffer(frameIndex);
+    vkResetCommandBuffer(commandBuffer, 0);
+
+    VkCommandBufferBeginInfo beginInfo{};
+    beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+    beginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+    if (vkBeginCommandBuffer(commandBuffer, &beginInfo) != VK_SUCCESS) {
+        throw std::runtime_error("failed to begin particle command buffer!");
+    }
+
+    if (timestampPool != VK_NULL_HANDLE) {
+        vkCmdResetQueryPool(commandBuffer, timestampPool, frameIndex * 2, 2);
+        vkCmdWriteTimestamp2(commandBuffer, VK_PIPELINE_STAGE_2_NONE, timestampPool, frameIndex * 2);
+    }
+
+    // The previous step wrote the buffer this step reads, and read the buffer
+    // this step writes.  The graphics queue's reads of that buffer are covered
+    // by the wait on the frame slot's timeline value.
+    VkMemoryBarrier2 barrier{};
+    barrier.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER_2;
+    barrier.srcStageMask = VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT;
+    barrier.srcAccessMask = VK_ACCESS_2_SHADER_STORAGE_WRITE_BIT;
+    barrier.dstStageMask = VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT;
+    barrier.dstAccessMask = VK_ACCESS_2_SHADER_STORAGE_READ_BIT | VK_ACCESS_2_SHADER_STORAGE_WRITE_BIT;
+
+    VkDependencyInfo dependencyInfo{};
+    dependencyInfo.sType = VK_STRUCTURE_TYPE_DEPENDENCY_INFO;
+    dependencyInfo.memoryBarrierCount = 1;
+    dependencyInfo.pMemoryBarriers = &barrier;
+    vkCmdPipelineBarrier2(commandBuffer, &dependencyInfo);
+
+    ParticlePushConstants pushConstants{};
+    pushConstants.deltaTime = deltaTime;
+    pushConstants.count = particleCount;
+
+    vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, computePipeline->getPipeline());
+    vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, computePipeline->getPipelineLayout(),
+                            0, 1, &descriptorSets[readIndex], 0, nullptr);
+    vkCmdPushConstants(commandBuffer, computePipeline->getPipelineLayout(), VK_SHADER_STAGE_COMPUTE_BIT,
+                       0, sizeof(ParticlePushConstants), &pushConstants);
+    vkCmdDispatch(commandBuffer, (particleCount + PARTICLE_WORKGROUP_SIZE - 1) / PARTICLE_WORKGROUP_SIZE, 1, 1);
+
+    if (timestampPool != VK_NULL_HANDLE) {
+        vkCmdWriteTimestamp2(commandBuffer, VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT, timestampPool, frameIndex * 2 + 1);
+    }
+
+    if (vkEndCommandBuffer(commandBuffer) != VK_SUCCESS) {
+        throw std::runtime_error("failed to record particle command buffer!");
+    }
+
+    uint64_t value = computeTimeline.reserve();
+    VkCommandBufferSubmitInfo commandBufferInfo{};
+    commandBufferInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_SUBMIT_INFO;
+    commandBufferInfo.commandBuffer = commandBuffer;
+    VkSemaphoreSubmitInfo signalInfo = computeTimeline.signalInfo(value, VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT);
+
+    VkSubmitInfo2 submitInfo{};
+    submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO_2;
+    submitInfo.commandBufferInfoCount = 1;
+    submitInfo.pCommandBufferInfos = &commandBufferInfo;
+    submitInfo.signalSemaphoreInfoCount = 1;
+    submitInfo.pSignalSemaphoreInfos = &signalInfo;
+
+    if (vkQueueSubmit2(computeQueue, 1, &submitInfo, VK_NULL_HANDLE) != VK_SUCCESS) {
+        throw std::runtime_error("failed to submit particle simulation!");
+    }
+
+    if (timestampPool != VK_NULL_HANDLE) {
+        timestampValues[frameIndex] = value;
+    }
+    readIndex = 1 - readIndex;
+    return value;
+}
+// --------------------------------------------------------------------------------
+
+VkBuffer ParticleSystem::getVertexBuffer() const {
+    // After simulate() flips the index, readIndex names the buffer just written
+    return buffers[readIndex];
+}
+// --------------------------------------------------------------------------------
+
+std::vector<std::string> ParticleSystem::getShaderPaths(uint32_t viewCount) {
+    return {COMPUTE_SHADER, viewCount > 1 ? MULTIVIEW_VERTEX_SHADER : VERTEX_SHADER, FRAGMENT_SHADER};
+}
+// --------------------------------------------------------------------------------
+
+void ParticleSystem::refreshPipeline() {
+    computePipeline->refreshPipeline();
+}
+// --------------------------------------------------------------------------------
+
+PipelineDesc ParticleSystem::getPipelineDesc(const PipelineDesc& base, uint32_t viewCount) {
+    PipelineDesc desc = base;
+    desc.vertexShader = viewCount > 1 ? MULTIVIEW_VERTEX_SHADER : VERTEX_SHADER;
+    desc.fragmentShader = FRAGMENT_SHADER;
+
+    VkVertexInputBindingDescription binding{};
+    binding.binding = 0;
+    binding.stride = sizeof(Particle);
+    binding.inputRate = VK_VERTEX_INPUT_RATE_INSTANCE;
+    desc.vertexBindings = {binding};
+
+    VkVertexInputAttributeDescription position{};
+    position.location = 0;
+    position.binding = 0;
+    position.format = VK_FORMAT_R32G32_SFLOAT;
+    position.offset = offsetof(Particle, position);
+
+    VkVertexInputAttributeDescription velocity{};
+    velocity.location = 1;
+    velocity.binding = 0;
+    velocity.format = VK_FORMAT_R32G32_SFLOAT;
+    velocity.offset = offsetof(Particle, velocity);
+    desc.vertexAttributes = {position, velocity};
+
+    desc.topology = VK_PRIMITIVE_TOPOLOGY_POINT_LIST;
+    desc.cullMode = VK_CULL_MODE_NONE;
+
+    // Overlapping particles add up rather than hide each other
+    desc.blendEnable = VK_TRUE;
+    desc.srcColorBlendFactor = VK_BLEND_FACTOR_ONE;
+    desc.dstColorBlendFactor = VK_BLEND_FACTOR_ONE;
+    return desc;
+}
+// --------------------------------------------------------------------------------
+
+uint32_t ParticleSystem::getParticleCount() const {
+    return particleCount;
+}
+// --------------------------------------------------------------------------------
+
+uint64_t ParticleSystem::getMeasuredStepCount() const {
+    return measuredSteps;
+}
+// --------------------------------------------------------------------------------
+
+double ParticleSystem::getAverageStepMicroseconds() const {
+    return measuredSteps > 0 ? measuredMicroseconds / static_cast<double>(measuredSteps) : 0.0;
+}
+// ================================================================================
+
+void ParticleSystem::createBuffers() {
+    VkBufferCreateInfo bufferInfo{};
+    bufferInfo.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+    bufferInfo.size = static_cast<VkDeviceSize>(particleCount) * sizeof(Particle);
+    bufferInfo.usage = VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_VERTEX_BUFFER_BIT |
+                       VK_BUFFER_USAGE_TRANSFER_DST_BIT;
+
+    // Written on the compute queue and read on the graphics queue
+    if (sharingFamilies.size() > 1) {
+        bufferInfo.sharingMode = VK_SHARING_MODE_CONCURRENT;
+        bufferInfo.queueFamilyIndexCount = static_cast<uint32_t>(sharingFamilies.size());
+        bufferInfo.pQueueFamilyIndices = sharingFamilies.data();
+    } else {
+        bufferInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+    }
+
+    for (uint32_t i = 0; i < 2; i++) {
+        if (vkCreateBuffer(device, &bufferInfo, hostAllocator(VK_OBJECT_TYPE_BUFFER), &buffers[i]) != VK_SUCCESS) {
+            throw std::runtime_error("failed to create particle buffer!");
+        }
+
+        VkMemoryRequirements memRequirements;
+        vkGetBufferMemoryRequirements(device, buffers[i], &memRequirements);
+
+        VkMemoryAllocateInfo allocInfo{};
+        allocInfo.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
+        allocInfo.allocationSize = memRequirements.size;
+        allocInfo.memoryTypeIndex = findMemoryType(physicalDevice, memRequirements.memoryTypeBits,
+                                                   VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
+
+        bufferResidency[i] = residency.allocate(allocInfo, RESIDENCY_PRIORITY_HIGH, "particles",
+                                                nullptr, bufferMemory[i]);
+        vkBindBufferMemory(device, buffers[i], bufferMemory[i], 0);
+    }
+}
+// --------------------------------------------------------------------------------
+
+void ParticleSystem::uploadInitialState(UploadManager& uploads, uint32_t computeFamily) {
+    // A fixed seed keeps benchmark runs comparable
+    std::vector<Particle> particles(particleCount);
+    std::mt19937 generator(1234);
+    std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+    for (Particle& particle : particles) {
+        float radius = 0.25f + 0.5f * std::sqrt(unit(generator));
+        float angle = unit(generator) * 6.2831853f;
+        float speed = 0.2f / std::sqrt(radius);
+        particle.position[0] = radius * std::cos(angle);
+        particle.position[1] = radius * std::sin(angle);
+        particle.velocity[0] = -speed * std::sin(angle);
+        particle.velocity[1] = speed * std::cos(angle);
+    }
+
+    // The particles are larger than the staging ring, so they go up in
+    // chunks, and the ring is flushed whenever the next chunk does not fit.
+    // Half the ring always fits once it is empty, even where it wraps.
+    const uint8_t* data = reinterpret_cast<const uint8_t*>(particles.data());
+    VkDeviceSize size = static_cast<VkDeviceSize>(particleCount) * sizeof(Particle);
+    VkDeviceSize chunkSize = uploads.getStagingSize() / 2;
+    for (VkDeviceSize offset = 0; offset < size; offset += chunkSize) {
+        VkDeviceSize chunk = std::min(chunkSize, size - offset);
+        if (!uploads.write(buffers[0], offset, data + offset, chunk)) {
+            uploads.flush(computeQueue, computeFamily, computeTimeline);
+            if (!uploads.write(buffers[0], offset, data + offset, chunk)) {
+                throw std::runtime_error("failed to stage initial particle state!");
+            }
+        }
+    }
+
+    // The first step is submitted after the flush on the same queue, which
+    // waited for the copies
+    uploads.flush(computeQueue, computeFamily, computeTimeline);
+}
+// --------------------------------------------------------------------------------
+
+void ParticleSystem::createDescriptors() {
+    VkDescriptorSetLayoutBinding bindings[2]{};
+    for (uint32_t i = 0; i < 2; i++) {
+        bindings[i].binding = i;
+        bindings[i].descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+        bindings[i].descriptorCount = 1;
+        bindings[i].stageFlags = VK_SHADER_STAGE_COMPUTE_BIT;
+    }
+
+    VkDescriptorSetLayoutCreateInfo layoutInfo{};
+    layoutInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
+    layoutInfo.bindingCount = 2;
+    layoutInfo.pBindings = bindings;
+    if (vkCreateDescriptorSetLayout(device, &layoutInfo, hostAllocator(VK_OBJECT_TYPE_DESCRIPTOR_SET_LAYOUT), &descriptorSetLayout) != VK_SUCCESS) {
+        throw std::runtime_error("failed to create particle descriptor set layout!");
+    }
+
+    VkDescriptorPoolSize poolSize{};
+    poolSize.type = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+    poolSize.descriptorCount = 4;
+
+    VkDescriptorPoolCreateInfo poolInfo{};
+    poolInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
+    poolInfo.poolSizeCount = 1;
+    poolInfo.pPoolSizes = &poolSize;
+    poolInfo.maxSets = 2;
+    if (vkCreateDescriptorPool(device, &poolInfo, hostAllocator(VK_OBJECT_TYPE_DESCRIPTOR_POOL), &descriptorPool) != VK_SUCCESS) {
+        throw std::runtime_error("failed to create particle descriptor pool!");
+    }
+
+    VkDescriptorSetLayout layouts[2] = {descriptorSetLayout, descriptorSetLayout};
+    VkDescriptorSetAllocateInfo allocInfo{};
+    allocInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+    allocInfo.descriptorPool = descriptorPool;
+    allocInfo.descriptorSetCount = 2;
+    allocInfo.pSetLayouts = layouts;
+    if (vkAllocateDescriptorSets(device, &allocInfo, descriptorSets) != VK_SUCCESS) {
+        throw std::runtime_error("failed to allocate particle descriptor sets!");
+    }
+
+    // Set i reads buffer i and writes the other one
+    VkDeviceSize size = static_cast<VkDeviceSize>(particleCount) * sizeof(Particle);
+    for (uint32_t i = 0; i < 2; i++) {
+        VkDescriptorBufferInfo bufferInfos[2]{};
+        bufferInfos[0].buffer = buffers[i];
+        bufferInfos[0].range = size;
+        bufferInfos[1].buffer = buffers[1 - i];
+        bufferInfos[1].range = size;
+
+        VkWriteDescriptorSet write{};
+        write.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+        write.dstSet = descriptorSets[i];
+        write.dstBinding = 0;
+        write.descriptorCount = 2;
+        write.descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+        write.pBufferInfo = bufferInfos;
+        vkUpdateDescriptorSets(device, 1, &write, 0, nullptr);
+    }
+}
+// --------------------------------------------------------------------------------
+
+void ParticleSystem::createTimestampPool(uint32_t computeFamily, uint32_t framesInFlight) {
+    uint32_t queueFamilyCount = 0;
+    vkGetPhysicalDeviceQueueFamilyProperties(physicalDevice, &queueFamilyCount, nullptr);
+    std::vector<VkQueueFamilyProperties> queueFamilies(queueFamilyCount);
+    vkGetPhysicalDeviceQueueFamilyProperties(physicalDevice, &queueFamilyCount, queueFamilies.data());
+
+    uint32_t validBits = queueFamilies[computeFamily].timestampValidBits;
+    if (validBits == 0) {
+        return;
+    }
+    timestampMask = validBits >= 64 ? ~0ULL : (1ULL << validBits) - 1;
+
+    VkPhysicalDeviceProperties properties;
+    vkGetPhysicalDeviceProperties(physicalDevice, &properties);
+    timestampPeriod = properties.limits.timestampPeriod;
+
+    VkQueryPoolCreateInfo poolInfo{};
+    poolInfo.sType = VK_STRUCTURE_TYPE_QUERY_POOL_CREATE_INFO;
+    poolInfo.queryType = VK_QUERY_TYPE_TIMESTAMP;
+    poolInfo.queryCount = framesInFlight * 2;
+    if (vkCreateQueryPool(device, &poolInfo, hostAllocator(VK_OBJECT_TYPE_QUERY_POOL), &timestampPool) != VK_SUCCESS) {
+        throw std::runtime_error("failed to create particle timestamp pool!");
+    }
+    timestampValues.assign(framesInFlight, 0);
+}
+// --------------------------------------------------------------------------------
+
+void ParticleSystem::collectTimestamps(uint32_t frameIndex) {
+    if (timestampPool == VK_NULL_HANDLE || timestampValues[frameIndex] == 0 ||
+        !computeTimeline.isComplete(timestampValues[frameIndex])) {
+        return;
+    }
+    timestampValues[frameIndex] = 0;
+
+    uint64_t timestamps[2];
+    if (vkGetQueryPoolResults(device, timestampPool, frameIndex * 2, 2, sizeof(timestamps), timestamps,
+                              sizeof(uint64_t), VK_QUERY_RESULT_64_BIT) != VK_SUCCESS) {
+        return;
+    }
+    uint64_t ticks = (timestamps[1] - timestamps[0]) & timestampMask;
+    measuredMicroseconds += static_cast<double>(ticks) * timestampPeriod / 1000.0;
+    measuredSteps++;
+}
+// ================================================================================
+// ================================================================================
+// eof
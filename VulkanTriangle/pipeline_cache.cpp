@@ -0,0 +1,555 @@
+// ================================================================================
+// ================================================================================
+// - File:    pipeline_cache.cpp
+// - Purpose: Contains the implementation for pipeline_cache.hpp
+//
+// Source Metadata
+// - Author:  Jonathan A. Webb
+// - Date:    October 18, 2026
+// - Version: 1.0
+// - Copyright: Copyright 2022, Jon Webb Inc.
+// ================================================================================
+// ================================================================================
+// Include modules here
+
+#include "include/pipeline_cache.hpp"
+#include "include/host_allocator.hpp"
+#include "include/deletion_queue.hpp"
+#include <stdexcept>
+#include <iostream>
+#include <fstream>
+#include <thread>
+// ================================================================================
+// ================================================================================
+
+size_t PipelineDesc::hash() const {
+    size_t seed = 0;
+    hashCombine(seed, vertexShader);
+    hashCombine(seed, fragmentShader);
+
+    for (const auto& binding : vertexBindings) {
+        hashCombine(seed, binding.binding);
+        hashCombine(seed, binding.stride);
+        hashCombine(seed, static_cast<uint32_t>(binding.inputRate));
+    }
+    for (const auto& attribute : vertexAttributes) {
+        hashCombine(seed, attribute.location);
+        hashCombine(seed, attribute.binding);
+        hashCombine(seed, static_cast<uint32_t>(attribute.format));
+        hashCombine(seed, attribute.offset);
+    }
+    hashCombine(seed, static_cast<uint32_t>(topology));
+
+    hashCombine(seed, static_cast<uint32_t>(polygonMode));
+    hashCombine(seed, cullMode);
+    hashCombine(seed, static_cast<uint32_t>(frontFace));
+    hashCombine(seed, static_cast<uint32_t>(samples));
+
+    hashCombine(seed, depthTestEnable);
+    hashCombine(seed, depthWriteEnable);
+    hashCombine(seed, static_cast<uint32_t>(depthCompareOp));
+
+    hashCombine(seed, blendEnable);
+    hashCombine(seed, static_cast<uint32_t>(srcColorBlendFactor));
+    hashCombine(seed, static_cast<uint32_t>(dstColorBlendFactor));
+    hashCombine(seed, static_cast<uint32_t>(colorBlendOp));
+    hashCombine(seed, static_cast<uint32_t>(srcAlphaBlendFactor));
+    hashCombine(seed, static_cast<uint32_t>(dstAlphaBlendFactor));
+    hashCombine(seed, static_cast<uint32_t>(alphaBlendOp));
+    hashCombine(seed, colorWriteMask);
+
+    for (VkFormat format : colorFormats) {
+        hashCombine(seed, static_cast<uint32_t>(format));
+    }
+    hashCombine(seed, static_cast<uint32_t>(depthFormat));
+
+    for (VkDynamicState state : dynamicStates) {
+        hashCombine(seed, static_cast<uint32_t>(state));
+    }
+    return seed;
+}
+// --------------------------------------------------------------------------------
+
+bool PipelineDesc::operator==(const PipelineDesc& other) const {
+    if (vertexBindings.size() != other.vertexBindings.size() ||
+        vertexAttributes.size() != other.vertexAttributes.size()) {
+        return false;
+    }
+    for (size_t i = 0; i < vertexBindings.size(); i++) {
+        const auto& a = vertexBindings[i];
+        const auto& b = other.vertexBindings[i];
+        if (a.binding != b.binding || a.stride != b.stride || a.inputRate != b.inputRate) {
+            return false;
+        }
+    }
+    for (size_t i = 0; i < vertexAttributes.size(); i++) {
+        const auto& a = vertexAttributes[i];
+        const auto& b = other.vertexAttributes[i];
+        if (a.location != b.location || a.binding != b.binding ||
+            a.format != b.format || a.offset != b.offset) {
+            return false;
+        }
+    }
+
+    return vertexShader == other.vertexShader &&
+           fragmentShader == other.fragmentShader &&
+           topology == other.topology &&
+           polygonMode == other.polygonMode &&
+           cullMode == other.cullMode &&
+           frontFace == other.frontFace &&
+           samples == other.samples &&
+           depthTestEnable == other.depthTestEnable &&
+           depthWriteEnable == other.depthWriteEnable &&
+           depthCompareOp == other.depthCompareOp &&
+           blendEnable == other.blendEnable &&
+           srcColorBlendFactor == other.srcColorBlendFactor &&
+           dstColorBlendFactor == other.dstColorBlendFactor &&
+           colorBlendOp == other.colorBlendOp &&
+           srcAlphaBlendFactor == other.srcAlphaBlendFactor &&
+           dstAlphaBlendFactor == other.dstAlphaBlendFactor &&
+           alphaBlendOp == other.alphaBlendOp &&
+           colorWriteMask == other.colorWriteMask &&
+           colorFormats == other.colorFormats &&
+           depthFormat == other.depthFormat &&
+           dynamicStates == other.dynamicStates;
+}
+// ================================================================================
+// ================================================================================
+
+PipelineStateCache::PipelineStateCache(VkDevice device,
+                                       std::unique_ptr<ShaderLibrary> shaders,
+                                       const std::vector<char>& initialData,
+                                       bool externallySynchronized)
+    : device(device),
+      externallySynchronized(externallySynchronized),
+      shaders(shaders ? std::move(shaders) : std::make_unique<ShaderLibrary>()) {
+    VkPipelineCacheCreateInfo cacheInfo{};
+    cacheInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO;
+    if (externallySynchronized) {
+        cacheInfo.flags |= VK_PIPELINE_CACHE_CREATE_EXTERNALLY_SYNCHRONIZED_BIT;
+    }
+    cacheInfo.initialDataSize = initialData.size();
+    cacheInfo.pInitialData = initialData.empty() ? nullptr : initialData.data();
+
+    VkResult result = vkCreatePipelineCache(device, &cacheInfo, hostAllocator(VK_OBJECT_TYPE_PIPELINE_CACHE), &pipelineCache);
+    if (result != VK_SUCCESS && !initialData.empty()) {
+        // A damaged file should only cost a cold start
+        std::cerr << "Pipeline cache data was rejected; starting with an empty cache" << std::endl;
+        cacheInfo.initialDataSize = 0;
+        cacheInfo.pInitialData = nullptr;
+        result = vkCreatePipelineCache(device, &cacheInfo, hostAllocator(VK_OBJECT_TYPE_PIPELINE_CACHE), &pipelineCache);
+    }
+    if (result != VK_SUCCESS) {
+        throw std::runtime_error("failed to create pipeline cache!");
+    }
+}
+// --------------------------------------------------------------------------------
+
+PipelineStateCache::~PipelineStateCache() {
+    clear();
+    if (pipelineCache != VK_NULL_HANDLE) {
+        vkDestroyPipelineCache(device, pipelineCache, hostAllocator(VK_OBJECT_TYPE_PIPELINE_CACHE));
+    }
+}
+// --------------------------------------------------------------------------------
+
+VkPipeline PipelineStateCache::getPipeline(const PipelineDesc& desc,
+                                           VkPipelineLayout layout,
+                                           VkRenderPass renderPass,
+                                           uint32_t subpass) {
+    Key key{desc, layout, renderPass, subpass};
+
+    auto it = pipelines.find(key);
+    if (it != pipelines.end()) {
+        hits++;
+        return it->second;
+    }
+
+    misses++;
+    VkPipeline pipeline = createPipeline(key, pipelineCache);
+    pipelines.emplace(std::move(key), pipeline);
+    return pipeline;
+}
+// --------------------------------------------------------------------------------
+
+VkPipeline PipelineStateCache::getComputePipeline(const std::string& computeShader, VkPipelineLayout layout) {
+    ComputeKey key{computeShader, layout};
+
+    auto it = computePipelines.find(key);
+    if (it != computePipelines.end()) {
+        hits++;
+        return it->second;
+    }
+
+    misses++;
+    VkPipeline pipeline = createComputePipeline(key, pipelineCache);
+    computePipelines.emplace(std::move(key), pipeline);
+    return pipeline;
+}
+// --------------------------------------------------------------------------------
+
+void PipelineStateCache::rebuildPipelines(const std::string& shader, JobSystem& jobs) {
+    Rebuild rebuild;
+    rebuild.shader = shader;
+    rebuild.request = ++rebuildRequests;
+    latestRebuilds[shader] = rebuild.request;
+
+    // The keys are copied here since the maps may change while the job runs
+    for (const auto& entry : pipelines) {
+        if (entry.first.desc.vertexShader == shader || entry.first.desc.fragmentShader == shader) {
+            rebuild.pipelines.emplace_back(entry.first, VK_NULL_HANDLE);
+        }
+    }
+    for (const auto& entry : computePipelines) {
+        if (entry.first.computeShader == shader) {
+            rebuild.computePipelines.emplace_back(entry.first, VK_NULL_HANDLE);
+        }
+    }
+    if (rebuild.pipelines.empty() && rebuild.computePipelines.empty()) {
+        return;
+    }
+
+    jobs.run([this, rebuild = std::move(rebuild)]() mutable {
+        try {
+            // Only this job touches its cache, so the main one needs no lock
+            // while misses compile into it on the caller's thread
+            VkPipelineCacheCreateInfo cacheInfo{};
+            cacheInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO;
+            if (externallySynchronized) {
+                cacheInfo.flags |= VK_PIPELINE_CACHE_CREATE_EXTERNALLY_SYNCHRONIZED_BIT;
+            }
+            if (vkCreatePipelineCache(device, &cacheInfo, hostAllocator(VK_OBJECT_TYPE_PIPELINE_CACHE),
+                                      &rebuild.cache) != VK_SUCCESS) {
+                rebuild.cache = VK_NULL_HANDLE;
+                throw std::runtime_error("failed to create pipeline cache!");
+            }
+            for (auto& entry : rebuild.pipelines) {
+                entry.second = createPipeline(entry.first, rebuild.cache);
+            }
+            for (auto& entry : rebuild.computePipelines) {
+                entry.second = createComputePipeline(entry.first, rebuild.cache);
+            }
+        } catch (const std::exception& e) {
+            rebuild.error = e.what();
+        }
+
+        std::lock_guard<std::mutex> lock(rebuildMutex);
+        finishedRebuilds.push_back(std::move(rebuild));
+    }, &rebuildJobs);
+}
+// --------------------------------------------------------------------------------
+
+size_t PipelineStateCache::swapRebuiltPipelines(DeletionQueue& retired) {
+    std::vector<Rebuild> rebuilds;
+    {
+        std::lock_guard<std::mutex> lock(rebuildMutex);
+        rebuilds.swap(finishedRebuilds);
+    }
+
+    size_t swapped = 0;
+    for (const Rebuild& rebuild : rebuilds) {
+        // A newer version of the shader is still compiling
+        if (latestRebuilds[rebuild.shader] != rebuild.request) {
+            discard(rebuild);
+            continue;
+        }
+        if (!rebuild.error.empty()) {
+            std::cerr << "Shader reload: keeping the previous pipelines for " << rebuild.shader
+                      << ": " << rebuild.error << std::endl;
+            discard(rebuild);
+            continue;
+        }
+
+        // A failed merge only means the next run compiles these again
+        if (vkMergePipelineCaches(device, pipelineCache, 1, &rebuild.cache) != VK_SUCCESS) {
+            std::cerr << "Shader reload: failed to merge the pipeline cache for " << rebuild.shader << std::endl;
+        }
+        vkDestroyPipelineCache(device, rebuild.cache, hostAllocator(VK_OBJECT_TYPE_PIPELINE_CACHE));
+
+        // Pipelines cleared since the rebuild started have no old version to replace
+        for (const auto& entry : rebuild.pipelines) {
+            auto it = pipelines.find(entry.first);
+            if (it == pipelines.end()) {
+                vkDestroyPipeline(device, entry.second, hostAllocator(VK_OBJECT_TYPE_PIPELINE));
+                continue;
+            }
+            retired.destroy(VK_OBJECT_TYPE_PIPELINE, it->second);
+            it->second = entry.second;
+            swapped++;
+        }
+        for (const auto& entry : rebuild.computePipelines) {
+            auto it = computePipelines.find(entry.first);
+            if (it == computePipelines.end()) {
+                vkDestroyPipeline(device, entry.second, hostAllocator(VK_OBJECT_TYPE_PIPELINE));
+                continue;
+            }
+            retired.destroy(VK_OBJECT_TYPE_PIPELINE, it->second);
+            it->second = entry.second;
+            swapped++;
+        }
+    }
+    return swapped;
+}
+// --------------------------------------------------------------------------------
+
+void PipelineStateCache::clear() {
+    // A rebuild still compiling reads the shader library and the pipeline cache
+    while (!rebuildJobs.isDone()) {
+        std::this_thread::yield();
+    }
+    for (const Rebuild& rebuild : finishedRebuilds) {
+        discard(rebuild);
+    }
+    finishedRebuilds.clear();
+
+    for (auto& entry : pipelines) {
+        vkDestroyPipeline(device, entry.second, hostAllocator(VK_OBJECT_TYPE_PIPELINE));
+    }
+    pipelines.clear();
+    for (auto& entry : computePipelines) {
+        vkDestroyPipeline(device, entry.second, hostAllocator(VK_OBJECT_TYPE_PIPELINE));
+    }
+    computePipelines.clear();
+}
+// --------------------------------------------------------------------------------
+
+uint64_t PipelineStateCache::getHits() const {
+    return hits;
+}
+// --------------------------------------------------------------------------------
+
+uint64_t PipelineStateCache::getMisses() const {
+    return misses;
+}
+// --------------------------------------------------------------------------------
+
+size_t PipelineStateCache::size() const {
+    return pipelines.size() + computePipelines.size();
+}
+// --------------------------------------------------------------------------------
+
+VkPipelineCache PipelineStateCache::getVkPipelineCache() const {
+    return pipelineCache;
+}
+// --------------------------------------------------------------------------------
+
+ShaderLibrary& PipelineStateCache::getShaderLibrary() {
+    return *shaders;
+}
+// --------------------------------------------------------------------------------
+
+void PipelineStateCache::saveCacheData(const std::string& path) const {
+    size_t size = 0;
+    if (vkGetPipelineCacheData(device, pipelineCache, &size, nullptr) != VK_SUCCESS) {
+        std::cerr << "Failed to query pipeline cache data" << std::endl;
+        return;
+    }
+    std::vector<char> data(size);
+    if (vkGetPipelineCacheData(device, pipelineCache, &size, data.data()) != VK_SUCCESS) {
+        std::cerr << "Failed to read pipeline cache data" << std::endl;
+        return;
+    }
+
+    std::ofstream file(path, std::ios::binary);
+    file.write(data.data(), static_cast<std::streamsize>(size));
+    if (!file) {
+        std::cerr << "Failed to write pipeline cache to '" << path << "'" << std::endl;
+    }
+}
+// --------------------------------------------------------------------------------
+
+std::vector<char> PipelineStateCache::loadCacheData(const std::string& path) {
+    std::ifstream file(path, std::ios::ate | std::ios::binary);
+    if (!file.is_open()) {
+        return {};
+    }
+
+    std::vector<char> data(static_cast<size_t>(file.tellg()));
+    file.seekg(0);
+    file.read(data.data(), static_cast<std::streamsize>(data.size()));
+    if (!file) {
+        return {};
+    }
+    return data;
+}
+// ================================================================================
+
+void PipelineStateCache::discard(const Rebuild& rebuild) {
+    for (const auto& entry : rebuild.pipelines) {
+        if (entry.second != VK_NULL_HANDLE) {
+            vkDestroyPipeline(device, entry.second, hostAllocator(VK_OBJECT_TYPE_PIPELINE));
+        }
+    }
+    for (const auto& entry : rebuild.computePipelines) {
+        if (entry.second != VK_NULL_HANDLE) {
+            vkDestroyPipeline(device, entry.second, hostAllocator(VK_OBJECT_TYPE_PIPELINE));
+        }
+    }
+    if (rebuild.cache != VK_NULL_HANDLE) {
+        vkDestroyPipelineCache(device, rebuild.cache, hostAllocator(VK_OBJECT_TYPE_PIPELINE_CACHE));
+    }
+}
+// --------------------------------------------------------------------------------
+
+VkPipeline PipelineStateCache::createPipeline(const Key& key, VkPipelineCache cache) {
+    const PipelineDesc& desc = key.desc;
+
+    std::shared_ptr<const ShaderCode> vertShaderCode = shaders->get(desc.vertexShader);
+    std::shared_ptr<const ShaderCode> fragShaderCode = shaders->get(desc.fragmentShader);
+
+    VkShaderModule vertShaderModule = createShaderModule(vertShaderCode->code);
+    VkShaderModule fragShaderModule = createShaderModule(fragShaderCode->code);
+
+    VkPipelineShaderStageCreateInfo vertShaderStageInfo{};
+    vertShaderStageInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
+    vertShaderStageInfo.stage = VK_SHADER_STAGE_VERTEX_BIT;
+    vertShaderStageInfo.module = vertShaderModule;
+    vertShaderStageInfo.pName = "main";
+
+    VkPipelineShaderStageCreateInfo fragShaderStageInfo{};
+    fragShaderStageInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
+    fragShaderStageInfo.stage = VK_SHADER_STAGE_FRAGMENT_BIT;
+    fragShaderStageInfo.module = fragShaderModule;
+    fragShaderStageInfo.pName = "main";
+
+    VkPipelineShaderStageCreateInfo shaderStages[] = {vertShaderStageInfo, fragShaderStageInfo};
+
+    VkPipelineVertexInputStateCreateInfo vertexInputInfo{};
+    vertexInputInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_VERTEX_INPUT_STATE_CREATE_INFO;
+    vertexInputInfo.vertexBindingDescriptionCount = static_cast<uint32_t>(desc.vertexBindings.size());
+    vertexInputInfo.pVertexBindingDescriptions = desc.vertexBindings.data();
+    vertexInputInfo.vertexAttributeDescriptionCount = static_cast<uint32_t>(desc.vertexAttributes.size());
+    vertexInputInfo.pVertexAttributeDescriptions = desc.vertexAttributes.data();
+
+    VkPipelineInputAssemblyStateCreateInfo inputAssembly{};
+    inputAssembly.sType = VK_STRUCTURE_TYPE_PIPELINE_INPUT_ASSEMBLY_STATE_CREATE_INFO;
+    inputAssembly.topology = desc.topology;
+    inputAssembly.primitiveRestartEnable = VK_FALSE;
+
+    VkPipelineViewportStateCreateInfo viewportState{};
+    viewportState.sType = VK_STRUCTURE_TYPE_PIPELINE_VIEWPORT_STATE_CREATE_INFO;
+    viewportState.viewportCount = 1;
+    viewportState.scissorCount = 1;
+
+    VkPipelineRasterizationStateCreateInfo rasterizer{};
+    rasterizer.sType = VK_STRUCTURE_TYPE_PIPELINE_RASTERIZATION_STATE_CREATE_INFO;
+    rasterizer.depthClampEnable = VK_FALSE;
+    rasterizer.rasterizerDiscardEnable = VK_FALSE;
+    rasterizer.polygonMode = desc.polygonMode;
+    rasterizer.lineWidth = 1.0f;
+    rasterizer.cullMode = desc.cullMode;
+    rasterizer.frontFace = desc.frontFace;
+    rasterizer.depthBiasEnable = VK_FALSE;
+
+    VkPipelineMultisampleStateCreateInfo multisampling{};
+    multisampling.sType = VK_STRUCTURE_TYPE_PIPELINE_MULTISAMPLE_STATE_CREATE_INFO;
+    multisampling.sampleShadingEnable = VK_FALSE;
+    multisampling.rasterizationSamples = desc.samples;
+
+    VkPipelineDepthStencilStateCreateInfo depthStencil{};
+    depthStencil.sType = VK_STRUCTURE_TYPE_PIPELINE_DEPTH_STENCIL_STATE_CREATE_INFO;
+    depthStencil.depthTestEnable = desc.depthTestEnable;
+    depthStencil.depthWriteEnable = desc.depthWriteEnable;
+    depthStencil.depthCompareOp = desc.depthCompareOp;
+    depthStencil.depthBoundsTestEnable = VK_FALSE;
+    depthStencil.stencilTestEnable = VK_FALSE;
+
+    VkPipelineColorBlendAttachmentState colorBlendAttachment{};
+    colorBlendAttachment.colorWriteMask = desc.colorWriteMask;
+    colorBlendAttachment.blendEnable = desc.blendEnable;
+    colorBlendAttachment.srcColorBlendFactor = desc.srcColorBlendFactor;
+    colorBlendAttachment.dstColorBlendFactor = desc.dstColorBlendFactor;
+    colorBlendAttachment.colorBlendOp = desc.colorBlendOp;
+    colorBlendAttachment.srcAlphaBlendFactor = desc.srcAlphaBlendFactor;
+    colorBlendAttachment.dstAlphaBlendFactor = desc.dstAlphaBlendFactor;
+    colorBlendAttachment.alphaBlendOp = desc.alphaBlendOp;
+    std::vector<VkPipelineColorBlendAttachmentState> colorBlendAttachments(desc.colorFormats.size(),
+                                                                           colorBlendAttachment);
+
+    VkPipelineColorBlendStateCreateInfo colorBlending{};
+    colorBlending.sType = VK_STRUCTURE_TYPE_PIPELINE_COLOR_BLEND_STATE_CREATE_INFO;
+    colorBlending.logicOpEnable = VK_FALSE;
+    colorBlending.logicOp = VK_LOGIC_OP_COPY;
+    colorBlending.attachmentCount = static_cast<uint32_t>(colorBlendAttachments.size());
+    colorBlending.pAttachments = colorBlendAttachments.data();
+    colorBlending.blendConstants[0] = 0.0f;
+    colorBlending.blendConstants[1] = 0.0f;
+    colorBlending.blendConstants[2] = 0.0f;
+    colorBlending.blendConstants[3] = 0.0f;
+
+    VkPipelineDynamicStateCreateInfo dynamicState{};
+    dynamicState.sType = VK_STRUCTURE_TYPE_PIPELINE_DYNAMIC_STATE_CREATE_INFO;
+    dynamicState.dynamicStateCount = static_cast<uint32_t>(desc.dynamicStates.size());
+    dynamicState.pDynamicStates = desc.dynamicStates.data();
+
+    VkGraphicsPipelineCreateInfo pipelineInfo{};
+    pipelineInfo.sType = VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_CREATE_INFO;
+    pipelineInfo.stageCount = 2;
+    pipelineInfo.pStages = shaderStages;
+    pipelineInfo.pVertexInputState = &vertexInputInfo;
+    pipelineInfo.pInputAssemblyState = &inputAssembly;
+    pipelineInfo.pViewportState = &viewportState;
+    pipelineInfo.pRasterizationState = &rasterizer;
+    pipelineInfo.pMultisampleState = &multisampling;
+    pipelineInfo.pDepthStencilState = desc.depthFormat != VK_FORMAT_UNDEFINED ? &depthStencil : nullptr;
+    pipelineInfo.pColorBlendState = &colorBlending;
+    pipelineInfo.pDynamicState = &dynamicState;
+    pipelineInfo.layout = key.layout;
+    pipelineInfo.renderPass = key.renderPass;
+    pipelineInfo.subpass = key.subpass;
+    pipelineInfo.basePipelineHandle = VK_NULL_HANDLE;
+
+    VkPipeline pipeline;
+    VkResult result = vkCreateGraphicsPipelines(device, cache, 1, &pipelineInfo, hostAllocator(VK_OBJECT_TYPE_PIPELINE), &pipeline);
+
+    vkDestroyShaderModule(device, fragShaderModule, hostAllocator(VK_OBJECT_TYPE_SHADER_MODULE));
+    vkDestroyShaderModule(device, vertShaderModule, hostAllocator(VK_OBJECT_TYPE_SHADER_MODULE));
+
+    if (result != VK_SUCCESS) {
+        throw std::runtime_error("failed to create graphics pipeline!");
+    }
+    return pipeline;
+}
+// --------------------------------------------------------------------------------
+
+VkPipeline PipelineStateCache::createComputePipeline(const ComputeKey& key, VkPipelineCache cache) {
+    std::shared_ptr<const ShaderCode> computeShaderCode = shaders->get(key.computeShader);
+    VkShaderModule computeShaderModule = createShaderModule(computeShaderCode->code);
+
+    VkComputePipelineCreateInfo pipelineInfo{};
+    pipelineInfo.sType = VK_STRUCTURE_TYPE_COMPUTE_PIPELINE_CREATE_INFO;
+    pipelineInfo.stage.sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
+    pipelineInfo.stage.stage = VK_SHADER_STAGE_COMPUTE_BIT;
+    pipelineInfo.stage.module = computeShaderModule;
+    pipelineInfo.stage.pName = "main";
+    pipelineInfo.layout = key.layout;
+    pipelineInfo.basePipelineHandle = VK_NULL_HANDLE;
+
+    VkPipeline pipeline;
+    VkResult result = vkCreateComputePipelines(device, cache, 1, &pipelineInfo, hostAllocator(VK_OBJECT_TYPE_PIPELINE), &pipeline);
+
+    vkDestroyShaderModule(device, computeShaderModule, hostAllocator(VK_OBJECT_TYPE_SHADER_MODULE));
+
+    if (result != VK_SUCCESS) {
+        throw std::runtime_error("failed to create compute pipeline!");
+    }
+    return pipeline;
+}
+// --------------------------------------------------------------------------------
+
+VkShaderModule PipelineStateCache::createShaderModule(const std::vector<char>& code) {
+    VkShaderModuleCreateInfo createInfo{};
+    createInfo.sType = VK_STRUCTURE_TYPE_SHADER_MODULE_CREATE_INFO;
+    createInfo.codeSize = code.size();
+    createInfo.pCode = reinterpret_cast<const uint32_t*>(code.data());
+
+    VkShaderModule shaderModule;
+    if (vkCreateShaderModule(device, &createInfo, hostAllocator(VK_OBJECT_TYPE_SHADER_MODULE), &shaderModule) != VK_SUCCESS) {
+        throw std::runtime_error("failed to create shader module!");
+    }
+
+    return shaderModule;
+}
+// ================================================================================
+// ================================================================================
+// eof
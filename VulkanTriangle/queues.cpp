@@ -28,25 +28,52 @@ QueueFamilyIndices QueueFamily::findQueueFamilies(VkPhysicalDevice device, VkSur
     std::vector<VkQueueFamilyProperties> queueFamilies(queueFamilyCount);
     vkGetPhysicalDeviceQueueFamilyProperties(device, &queueFamilyCount, queueFamilies.data());
 
-    int i = 0;
-    for (const auto& queueFamily : queueFamilies) {
-        if (queueFamily.queueFlags & VK_QUEUE_GRAPHICS_BIT) {
+    std::optional<uint32_t> asyncTransferFamily;
+    std::optional<uint32_t> dedicatedTransferFamily;
+    std::optional<uint32_t> asyncComputeFamily;
+    for (uint32_t i = 0; i < queueFamilyCount; i++) {
+        const VkQueueFamilyProperties& queueFamily = queueFamilies[i];
+        if ((queueFamily.queueFlags & VK_QUEUE_GRAPHICS_BIT) && !indices.graphicsFamily.has_value()) {
             indices.graphicsFamily = i;
         }
 
+        // Without a surface nothing is presented, so the graphics family stands in
         VkBool32 presentSupport = false;
-        vkGetPhysicalDeviceSurfaceSupportKHR(device, i, surface, &presentSupport);
+        if (surface != VK_NULL_HANDLE) {
+            vkGetPhysicalDeviceSurfaceSupportKHR(device, i, surface, &presentSupport);
+        } else {
+            presentSupport = (queueFamily.queueFlags & VK_QUEUE_GRAPHICS_BIT) != 0;
+        }
 
-        if (presentSupport) {
+        if (presentSupport && !indices.presentFamily.has_value()) {
             indices.presentFamily = i;
         }
 
-        if (indices.isComplete()) {
-            break;
+        if ((queueFamily.queueFlags & VK_QUEUE_COMPUTE_BIT) && !(queueFamily.queueFlags & VK_QUEUE_GRAPHICS_BIT) &&
+            !asyncComputeFamily.has_value()) {
+            asyncComputeFamily = i;
+        }
+
+        // Graphics and compute families implicitly support transfers
+        bool transfers = queueFamily.queueFlags & (VK_QUEUE_TRANSFER_BIT | VK_QUEUE_COMPUTE_BIT);
+        if (transfers && !(queueFamily.queueFlags & VK_QUEUE_GRAPHICS_BIT)) {
+            if (!(queueFamily.queueFlags & VK_QUEUE_COMPUTE_BIT) && !dedicatedTransferFamily.has_value()) {
+                dedicatedTransferFamily = i;
+            }
+            if (!asyncTransferFamily.has_value()) {
+                asyncTransferFamily = i;
+            }
         }
+    }
 
-        i++;
+    if (dedicatedTransferFamily.has_value()) {
+        indices.transferFamily = dedicatedTransferFamily;
+    } else if (asyncTransferFamily.has_value()) {
+        indices.transferFamily = asyncTransferFamily;
+    } else {
+        indices.transferFamily = indices.graphicsFamily;
     }
+    indices.computeFamily = asyncComputeFamily.has_value() ? asyncComputeFamily : indices.graphicsFamily;
 
     if (!indices.graphicsFamily.has_value()) {
         std::cerr << "Failed to find graphics queue family." << std::endl;
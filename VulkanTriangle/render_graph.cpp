@@ -0,0 +1,500 @@
+// ================================================================================
+// ================================================================================
+// - File:    render_graph.cpp
+// - Purpose: Contains the implementation for render_graph.hpp
+//
+// Source Metadata
+// - Author:  Jonathan A. Webb
+// - Date:    October 18, 2026
+// - Version: 1.0
+// - Copyright: Copyright 2022, Jon Webb Inc.
+// ================================================================================
+// ================================================================================
+// Include modules here
+
+#include "include/render_graph.hpp"
+#include "include/buffers.hpp"
+#include "include/host_allocator.hpp"
+#include <stdexcept>
+#include <algorithm>
+// ================================================================================
+// ================================================================================
+
+static const VkAccessFlags2 WRITE_ACCESS_MASK = VK_ACCESS_2_SHADER_WRITE_BIT |
+                                                VK_ACCESS_2_COLOR_ATTACHMENT_WRITE_BIT |
+                                                VK_ACCESS_2_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT |
+                                                VK_ACCESS_2_TRANSFER_WRITE_BIT |
+                                                VK_ACCESS_2_MEMORY_WRITE_BIT |
+                                                VK_ACCESS_2_SHADER_STORAGE_WRITE_BIT;
+// --------------------------------------------------------------------------------
+
+static bool isWrite(VkAccessFlags2 access) {
+    return (access & WRITE_ACCESS_MASK) != 0;
+}
+// --------------------------------------------------------------------------------
+
+static bool lifetimesOverlap(int firstA, int lastA, int firstB, int lastB) {
+    return firstA <= lastB && firstB <= lastA;
+}
+// ================================================================================
+// ================================================================================
+
+RenderGraph::RenderGraph(VkDevice device, VkPhysicalDevice physicalDevice, ResidencyManager* residency)
+    : device(device), physicalDevice(physicalDevice), residency(residency) {}
+// --------------------------------------------------------------------------------
+
+RenderGraph::~RenderGraph() {
+    for (Resource& resource : resources) {
+        if (resource.imported) {
+            continue;
+        }
+        if (resource.view != VK_NULL_HANDLE) {
+            vkDestroyImageView(device, resource.view, hostAllocator(VK_OBJECT_TYPE_IMAGE_VIEW));
+        }
+        if (resource.image != VK_NULL_HANDLE) {
+            vkDestroyImage(device, resource.image, hostAllocator(VK_OBJECT_TYPE_IMAGE));
+        }
+    }
+    if (transientMemory != VK_NULL_HANDLE && residency != nullptr) {
+        residency->free(transientResidency, transientMemory);
+    } else if (transientMemory != VK_NULL_HANDLE) {
+        vkFreeMemory(device, transientMemory, hostAllocator(VK_OBJECT_TYPE_DEVICE_MEMORY));
+    }
+}
+// --------------------------------------------------------------------------------
+
+RenderGraphResource RenderGraph::importImage(const std::string& name,
+                                             VkImageAspectFlags aspect,
+                                             ResourceState initialState,
+                                             ResourceUsage finalUsage) {
+    if (compiled) {
+        throw std::runtime_error("cannot import an image into a compiled render graph!");
+    }
+    Resource resource;
+    resource.name = name;
+    resource.imported = true;
+    resource.aspect = aspect;
+    resource.initialState = initialState;
+    resource.finalUsage = finalUsage;
+    resources.push_back(resource);
+    return static_cast<RenderGraphResource>(resources.size() - 1);
+}
+// --------------------------------------------------------------------------------
+
+void RenderGraph::setImportedImage(RenderGraphResource resource, VkImage image, VkImageView view) {
+    if (resource >= resources.size() || !resources[resource].imported) {
+        throw std::runtime_error("render graph resource is not an imported image!");
+    }
+    resources[resource].image = image;
+    resources[resource].view = view;
+}
+// --------------------------------------------------------------------------------
+
+RenderGraphResource RenderGraph::createImage(const std::string& name, const TransientImageDesc& desc) {
+    if (compiled) {
+        throw std::runtime_error("cannot create an image in a compiled render graph!");
+    }
+    Resource resource;
+    resource.name = name;
+    resource.desc = desc;
+    resource.aspect = desc.aspect;
+    resources.push_back(resource);
+    return static_cast<RenderGraphResource>(resources.size() - 1);
+}
+// --------------------------------------------------------------------------------
+
+void RenderGraph::addPass(const std::string& name,
+                          std::vector<PassResource> passResources,
+                          ExecuteFn execute) {
+    if (compiled) {
+        throw std::runtime_error("cannot add a pass to a compiled render graph!");
+    }
+    for (const PassResource& use : passResources) {
+        if (use.resource >= resources.size()) {
+            throw std::runtime_error("render pass '" + name + "' uses an unknown resource!");
+        }
+    }
+    Pass pass;
+    pass.name = name;
+    pass.resources = std::move(passResources);
+    pass.execute = std::move(execute);
+    passes.push_back(std::move(pass));
+}
+// --------------------------------------------------------------------------------
+
+void RenderGraph::compile() {
+    if (compiled) {
+        throw std::runtime_error("render graph has already been compiled!");
+    }
+    cullPasses();
+    computeLifetimes();
+    allocateTransientImages();
+    computeBarriers();
+    compiled = true;
+}
+// --------------------------------------------------------------------------------
+
+void RenderGraph::execute(VkCommandBuffer commandBuffer) {
+    if (!compiled) {
+        throw std::runtime_error("render graph must be compiled before it is executed!");
+    }
+    for (size_t i = 0; i < passes.size(); i++) {
+        if (!passes[i].live) {
+            continue;
+        }
+        recordBarriers(commandBuffer, passBarriers[i]);
+        passes[i].execute(commandBuffer, *this);
+    }
+    recordBarriers(commandBuffer, finalBarriers);
+}
+// --------------------------------------------------------------------------------
+
+VkImage RenderGraph::getImage(RenderGraphResource resource) const {
+    return resources.at(resource).image;
+}
+// --------------------------------------------------------------------------------
+
+VkImageView RenderGraph::getImageView(RenderGraphResource resource) const {
+    return resources.at(resource).view;
+}
+// --------------------------------------------------------------------------------
+
+const RenderGraphStats& RenderGraph::getStats() const {
+    return stats;
+}
+// --------------------------------------------------------------------------------
+
+ResourceState RenderGraph::stateFor(ResourceUsage usage) {
+    switch (usage) {
+        case ResourceUsage::ColorAttachment:
+            return {VK_PIPELINE_STAGE_2_COLOR_ATTACHMENT_OUTPUT_BIT,
+                    VK_ACCESS_2_COLOR_ATTACHMENT_READ_BIT | VK_ACCESS_2_COLOR_ATTACHMENT_WRITE_BIT,
+                    VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL};
+        case ResourceUsage::DepthAttachment:
+            return {VK_PIPELINE_STAGE_2_EARLY_FRAGMENT_TESTS_BIT | VK_PIPELINE_STAGE_2_LATE_FRAGMENT_TESTS_BIT,
+                    VK_ACCESS_2_DEPTH_STENCIL_ATTACHMENT_READ_BIT | VK_ACCESS_2_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT,
+                    VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL};
+        case ResourceUsage::SampledRead:
+            return {VK_PIPELINE_STAGE_2_FRAGMENT_SHADER_BIT | VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT,
+                    VK_ACCESS_2_SHADER_SAMPLED_READ_BIT,
+                    VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL};
+        case ResourceUsage::StorageRead:
+            return {VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT,
+                    VK_ACCESS_2_SHADER_STORAGE_READ_BIT,
+                    VK_IMAGE_LAYOUT_GENERAL};
+        case ResourceUsage::StorageWrite:
+            return {VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT,
+                    VK_ACCESS_2_SHADER_STORAGE_READ_BIT | VK_ACCESS_2_SHADER_STORAGE_WRITE_BIT,
+                    VK_IMAGE_LAYOUT_GENERAL};
+        case ResourceUsage::TransferSrc:
+            return {VK_PIPELINE_STAGE_2_ALL_TRANSFER_BIT,
+                    VK_ACCESS_2_TRANSFER_READ_BIT,
+                    VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL};
+        case ResourceUsage::TransferDst:
+            return {VK_PIPELINE_STAGE_2_ALL_TRANSFER_BIT,
+                    VK_ACCESS_2_TRANSFER_WRITE_BIT,
+                    VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL};
+        case ResourceUsage::Present:
+            // The semaphore signalled at the end of the submission orders presentation
+            return {VK_PIPELINE_STAGE_2_NONE, VK_ACCESS_2_NONE, VK_IMAGE_LAYOUT_PRESENT_SRC_KHR};
+    }
+    throw std::runtime_error("unknown render graph resource usage!");
+}
+// ================================================================================
+
+void RenderGraph::cullPasses() {
+    // Walk backwards from the imported images; a pass survives only if it touches
+    // an imported image or writes something a surviving pass consumes
+    std::vector<bool> needed(resources.size(), false);
+    for (size_t i = 0; i < resources.size(); i++) {
+        needed[i] = resources[i].imported;
+    }
+
+    stats = RenderGraphStats{};
+    for (size_t i = passes.size(); i-- > 0;) {
+        Pass& pass = passes[i];
+        pass.live = false;
+        for (const PassResource& use : pass.resources) {
+            if (needed[use.resource] && (resources[use.resource].imported || isWrite(stateFor(use.usage).access))) {
+                pass.live = true;
+                break;
+            }
+        }
+        if (!pass.live) {
+            stats.culledPassCount++;
+            continue;
+        }
+        stats.passCount++;
+        for (const PassResource& use : pass.resources) {
+            needed[use.resource] = true;
+        }
+    }
+}
+// --------------------------------------------------------------------------------
+
+void RenderGraph::computeLifetimes() {
+    for (size_t i = 0; i < passes.size(); i++) {
+        if (!passes[i].live) {
+            continue;
+        }
+        for (const PassResource& use : passes[i].resources) {
+            Resource& resource = resources[use.resource];
+            if (resource.firstPass < 0) {
+                resource.firstPass = static_cast<int>(i);
+            }
+            resource.lastPass = static_cast<int>(i);
+        }
+    }
+}
+// --------------------------------------------------------------------------------
+
+void RenderGraph::allocateTransientImages() {
+    std::vector<RenderGraphResource> transients;
+    std::vector<VkDeviceSize> alignments(resources.size(), 1);
+    uint32_t memoryTypeBits = ~0u;
+
+    for (size_t i = 0; i < resources.size(); i++) {
+        Resource& resource = resources[i];
+        if (resource.imported || resource.firstPass < 0) {
+            continue;
+        }
+
+        VkImageCreateInfo imageInfo{};
+        imageInfo.sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO;
+        imageInfo.imageType = VK_IMAGE_TYPE_2D;
+        imageInfo.format = resource.desc.format;
+        imageInfo.extent = {resource.desc.extent.width, resource.desc.extent.height, 1};
+        imageInfo.mipLevels = 1;
+        imageInfo.arrayLayers = resource.desc.layers;
+        imageInfo.samples = resource.desc.samples;
+        imageInfo.tiling = VK_IMAGE_TILING_OPTIMAL;
+        imageInfo.usage = resource.desc.usage;
+        imageInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+        imageInfo.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+
+        if (vkCreateImage(device, &imageInfo, hostAllocator(VK_OBJECT_TYPE_IMAGE), &resource.image) != VK_SUCCESS) {
+            throw std::runtime_error("failed to create transient image '" + resource.name + "'!");
+        }
+
+        VkMemoryRequirements requirements;
+        vkGetImageMemoryRequirements(device, resource.image, &requirements);
+        resource.size = requirements.size;
+        alignments[i] = requirements.alignment;
+        memoryTypeBits &= requirements.memoryTypeBits;
+        stats.transientMemoryRequested += requirements.size;
+        transients.push_back(static_cast<RenderGraphResource>(i));
+    }
+
+    if (transients.empty()) {
+        return;
+    }
+    if (memoryTypeBits == 0) {
+        throw std::runtime_error("no memory type can back every transient image!");
+    }
+
+    // Place the largest images first; each image takes the lowest offset that
+    // does not collide with an already placed image whose lifetime overlaps
+    std::sort(transients.begin(), transients.end(),
+              [this](RenderGraphResource a, RenderGraphResource b) {
+                  return resources[a].size > resources[b].size;
+              });
+
+    VkDeviceSize heapSize = 0;
+    std::vector<RenderGraphResource> placed;
+    for (RenderGraphResource index : transients) {
+        Resource& resource = resources[index];
+
+        std::vector<RenderGraphResource> live;
+        for (RenderGraphResource other : placed) {
+            if (lifetimesOverlap(resource.firstPass, resource.lastPass,
+                                 resources[other].firstPass, resources[other].lastPass)) {
+                live.push_back(other);
+            }
+        }
+        std::sort(live.begin(), live.end(), [this](RenderGraphResource a, RenderGraphResource b) {
+            return resources[a].offset < resources[b].offset;
+        });
+
+        VkDeviceSize offset = 0;
+        for (RenderGraphResource other : live) {
+            if (offset + resource.size <= resources[other].offset) {
+                break;
+            }
+            VkDeviceSize end = resources[other].offset + resources[other].size;
+            VkDeviceSize alignment = alignments[index];
+            offset = std::max(offset, (end + alignment - 1) / alignment * alignment);
+        }
+
+        resource.offset = offset;
+        heapSize = std::max(heapSize, offset + resource.size);
+        placed.push_back(index);
+    }
+
+    // Record which images share memory so their first use can wait on the others
+    for (RenderGraphResource a : transients) {
+        for (RenderGraphResource b : transients) {
+            if (a == b) {
+                continue;
+            }
+            const Resource& ra = resources[a];
+            const Resource& rb = resources[b];
+            if (ra.offset < rb.offset + rb.size && rb.offset < ra.offset + ra.size) {
+                resources[a].aliases.push_back(b);
+            }
+        }
+    }
+
+    VkMemoryAllocateInfo allocInfo{};
+    allocInfo.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
+    allocInfo.allocationSize = heapSize;
+    allocInfo.memoryTypeIndex = findMemoryType(physicalDevice, memoryTypeBits,
+                                               VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
+
+    if (residency != nullptr) {
+        // Render targets are needed every frame and are never evicted
+        transientResidency = residency->allocate(allocInfo, RESIDENCY_PRIORITY_RENDER_TARGET,
+                                                 "render graph transients", nullptr, transientMemory);
+    } else if (vkAllocateMemory(device, &allocInfo, hostAllocator(VK_OBJECT_TYPE_DEVICE_MEMORY), &transientMemory) != VK_SUCCESS) {
+        throw std::runtime_error("failed to allocate render graph transient memory!");
+    }
+    stats.transientMemoryAllocated = heapSize;
+
+    for (RenderGraphResource index : transients) {
+        Resource& resource = resources[index];
+        if (vkBindImageMemory(device, resource.image, transientMemory, resource.offset) != VK_SUCCESS) {
+            throw std::runtime_error("failed to bind transient image '" + resource.name + "'!");
+        }
+
+        VkImageViewCreateInfo viewInfo{};
+        viewInfo.sType = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO;
+        viewInfo.image = resource.image;
+        viewInfo.viewType = resource.desc.layers > 1 ? VK_IMAGE_VIEW_TYPE_2D_ARRAY : VK_IMAGE_VIEW_TYPE_2D;
+        viewInfo.format = resource.desc.format;
+        viewInfo.subresourceRange.aspectMask = resource.aspect;
+        viewInfo.subresourceRange.baseMipLevel = 0;
+        viewInfo.subresourceRange.levelCount = 1;
+        viewInfo.subresourceRange.baseArrayLayer = 0;
+        viewInfo.subresourceRange.layerCount = resource.desc.layers;
+
+        if (vkCreateImageView(device, &viewInfo, hostAllocator(VK_OBJECT_TYPE_IMAGE_VIEW), &resource.view) != VK_SUCCESS) {
+            throw std::runtime_error("failed to create view for transient image '" + resource.name + "'!");
+        }
+    }
+}
+// --------------------------------------------------------------------------------
+
+void RenderGraph::computeBarriers() {
+    std::vector<ResourceState> current(resources.size());
+    for (size_t i = 0; i < resources.size(); i++) {
+        if (resources[i].imported) {
+            current[i] = resources[i].initialState;
+        }
+    }
+
+    passBarriers.assign(passes.size(), {});
+    std::vector<std::pair<size_t, size_t>> firstUses;
+
+    for (size_t i = 0; i < passes.size(); i++) {
+        if (!passes[i].live) {
+            continue;
+        }
+        for (const PassResource& use : passes[i].resources) {
+            const Resource& resource = resources[use.resource];
+            ResourceState need = stateFor(use.usage);
+            ResourceState& state = current[use.resource];
+
+            // The first use of a transient image discards its contents; the
+            // source scope is filled in once the last use of its aliases is known
+            if (!resource.imported && resource.firstPass == static_cast<int>(i)) {
+                firstUses.emplace_back(i, passBarriers[i].size());
+                passBarriers[i].push_back({use.resource, ResourceState{}, need});
+                state = need;
+                continue;
+            }
+
+            // Reads of an image in the same layout can share one barrier
+            bool hazard = state.layout != need.layout || isWrite(state.access) || isWrite(need.access);
+            if (!hazard) {
+                state.stages |= need.stages;
+                state.access |= need.access;
+                continue;
+            }
+            passBarriers[i].push_back({use.resource, state, need});
+            state = need;
+        }
+    }
+
+    // Images that share memory are used back to back, either earlier in this
+    // frame or in the previous frame on the same queue.  The first use must wait
+    // for the last use of every alias, including the image itself.
+    for (const auto& firstUse : firstUses) {
+        Barrier& barrier = passBarriers[firstUse.first][firstUse.second];
+        std::vector<RenderGraphResource> predecessors = resources[barrier.resource].aliases;
+        predecessors.push_back(barrier.resource);
+        for (RenderGraphResource predecessor : predecessors) {
+            barrier.src.stages |= current[predecessor].stages;
+            barrier.src.access |= current[predecessor].access & WRITE_ACCESS_MASK;
+        }
+        barrier.src.layout = VK_IMAGE_LAYOUT_UNDEFINED;
+    }
+
+    finalBarriers.clear();
+    for (size_t i = 0; i < resources.size(); i++) {
+        if (!resources[i].imported) {
+            continue;
+        }
+        ResourceState need = stateFor(resources[i].finalUsage);
+        if (current[i].layout != need.layout || isWrite(current[i].access)) {
+            finalBarriers.push_back({static_cast<RenderGraphResource>(i), current[i], need});
+        }
+    }
+
+    for (const std::vector<Barrier>& barriers : passBarriers) {
+        stats.barrierCount += static_cast<uint32_t>(barriers.size());
+        stats.barrierBatchCount += barriers.empty() ? 0 : 1;
+    }
+    stats.barrierCount += static_cast<uint32_t>(finalBarriers.size());
+    stats.barrierBatchCount += finalBarriers.empty() ? 0 : 1;
+}
+// --------------------------------------------------------------------------------
+
+void RenderGraph::recordBarriers(VkCommandBuffer commandBuffer, const std::vector<Barrier>& barriers) {
+    if (barriers.empty()) {
+        return;
+    }
+
+    scratchBarriers.clear();
+    for (const Barrier& barrier : barriers) {
+        const Resource& resource = resources[barrier.resource];
+        if (resource.image == VK_NULL_HANDLE) {
+            throw std::runtime_error("render graph image '" + resource.name + "' has not been set!");
+        }
+
+        VkImageMemoryBarrier2 imageBarrier{};
+        imageBarrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER_2;
+        imageBarrier.srcStageMask = barrier.src.stages;
+        imageBarrier.srcAccessMask = barrier.src.access & WRITE_ACCESS_MASK;
+        imageBarrier.dstStageMask = barrier.dst.stages;
+        imageBarrier.dstAccessMask = barrier.dst.access;
+        imageBarrier.oldLayout = barrier.src.layout;
+        imageBarrier.newLayout = barrier.dst.layout;
+        imageBarrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+        imageBarrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+        imageBarrier.image = resource.image;
+        imageBarrier.subresourceRange.aspectMask = resource.aspect;
+        imageBarrier.subresourceRange.baseMipLevel = 0;
+        imageBarrier.subresourceRange.levelCount = VK_REMAINING_MIP_LEVELS;
+        imageBarrier.subresourceRange.baseArrayLayer = 0;
+        imageBarrier.subresourceRange.layerCount = VK_REMAINING_ARRAY_LAYERS;
+        scratchBarriers.push_back(imageBarrier);
+    }
+
+    VkDependencyInfo dependencyInfo{};
+    dependencyInfo.sType = VK_STRUCTURE_TYPE_DEPENDENCY_INFO;
+    dependencyInfo.imageMemoryBarrierCount = static_cast<uint32_t>(scratchBarriers.size());
+    dependencyInfo.pImageMemoryBarriers = scratchBarriers.data();
+    vkCmdPipelineBarrier2(commandBuffer, &dependencyInfo);
+}
+// ================================================================================
+// ================================================================================
+// eof
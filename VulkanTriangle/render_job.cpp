@@ -0,0 +1,151 @@
+// ================================================================================
+// ================================================================================
+// - File:    render_job.cpp
+// - Purpose: Contains the implementation for render_job.hpp
+//
+// Source Metadata
+// - Author:  Jonathan A. Webb
+// - Date:    October 18, 2026
+// - Version: 1.0
+// - Copyright: Copyright 2022, Jon Webb Inc.
+// ================================================================================
+// ================================================================================
+// Include modules here
+
+#include "include/render_job.hpp"
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+// ================================================================================
+// ================================================================================
+
+// Larger than any image a device is required to support
+static const uint32_t MAX_IMAGE_SIDE = 16384;
+// --------------------------------------------------------------------------------
+
+/**
+ * @brief Strips a comment and returns false if nothing but whitespace is left
+ */
+static bool stripComment(std::string& line) {
+    size_t comment = line.find('#');
+    if (comment != std::string::npos) {
+        line.erase(comment);
+    }
+    return line.find_first_not_of(" \t\r") != std::string::npos;
+}
+// --------------------------------------------------------------------------------
+
+static std::runtime_error parseError(const std::string& name, uint32_t lineNumber, const std::string& message) {
+    return std::runtime_error(name + ":" + std::to_string(lineNumber) + ": " + message + "!");
+}
+// --------------------------------------------------------------------------------
+
+/**
+ * @brief Returns true if the stream has nothing left but whitespace
+ */
+static bool atEnd(std::istringstream& fields) {
+    std::string extra;
+    return !(fields >> extra);
+}
+// --------------------------------------------------------------------------------
+
+static std::string resolve(const std::string& path, const std::string& baseDirectory) {
+    std::filesystem::path resolved(path);
+    if (resolved.is_relative() && !baseDirectory.empty()) {
+        resolved = std::filesystem::path(baseDirectory) / resolved;
+    }
+    return resolved.string();
+}
+// ================================================================================
+// ================================================================================
+
+SceneDesc parseScene(std::istream& input, const std::string& name) {
+    SceneDesc scene;
+    std::string line;
+    uint32_t lineNumber = 0;
+    while (std::getline(input, line)) {
+        lineNumber++;
+        if (!stripComment(line)) {
+            continue;
+        }
+
+        std::istringstream fields(line);
+        std::string command;
+        fields >> command;
+        if (command == "tint") {
+            if (!(fields >> scene.tint[0] >> scene.tint[1] >> scene.tint[2]) || !atEnd(fields)) {
+                throw parseError(name, lineNumber, "expected 'tint <r> <g> <b>'");
+            }
+        } else if (command == "triangle") {
+            SceneTriangle triangle;
+            if (!(fields >> triangle.offset[0] >> triangle.offset[1] >> triangle.scale) || !atEnd(fields)) {
+                throw parseError(name, lineNumber, "expected 'triangle <x> <y> <scale>'");
+            }
+            scene.triangles.push_back(triangle);
+        } else {
+            throw parseError(name, lineNumber, "unknown scene command '" + command + "'");
+        }
+    }
+    return scene;
+}
+// --------------------------------------------------------------------------------
+
+std::vector<RenderJob> parseRenderJobs(std::istream& input,
+                                       const std::string& name,
+                                       const std::string& baseDirectory) {
+    std::vector<RenderJob> jobs;
+    std::string line;
+    uint32_t lineNumber = 0;
+    while (std::getline(input, line)) {
+        lineNumber++;
+        if (!stripComment(line)) {
+            continue;
+        }
+
+        // Read the sizes as signed so a negative value is rejected, not wrapped
+        std::istringstream fields(line);
+        RenderJob job;
+        int64_t width = 0;
+        int64_t height = 0;
+        if (!(fields >> job.scenePath >> width >> height >>
+              job.camera.x >> job.camera.y >> job.camera.zoom >> job.outputPath) || !atEnd(fields)) {
+            throw parseError(name, lineNumber,
+                             "expected '<scene> <width> <height> <camera x> <camera y> <zoom> <output>'");
+        }
+        if (width <= 0 || height <= 0 || width > MAX_IMAGE_SIDE || height > MAX_IMAGE_SIDE) {
+            throw parseError(name, lineNumber, "image sides must be between 1 and " + std::to_string(MAX_IMAGE_SIDE));
+        }
+        if (!(job.camera.zoom > 0.0f)) {
+            throw parseError(name, lineNumber, "zoom must be positive");
+        }
+
+        job.width = static_cast<uint32_t>(width);
+        job.height = static_cast<uint32_t>(height);
+        job.scenePath = resolve(job.scenePath, baseDirectory);
+        job.outputPath = resolve(job.outputPath, baseDirectory);
+        jobs.push_back(job);
+    }
+    return jobs;
+}
+// --------------------------------------------------------------------------------
+
+SceneDesc loadScene(const std::string& path) {
+    std::ifstream file(path);
+    if (!file.is_open()) {
+        throw std::runtime_error("failed to open scene file '" + path + "'!");
+    }
+    return parseScene(file, path);
+}
+// --------------------------------------------------------------------------------
+
+std::vector<RenderJob> loadRenderJobs(const std::string& path) {
+    std::ifstream file(path);
+    if (!file.is_open()) {
+        throw std::runtime_error("failed to open job file '" + path + "'!");
+    }
+    return parseRenderJobs(file, path, std::filesystem::path(path).parent_path().string());
+}
+// ================================================================================
+// ================================================================================
+// eof
@@ -0,0 +1,277 @@
+// ================================================================================
+// ================================================================================
+// - File:    render_queue.cpp
+// - Purpose: Contains the implementation for render_queue.hpp
+//
+// Source Metadata
+// - Author:  Jonathan A. Webb
+// - Date:    October 18, 2026
+// - Version: 1.0
+// - Copyright: Copyright 2022, Jon Webb Inc.
+// ================================================================================
+// ================================================================================
+// Include modules here
+
+#include "include/render_queue.hpp"
+#include "include/pipeline_cache.hpp"
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+// ================================================================================
+// ================================================================================
+
+// Key layout, from the most significant bit down
+static const uint32_t PASS_BITS = 4;
+static const uint32_t PIPELINE_BITS = 12;
+static const uint32_t MATERIAL_BITS = 24;
+static const uint32_t DEPTH_BITS = 24;
+static const uint32_t DEPTH_SHIFT = 0;
+static const uint32_t MATERIAL_SHIFT = DEPTH_SHIFT + DEPTH_BITS;
+static const uint32_t PIPELINE_SHIFT = MATERIAL_SHIFT + MATERIAL_BITS;
+static const uint32_t PASS_SHIFT = PIPELINE_SHIFT + PIPELINE_BITS;
+static_assert(PASS_SHIFT + PASS_BITS == 64, "the sort key must fill 64 bits");
+// ================================================================================
+// ================================================================================
+
+bool RenderQueue::Material::operator==(const Material& other) const {
+    return layout == other.layout &&
+           descriptorSet == other.descriptorSet &&
+           dynamicOffset == other.dynamicOffset &&
+           hasDynamicOffset == other.hasDynamicOffset &&
+           vertexBuffer == other.vertexBuffer &&
+           vertexOffset == other.vertexOffset;
+}
+// --------------------------------------------------------------------------------
+
+size_t RenderQueue::MaterialHash::operator()(const Material& material) const {
+    size_t seed = 0;
+    hashCombine(seed, material.layout);
+    hashCombine(seed, material.descriptorSet);
+    hashCombine(seed, material.dynamicOffset);
+    hashCombine(seed, material.hasDynamicOffset);
+    hashCombine(seed, material.vertexBuffer);
+    hashCombine(seed, material.vertexOffset);
+    return seed;
+}
+// ================================================================================
+// ================================================================================
+
+void RenderQueue::submit(const DrawItem& item,
+                         const void* pushConstants,
+                         uint32_t pushConstantSize,
+                         VkShaderStageFlags pushConstantStages) {
+    if (item.pipeline == VK_NULL_HANDLE) {
+        throw std::runtime_error("draw submitted without a pipeline!");
+    }
+
+    uint32_t pipelineId = assignId(pipelineIds, item.pipeline, pipelineCount);
+    Material material{item.layout, item.descriptorSet, item.dynamicOffset, item.hasDynamicOffset,
+                      item.vertexBuffer, item.vertexOffset};
+    uint32_t materialId = assignId(materialIds, material, materialCount);
+    if (pipelineCount > (1u << PIPELINE_BITS) || materialCount > (1u << MATERIAL_BITS)) {
+        throw std::runtime_error("too many pipelines or materials in one render queue flush!");
+    }
+
+    float depth = std::min(std::max(item.depth, 0.0f), 1.0f);
+    uint64_t depthBits = static_cast<uint64_t>(depth * static_cast<float>((1u << DEPTH_BITS) - 1));
+
+    uint64_t key = (static_cast<uint64_t>(item.pass & ((1u << PASS_BITS) - 1)) << PASS_SHIFT) |
+                   (static_cast<uint64_t>(pipelineId) << PIPELINE_SHIFT) |
+                   (static_cast<uint64_t>(materialId) << MATERIAL_SHIFT) |
+                   (depthBits << DEPTH_SHIFT);
+    entries.push_back({key, static_cast<uint32_t>(draws.size())});
+
+    uint32_t offset = static_cast<uint32_t>(pushConstantData.size());
+    if (pushConstants != nullptr && pushConstantSize > 0) {
+        pushConstantData.resize(offset + pushConstantSize);
+        std::memcpy(pushConstantData.data() + offset, pushConstants, pushConstantSize);
+    } else {
+        pushConstantSize = 0;
+    }
+    draws.push_back({item, offset, pushConstantSize, pushConstantStages});
+}
+// --------------------------------------------------------------------------------
+
+void RenderQueue::flush(VkCommandBuffer commandBuffer) {
+    radixSort();
+
+    lastFlush = RenderQueueStats{};
+    lastFlush.flushes = 1;
+    lastFlush.draws = draws.size();
+    lastFlush.unsortedStateChanges = walk(VK_NULL_HANDLE, false);
+    lastFlush.stateChanges = walk(commandBuffer, true);
+
+    total.flushes += lastFlush.flushes;
+    total.draws += lastFlush.draws;
+    total.stateChanges += lastFlush.stateChanges;
+    total.unsortedStateChanges += lastFlush.unsortedStateChanges;
+
+    // Clearing keeps the capacity for the next flush.  Clearing the maps would
+    // free their nodes, so the numbers are outdated by the flush count instead.
+    draws.clear();
+    pushConstantData.clear();
+    entries.clear();
+    pruneIds(pipelineIds, pipelineCount);
+    pruneIds(materialIds, materialCount);
+    pipelineCount = 0;
+    materialCount = 0;
+}
+// --------------------------------------------------------------------------------
+
+size_t RenderQueue::size() const {
+    return draws.size();
+}
+// --------------------------------------------------------------------------------
+
+const RenderQueueStats& RenderQueue::getLastFlushStats() const {
+    return lastFlush;
+}
+// --------------------------------------------------------------------------------
+
+const RenderQueueStats& RenderQueue::getTotalStats() const {
+    return total;
+}
+// ================================================================================
+
+void RenderQueue::radixSort() {
+    const size_t count = entries.size();
+    if (count < 2) {
+        return;
+    }
+    scratch.resize(count);
+
+    // Every byte's histogram is built in one pass over the keys
+    uint32_t histograms[8][256] = {};
+    for (const SortEntry& entry : entries) {
+        for (uint32_t byte = 0; byte < 8; byte++) {
+            histograms[byte][(entry.key >> (byte * 8)) & 0xFF]++;
+        }
+    }
+
+    for (uint32_t byte = 0; byte < 8; byte++) {
+        uint32_t* histogram = histograms[byte];
+
+        // Usually most bytes are the same in every key, e.g. the pass or the
+        // unused high pipeline bits, and their pass would not move anything
+        if (histogram[(entries[0].key >> (byte * 8)) & 0xFF] == count) {
+            continue;
+        }
+
+        uint32_t offset = 0;
+        for (uint32_t bucket = 0; bucket < 256; bucket++) {
+            uint32_t bucketCount = histogram[bucket];
+            histogram[bucket] = offset;
+            offset += bucketCount;
+        }
+        for (const SortEntry& entry : entries) {
+            scratch[histogram[(entry.key >> (byte * 8)) & 0xFF]++] = entry;
+        }
+        entries.swap(scratch);
+    }
+}
+// --------------------------------------------------------------------------------
+
+template <typename Map, typename Key>
+uint32_t RenderQueue::assignId(Map& ids, const Key& key, uint32_t& count) {
+    // total.flushes is the number of the flush being built
+    auto entry = ids.try_emplace(key, KeyId{count, total.flushes});
+    if (entry.second) {
+        return count++;
+    }
+    KeyId& keyId = entry.first->second;
+    if (keyId.flush != total.flushes) {
+        keyId = KeyId{count++, total.flushes};
+    }
+    return keyId.id;
+}
+// --------------------------------------------------------------------------------
+
+template <typename Map>
+void RenderQueue::pruneIds(Map& ids, uint32_t count) {
+    if (ids.size() <= 2 * static_cast<size_t>(count)) {
+        return;
+    }
+    // total.flushes was already advanced past the flush that just finished
+    for (auto it = ids.begin(); it != ids.end();) {
+        if (it->second.flush + 1 != total.flushes) {
+            it = ids.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+// --------------------------------------------------------------------------------
+
+uint64_t RenderQueue::walk(VkCommandBuffer commandBuffer, bool sorted) const {
+    uint64_t stateChanges = 0;
+    VkPipeline boundPipeline = VK_NULL_HANDLE;
+    VkPipelineLayout boundLayout = VK_NULL_HANDLE;
+    VkDescriptorSet boundSet = VK_NULL_HANDLE;
+    uint32_t boundDynamicOffset = 0;
+    VkBuffer boundVertexBuffer = VK_NULL_HANDLE;
+    VkDeviceSize boundVertexOffset = 0;
+    const uint8_t* pushed = nullptr;
+    uint32_t pushedSize = 0;
+
+    for (size_t i = 0; i < draws.size(); i++) {
+        const QueuedDraw& draw = draws[sorted ? entries[i].index : i];
+        const DrawItem& item = draw.item;
+
+        if (item.pipeline != boundPipeline) {
+            if (commandBuffer != VK_NULL_HANDLE) {
+                vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, item.pipeline);
+            }
+            boundPipeline = item.pipeline;
+            stateChanges++;
+        }
+
+        // Sets and push constants stay valid across pipelines with the same layout
+        bool layoutChanged = item.layout != boundLayout;
+        boundLayout = item.layout;
+
+        if (item.descriptorSet != VK_NULL_HANDLE &&
+            (layoutChanged || item.descriptorSet != boundSet ||
+             (item.hasDynamicOffset && item.dynamicOffset != boundDynamicOffset))) {
+            if (commandBuffer != VK_NULL_HANDLE) {
+                vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, item.layout,
+                                        0, 1, &item.descriptorSet,
+                                        item.hasDynamicOffset ? 1 : 0, &item.dynamicOffset);
+            }
+            boundSet = item.descriptorSet;
+            boundDynamicOffset = item.dynamicOffset;
+            stateChanges++;
+        }
+
+        if (item.vertexBuffer != VK_NULL_HANDLE &&
+            (item.vertexBuffer != boundVertexBuffer || item.vertexOffset != boundVertexOffset)) {
+            if (commandBuffer != VK_NULL_HANDLE) {
+                vkCmdBindVertexBuffers(commandBuffer, 0, 1, &item.vertexBuffer, &item.vertexOffset);
+            }
+            boundVertexBuffer = item.vertexBuffer;
+            boundVertexOffset = item.vertexOffset;
+            stateChanges++;
+        }
+
+        if (draw.pushConstantSize > 0) {
+            const uint8_t* data = pushConstantData.data() + draw.pushConstantOffset;
+            if (layoutChanged || draw.pushConstantSize != pushedSize ||
+                std::memcmp(data, pushed, draw.pushConstantSize) != 0) {
+                if (commandBuffer != VK_NULL_HANDLE) {
+                    vkCmdPushConstants(commandBuffer, item.layout, draw.pushConstantStages,
+                                       0, draw.pushConstantSize, data);
+                }
+                pushed = data;
+                pushedSize = draw.pushConstantSize;
+                stateChanges++;
+            }
+        }
+
+        if (commandBuffer != VK_NULL_HANDLE) {
+            vkCmdDraw(commandBuffer, item.vertexCount, item.instanceCount, item.firstVertex, item.firstInstance);
+        }
+    }
+    return stateChanges;
+}
+// ================================================================================
+// ================================================================================
+// eof
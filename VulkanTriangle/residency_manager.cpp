@@ -0,0 +1,275 @@
+// ================================================================================
+// ================================================================================
+// - File:    residency_manager.cpp
+// - Purpose: Contains the implementation for residency_manager.hpp
+//
+// Source Metadata
+// - Author:  Jonathan A. Webb
+// - Date:    October 18, 2026
+// - Version: 1.0
+// - Copyright: Copyright 2022, Jon Webb Inc.
+// ================================================================================
+// ================================================================================
+// Include modules here
+
+#include "include/residency_manager.hpp"
+#include "include/constants.hpp"
+#include "include/host_allocator.hpp"
+#include <algorithm>
+#include <stdexcept>
+// ================================================================================
+// ================================================================================
+
+ResidencyManager::ResidencyManager(VkPhysicalDevice physicalDevice,
+                                   VkDevice device,
+                                   bool memoryBudgetEnabled,
+                                   bool memoryPriorityEnabled,
+                                   uint32_t framesInFlight)
+    : physicalDevice(physicalDevice),
+      device(device),
+      memoryBudgetEnabled(memoryBudgetEnabled),
+      memoryPriorityEnabled(memoryPriorityEnabled),
+      framesInFlight(framesInFlight) {
+    vkGetPhysicalDeviceMemoryProperties(physicalDevice, &memoryProperties);
+
+    heaps.resize(memoryProperties.memoryHeapCount);
+    for (uint32_t i = 0; i < memoryProperties.memoryHeapCount; i++) {
+        heaps[i].size = memoryProperties.memoryHeaps[i].size;
+    }
+
+    std::lock_guard<std::mutex> lock(mutex);
+    updateBudgetLocked();
+}
+// --------------------------------------------------------------------------------
+
+void ResidencyManager::beginFrame(uint64_t frameNumber) {
+    std::lock_guard<std::mutex> lock(mutex);
+    currentFrame = frameNumber;
+
+    if (currentFrame - lastBudgetFrame < RESIDENCY_BUDGET_POLL_FRAMES) {
+        return;
+    }
+    updateBudgetLocked();
+
+    // Another process may have claimed memory since the last poll
+    for (uint32_t i = 0; i < heaps.size(); i++) {
+        makeRoomLocked(i, 0);
+    }
+}
+// --------------------------------------------------------------------------------
+
+void ResidencyManager::updateBudget() {
+    std::lock_guard<std::mutex> lock(mutex);
+    updateBudgetLocked();
+}
+// --------------------------------------------------------------------------------
+
+ResidencyHandle ResidencyManager::allocate(const VkMemoryAllocateInfo& allocInfo,
+                                           float priority,
+                                           const std::string& name,
+                                           EvictFn evict,
+                                           VkDeviceMemory& memory) {
+    std::lock_guard<std::mutex> lock(mutex);
+    uint32_t heapIndex = getHeapIndex(allocInfo.memoryTypeIndex);
+    priority = std::min(std::max(priority, 0.0f), 1.0f);
+
+    // Best effort; the driver has the final word on whether the allocation fits
+    makeRoomLocked(heapIndex, allocInfo.allocationSize);
+
+    VkMemoryAllocateInfo info = allocInfo;
+    VkMemoryPriorityAllocateInfoEXT priorityInfo{};
+    if (memoryPriorityEnabled) {
+        priorityInfo.sType = VK_STRUCTURE_TYPE_MEMORY_PRIORITY_ALLOCATE_INFO_EXT;
+        priorityInfo.pNext = allocInfo.pNext;
+        priorityInfo.priority = priority;
+        info.pNext = &priorityInfo;
+    }
+
+    VkResult result = vkAllocateMemory(device, &info, hostAllocator(VK_OBJECT_TYPE_DEVICE_MEMORY), &memory);
+    if (result == VK_ERROR_OUT_OF_DEVICE_MEMORY) {
+        // The budget was stale; trust the driver and free at least as much
+        updateBudgetLocked();
+        evictLocked(heapIndex, allocInfo.allocationSize);
+        result = vkAllocateMemory(device, &info, hostAllocator(VK_OBJECT_TYPE_DEVICE_MEMORY), &memory);
+    }
+    if (result != VK_SUCCESS) {
+        throw std::runtime_error("failed to allocate device memory for '" + name + "'!");
+    }
+
+    HeapBudget& heap = heaps[heapIndex];
+    heap.usage += allocInfo.allocationSize;
+    heap.tracked += allocInfo.allocationSize;
+
+    ResidencyHandle handle = nextHandle++;
+    allocations[handle] = Allocation{name, heapIndex, allocInfo.allocationSize, priority,
+                                     currentFrame, std::move(evict)};
+    return handle;
+}
+// --------------------------------------------------------------------------------
+
+void ResidencyManager::free(ResidencyHandle handle, VkDeviceMemory memory) {
+    std::lock_guard<std::mutex> lock(mutex);
+    auto it = allocations.find(handle);
+    if (it == allocations.end()) {
+        // Evicted entirely; the eviction callback already freed the memory
+        return;
+    }
+
+    HeapBudget& heap = heaps[it->second.heapIndex];
+    heap.usage -= std::min(heap.usage, it->second.size);
+    heap.tracked -= std::min(heap.tracked, it->second.size);
+    allocations.erase(it);
+
+    vkFreeMemory(device, memory, hostAllocator(VK_OBJECT_TYPE_DEVICE_MEMORY));
+}
+// --------------------------------------------------------------------------------
+
+void ResidencyManager::touch(ResidencyHandle handle) {
+    std::lock_guard<std::mutex> lock(mutex);
+    auto it = allocations.find(handle);
+    if (it != allocations.end()) {
+        it->second.lastUsedFrame = currentFrame;
+    }
+}
+// --------------------------------------------------------------------------------
+
+void ResidencyManager::setPriority(ResidencyHandle handle, float priority) {
+    std::lock_guard<std::mutex> lock(mutex);
+    auto it = allocations.find(handle);
+    if (it != allocations.end()) {
+        it->second.priority = std::min(std::max(priority, 0.0f), 1.0f);
+    }
+}
+// --------------------------------------------------------------------------------
+
+bool ResidencyManager::isResident(ResidencyHandle handle) const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return allocations.find(handle) != allocations.end();
+}
+// --------------------------------------------------------------------------------
+
+bool ResidencyManager::makeRoom(uint32_t heapIndex, VkDeviceSize bytes) {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (heapIndex >= heaps.size()) {
+        throw std::runtime_error("memory heap index out of range!");
+    }
+    return makeRoomLocked(heapIndex, bytes);
+}
+// --------------------------------------------------------------------------------
+
+uint32_t ResidencyManager::getHeapCount() const {
+    return static_cast<uint32_t>(heaps.size());
+}
+// --------------------------------------------------------------------------------
+
+HeapBudget ResidencyManager::getHeapBudget(uint32_t heapIndex) const {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (heapIndex >= heaps.size()) {
+        throw std::runtime_error("memory heap index out of range!");
+    }
+    return heaps[heapIndex];
+}
+// --------------------------------------------------------------------------------
+
+uint32_t ResidencyManager::getHeapIndex(uint32_t memoryTypeIndex) const {
+    if (memoryTypeIndex >= memoryProperties.memoryTypeCount) {
+        throw std::runtime_error("memory type index out of range!");
+    }
+    return memoryProperties.memoryTypes[memoryTypeIndex].heapIndex;
+}
+// --------------------------------------------------------------------------------
+
+uint64_t ResidencyManager::getEvictionCount() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return evictionCount;
+}
+// ================================================================================
+
+void ResidencyManager::updateBudgetLocked() {
+    lastBudgetFrame = currentFrame;
+
+    if (!memoryBudgetEnabled) {
+        // Without the extension only our own allocations are visible
+        for (HeapBudget& heap : heaps) {
+            heap.budget = static_cast<VkDeviceSize>(heap.size * RESIDENCY_FALLBACK_BUDGET_FRACTION);
+            heap.usage = heap.tracked;
+        }
+        return;
+    }
+
+    VkPhysicalDeviceMemoryBudgetPropertiesEXT budgetProperties{};
+    budgetProperties.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_MEMORY_BUDGET_PROPERTIES_EXT;
+    VkPhysicalDeviceMemoryProperties2 properties{};
+    properties.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_MEMORY_PROPERTIES_2;
+    properties.pNext = &budgetProperties;
+    vkGetPhysicalDeviceMemoryProperties2(physicalDevice, &properties);
+
+    for (uint32_t i = 0; i < heaps.size(); i++) {
+        heaps[i].budget = budgetProperties.heapBudget[i];
+        heaps[i].usage = budgetProperties.heapUsage[i];
+    }
+}
+// --------------------------------------------------------------------------------
+
+bool ResidencyManager::makeRoomLocked(uint32_t heapIndex, VkDeviceSize bytes) {
+    HeapBudget& heap = heaps[heapIndex];
+    VkDeviceSize limit = budgetLimit(heap);
+    if (heap.usage + bytes <= limit) {
+        return true;
+    }
+    VkDeviceSize needed = heap.usage + bytes - limit;
+    return evictLocked(heapIndex, needed) >= needed;
+}
+// --------------------------------------------------------------------------------
+
+VkDeviceSize ResidencyManager::evictLocked(uint32_t heapIndex, VkDeviceSize bytes) {
+    HeapBudget& heap = heaps[heapIndex];
+    VkDeviceSize needed = bytes;
+
+    // Offer the least important, least recently used resources first.  Anything
+    // used by a frame the GPU may still be executing is left alone.
+    std::vector<std::pair<ResidencyHandle, Allocation*>> candidates;
+    for (auto& entry : allocations) {
+        Allocation& allocation = entry.second;
+        if (allocation.heapIndex == heapIndex && allocation.evict &&
+            allocation.lastUsedFrame + framesInFlight <= currentFrame) {
+            candidates.emplace_back(entry.first, &allocation);
+        }
+    }
+    std::sort(candidates.begin(), candidates.end(), [](const auto& a, const auto& b) {
+        if (a.second->priority != b.second->priority) {
+            return a.second->priority < b.second->priority;
+        }
+        return a.second->lastUsedFrame < b.second->lastUsedFrame;
+    });
+
+    for (auto& candidate : candidates) {
+        if (needed == 0) {
+            break;
+        }
+        Allocation& allocation = *candidate.second;
+        VkDeviceSize remaining = std::min(allocation.evict(needed), allocation.size);
+        VkDeviceSize released = allocation.size - remaining;
+        if (released == 0) {
+            continue;
+        }
+
+        evictionCount++;
+        heap.usage -= std::min(heap.usage, released);
+        heap.tracked -= std::min(heap.tracked, released);
+        needed -= std::min(needed, released);
+        allocation.size = remaining;
+        if (remaining == 0) {
+            allocations.erase(candidate.first);
+        }
+    }
+    return bytes - needed;
+}
+// --------------------------------------------------------------------------------
+
+VkDeviceSize ResidencyManager::budgetLimit(const HeapBudget& heap) const {
+    return static_cast<VkDeviceSize>(heap.budget * RESIDENCY_BUDGET_HEADROOM);
+}
+// ================================================================================
+// ================================================================================
+// eof
@@ -0,0 +1,70 @@
+// ================================================================================
+// ================================================================================
+// - File:    shader_library.cpp
+// - Purpose: Contains the implementation for shader_library.hpp
+//
+// Source Metadata
+// - Author:  Jonathan A. Webb
+// - Date:    October 18, 2026
+// - Version: 1.0
+// - Copyright: Copyright 2022, Jon Webb Inc.
+// ================================================================================
+// ================================================================================
+// Include modules here
+
+#include "include/shader_library.hpp"
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <stdexcept>
+// ================================================================================
+// ================================================================================
+
+std::shared_ptr<const ShaderCode> ShaderLibrary::load(const std::string& path) {
+    // Read outside the lock so several files can be read at once
+    std::ifstream file(path, std::ios::ate | std::ios::binary);
+    if (!file.is_open()) {
+        std::cerr << "Current working directory: " << std::filesystem::current_path() << std::endl;
+        throw std::runtime_error("failed to open file '" + path + "'!");
+    }
+
+    auto shader = std::make_shared<ShaderCode>();
+    size_t fileSize = static_cast<size_t>(file.tellg());
+    shader->code.resize(fileSize);
+    file.seekg(0);
+    file.read(shader->code.data(), static_cast<std::streamsize>(fileSize));
+    if (!file) {
+        throw std::runtime_error("failed to read file '" + path + "'!");
+    }
+
+    uint64_t hash = 14695981039346656037ull;
+    for (char byte : shader->code) {
+        hash = (hash ^ static_cast<uint8_t>(byte)) * 1099511628211ull;
+    }
+    shader->hash = hash;
+
+    std::lock_guard<std::mutex> lock(mutex);
+    shaders[path] = shader;
+    return shader;
+}
+// --------------------------------------------------------------------------------
+
+std::shared_ptr<const ShaderCode> ShaderLibrary::get(const std::string& path) {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        auto it = shaders.find(path);
+        if (it != shaders.end()) {
+            return it->second;
+        }
+    }
+    return load(path);
+}
+// --------------------------------------------------------------------------------
+
+size_t ShaderLibrary::size() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return shaders.size();
+}
+// ================================================================================
+// ================================================================================
+// eof
@@ -0,0 +1,202 @@
+// ================================================================================
+// ================================================================================
+// - File:    shader_watcher.cpp
+// - Purpose: Contains the implementation for shader_watcher.hpp
+//
+// Source Metadata
+// - Author:  Jonathan A. Webb
+// - Date:    October 18, 2026
+// - Version: 1.0
+// - Copyright: Copyright 2022, Jon Webb Inc.
+// ================================================================================
+// ================================================================================
+// Include modules here
+
+#include "include/shader_watcher.hpp"
+#include <algorithm>
+#include <cstdio>
+#include <filesystem>
+#include <iostream>
+#include <stdexcept>
+#include <poll.h>
+#include <sys/inotify.h>
+#include <sys/wait.h>
+#include <unistd.h>
+// ================================================================================
+// ================================================================================
+
+// How often the watcher thread checks whether it should stop
+static const int POLL_TIMEOUT_MILLISECONDS = 100;
+// --------------------------------------------------------------------------------
+
+// Quotes a path for the shell
+static std::string quote(const std::string& path) {
+    std::string quoted = "'";
+    for (char c : path) {
+        if (c == '\'') {
+            quoted += "'\\''";
+        } else {
+            quoted += c;
+        }
+    }
+    return quoted + "'";
+}
+// ================================================================================
+// ================================================================================
+
+ShaderWatcher::ShaderWatcher(const std::string& directory,
+                             const std::string& outputDirectory,
+                             ShaderLibrary& shaders,
+                             const std::string& compiler)
+    : directory(directory),
+      outputDirectory(outputDirectory),
+      shaders(shaders),
+      compiler(compiler) {
+    inotifyFd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (inotifyFd < 0) {
+        throw std::runtime_error("failed to initialize inotify!");
+    }
+    // Editors either rewrite a file in place or rename a new file over it
+    if (inotify_add_watch(inotifyFd, directory.c_str(), IN_CLOSE_WRITE | IN_MOVED_TO) < 0) {
+        close(inotifyFd);
+        throw std::runtime_error("failed to watch shader directory '" + directory + "'!");
+    }
+    thread = std::thread(&ShaderWatcher::watch, this);
+}
+// --------------------------------------------------------------------------------
+
+ShaderWatcher::~ShaderWatcher() {
+    stopping = true;
+    if (thread.joinable()) {
+        thread.join();
+    }
+    close(inotifyFd);
+}
+// --------------------------------------------------------------------------------
+
+std::vector<std::string> ShaderWatcher::takeChangedShaders() {
+    std::lock_guard<std::mutex> lock(mutex);
+    std::vector<std::string> result;
+    result.swap(changed);
+    return result;
+}
+// --------------------------------------------------------------------------------
+
+std::string ShaderWatcher::getLastError() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return lastError;
+}
+// ================================================================================
+
+void ShaderWatcher::watch() {
+    alignas(inotify_event) char buffer[4096];
+    pollfd descriptor{inotifyFd, POLLIN, 0};
+
+    while (!stopping) {
+        if (poll(&descriptor, 1, POLL_TIMEOUT_MILLISECONDS) <= 0) {
+            continue;
+        }
+
+        // One save can produce several events, so each file is compiled once
+        // per batch
+        std::vector<std::string> fileNames;
+        ssize_t length;
+        while ((length = read(inotifyFd, buffer, sizeof(buffer))) > 0) {
+            for (char* next = buffer; next < buffer + length;) {
+                const inotify_event* event = reinterpret_cast<const inotify_event*>(next);
+                next += sizeof(inotify_event) + event->len;
+                if (event->len == 0) {
+                    continue;
+                }
+                std::string fileName = event->name;
+                if (isShaderSource(fileName) &&
+                    std::find(fileNames.begin(), fileNames.end(), fileName) == fileNames.end()) {
+                    fileNames.push_back(fileName);
+                }
+            }
+        }
+
+        for (const std::string& fileName : fileNames) {
+            compile(fileName);
+        }
+    }
+}
+// --------------------------------------------------------------------------------
+
+void ShaderWatcher::compile(const std::string& fileName) {
+    std::string source = directory + "/" + fileName;
+    std::string output = outputDirectory + "/" + fileName + ".spv";
+    std::string temporary = output + ".tmp";
+
+    std::string command = quote(compiler) + " -V " + quote(source) + " -o " + quote(temporary) + " 2>&1";
+    FILE* pipe = popen(command.c_str(), "r");
+    if (pipe == nullptr) {
+        std::cerr << "Shader reload: failed to run " << compiler << std::endl;
+        return;
+    }
+    std::string log;
+    char line[256];
+    while (std::fgets(line, sizeof(line), pipe) != nullptr) {
+        log += line;
+    }
+    int status = pclose(pipe);
+
+    if (status == -1 || !WIFEXITED(status) || WEXITSTATUS(status) != 0) {
+        std::error_code ignored;
+        std::filesystem::remove(temporary, ignored);
+        std::cerr << "Shader reload: " << fileName << " failed to compile; keeping the previous version\n"
+                  << log << std::flush;
+        std::lock_guard<std::mutex> lock(mutex);
+        lastError = log;
+        return;
+    }
+
+    // Saving without an edit, or changing only a comment, needs no rebuild.
+    // The previous code is read before the file is replaced.
+    try {
+        std::shared_ptr<const ShaderCode> previous;
+        if (std::filesystem::exists(output)) {
+            previous = shaders.get(output);
+        }
+
+        std::error_code error;
+        std::filesystem::rename(temporary, output, error);
+        if (error) {
+            std::cerr << "Shader reload: failed to replace " << output << ": " << error.message() << std::endl;
+            return;
+        }
+
+        std::shared_ptr<const ShaderCode> current = shaders.load(output);
+        if (previous && previous->hash == current->hash && previous->code == current->code) {
+            std::lock_guard<std::mutex> lock(mutex);
+            lastError.clear();
+            return;
+        }
+    } catch (const std::exception& e) {
+        std::cerr << "Shader reload: " << e.what() << std::endl;
+        return;
+    }
+
+    std::cout << "Shader reload: recompiled " << fileName << std::endl;
+    std::lock_guard<std::mutex> lock(mutex);
+    lastError.clear();
+    if (std::find(changed.begin(), changed.end(), output) == changed.end()) {
+        changed.push_back(output);
+    }
+}
+// --------------------------------------------------------------------------------
+
+bool ShaderWatcher::isShaderSource(const std::string& fileName) {
+    static const char* const extensions[] = {".vert", ".frag", ".comp", ".geom", ".tesc", ".tese"};
+
+    std::string extension = std::filesystem::path(fileName).extension().string();
+    for (const char* candidate : extensions) {
+        if (extension == candidate) {
+            return true;
+        }
+    }
+    return false;
+}
+// ================================================================================
+// ================================================================================
+// eof
@@ -0,0 +1,34 @@
+#version 450
+
+// The build also compiles a MULTIVIEW=1 variant, drawn by a multiview render
+// pass that broadcasts each draw to every view
+#ifndef MULTIVIEW
+#define MULTIVIEW 0
+#endif
+#if MULTIVIEW
+#extension GL_EXT_multiview : require
+#define VIEW_INDEX gl_ViewIndex
+#else
+#define VIEW_INDEX 0
+#endif
+
+layout(set = 0, binding = 0) uniform FrameUniforms {
+    vec4 tint;
+    // Offset in xy and scale in z for each view; MAX_VIEW_COUNT in graphics_pipeline.hpp
+    vec4 views[4];
+} frame;
+
+// One instance per particle, read straight from the simulation's storage buffer
+layout(location = 0) in vec2 inPosition;
+layout(location = 1) in vec2 inVelocity;
+
+layout(location = 0) out vec3 fragColor;
+
+void main() {
+    gl_PointSize = 1.0;
+    vec4 view = frame.views[VIEW_INDEX];
+    gl_Position = vec4(inPosition * view.z + view.xy, 0.0, 1.0);
+
+    float speed = clamp(length(inVelocity) * 2.0, 0.0, 1.0);
+    fragColor = mix(vec3(0.2, 0.4, 1.0), vec3(1.0, 0.6, 0.2), speed) * frame.tint.rgb;
+}
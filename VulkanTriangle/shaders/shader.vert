@@ -1,5 +1,28 @@
 #version 450
 
+// The build also compiles a MULTIVIEW=1 variant, drawn by a multiview render
+// pass that broadcasts each draw to every view
+#ifndef MULTIVIEW
+#define MULTIVIEW 0
+#endif
+#if MULTIVIEW
+#extension GL_EXT_multiview : require
+#define VIEW_INDEX gl_ViewIndex
+#else
+#define VIEW_INDEX 0
+#endif
+
+layout(set = 0, binding = 0) uniform FrameUniforms {
+    vec4 tint;
+    // Offset in xy and scale in z for each view; MAX_VIEW_COUNT in graphics_pipeline.hpp
+    vec4 views[4];
+} frame;
+
+layout(push_constant) uniform DrawPushConstants {
+    vec2 offset;
+    float scale;
+} draw;
+
 layout(location = 0) out vec3 fragColor;
 
 vec2 positions[3] = vec2[](
@@ -15,6 +38,8 @@ vec3 colors[3] = vec3[](
 );
 
 void main() {
-    gl_Position = vec4(positions[gl_VertexIndex], 0.0, 1.0);
-    fragColor = colors[gl_VertexIndex];
+    vec4 view = frame.views[VIEW_INDEX];
+    vec2 position = positions[gl_VertexIndex] * draw.scale + draw.offset;
+    gl_Position = vec4(position * view.z + view.xy, 0.0, 1.0);
+    fragColor = colors[gl_VertexIndex] * frame.tint.rgb;
 }
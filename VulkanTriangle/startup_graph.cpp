@@ -0,0 +1,151 @@
+// ================================================================================
+// ================================================================================
+// - File:    startup_graph.cpp
+// - Purpose: Contains the implementation for startup_graph.hpp
+//
+// Source Metadata
+// - Author:  Jonathan A. Webb
+// - Date:    October 18, 2026
+// - Version: 1.0
+// - Copyright: Copyright 2022, Jon Webb Inc.
+// ================================================================================
+// ================================================================================
+// Include modules here
+
+#include "include/startup_graph.hpp"
+#include <algorithm>
+#include <cstdio>
+// ================================================================================
+// ================================================================================
+
+StartupGraph::StartupGraph(JobSystem& jobs)
+    : jobs(jobs), origin(std::chrono::steady_clock::now()) {
+    // The constructing thread is reported as the main thread
+    threadIndices[std::this_thread::get_id()] = 0;
+}
+// --------------------------------------------------------------------------------
+
+StartupGraph::~StartupGraph() {
+    // The job system may already be owned by something else by now, so only
+    // the counters are touched
+    for (JobCounter* group : groups) {
+        while (!group->isDone()) {
+            std::this_thread::yield();
+        }
+    }
+}
+// --------------------------------------------------------------------------------
+
+void StartupGraph::run(const std::string& name, std::function<void()> step, JobCounter& group) {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (std::find(groups.begin(), groups.end(), &group) == groups.end()) {
+            groups.push_back(&group);
+        }
+    }
+    jobs.run(wrap(name, std::move(step)), &group);
+}
+// --------------------------------------------------------------------------------
+
+void StartupGraph::runAfter(JobCounter& dependency,
+                            const std::string& name,
+                            std::function<void()> step,
+                            JobCounter& group) {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (std::find(groups.begin(), groups.end(), &group) == groups.end()) {
+            groups.push_back(&group);
+        }
+    }
+    jobs.runAfter(dependency, wrap(name, std::move(step)), &group);
+}
+// --------------------------------------------------------------------------------
+
+void StartupGraph::runHere(const std::string& name, const std::function<void()>& step) {
+    auto start = std::chrono::steady_clock::now();
+    step();
+    record(name, start, std::chrono::steady_clock::now());
+}
+// --------------------------------------------------------------------------------
+
+void StartupGraph::join(JobCounter& group) {
+    jobs.wait(group);
+
+    std::lock_guard<std::mutex> lock(mutex);
+    if (error) {
+        std::rethrow_exception(error);
+    }
+}
+// --------------------------------------------------------------------------------
+
+void StartupGraph::print(std::ostream& out) const {
+    std::vector<Step> sorted;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        sorted = steps;
+    }
+    std::sort(sorted.begin(), sorted.end(), [](const Step& a, const Step& b) {
+        return a.startMilliseconds < b.startMilliseconds;
+    });
+
+    double serialMilliseconds = 0.0;
+    double finishMilliseconds = 0.0;
+    out << "Startup timeline:\n";
+    for (const Step& step : sorted) {
+        char line[64];
+        if (step.thread == 0) {
+            std::snprintf(line, sizeof(line), "  %8.2f - %8.2f ms  main      ",
+                          step.startMilliseconds, step.endMilliseconds);
+        } else {
+            std::snprintf(line, sizeof(line), "  %8.2f - %8.2f ms  worker %-2u ",
+                          step.startMilliseconds, step.endMilliseconds, step.thread);
+        }
+        out << line << step.name << "\n";
+        serialMilliseconds += step.endMilliseconds - step.startMilliseconds;
+        finishMilliseconds = std::max(finishMilliseconds, step.endMilliseconds);
+    }
+    out << "Startup took " << finishMilliseconds << " ms; the steps add up to "
+        << serialMilliseconds << " ms run one after another" << std::endl;
+}
+// ================================================================================
+
+std::function<void()> StartupGraph::wrap(const std::string& name, std::function<void()> step) {
+    return [this, name, step = std::move(step)]() {
+        {
+            // A failed step usually leaves later steps without their inputs
+            std::lock_guard<std::mutex> lock(mutex);
+            if (error) {
+                return;
+            }
+        }
+        auto start = std::chrono::steady_clock::now();
+        try {
+            step();
+        } catch (...) {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (!error) {
+                error = std::current_exception();
+            }
+            return;
+        }
+        record(name, start, std::chrono::steady_clock::now());
+    };
+}
+// --------------------------------------------------------------------------------
+
+void StartupGraph::record(const std::string& name,
+                          std::chrono::steady_clock::time_point start,
+                          std::chrono::steady_clock::time_point end) {
+    using Milliseconds = std::chrono::duration<double, std::milli>;
+
+    std::lock_guard<std::mutex> lock(mutex);
+    auto inserted = threadIndices.emplace(std::this_thread::get_id(),
+                                          static_cast<uint32_t>(threadIndices.size()));
+    steps.push_back({name,
+                     inserted.first->second,
+                     Milliseconds(start - origin).count(),
+                     Milliseconds(end - origin).count()});
+}
+// ================================================================================
+// ================================================================================
+// eof
@@ -0,0 +1,202 @@
+// ================================================================================
+// ================================================================================
+// - File:    synchronization.cpp
+// - Purpose: Contains the implementation for synchronization.hpp
+//
+// Source Metadata
+// - Author:  Jonathan A. Webb
+// - Date:    October 18, 2026
+// - Version: 1.0
+// - Copyright: Copyright 2022, Jon Webb Inc.
+// ================================================================================
+// ================================================================================
+// Include modules here
+
+#include "include/synchronization.hpp"
+#include "include/deletion_queue.hpp"
+#include "include/host_allocator.hpp"
+#include <algorithm>
+#include <stdexcept>
+// ================================================================================
+// ================================================================================
+
+VkSemaphoreSubmitInfo semaphoreSubmitInfo(VkSemaphore semaphore,
+                                          uint64_t value,
+                                          VkPipelineStageFlags2 stageMask) {
+    VkSemaphoreSubmitInfo info{};
+    info.sType = VK_STRUCTURE_TYPE_SEMAPHORE_SUBMIT_INFO;
+    info.semaphore = semaphore;
+    info.value = value;
+    info.stageMask = stageMask;
+    return info;
+}
+// ================================================================================
+// ================================================================================
+
+TimelineSemaphore::TimelineSemaphore(VkDevice device)
+    : device(device) {
+    VkSemaphoreTypeCreateInfo typeInfo{};
+    typeInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_TYPE_CREATE_INFO;
+    typeInfo.semaphoreType = VK_SEMAPHORE_TYPE_TIMELINE;
+    typeInfo.initialValue = 0;
+
+    VkSemaphoreCreateInfo semaphoreInfo{};
+    semaphoreInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO;
+    semaphoreInfo.pNext = &typeInfo;
+
+    if (vkCreateSemaphore(device, &semaphoreInfo, hostAllocator(VK_OBJECT_TYPE_SEMAPHORE), &semaphore) != VK_SUCCESS) {
+        throw std::runtime_error("failed to create timeline semaphore!");
+    }
+}
+// --------------------------------------------------------------------------------
+
+TimelineSemaphore::~TimelineSemaphore() {
+    if (semaphore != VK_NULL_HANDLE) {
+        vkDestroySemaphore(device, semaphore, hostAllocator(VK_OBJECT_TYPE_SEMAPHORE));
+    }
+}
+// --------------------------------------------------------------------------------
+
+VkSemaphore TimelineSemaphore::getSemaphore() const {
+    return semaphore;
+}
+// --------------------------------------------------------------------------------
+
+uint64_t TimelineSemaphore::reserve() {
+    return ++pendingValue;
+}
+// --------------------------------------------------------------------------------
+
+uint64_t TimelineSemaphore::getPendingValue() const {
+    return pendingValue;
+}
+// --------------------------------------------------------------------------------
+
+bool TimelineSemaphore::isComplete(uint64_t value) const {
+    if (value <= completedValue) {
+        return true;
+    }
+    uint64_t current = 0;
+    if (vkGetSemaphoreCounterValue(device, semaphore, &current) != VK_SUCCESS) {
+        throw std::runtime_error("failed to query timeline semaphore!");
+    }
+    completedValue = std::max(completedValue, current);
+    return value <= completedValue;
+}
+// --------------------------------------------------------------------------------
+
+void TimelineSemaphore::wait(uint64_t value) const {
+    if (value <= completedValue) {
+        return;
+    }
+
+    VkSemaphoreWaitInfo waitInfo{};
+    waitInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_WAIT_INFO;
+    waitInfo.semaphoreCount = 1;
+    waitInfo.pSemaphores = &semaphore;
+    waitInfo.pValues = &value;
+
+    if (vkWaitSemaphores(device, &waitInfo, UINT64_MAX) != VK_SUCCESS) {
+        throw std::runtime_error("failed to wait on timeline semaphore!");
+    }
+    completedValue = value;
+}
+// --------------------------------------------------------------------------------
+
+VkSemaphoreSubmitInfo TimelineSemaphore::waitInfo(uint64_t value, VkPipelineStageFlags2 stageMask) const {
+    return semaphoreSubmitInfo(semaphore, value, stageMask);
+}
+// --------------------------------------------------------------------------------
+
+VkSemaphoreSubmitInfo TimelineSemaphore::signalInfo(uint64_t value, VkPipelineStageFlags2 stageMask) const {
+    return semaphoreSubmitInfo(semaphore, value, stageMask);
+}
+// ================================================================================
+// ================================================================================
+
+SyncObjects::SyncObjects(VkDevice device,
+                         const TimelineSemaphore& graphicsTimeline,
+                         uint32_t framesInFlight,
+                         uint32_t imageCount)
+    : device(device), graphicsTimeline(graphicsTimeline) {
+    createSyncObjects(framesInFlight, imageCount);
+}
+// --------------------------------------------------------------------------------
+
+SyncObjects::~SyncObjects() {
+    for (VkSemaphore semaphore : imageAvailableSemaphores) {
+        vkDestroySemaphore(device, semaphore, hostAllocator(VK_OBJECT_TYPE_SEMAPHORE));
+    }
+    for (VkSemaphore semaphore : renderFinishedSemaphores) {
+        vkDestroySemaphore(device, semaphore, hostAllocator(VK_OBJECT_TYPE_SEMAPHORE));
+    }
+}
+// --------------------------------------------------------------------------------
+
+VkSemaphore SyncObjects::getImageAvailableSemaphore(uint32_t frameIndex) const {
+    return imageAvailableSemaphores[frameIndex];
+}
+// --------------------------------------------------------------------------------
+
+VkSemaphore SyncObjects::getRenderFinishedSemaphore(uint32_t imageIndex) const {
+    return renderFinishedSemaphores[imageIndex];
+}
+// --------------------------------------------------------------------------------
+
+void SyncObjects::setImageCount(uint32_t imageCount, DeletionQueue& deletionQueue) {
+    for (VkSemaphore semaphore : renderFinishedSemaphores) {
+        deletionQueue.destroy(VK_OBJECT_TYPE_SEMAPHORE, semaphore);
+    }
+    createRenderFinishedSemaphores(imageCount);
+}
+// --------------------------------------------------------------------------------
+
+void SyncObjects::setFrameValue(uint32_t frameIndex, uint64_t value) {
+    frameValues[frameIndex] = value;
+}
+// --------------------------------------------------------------------------------
+
+void SyncObjects::waitForFrame(uint32_t frameIndex) const {
+    graphicsTimeline.wait(frameValues[frameIndex]);
+}
+// --------------------------------------------------------------------------------
+
+void SyncObjects::waitForAllFrames() const {
+    graphicsTimeline.wait(*std::max_element(frameValues.begin(), frameValues.end()));
+}
+// ================================================================================
+
+void SyncObjects::createSyncObjects(uint32_t framesInFlight, uint32_t imageCount) {
+    imageAvailableSemaphores.resize(framesInFlight, VK_NULL_HANDLE);
+
+    // Value zero is signaled from the start, so the first wait of each frame
+    // returns immediately
+    frameValues.assign(framesInFlight, 0);
+
+    VkSemaphoreCreateInfo semaphoreInfo{};
+    semaphoreInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO;
+
+    for (uint32_t i = 0; i < framesInFlight; i++) {
+        if (vkCreateSemaphore(device, &semaphoreInfo, hostAllocator(VK_OBJECT_TYPE_SEMAPHORE), &imageAvailableSemaphores[i]) != VK_SUCCESS) {
+            throw std::runtime_error("failed to create synchronization objects for a frame!");
+        }
+    }
+    createRenderFinishedSemaphores(imageCount);
+}
+// --------------------------------------------------------------------------------
+
+void SyncObjects::createRenderFinishedSemaphores(uint32_t imageCount) {
+    renderFinishedSemaphores.assign(imageCount, VK_NULL_HANDLE);
+
+    VkSemaphoreCreateInfo semaphoreInfo{};
+    semaphoreInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO;
+
+    for (uint32_t i = 0; i < imageCount; i++) {
+        if (vkCreateSemaphore(device, &semaphoreInfo, hostAllocator(VK_OBJECT_TYPE_SEMAPHORE), &renderFinishedSemaphores[i]) != VK_SUCCESS) {
+            throw std::runtime_error("failed to create synchronization objects for an image!");
+        }
+    }
+}
+// ================================================================================
+// ================================================================================
+// eof
@@ -0,0 +1,437 @@
+// ================================================================================
+// ================================================================================
+// - File:    frame_allocation_test.cpp
+// - Purpose: Runs the per-frame work of the render loop for a number of frames
+//            against a fake driver and fails if any frame after warm-up
+//            allocates from the heap
+//
+// Source Metadata
+// - Author:  Jonathan A. Webb
+// - Date:    October 18, 2026
+// - Version: 1.0
+// - Copyright: Copyright 2024, Jon Webb Inc.
+// ================================================================================
+// ================================================================================
+// - Begin test
+
+#include "../include/allocation_tracker.hpp"
+#include "../include/buffers.hpp"
+#include "../include/constants.hpp"
+#include "../include/deletion_queue.hpp"
+#include "../include/frame_arena.hpp"
+#include "../include/host_allocator.hpp"
+#include "../include/job_system.hpp"
+#include "../include/queues.hpp"
+#include "../include/render_graph.hpp"
+#include "../include/render_queue.hpp"
+#include "../include/residency_manager.hpp"
+#include "../include/synchronization.hpp"
+#include "../include/texture_streamer.hpp"
+#include "../include/upload_manager.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+// ================================================================================
+// ================================================================================
+
+static const uint64_t WARMUP_FRAMES = 8;
+static const uint64_t MEASURED_FRAMES = 240;
+static const uint32_t DRAWS_PER_FRAME = 2000;
+static const uint32_t PIPELINE_COUNT = 16;
+static const uint32_t MATERIAL_COUNT = 64;
+static const uint32_t TEXTURE_COUNT = 4;
+static const uint32_t TEXTURE_SIZE = 256;
+static const uint32_t SWAP_CHAIN_IMAGE_COUNT = 3;
+static const VkDeviceSize INSTANCE_BUFFER_SIZE = 4096;
+
+// Long enough for a loaded CI machine to finish the texture loads
+static const std::chrono::seconds STREAMING_TIMEOUT(10);
+
+static const char* TEXTURE_PATH = "frame_allocation_test.dds";
+// --------------------------------------------------------------------------------
+
+/**
+ * @brief Makes a fake handle.  The fake driver never dereferences device,
+ * queue or draw handles, so they are only compared and hashed.
+ */
+template <typename Handle>
+static Handle fakeHandle(uint64_t value) {
+    return reinterpret_cast<Handle>(static_cast<uintptr_t>(value + 1));
+}
+// --------------------------------------------------------------------------------
+
+static void putU32(std::vector<uint8_t>& data, size_t offset, uint32_t value) {
+    for (size_t i = 0; i < 4; i++) {
+        data[offset + i] = static_cast<uint8_t>(value >> (8 * i));
+    }
+}
+// --------------------------------------------------------------------------------
+
+/**
+ * @brief Writes an uncompressed RGBA8 DDS texture with a full mip chain
+ */
+static void writeTexture(const std::string& path, uint32_t size) {
+    uint32_t levelCount = 1;
+    uint64_t dataSize = 0;
+    for (uint32_t extent = size; ; extent /= 2) {
+        dataSize += static_cast<uint64_t>(extent) * extent * 4;
+        if (extent == 1) {
+            break;
+        }
+        levelCount++;
+    }
+
+    std::vector<uint8_t> data(128 + static_cast<size_t>(dataSize), 0x80);
+    std::fill(data.begin(), data.begin() + 128, 0);
+    putU32(data, 0, 0x20534444);        // "DDS "
+    putU32(data, 4, 124);               // Header size
+    putU32(data, 8, 0x1 | 0x2 | 0x4 | 0x1000 | 0x20000);
+    putU32(data, 12, size);             // Height
+    putU32(data, 16, size);             // Width
+    putU32(data, 28, levelCount);
+    putU32(data, 76, 32);               // Pixel format size
+    putU32(data, 80, 0x40 | 0x1);       // RGB with alpha
+    putU32(data, 88, 32);               // Bits per pixel
+    putU32(data, 92, 0x000000ff);
+    putU32(data, 96, 0x0000ff00);
+    putU32(data, 100, 0x00ff0000);
+    putU32(data, 104, 0xff000000);
+    putU32(data, 108, 0x1000 | 0x400000 | 0x8);
+
+    std::ofstream file(path, std::ios::binary);
+    file.write(reinterpret_cast<const char*>(data.data()), static_cast<std::streamsize>(data.size()));
+}
+// ================================================================================
+// ================================================================================
+
+/**
+ * @brief The per-frame modules of the renderer, wired together the way
+ * HelloTriangleApplication wires them.  The transfer queue is in its own
+ * family, so uploads also record the ownership transfers.
+ */
+class FrameLoop {
+public:
+    FrameLoop()
+        : device(fakeHandle<VkDevice>(0)),
+          physicalDevice(fakeHandle<VkPhysicalDevice>(0)),
+          graphicsQueue(fakeHandle<VkQueue>(0)),
+          transferQueue(fakeHandle<VkQueue>(1)),
+          arena(FRAME_ARENA_SIZE),
+          graphicsTimeline(device),
+          transferTimeline(device),
+          deletionQueue(device, graphicsTimeline),
+          residency(physicalDevice, device, false, false, MAX_FRAMES_IN_FLIGHT),
+          jobs(2) {
+        families.graphicsFamily = 0;
+        families.presentFamily = 0;
+        families.transferFamily = 1;
+        families.computeFamily = 0;
+
+        uploads = std::make_unique<UploadManager>(device, physicalDevice, families, transferQueue,
+                                                  transferTimeline, graphicsTimeline,
+                                                  UPLOAD_STAGING_RING_SIZE, UPLOAD_BATCH_COUNT);
+        streamer = std::make_unique<TextureStreamer>(device, physicalDevice, families, transferQueue,
+                                                     transferTimeline, graphicsTimeline, residency, jobs);
+        commandBuffers = std::make_unique<CommandBufferManager>(device, 0u, MAX_FRAMES_IN_FLIGHT);
+
+        uniformBuffer = std::make_unique<UniformRingBuffer>(device, physicalDevice, UNIFORM_RING_FRAME_SIZE,
+                                                            MAX_FRAMES_IN_FLIGHT, UNIFORM_RING_MAX_ALLOCATION);
+
+        VkBufferCreateInfo bufferInfo{};
+        bufferInfo.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+        bufferInfo.size = INSTANCE_BUFFER_SIZE;
+        bufferInfo.usage = VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_VERTEX_BUFFER_BIT;
+        bufferInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+        vkCreateBuffer(device, &bufferInfo, hostAllocator(VK_OBJECT_TYPE_BUFFER), &instanceBuffer);
+
+        // Initial contents go up before the first frame, as the particle state does
+        std::vector<uint8_t> initialInstances(INSTANCE_BUFFER_SIZE, 0);
+        uploads->write(instanceBuffer, 0, initialInstances.data(), INSTANCE_BUFFER_SIZE);
+        uploads->flush(graphicsQueue, 0, graphicsTimeline);
+
+        for (uint32_t i = 0; i < SWAP_CHAIN_IMAGE_COUNT; i++) {
+            swapChainImages.push_back(fakeHandle<VkImage>(1000 + i));
+            swapChainImageViews.push_back(fakeHandle<VkImageView>(1000 + i));
+        }
+        buildRenderGraph();
+
+        for (uint32_t i = 0; i < TEXTURE_COUNT; i++) {
+            textures.push_back(streamer->load(TEXTURE_PATH));
+            streamer->requestResolution(textures.back(), TEXTURE_SIZE);
+        }
+    }
+// --------------------------------------------------------------------------------
+
+    ~FrameLoop() {
+        graphicsTimeline.wait(graphicsTimeline.getPendingValue());
+        graph.reset();
+        streamer.reset();
+        uploads.reset();
+        deletionQueue.collect();
+        vkDestroyBuffer(device, instanceBuffer, hostAllocator(VK_OBJECT_TYPE_BUFFER));
+    }
+// --------------------------------------------------------------------------------
+
+    /**
+     * @brief The CPU side of HelloTriangleApplication::drawFrame(), in the
+     * same order, minus the swap chain
+     */
+    void runFrame() {
+        frameNumber++;
+        uint32_t frameIndex = static_cast<uint32_t>(frameNumber % MAX_FRAMES_IN_FLIGHT);
+
+        arena.reset();
+        deletionQueue.collect(&arena);
+
+        residency.beginFrame(frameNumber);
+        streamer->update(frameNumber, &arena);
+        for (TextureHandle texture : textures) {
+            streamer->markUsed(texture);
+        }
+
+        // A buffer retired by the frame, as a replaced or resized one would be
+        VkBufferCreateInfo bufferInfo{};
+        bufferInfo.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+        bufferInfo.size = 256;
+        bufferInfo.usage = VK_BUFFER_USAGE_VERTEX_BUFFER_BIT;
+        VkBuffer retired;
+        vkCreateBuffer(device, &bufferInfo, hostAllocator(VK_OBJECT_TYPE_BUFFER), &retired);
+        deletionQueue.destroy(VK_OBJECT_TYPE_BUFFER, retired);
+
+        // Buffer updates: writes that merge into one region and one that
+        // overlaps them and needs a second copy group
+        float instance[16] = {static_cast<float>(frameNumber)};
+        uploads->write(instanceBuffer, 0, instance, sizeof(instance));
+        uploads->write(instanceBuffer, sizeof(instance), instance, sizeof(instance));
+        uploads->write(instanceBuffer, sizeof(instance) / 2, instance, sizeof(instance));
+
+        UploadSubmission uploadSubmission;
+        bool uploading = uploads->submit(uploadSubmission);
+
+        uniformBuffer->beginFrame(frameIndex);
+        VkCommandBuffer commandBuffer = commandBuffers->getCommandBuffer(frameIndex);
+        vkResetCommandBuffer(commandBuffer, 0);
+        VkCommandBufferBeginInfo beginInfo{};
+        beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+        vkBeginCommandBuffer(commandBuffer, &beginInfo);
+        uint32_t imageIndex = static_cast<uint32_t>(frameNumber % SWAP_CHAIN_IMAGE_COUNT);
+        graph->setImportedImage(backbuffer, swapChainImages[imageIndex], swapChainImageViews[imageIndex]);
+        graph->execute(commandBuffer);
+        vkEndCommandBuffer(commandBuffer);
+
+        uint64_t frameValue = graphicsTimeline.reserve();
+        VkSemaphoreSubmitInfo signalInfo = graphicsTimeline.signalInfo(frameValue,
+                                                                       VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT);
+        VkCommandBufferSubmitInfo commandBufferInfos[2]{};
+        uint32_t commandBufferCount = 0;
+        if (uploading && uploadSubmission.acquireCommandBuffer != VK_NULL_HANDLE) {
+            commandBufferInfos[commandBufferCount].sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_SUBMIT_INFO;
+            commandBufferInfos[commandBufferCount++].commandBuffer = uploadSubmission.acquireCommandBuffer;
+        }
+        commandBufferInfos[commandBufferCount].sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_SUBMIT_INFO;
+        commandBufferInfos[commandBufferCount++].commandBuffer = commandBuffer;
+
+        VkSubmitInfo2 submitInfo{};
+        submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO_2;
+        submitInfo.waitSemaphoreInfoCount = uploading ? 1 : 0;
+        submitInfo.pWaitSemaphoreInfos = &uploadSubmission.waitInfo;
+        submitInfo.commandBufferInfoCount = commandBufferCount;
+        submitInfo.pCommandBufferInfos = commandBufferInfos;
+        submitInfo.signalSemaphoreInfoCount = 1;
+        submitInfo.pSignalSemaphoreInfos = &signalInfo;
+        vkQueueSubmit2(graphicsQueue, 1, &submitInfo, VK_NULL_HANDLE);
+        if (uploading) {
+            uploads->submitted(frameValue);
+        }
+    }
+// --------------------------------------------------------------------------------
+
+    /**
+     * @brief Returns true once every texture is resident at the requested
+     * resolution and no upload is in flight
+     */
+    bool isStreamingSettled() const {
+        TextureStreamingStats stats = streamer->getStats();
+        if (stats.pendingLoads != 0 || stats.batchesInFlight != 0) {
+            return false;
+        }
+        for (TextureHandle texture : textures) {
+            if (streamer->getResidentMip(texture) != 0) {
+                return false;
+            }
+        }
+        return true;
+    }
+// --------------------------------------------------------------------------------
+
+    const RenderQueue& getRenderQueue() const {
+        return renderQueue;
+    }
+// --------------------------------------------------------------------------------
+
+    const UploadStats& getUploadStats() const {
+        return uploads->getStats();
+    }
+// ================================================================================
+private:
+    VkDevice device;
+    VkPhysicalDevice physicalDevice;
+    VkQueue graphicsQueue;
+    VkQueue transferQueue;
+    QueueFamilyIndices families;
+    FrameArena arena;
+    TimelineSemaphore graphicsTimeline;
+    TimelineSemaphore transferTimeline;
+    DeletionQueue deletionQueue;
+    ResidencyManager residency;
+    JobSystem jobs;
+    std::unique_ptr<UploadManager> uploads;
+    std::unique_ptr<TextureStreamer> streamer;
+    std::unique_ptr<CommandBufferManager> commandBuffers;
+    std::unique_ptr<UniformRingBuffer> uniformBuffer;
+    std::unique_ptr<RenderGraph> graph;
+    RenderQueue renderQueue;
+    VkBuffer instanceBuffer = VK_NULL_HANDLE;
+    std::vector<VkImage> swapChainImages;
+    std::vector<VkImageView> swapChainImageViews;
+    std::vector<TextureHandle> textures;
+    RenderGraphResource backbuffer = 0;
+    uint64_t frameNumber = 0;
+// --------------------------------------------------------------------------------
+
+    /**
+     * @brief The offscreen graph: the main pass draws into a transient image
+     * that is then copied to the backbuffer
+     */
+    void buildRenderGraph() {
+        graph = std::make_unique<RenderGraph>(device, physicalDevice, &residency);
+
+        ResourceState acquired;
+        acquired.stages = VK_PIPELINE_STAGE_2_COLOR_ATTACHMENT_OUTPUT_BIT;
+        acquired.layout = VK_IMAGE_LAYOUT_UNDEFINED;
+        backbuffer = graph->importImage("backbuffer", VK_IMAGE_ASPECT_COLOR_BIT, acquired, ResourceUsage::Present);
+
+        TransientImageDesc sceneDesc;
+        sceneDesc.format = VK_FORMAT_B8G8R8A8_SRGB;
+        sceneDesc.extent = {1280, 720};
+        sceneDesc.usage = VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT | VK_IMAGE_USAGE_TRANSFER_SRC_BIT;
+        RenderGraphResource scene = graph->createImage("scene", sceneDesc);
+
+        graph->addPass("main", {{scene, ResourceUsage::ColorAttachment}},
+                       [this](VkCommandBuffer commandBuffer, const RenderGraph&) {
+                           recordMainPass(commandBuffer);
+                       });
+        graph->addPass("present copy",
+                       {{scene, ResourceUsage::TransferSrc}, {backbuffer, ResourceUsage::TransferDst}},
+                       [](VkCommandBuffer, const RenderGraph&) {});
+        graph->compile();
+    }
+// --------------------------------------------------------------------------------
+
+    void recordMainPass(VkCommandBuffer commandBuffer) {
+        // The frame uniforms go through the host visible ring, as in the renderer
+        float frameUniforms[20] = {static_cast<float>(frameNumber)};
+        uint32_t frameOffset = uniformBuffer->push(frameUniforms);
+
+        for (uint32_t i = 0; i < DRAWS_PER_FRAME; i++) {
+            uint32_t material = (i * 7 + static_cast<uint32_t>(frameNumber)) % MATERIAL_COUNT;
+
+            DrawItem item{};
+            item.pass = static_cast<uint8_t>(i % 2);
+            item.depth = static_cast<float>((i * 13) % 1000) / 1000.0f;
+            item.pipeline = fakeHandle<VkPipeline>(material % PIPELINE_COUNT);
+            item.layout = fakeHandle<VkPipelineLayout>(0);
+            item.descriptorSet = fakeHandle<VkDescriptorSet>(material);
+            item.vertexBuffer = fakeHandle<VkBuffer>(material % 4);
+            item.vertexCount = 3;
+            if (i == 0) {
+                item.descriptorSet = uniformBuffer->getDescriptorSet();
+                item.dynamicOffset = frameOffset;
+                item.hasDynamicOffset = true;
+            }
+
+            float pushConstants[4] = {static_cast<float>(i), 0.0f, 0.0f, 1.0f};
+            renderQueue.submit(item, pushConstants, sizeof(pushConstants), VK_SHADER_STAGE_VERTEX_BIT);
+        }
+        renderQueue.flush(commandBuffer);
+    }
+};
+// ================================================================================
+// ================================================================================
+
+int main() {
+    if (!AllocationTracker::isEnabled()) {
+        std::cerr << "frame_allocation_test must be built with TRACK_ALLOCATIONS" << std::endl;
+        return 1;
+    }
+
+    // The check is only meaningful if the counting operator new is the one in use
+    {
+        AllocationBudget probe(0, AllocationViolation::Count);
+        std::unique_ptr<int> allocation = std::make_unique<int>(0);
+        if (probe.getAllocations() != 1) {
+            std::cerr << "the counting operator new is not linked in" << std::endl;
+            return 1;
+        }
+    }
+
+    writeTexture(TEXTURE_PATH, TEXTURE_SIZE);
+    int result = 0;
+    {
+        FrameLoop loop;
+
+        // Loading and promoting textures allocates by design, so the measured
+        // frames start once streaming has settled
+        auto deadline = std::chrono::steady_clock::now() + STREAMING_TIMEOUT;
+        while (!loop.isStreamingSettled()) {
+            if (std::chrono::steady_clock::now() > deadline) {
+                std::cerr << "textures did not finish streaming" << std::endl;
+                std::remove(TEXTURE_PATH);
+                return 1;
+            }
+            loop.runFrame();
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        for (uint64_t frame = 0; frame < WARMUP_FRAMES; frame++) {
+            loop.runFrame();
+        }
+
+        uint64_t allocations = 0;
+        uint64_t framesOverBudget = 0;
+        uint64_t submitsBefore = loop.getUploadStats().submits;
+        for (uint64_t frame = 0; frame < MEASURED_FRAMES; frame++) {
+            AllocationBudget budget(0, AllocationViolation::Log);
+            loop.runFrame();
+            allocations += budget.getAllocations();
+            if (budget.getAllocations() > 0) {
+                framesOverBudget++;
+            }
+        }
+        uint64_t submits = loop.getUploadStats().submits - submitsBefore;
+
+        std::cout << MEASURED_FRAMES << " frames after warm-up: " << allocations << " allocations in "
+                  << framesOverBudget << " frames, "
+                  << loop.getRenderQueue().getTotalStats().draws << " draws queued, "
+                  << submits << " upload batches" << std::endl;
+        if (allocations != 0) {
+            result = 1;
+        }
+        // A frame that skipped its uploads would also skip their allocations
+        if (submits != MEASURED_FRAMES) {
+            std::cerr << "only " << submits << " of " << MEASURED_FRAMES << " frames submitted uploads" << std::endl;
+            result = 1;
+        }
+    }
+    std::remove(TEXTURE_PATH);
+    return result;
+}
+// ================================================================================
+// ================================================================================
+// eof
@@ -0,0 +1,57 @@
+// ================================================================================
+// ================================================================================
+// - File:    job_system_test.cpp
+// - Purpose: Checks that a job system sized for one thread still runs jobs
+//            that nobody waits on
+//
+// Source Metadata
+// - Author:  Jonathan A. Webb
+// - Date:    October 18, 2026
+// - Version: 1.0
+// - Copyright: Copyright 2024, Jon Webb Inc.
+// ================================================================================
+// ================================================================================
+// - Begin test
+
+#include "../include/job_system.hpp"
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <thread>
+// ================================================================================
+// ================================================================================
+
+// Long enough for a loaded CI machine to schedule the worker
+static const std::chrono::seconds TIMEOUT(10);
+// ================================================================================
+// ================================================================================
+
+int main() {
+    // Same as a single core machine, where hardware_concurrency() returns 1
+    JobSystem jobs(1);
+    if (jobs.getThreadCount() < 2) {
+        std::cerr << "JobSystem(1) started no worker thread" << std::endl;
+        return 1;
+    }
+
+    // The owner never calls wait(), the way the render thread treats texture
+    // loads and capture encodes
+    std::atomic<bool> ran{false};
+    JobCounter counter;
+    jobs.run([&ran]() { ran.store(true, std::memory_order_release); }, &counter);
+
+    auto deadline = std::chrono::steady_clock::now() + TIMEOUT;
+    while (!counter.isDone() && std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    if (!counter.isDone() || !ran.load(std::memory_order_acquire)) {
+        std::cerr << "a job nobody waited on did not run" << std::endl;
+        return 1;
+    }
+
+    std::cout << "fire-and-forget job ran on " << jobs.getThreadCount() << " threads" << std::endl;
+    return 0;
+}
+// ================================================================================
+// ================================================================================
+// eof
@@ -0,0 +1,120 @@
+// ================================================================================
+// ================================================================================
+// - File:    render_job_test.cpp
+// - Purpose: Parses batch render job and scene files and checks that malformed
+//            lines are rejected with the line they came from
+//
+// Source Metadata
+// - Author:  Jonathan A. Webb
+// - Date:    October 18, 2026
+// - Version: 1.0
+// - Copyright: Copyright 2024, Jon Webb Inc.
+// ================================================================================
+// ================================================================================
+// - Begin test
+
+#include "../include/render_job.hpp"
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+// ================================================================================
+// ================================================================================
+
+static int failures = 0;
+// --------------------------------------------------------------------------------
+
+static void check(bool condition, const std::string& message) {
+    if (!condition) {
+        std::cerr << "FAILED: " << message << std::endl;
+        failures++;
+    }
+}
+// --------------------------------------------------------------------------------
+
+/**
+ * @brief Checks that parsing a job file fails and names the expected line
+ */
+static void checkJobsRejected(const std::string& contents, const std::string& where) {
+    std::istringstream input(contents);
+    try {
+        parseRenderJobs(input, "jobs.txt", "");
+        check(false, "accepted malformed jobs: " + contents);
+    } catch (const std::runtime_error& error) {
+        check(std::string(error.what()).find(where) == 0,
+              "expected an error at " + where + ", got: " + error.what());
+    }
+}
+// ================================================================================
+// ================================================================================
+
+static void testScene() {
+    std::istringstream input("# a comment\n"
+                             "tint 1 0.5 0.25\n"
+                             "\n"
+                             "triangle -0.5 0.5 0.25   # trailing comment\n"
+                             "triangle 0 0 1\n");
+    SceneDesc scene = parseScene(input, "scene.txt");
+    check(scene.tint[0] == 1.0f && scene.tint[1] == 0.5f && scene.tint[2] == 0.25f, "scene tint");
+    check(scene.tint[3] == 1.0f, "scene tint alpha");
+    check(scene.triangles.size() == 2, "scene triangle count");
+    if (scene.triangles.size() == 2) {
+        check(scene.triangles[0].offset[0] == -0.5f && scene.triangles[0].offset[1] == 0.5f, "triangle offset");
+        check(scene.triangles[0].scale == 0.25f, "triangle scale");
+    }
+
+    std::istringstream unknown("tint 1 1 1\nsphere 0 0 1\n");
+    try {
+        parseScene(unknown, "scene.txt");
+        check(false, "accepted an unknown scene command");
+    } catch (const std::runtime_error& error) {
+        check(std::string(error.what()).find("scene.txt:2:") == 0, "unknown command line number");
+    }
+
+    std::istringstream extra("triangle 0 0 1 2\n");
+    try {
+        parseScene(extra, "scene.txt");
+        check(false, "accepted a triangle with an extra field");
+    } catch (const std::runtime_error&) {
+    }
+}
+// --------------------------------------------------------------------------------
+
+static void testJobs() {
+    std::istringstream input("scene.txt 64 32 0.5 -0.25 2 out/a.png\n"
+                             "# skipped\n"
+                             "/abs/scene.txt 1 1 0 0 1 /abs/b.rgba\n");
+    std::vector<RenderJob> jobs = parseRenderJobs(input, "jobs.txt", "base");
+    check(jobs.size() == 2, "job count");
+    if (jobs.size() == 2) {
+        check(jobs[0].width == 64 && jobs[0].height == 32, "job size");
+        check(jobs[0].camera.x == 0.5f && jobs[0].camera.y == -0.25f && jobs[0].camera.zoom == 2.0f, "job camera");
+        check(jobs[0].scenePath == "base/scene.txt", "relative scene path resolved");
+        check(jobs[0].outputPath == "base/out/a.png", "relative output path resolved");
+        check(jobs[1].scenePath == "/abs/scene.txt", "absolute scene path kept");
+        check(jobs[1].outputPath == "/abs/b.rgba", "absolute output path kept");
+    }
+
+    checkJobsRejected("scene.txt 64 32 0 0 1\n", "jobs.txt:1:");
+    checkJobsRejected("\nscene.txt 0 32 0 0 1 a.png\n", "jobs.txt:2:");
+    checkJobsRejected("scene.txt -1 32 0 0 1 a.png\n", "jobs.txt:1:");
+    checkJobsRejected("scene.txt 64 16385 0 0 1 a.png\n", "jobs.txt:1:");
+    checkJobsRejected("scene.txt 64 32 0 0 0 a.png\n", "jobs.txt:1:");
+    checkJobsRejected("scene.txt 64 32 0 0 1 a.png extra\n", "jobs.txt:1:");
+}
+// ================================================================================
+// ================================================================================
+
+int main() {
+    testScene();
+    testJobs();
+    if (failures > 0) {
+        std::cerr << failures << " render job checks failed" << std::endl;
+        return 1;
+    }
+    std::cout << "render job parsing passed" << std::endl;
+    return 0;
+}
+// ================================================================================
+// ================================================================================
+// eof
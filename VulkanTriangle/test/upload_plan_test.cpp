@@ -0,0 +1,134 @@
+// ================================================================================
+// ================================================================================
+// - File:    upload_plan_test.cpp
+// - Purpose: Checks how staged buffer writes are grouped and merged into the
+//            copy commands of an upload batch
+//
+// Source Metadata
+// - Author:  Jonathan A. Webb
+// - Date:    October 18, 2026
+// - Version: 1.0
+// - Copyright: Copyright 2024, Jon Webb Inc.
+// ================================================================================
+// ================================================================================
+// - Begin test
+
+#include "../include/upload_plan.hpp"
+#include <cstdint>
+#include <iostream>
+#include <string>
+// ================================================================================
+// ================================================================================
+
+static int failures = 0;
+// --------------------------------------------------------------------------------
+
+static void check(bool condition, const std::string& message) {
+    if (!condition) {
+        std::cerr << "FAILED: " << message << std::endl;
+        failures++;
+    }
+}
+// --------------------------------------------------------------------------------
+
+/**
+ * @brief Makes a fake buffer handle.  Nothing is recorded, so the handles are
+ * only compared.
+ */
+static VkBuffer fakeBuffer(uint64_t value) {
+    return reinterpret_cast<VkBuffer>(static_cast<uintptr_t>(value));
+}
+// --------------------------------------------------------------------------------
+
+static bool regionIs(const VkBufferCopy& region, VkDeviceSize src, VkDeviceSize dst, VkDeviceSize size) {
+    return region.srcOffset == src && region.dstOffset == dst && region.size == size;
+}
+// ================================================================================
+// ================================================================================
+
+static void testAdjacentWritesMerge() {
+    UploadPlan plan;
+    VkBuffer buffer = fakeBuffer(1);
+    plan.add(buffer, 0, 64, 16);
+    plan.add(buffer, 16, 80, 16);
+    plan.add(buffer, 32, 96, 32);
+    plan.build();
+
+    check(plan.getCopies().size() == 1, "adjacent writes use one copy");
+    check(plan.getRegions().size() == 1, "adjacent writes merge into one region");
+    if (plan.getRegions().size() == 1) {
+        check(regionIs(plan.getRegions()[0], 0, 64, 64), "merged region covers every write");
+    }
+}
+// --------------------------------------------------------------------------------
+
+static void testAdjacentInBufferOnly() {
+    // Written back to front, so the ring order is the reverse of the buffer order
+    UploadPlan plan;
+    VkBuffer buffer = fakeBuffer(1);
+    plan.add(buffer, 0, 16, 16);
+    plan.add(buffer, 16, 0, 16);
+    plan.build();
+
+    check(plan.getCopies().size() == 1, "writes to one buffer use one copy");
+    check(plan.getRegions().size() == 2, "writes not adjacent in the ring stay separate");
+    if (plan.getRegions().size() == 2) {
+        check(regionIs(plan.getRegions()[0], 16, 0, 16), "regions are sorted by destination");
+        check(regionIs(plan.getRegions()[1], 0, 16, 16), "second region");
+    }
+}
+// --------------------------------------------------------------------------------
+
+static void testOverlapStartsGroup() {
+    UploadPlan plan;
+    VkBuffer buffer = fakeBuffer(1);
+    VkBuffer other = fakeBuffer(2);
+    plan.add(buffer, 0, 0, 32);
+    plan.add(other, 32, 0, 16);
+    plan.add(buffer, 48, 16, 32);  // Overlaps bytes 16 to 32 of the first write
+    plan.build();
+
+    const std::vector<UploadCopy>& copies = plan.getCopies();
+    check(copies.size() == 3, "an overlapping write starts a new copy");
+    if (copies.size() != 3) {
+        return;
+    }
+    check(!copies[0].barrierBefore && !copies[1].barrierBefore, "the first group has no barrier");
+    check(copies[0].buffer != copies[1].buffer, "the first group copies both buffers");
+    check(copies[2].barrierBefore, "the second group waits for the first");
+    check(copies[2].buffer == buffer && copies[2].regionCount == 1, "the second group copies the overlapping write");
+    check(regionIs(plan.getRegions()[copies[2].firstRegion], 48, 16, 32), "the later write is copied last");
+}
+// --------------------------------------------------------------------------------
+
+static void testClearResetsGroups() {
+    UploadPlan plan;
+    VkBuffer buffer = fakeBuffer(1);
+    plan.add(buffer, 0, 0, 16);
+    plan.add(buffer, 16, 0, 16);
+    plan.clear();
+    check(plan.getWriteCount() == 0, "clear forgets the writes");
+
+    plan.add(buffer, 32, 0, 16);
+    plan.build();
+    check(plan.getCopies().size() == 1 && !plan.getCopies()[0].barrierBefore,
+          "a batch after clear starts without a barrier");
+}
+// ================================================================================
+// ================================================================================
+
+int main() {
+    testAdjacentWritesMerge();
+    testAdjacentInBufferOnly();
+    testOverlapStartsGroup();
+    testClearResetsGroups();
+    if (failures > 0) {
+        std::cerr << failures << " upload plan checks failed" << std::endl;
+        return 1;
+    }
+    std::cout << "upload plan grouping passed" << std::endl;
+    return 0;
+}
+// ================================================================================
+// ================================================================================
+// eof
@@ -0,0 +1,442 @@
+// ================================================================================
+// ================================================================================
+// - File:    vulkan_stub.cpp
+// - Purpose: A fake Vulkan driver that lets the frame loop modules run in a
+//            test without a GPU
+//
+// Source Metadata
+// - Author:  Jonathan A. Webb
+// - Date:    October 18, 2026
+// - Version: 1.0
+// - Copyright: Copyright 2024, Jon Webb Inc.
+// ================================================================================
+// ================================================================================
+// - Begin test
+
+// Defines the entry points the frame loop modules call, in place of the Vulkan
+// loader.  The GPU finishes every submission the moment it is submitted:
+// vkQueueSubmit2 sets each timeline semaphore to its signal value, and waits
+// return at once.  Device memory is host memory, so mapped writes land
+// somewhere real.  Commands are not recorded.
+//
+// Objects are created with malloc, which the allocation tracker does not
+// count, the same way it does not count a real driver's allocations.
+
+#include <vulkan/vulkan.h>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+// ================================================================================
+// ================================================================================
+
+static const VkDeviceSize FAKE_HEAP_SIZE = 1024ull * 1024 * 1024;
+static const VkDeviceSize FAKE_IMAGE_SIZE = 64 * 1024;
+static const VkDeviceSize FAKE_ALIGNMENT = 256;
+// --------------------------------------------------------------------------------
+
+struct FakeBuffer {
+    VkDeviceSize size;
+};
+// --------------------------------------------------------------------------------
+
+struct FakeSemaphore {
+    uint64_t value;
+};
+// --------------------------------------------------------------------------------
+
+/**
+ * @brief Makes a unique handle for an object that has no state
+ */
+template <typename Handle>
+static Handle nextHandle() {
+    static uintptr_t next = 0;
+    next += 16;
+    return reinterpret_cast<Handle>(next);
+}
+// --------------------------------------------------------------------------------
+
+template <typename Handle>
+static void fillHandles(Handle* handles, uint32_t count) {
+    for (uint32_t i = 0; i < count; i++) {
+        handles[i] = nextHandle<Handle>();
+    }
+}
+// ================================================================================
+// ================================================================================
+// Physical device
+
+VKAPI_ATTR void VKAPI_CALL vkGetPhysicalDeviceProperties(VkPhysicalDevice,
+                                                         VkPhysicalDeviceProperties* pProperties) {
+    std::memset(pProperties, 0, sizeof(*pProperties));
+    pProperties->apiVersion = VK_API_VERSION_1_3;
+    pProperties->limits.minUniformBufferOffsetAlignment = FAKE_ALIGNMENT;
+    pProperties->limits.maxUniformBufferRange = 65536;
+    pProperties->limits.nonCoherentAtomSize = 64;
+}
+// --------------------------------------------------------------------------------
+
+VKAPI_ATTR void VKAPI_CALL vkGetPhysicalDeviceMemoryProperties(VkPhysicalDevice,
+                                                               VkPhysicalDeviceMemoryProperties* pMemoryProperties) {
+    // One heap with a type that satisfies every request
+    std::memset(pMemoryProperties, 0, sizeof(*pMemoryProperties));
+    pMemoryProperties->memoryHeapCount = 1;
+    pMemoryProperties->memoryHeaps[0].size = FAKE_HEAP_SIZE;
+    pMemoryProperties->memoryHeaps[0].flags = VK_MEMORY_HEAP_DEVICE_LOCAL_BIT;
+    pMemoryProperties->memoryTypeCount = 1;
+    pMemoryProperties->memoryTypes[0].heapIndex = 0;
+    pMemoryProperties->memoryTypes[0].propertyFlags = VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT |
+                                                      VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT |
+                                                      VK_MEMORY_PROPERTY_HOST_COHERENT_BIT;
+}
+// --------------------------------------------------------------------------------
+
+VKAPI_ATTR void VKAPI_CALL vkGetPhysicalDeviceMemoryProperties2(VkPhysicalDevice physicalDevice,
+                                                                VkPhysicalDeviceMemoryProperties2* pMemoryProperties) {
+    vkGetPhysicalDeviceMemoryProperties(physicalDevice, &pMemoryProperties->memoryProperties);
+}
+// --------------------------------------------------------------------------------
+
+VKAPI_ATTR void VKAPI_CALL vkGetPhysicalDeviceFormatProperties(VkPhysicalDevice,
+                                                               VkFormat,
+                                                               VkFormatProperties* pFormatProperties) {
+    pFormatProperties->linearTilingFeatures = ~0u;
+    pFormatProperties->optimalTilingFeatures = ~0u;
+    pFormatProperties->bufferFeatures = ~0u;
+}
+// --------------------------------------------------------------------------------
+
+VKAPI_ATTR void VKAPI_CALL vkGetPhysicalDeviceQueueFamilyProperties(VkPhysicalDevice,
+                                                                    uint32_t* pQueueFamilyPropertyCount,
+                                                                    VkQueueFamilyProperties* pQueueFamilyProperties) {
+    if (pQueueFamilyProperties == nullptr) {
+        *pQueueFamilyPropertyCount = 1;
+        return;
+    }
+    *pQueueFamilyPropertyCount = 1;
+    std::memset(pQueueFamilyProperties, 0, sizeof(*pQueueFamilyProperties));
+    pQueueFamilyProperties->queueFlags = VK_QUEUE_GRAPHICS_BIT | VK_QUEUE_COMPUTE_BIT | VK_QUEUE_TRANSFER_BIT;
+    pQueueFamilyProperties->queueCount = 1;
+}
+// --------------------------------------------------------------------------------
+
+VKAPI_ATTR VkResult VKAPI_CALL vkGetPhysicalDeviceSurfaceSupportKHR(VkPhysicalDevice,
+                                                                    uint32_t,
+                                                                    VkSurfaceKHR,
+                                                                    VkBool32* pSupported) {
+    *pSupported = VK_TRUE;
+    return VK_SUCCESS;
+}
+// ================================================================================
+// ================================================================================
+// Memory
+
+VKAPI_ATTR VkResult VKAPI_CALL vkAllocateMemory(VkDevice,
+                                                const VkMemoryAllocateInfo* pAllocateInfo,
+                                                const VkAllocationCallbacks*,
+                                                VkDeviceMemory* pMemory) {
+    // The handle is the memory itself, so vkMapMemory needs no lookup
+    void* block = std::calloc(1, static_cast<size_t>(pAllocateInfo->allocationSize));
+    if (block == nullptr) {
+        return VK_ERROR_OUT_OF_HOST_MEMORY;
+    }
+    *pMemory = reinterpret_cast<VkDeviceMemory>(block);
+    return VK_SUCCESS;
+}
+// --------------------------------------------------------------------------------
+
+VKAPI_ATTR void VKAPI_CALL vkFreeMemory(VkDevice, VkDeviceMemory memory, const VkAllocationCallbacks*) {
+    std::free(reinterpret_cast<void*>(memory));
+}
+// --------------------------------------------------------------------------------
+
+VKAPI_ATTR VkResult VKAPI_CALL vkMapMemory(VkDevice,
+                                           VkDeviceMemory memory,
+                                           VkDeviceSize offset,
+                                           VkDeviceSize,
+                                           VkMemoryMapFlags,
+                                           void** ppData) {
+    *ppData = reinterpret_cast<uint8_t*>(memory) + offset;
+    return VK_SUCCESS;
+}
+// --------------------------------------------------------------------------------
+
+VKAPI_ATTR void VKAPI_CALL vkUnmapMemory(VkDevice, VkDeviceMemory) {
+}
+// ================================================================================
+// ================================================================================
+// Buffers and images
+
+VKAPI_ATTR VkResult VKAPI_CALL vkCreateBuffer(VkDevice,
+                                              const VkBufferCreateInfo* pCreateInfo,
+                                              const VkAllocationCallbacks*,
+                                              VkBuffer* pBuffer) {
+    FakeBuffer* buffer = static_cast<FakeBuffer*>(std::malloc(sizeof(FakeBuffer)));
+    if (buffer == nullptr) {
+        return VK_ERROR_OUT_OF_HOST_MEMORY;
+    }
+    buffer->size = pCreateInfo->size;
+    *pBuffer = reinterpret_cast<VkBuffer>(buffer);
+    return VK_SUCCESS;
+}
+// --------------------------------------------------------------------------------
+
+VKAPI_ATTR void VKAPI_CALL vkDestroyBuffer(VkDevice, VkBuffer buffer, const VkAllocationCallbacks*) {
+    std::free(reinterpret_cast<FakeBuffer*>(buffer));
+}
+// --------------------------------------------------------------------------------
+
+VKAPI_ATTR void VKAPI_CALL vkGetBufferMemoryRequirements(VkDevice,
+                                                         VkBuffer buffer,
+                                                         VkMemoryRequirements* pMemoryRequirements) {
+    VkDeviceSize size = reinterpret_cast<const FakeBuffer*>(buffer)->size;
+    pMemoryRequirements->size = (size + FAKE_ALIGNMENT - 1) / FAKE_ALIGNMENT * FAKE_ALIGNMENT;
+    pMemoryRequirements->alignment = FAKE_ALIGNMENT;
+    pMemoryRequirements->memoryTypeBits = 1;
+}
+// --------------------------------------------------------------------------------
+
+VKAPI_ATTR VkResult VKAPI_CALL vkBindBufferMemory(VkDevice, VkBuffer, VkDeviceMemory, VkDeviceSize) {
+    return VK_SUCCESS;
+}
+// --------------------------------------------------------------------------------
+
+VKAPI_ATTR VkResult VKAPI_CALL vkCreateImage(VkDevice,
+                                             const VkImageCreateInfo*,
+                                             const VkAllocationCallbacks*,
+                                             VkImage* pImage) {
+    *pImage = nextHandle<VkImage>();
+    return VK_SUCCESS;
+}
+// --------------------------------------------------------------------------------
+
+VKAPI_ATTR void VKAPI_CALL vkDestroyImage(VkDevice, VkImage, const VkAllocationCallbacks*) {
+}
+// --------------------------------------------------------------------------------
+
+VKAPI_ATTR void VKAPI_CALL vkGetImageMemoryRequirements(VkDevice,
+                                                        VkImage,
+                                                        VkMemoryRequirements* pMemoryRequirements) {
+    pMemoryRequirements->size = FAKE_IMAGE_SIZE;
+    pMemoryRequirements->alignment = FAKE_ALIGNMENT;
+    pMemoryRequirements->memoryTypeBits = 1;
+}
+// --------------------------------------------------------------------------------
+
+VKAPI_ATTR VkResult VKAPI_CALL vkBindImageMemory(VkDevice, VkImage, VkDeviceMemory, VkDeviceSize) {
+    return VK_SUCCESS;
+}
+// --------------------------------------------------------------------------------
+
+VKAPI_ATTR VkResult VKAPI_CALL vkCreateImageView(VkDevice,
+                                                 const VkImageViewCreateInfo*,
+                                                 const VkAllocationCallbacks*,
+                                                 VkImageView* pView) {
+    *pView = nextHandle<VkImageView>();
+    return VK_SUCCESS;
+}
+// --------------------------------------------------------------------------------
+
+VKAPI_ATTR void VKAPI_CALL vkDestroyImageView(VkDevice, VkImageView, const VkAllocationCallbacks*) {
+}
+// ================================================================================
+// ================================================================================
+// Descriptors
+
+VKAPI_ATTR VkResult VKAPI_CALL vkCreateDescriptorSetLayout(VkDevice,
+                                                           const VkDescriptorSetLayoutCreateInfo*,
+                                                           const VkAllocationCallbacks*,
+                                                           VkDescriptorSetLayout* pSetLayout) {
+    *pSetLayout = nextHandle<VkDescriptorSetLayout>();
+    return VK_SUCCESS;
+}
+// --------------------------------------------------------------------------------
+
+VKAPI_ATTR void VKAPI_CALL vkDestroyDescriptorSetLayout(VkDevice, VkDescriptorSetLayout, const VkAllocationCallbacks*) {
+}
+// --------------------------------------------------------------------------------
+
+VKAPI_ATTR VkResult VKAPI_CALL vkCreateDescriptorPool(VkDevice,
+                                                      const VkDescriptorPoolCreateInfo*,
+                                                      const VkAllocationCallbacks*,
+                                                      VkDescriptorPool* pDescriptorPool) {
+    *pDescriptorPool = nextHandle<VkDescriptorPool>();
+    return VK_SUCCESS;
+}
+// --------------------------------------------------------------------------------
+
+VKAPI_ATTR void VKAPI_CALL vkDestroyDescriptorPool(VkDevice, VkDescriptorPool, const VkAllocationCallbacks*) {
+}
+// --------------------------------------------------------------------------------
+
+VKAPI_ATTR VkResult VKAPI_CALL vkAllocateDescriptorSets(VkDevice,
+                                                        const VkDescriptorSetAllocateInfo* pAllocateInfo,
+                                                        VkDescriptorSet* pDescriptorSets) {
+    fillHandles(pDescriptorSets, pAllocateInfo->descriptorSetCount);
+    return VK_SUCCESS;
+}
+// --------------------------------------------------------------------------------
+
+VKAPI_ATTR void VKAPI_CALL vkUpdateDescriptorSets(VkDevice,
+                                                  uint32_t,
+                                                  const VkWriteDescriptorSet*,
+                                                  uint32_t,
+                                                  const VkCopyDescriptorSet*) {
+}
+// ================================================================================
+// ================================================================================
+// Command buffers
+
+VKAPI_ATTR VkResult VKAPI_CALL vkCreateCommandPool(VkDevice,
+                                                   const VkCommandPoolCreateInfo*,
+                                                   const VkAllocationCallbacks*,
+                                                   VkCommandPool* pCommandPool) {
+    *pCommandPool = nextHandle<VkCommandPool>();
+    return VK_SUCCESS;
+}
+// --------------------------------------------------------------------------------
+
+VKAPI_ATTR void VKAPI_CALL vkDestroyCommandPool(VkDevice, VkCommandPool, const VkAllocationCallbacks*) {
+}
+// --------------------------------------------------------------------------------
+
+VKAPI_ATTR VkResult VKAPI_CALL vkAllocateCommandBuffers(VkDevice,
+                                                        const VkCommandBufferAllocateInfo* pAllocateInfo,
+                                                        VkCommandBuffer* pCommandBuffers) {
+    fillHandles(pCommandBuffers, pAllocateInfo->commandBufferCount);
+    return VK_SUCCESS;
+}
+// --------------------------------------------------------------------------------
+
+VKAPI_ATTR VkResult VKAPI_CALL vkResetCommandBuffer(VkCommandBuffer, VkCommandBufferResetFlags) {
+    return VK_SUCCESS;
+}
+// --------------------------------------------------------------------------------
+
+VKAPI_ATTR VkResult VKAPI_CALL vkBeginCommandBuffer(VkCommandBuffer, const VkCommandBufferBeginInfo*) {
+    return VK_SUCCESS;
+}
+// --------------------------------------------------------------------------------
+
+VKAPI_ATTR VkResult VKAPI_CALL vkEndCommandBuffer(VkCommandBuffer) {
+    return VK_SUCCESS;
+}
+// --------------------------------------------------------------------------------
+
+VKAPI_ATTR void VKAPI_CALL vkCmdPipelineBarrier2(VkCommandBuffer, const VkDependencyInfo*) {
+}
+// --------------------------------------------------------------------------------
+
+VKAPI_ATTR void VKAPI_CALL vkCmdCopyBuffer(VkCommandBuffer, VkBuffer, VkBuffer, uint32_t, const VkBufferCopy*) {
+}
+// --------------------------------------------------------------------------------
+
+VKAPI_ATTR void VKAPI_CALL vkCmdCopyBufferToImage(VkCommandBuffer,
+                                                  VkBuffer,
+                                                  VkImage,
+                                                  VkImageLayout,
+                                                  uint32_t,
+                                                  const VkBufferImageCopy*) {
+}
+// --------------------------------------------------------------------------------
+
+VKAPI_ATTR void VKAPI_CALL vkCmdBindPipeline(VkCommandBuffer, VkPipelineBindPoint, VkPipeline) {
+}
+// --------------------------------------------------------------------------------
+
+VKAPI_ATTR void VKAPI_CALL vkCmdBindDescriptorSets(VkCommandBuffer,
+                                                   VkPipelineBindPoint,
+                                                   VkPipelineLayout,
+                                                   uint32_t,
+                                                   uint32_t,
+                                                   const VkDescriptorSet*,
+                                                   uint32_t,
+                                                   const uint32_t*) {
+}
+// --------------------------------------------------------------------------------
+
+VKAPI_ATTR void VKAPI_CALL vkCmdBindVertexBuffers(VkCommandBuffer,
+                                                  uint32_t,
+                                                  uint32_t,
+                                                  const VkBuffer*,
+                                                  const VkDeviceSize*) {
+}
+// --------------------------------------------------------------------------------
+
+VKAPI_ATTR void VKAPI_CALL vkCmdPushConstants(VkCommandBuffer,
+                                              VkPipelineLayout,
+                                              VkShaderStageFlags,
+                                              uint32_t,
+                                              uint32_t,
+                                              const void*) {
+}
+// --------------------------------------------------------------------------------
+
+VKAPI_ATTR void VKAPI_CALL vkCmdDraw(VkCommandBuffer, uint32_t, uint32_t, uint32_t, uint32_t) {
+}
+// ================================================================================
+// ================================================================================
+// Synchronization and submission
+
+VKAPI_ATTR VkResult VKAPI_CALL vkCreateSemaphore(VkDevice,
+                                                 const VkSemaphoreCreateInfo*,
+                                                 const VkAllocationCallbacks*,
+                                                 VkSemaphore* pSemaphore) {
+    FakeSemaphore* semaphore = static_cast<FakeSemaphore*>(std::calloc(1, sizeof(FakeSemaphore)));
+    if (semaphore == nullptr) {
+        return VK_ERROR_OUT_OF_HOST_MEMORY;
+    }
+    *pSemaphore = reinterpret_cast<VkSemaphore>(semaphore);
+    return VK_SUCCESS;
+}
+// --------------------------------------------------------------------------------
+
+VKAPI_ATTR void VKAPI_CALL vkDestroySemaphore(VkDevice, VkSemaphore semaphore, const VkAllocationCallbacks*) {
+    std::free(reinterpret_cast<FakeSemaphore*>(semaphore));
+}
+// --------------------------------------------------------------------------------
+
+VKAPI_ATTR VkResult VKAPI_CALL vkGetSemaphoreCounterValue(VkDevice, VkSemaphore semaphore, uint64_t* pValue) {
+    *pValue = reinterpret_cast<const FakeSemaphore*>(semaphore)->value;
+    return VK_SUCCESS;
+}
+// --------------------------------------------------------------------------------
+
+VKAPI_ATTR VkResult VKAPI_CALL vkWaitSemaphores(VkDevice, const VkSemaphoreWaitInfo*, uint64_t) {
+    return VK_SUCCESS;
+}
+// --------------------------------------------------------------------------------
+
+VKAPI_ATTR VkResult VKAPI_CALL vkQueueSubmit2(VkQueue, uint32_t submitCount, const VkSubmitInfo2* pSubmits, VkFence) {
+    for (uint32_t i = 0; i < submitCount; i++) {
+        for (uint32_t j = 0; j < pSubmits[i].signalSemaphoreInfoCount; j++) {
+            const VkSemaphoreSubmitInfo& signal = pSubmits[i].pSignalSemaphoreInfos[j];
+            reinterpret_cast<FakeSemaphore*>(signal.semaphore)->value = signal.value;
+        }
+    }
+    return VK_SUCCESS;
+}
+// ================================================================================
+// ================================================================================
+// Objects the deletion queue can destroy but the test never creates
+
+VKAPI_ATTR void VKAPI_CALL vkDestroyFramebuffer(VkDevice, VkFramebuffer, const VkAllocationCallbacks*) {
+}
+// --------------------------------------------------------------------------------
+
+VKAPI_ATTR void VKAPI_CALL vkDestroyPipeline(VkDevice, VkPipeline, const VkAllocationCallbacks*) {
+}
+// --------------------------------------------------------------------------------
+
+VKAPI_ATTR void VKAPI_CALL vkDestroySampler(VkDevice, VkSampler, const VkAllocationCallbacks*) {
+}
+// --------------------------------------------------------------------------------
+
+VKAPI_ATTR void VKAPI_CALL vkDestroyQueryPool(VkDevice, VkQueryPool, const VkAllocationCallbacks*) {
+}
+// --------------------------------------------------------------------------------
+
+VKAPI_ATTR void VKAPI_CALL vkDestroySwapchainKHR(VkDevice, VkSwapchainKHR, const VkAllocationCallbacks*) {
+}
+// ================================================================================
+// ================================================================================
+// eof
@@ -0,0 +1,337 @@
+// ================================================================================
+// ================================================================================
+// - File:    texture_file.cpp
+// - Purpose: Contains the implementation for texture_file.hpp
+//
+// Source Metadata
+// - Author:  Jonathan A. Webb
+// - Date:    October 18, 2026
+// - Version: 1.0
+// - Copyright: Copyright 2022, Jon Webb Inc.
+// ================================================================================
+// ================================================================================
+// Include modules here
+
+#include "include/texture_file.hpp"
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+// ================================================================================
+// ================================================================================
+
+// Enough to hold a DDS header or a KTX2 header with a full level index
+static const size_t TEXTURE_HEADER_READ_SIZE = 4096;
+
+static const uint8_t KTX2_IDENTIFIER[12] = {0xAB, 'K', 'T', 'X', ' ', '2', '0', 0xBB, '\r', '\n', 0x1A, '\n'};
+// --------------------------------------------------------------------------------
+
+// DDS header flags and pixel format flags
+static const uint32_t DDSD_MIPMAPCOUNT = 0x20000;
+static const uint32_t DDSD_DEPTH = 0x800000;
+static const uint32_t DDSCAPS2_CUBEMAP = 0x200;
+static const uint32_t DDPF_FOURCC = 0x4;
+static const uint32_t DDPF_RGB = 0x40;
+static const uint32_t DDS_HEADER_SIZE = 128;
+static const uint32_t DDS_DX10_HEADER_SIZE = 20;
+// --------------------------------------------------------------------------------
+
+static uint32_t readU32(const std::vector<uint8_t>& data, size_t offset) {
+    if (offset + 4 > data.size()) {
+        throw std::runtime_error("texture header is truncated!");
+    }
+    return static_cast<uint32_t>(data[offset]) |
+           static_cast<uint32_t>(data[offset + 1]) << 8 |
+           static_cast<uint32_t>(data[offset + 2]) << 16 |
+           static_cast<uint32_t>(data[offset + 3]) << 24;
+}
+// --------------------------------------------------------------------------------
+
+static uint64_t readU64(const std::vector<uint8_t>& data, size_t offset) {
+    return static_cast<uint64_t>(readU32(data, offset)) |
+           static_cast<uint64_t>(readU32(data, offset + 4)) << 32;
+}
+// --------------------------------------------------------------------------------
+
+static uint32_t fourCC(char a, char b, char c, char d) {
+    return static_cast<uint32_t>(a) | static_cast<uint32_t>(b) << 8 |
+           static_cast<uint32_t>(c) << 16 | static_cast<uint32_t>(d) << 24;
+}
+// --------------------------------------------------------------------------------
+
+// The number of levels down to 1x1, which also bounds the shifts that size them
+static uint32_t fullMipCount(uint32_t width, uint32_t height) {
+    uint32_t count = 1;
+    for (uint32_t size = std::max(width, height); size > 1; size >>= 1) {
+        count++;
+    }
+    return count;
+}
+// --------------------------------------------------------------------------------
+
+static VkFormat formatFromDxgi(uint32_t dxgiFormat) {
+    switch (dxgiFormat) {
+        case 28: return VK_FORMAT_R8G8B8A8_UNORM;
+        case 29: return VK_FORMAT_R8G8B8A8_SRGB;
+        case 71: return VK_FORMAT_BC1_RGBA_UNORM_BLOCK;
+        case 72: return VK_FORMAT_BC1_RGBA_SRGB_BLOCK;
+        case 74: return VK_FORMAT_BC2_UNORM_BLOCK;
+        case 75: return VK_FORMAT_BC2_SRGB_BLOCK;
+        case 77: return VK_FORMAT_BC3_UNORM_BLOCK;
+        case 78: return VK_FORMAT_BC3_SRGB_BLOCK;
+        case 80: return VK_FORMAT_BC4_UNORM_BLOCK;
+        case 81: return VK_FORMAT_BC4_SNORM_BLOCK;
+        case 83: return VK_FORMAT_BC5_UNORM_BLOCK;
+        case 84: return VK_FORMAT_BC5_SNORM_BLOCK;
+        case 95: return VK_FORMAT_BC6H_UFLOAT_BLOCK;
+        case 96: return VK_FORMAT_BC6H_SFLOAT_BLOCK;
+        case 98: return VK_FORMAT_BC7_UNORM_BLOCK;
+        case 99: return VK_FORMAT_BC7_SRGB_BLOCK;
+        default: return VK_FORMAT_UNDEFINED;
+    }
+}
+// ================================================================================
+// ================================================================================
+
+TextureFile::TextureFile(const std::string& path) : path(path) {
+    std::ifstream file(path, std::ios::binary | std::ios::ate);
+    if (!file.is_open()) {
+        throw std::runtime_error("failed to open texture '" + path + "'!");
+    }
+    uint64_t fileSize = static_cast<uint64_t>(file.tellg());
+
+    std::vector<uint8_t> header(static_cast<size_t>(std::min<uint64_t>(fileSize, TEXTURE_HEADER_READ_SIZE)));
+    file.seekg(0);
+    file.read(reinterpret_cast<char*>(header.data()), static_cast<std::streamsize>(header.size()));
+
+    if (header.size() >= sizeof(KTX2_IDENTIFIER) &&
+        std::memcmp(header.data(), KTX2_IDENTIFIER, sizeof(KTX2_IDENTIFIER)) == 0) {
+        parseKtx2(header);
+    } else if (header.size() >= 4 && readU32(header, 0) == fourCC('D', 'D', 'S', ' ')) {
+        parseDds(header);
+    } else {
+        throw std::runtime_error("texture '" + path + "' is neither a DDS nor a KTX2 file!");
+    }
+
+    for (const TextureLevel& level : levels) {
+        // Written so that offsets near the top of the range cannot wrap
+        if (level.fileOffset > fileSize || level.size > fileSize - level.fileOffset) {
+            throw std::runtime_error("texture '" + path + "' is truncated!");
+        }
+    }
+}
+// --------------------------------------------------------------------------------
+
+std::vector<uint8_t> TextureFile::readLevels(uint32_t firstLevel,
+                                             uint32_t levelCount,
+                                             std::vector<uint64_t>& offsets) const {
+    if (firstLevel + levelCount > levels.size()) {
+        throw std::runtime_error("texture level range out of bounds!");
+    }
+
+    std::ifstream file(path, std::ios::binary);
+    if (!file.is_open()) {
+        throw std::runtime_error("failed to open texture '" + path + "'!");
+    }
+
+    std::vector<uint8_t> data(static_cast<size_t>(getSizeFrom(firstLevel) - getSizeFrom(firstLevel + levelCount)));
+    offsets.clear();
+
+    // KTX2 stores the smallest level first, so every level is read separately
+    uint64_t offset = 0;
+    for (uint32_t i = firstLevel; i < firstLevel + levelCount; i++) {
+        const TextureLevel& level = levels[i];
+        file.seekg(static_cast<std::streamoff>(level.fileOffset));
+        file.read(reinterpret_cast<char*>(data.data() + offset), static_cast<std::streamsize>(level.size));
+        if (!file) {
+            throw std::runtime_error("failed to read texture '" + path + "'!");
+        }
+        offsets.push_back(offset);
+        offset += level.size;
+    }
+    return data;
+}
+// --------------------------------------------------------------------------------
+
+const std::string& TextureFile::getPath() const {
+    return path;
+}
+// --------------------------------------------------------------------------------
+
+VkFormat TextureFile::getFormat() const {
+    return format;
+}
+// --------------------------------------------------------------------------------
+
+uint32_t TextureFile::getLevelCount() const {
+    return static_cast<uint32_t>(levels.size());
+}
+// --------------------------------------------------------------------------------
+
+const TextureLevel& TextureFile::getLevel(uint32_t level) const {
+    return levels.at(level);
+}
+// --------------------------------------------------------------------------------
+
+uint64_t TextureFile::getSizeFrom(uint32_t firstLevel) const {
+    uint64_t size = 0;
+    for (uint32_t i = firstLevel; i < levels.size(); i++) {
+        size += levels[i].size;
+    }
+    return size;
+}
+// --------------------------------------------------------------------------------
+
+uint32_t TextureFile::blockSize(VkFormat format) {
+    switch (format) {
+        case VK_FORMAT_BC1_RGB_UNORM_BLOCK:
+        case VK_FORMAT_BC1_RGB_SRGB_BLOCK:
+        case VK_FORMAT_BC1_RGBA_UNORM_BLOCK:
+        case VK_FORMAT_BC1_RGBA_SRGB_BLOCK:
+        case VK_FORMAT_BC4_UNORM_BLOCK:
+        case VK_FORMAT_BC4_SNORM_BLOCK:
+            return 8;
+        case VK_FORMAT_BC2_UNORM_BLOCK:
+        case VK_FORMAT_BC2_SRGB_BLOCK:
+        case VK_FORMAT_BC3_UNORM_BLOCK:
+        case VK_FORMAT_BC3_SRGB_BLOCK:
+        case VK_FORMAT_BC5_UNORM_BLOCK:
+        case VK_FORMAT_BC5_SNORM_BLOCK:
+        case VK_FORMAT_BC6H_UFLOAT_BLOCK:
+        case VK_FORMAT_BC6H_SFLOAT_BLOCK:
+        case VK_FORMAT_BC7_UNORM_BLOCK:
+        case VK_FORMAT_BC7_SRGB_BLOCK:
+            return 16;
+        case VK_FORMAT_R8G8B8A8_UNORM:
+        case VK_FORMAT_R8G8B8A8_SNORM:
+        case VK_FORMAT_R8G8B8A8_SRGB:
+            return 4;
+        case VK_FORMAT_R16G16B16A16_SFLOAT:
+            return 8;
+        case VK_FORMAT_R32G32B32A32_SFLOAT:
+            return 16;
+        default:
+            return 0;
+    }
+}
+// --------------------------------------------------------------------------------
+
+bool TextureFile::isBlockCompressed(VkFormat format) {
+    return format >= VK_FORMAT_BC1_RGB_UNORM_BLOCK && format <= VK_FORMAT_BC7_SRGB_BLOCK;
+}
+// ================================================================================
+
+void TextureFile::parseDds(const std::vector<uint8_t>& header) {
+    if (readU32(header, 4) != 124) {
+        throw std::runtime_error("texture '" + path + "' has an invalid DDS header!");
+    }
+    uint32_t flags = readU32(header, 8);
+    uint32_t height = readU32(header, 12);
+    uint32_t width = readU32(header, 16);
+    uint32_t depth = readU32(header, 24);
+    uint32_t mipCount = (flags & DDSD_MIPMAPCOUNT) ? std::max(readU32(header, 28), 1u) : 1;
+    uint32_t pixelFlags = readU32(header, 80);
+    uint32_t code = readU32(header, 84);
+    uint32_t bitCount = readU32(header, 88);
+    uint32_t caps2 = readU32(header, 112);
+
+    if ((caps2 & DDSCAPS2_CUBEMAP) || ((flags & DDSD_DEPTH) && depth > 1)) {
+        throw std::runtime_error("texture '" + path + "' is not a 2D texture!");
+    }
+    if (width == 0 || height == 0 || mipCount > fullMipCount(width, height)) {
+        throw std::runtime_error("texture '" + path + "' has invalid dimensions or mip count!");
+    }
+
+    uint64_t dataOffset = DDS_HEADER_SIZE;
+    if ((pixelFlags & DDPF_FOURCC) && code == fourCC('D', 'X', '1', '0')) {
+        format = formatFromDxgi(readU32(header, DDS_HEADER_SIZE));
+        if (readU32(header, DDS_HEADER_SIZE + 12) > 1) {
+            throw std::runtime_error("texture '" + path + "' is a texture array!");
+        }
+        dataOffset += DDS_DX10_HEADER_SIZE;
+    } else if (pixelFlags & DDPF_FOURCC) {
+        if (code == fourCC('D', 'X', 'T', '1')) {
+            format = VK_FORMAT_BC1_RGBA_UNORM_BLOCK;
+        } else if (code == fourCC('D', 'X', 'T', '3')) {
+            format = VK_FORMAT_BC2_UNORM_BLOCK;
+        } else if (code == fourCC('D', 'X', 'T', '5')) {
+            format = VK_FORMAT_BC3_UNORM_BLOCK;
+        } else if (code == fourCC('A', 'T', 'I', '1') || code == fourCC('B', 'C', '4', 'U')) {
+            format = VK_FORMAT_BC4_UNORM_BLOCK;
+        } else if (code == fourCC('A', 'T', 'I', '2') || code == fourCC('B', 'C', '5', 'U')) {
+            format = VK_FORMAT_BC5_UNORM_BLOCK;
+        }
+    } else if ((pixelFlags & DDPF_RGB) && bitCount == 32 &&
+               readU32(header, 92) == 0x000000ff && readU32(header, 96) == 0x0000ff00 &&
+               readU32(header, 100) == 0x00ff0000) {
+        format = VK_FORMAT_R8G8B8A8_UNORM;
+    }
+
+    if (blockSize(format) == 0) {
+        throw std::runtime_error("texture '" + path + "' uses an unsupported DDS format!");
+    }
+
+    // DDS stores every level contiguously, largest first
+    uint64_t offset = dataOffset;
+    for (uint32_t i = 0; i < mipCount; i++) {
+        uint32_t levelWidth = std::max(width >> i, 1u);
+        uint32_t levelHeight = std::max(height >> i, 1u);
+        uint64_t size = levelSize(levelWidth, levelHeight);
+        levels.push_back({levelWidth, levelHeight, offset, size});
+        offset += size;
+    }
+}
+// --------------------------------------------------------------------------------
+
+void TextureFile::parseKtx2(const std::vector<uint8_t>& header) {
+    format = static_cast<VkFormat>(readU32(header, 12));
+    uint32_t width = readU32(header, 20);
+    uint32_t height = readU32(header, 24);
+    uint32_t depth = readU32(header, 28);
+    uint32_t layerCount = readU32(header, 32);
+    uint32_t faceCount = readU32(header, 36);
+    uint32_t levelCount = readU32(header, 40);
+    uint32_t supercompression = readU32(header, 44);
+
+    if (format == VK_FORMAT_UNDEFINED || supercompression != 0) {
+        throw std::runtime_error("texture '" + path + "' is supercompressed and needs transcoding!");
+    }
+    if (blockSize(format) == 0) {
+        throw std::runtime_error("texture '" + path + "' uses an unsupported KTX2 format!");
+    }
+    if (depth > 1 || layerCount > 1 || faceCount != 1) {
+        throw std::runtime_error("texture '" + path + "' is not a 2D texture!");
+    }
+    if (levelCount == 0) {
+        throw std::runtime_error("texture '" + path + "' asks for generated mip levels!");
+    }
+    if (width == 0 || height == 0 || levelCount > fullMipCount(width, height)) {
+        throw std::runtime_error("texture '" + path + "' has invalid dimensions or level count!");
+    }
+
+    // The level index follows the fixed header and is indexed from the largest level
+    const size_t levelIndexOffset = 80;
+    for (uint32_t i = 0; i < levelCount; i++) {
+        size_t entry = levelIndexOffset + i * 24;
+        uint64_t offset = readU64(header, entry);
+        uint64_t length = readU64(header, entry + 8);
+        uint32_t levelWidth = std::max(width >> i, 1u);
+        uint32_t levelHeight = std::max(height >> i, 1u);
+        if (length != levelSize(levelWidth, levelHeight)) {
+            throw std::runtime_error("texture '" + path + "' has an inconsistent level index!");
+        }
+        levels.push_back({levelWidth, levelHeight, offset, length});
+    }
+}
+// --------------------------------------------------------------------------------
+
+uint64_t TextureFile::levelSize(uint32_t width, uint32_t height) const {
+    uint64_t block = blockSize(format);
+    if (isBlockCompressed(format)) {
+        return static_cast<uint64_t>((width + 3) / 4) * ((height + 3) / 4) * block;
+    }
+    return static_cast<uint64_t>(width) * height * block;
+}
+// ================================================================================
+// ================================================================================
+// eof
@@ -0,0 +1,588 @@
+// ================================================================================
+// ================================================================================
+// - File:    texture_streamer.cpp
+// - Purpose: Contains the implementation for texture_streamer.hpp
+//
+// Source Metadata
+// - Author:  Jonathan A. Webb
+// - Date:    October 18, 2026
+// - Version: 1.0
+// - Copyright: Copyright 2022, Jon Webb Inc.
+// ================================================================================
+// ================================================================================
+// Include modules here
+
+#include "include/texture_streamer.hpp"
+#include "include/constants.hpp"
+#include "include/host_allocator.hpp"
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+#include <stdexcept>
+// ================================================================================
+// ================================================================================
+
+// Satisfies the texel block size of every supported format and the 4 byte
+// offset alignment vkCmdCopyBufferToImage requires
+static const VkDeviceSize TEXTURE_UPLOAD_ALIGNMENT = 16;
+// ================================================================================
+// ================================================================================
+
+TextureStreamer::TextureStreamer(VkDevice device,
+                                 VkPhysicalDevice physicalDevice,
+                                 const QueueFamilyIndices& queueFamilies,
+                                 VkQueue transferQueue,
+                                 TimelineSemaphore& transferTimeline,
+                                 const TimelineSemaphore& graphicsTimeline,
+                                 ResidencyManager& residency,
+                                 JobSystem& jobs)
+    : device(device),
+      physicalDevice(physicalDevice),
+      transferQueue(transferQueue),
+      transferTimeline(transferTimeline),
+      graphicsTimeline(graphicsTimeline),
+      residency(residency),
+      jobs(jobs) {
+    sharingFamilies.push_back(queueFamilies.graphicsFamily.value());
+    if (queueFamilies.transferFamily.value() != queueFamilies.graphicsFamily.value()) {
+        sharingFamilies.push_back(queueFamilies.transferFamily.value());
+    }
+
+    stagingRing = std::make_unique<StagingRing>(device, physicalDevice, TEXTURE_STAGING_RING_SIZE);
+    commandBuffers = std::make_unique<CommandBufferManager>(device,
+                                                            queueFamilies.transferFamily.value(),
+                                                            TEXTURE_UPLOAD_BATCH_COUNT);
+
+    batches.resize(TEXTURE_UPLOAD_BATCH_COUNT);
+    for (uint32_t i = 0; i < TEXTURE_UPLOAD_BATCH_COUNT; i++) {
+        batches[i].commandBuffer = commandBuffers->getCommandBuffer(i);
+    }
+}
+// --------------------------------------------------------------------------------
+
+TextureStreamer::~TextureStreamer() {
+    jobs.wait(loadCounter);
+    for (const UploadBatch& batch : batches) {
+        transferTimeline.wait(batch.timelineValue);
+    }
+
+    for (auto& entry : images) {
+        destroyImage(entry.second, true);
+    }
+    images.clear();
+}
+// --------------------------------------------------------------------------------
+
+TextureHandle TextureStreamer::load(const std::string& path) {
+    TextureHandle handle = static_cast<TextureHandle>(textures.size());
+    textures.emplace_back();
+    textures.back().path = path;
+    startLoad(handle, true, 0);
+    return handle;
+}
+// --------------------------------------------------------------------------------
+
+void TextureStreamer::requestResolution(TextureHandle handle, uint32_t screenPixels) {
+    textures.at(handle).requestedPixels = screenPixels;
+}
+// --------------------------------------------------------------------------------
+
+void TextureStreamer::markUsed(TextureHandle handle) {
+    Texture& texture = textures.at(handle);
+    texture.lastUsedFrame = currentFrame;
+    if (texture.tailImage != 0) {
+        residency.touch(images.at(texture.tailImage).residencyHandle);
+    }
+    if (texture.streamedImage != 0) {
+        residency.touch(images.at(texture.streamedImage).residencyHandle);
+    }
+}
+// --------------------------------------------------------------------------------
+
+void TextureStreamer::update(uint64_t frameNumber, std::pmr::memory_resource* scratch) {
+    currentFrame = frameNumber;
+    retireBatches();
+    destroyRetiredImages();
+
+    std::vector<LoadResult> completed;
+    {
+        std::lock_guard<std::mutex> lock(completedMutex);
+        completed.swap(completedLoads);
+    }
+
+    for (LoadResult& result : completed) {
+        pendingLoads--;
+        Texture& texture = textures[result.texture];
+        if (result.error.empty() && result.tail) {
+            VkFormatProperties properties{};
+            vkGetPhysicalDeviceFormatProperties(physicalDevice, result.file->getFormat(), &properties);
+            if (!(properties.optimalTilingFeatures & VK_FORMAT_FEATURE_SAMPLED_IMAGE_BIT)) {
+                result.error = "texture '" + texture.path + "' uses a format the device cannot sample!";
+            }
+        }
+        if (!result.error.empty()) {
+            // A missing or malformed asset should not take the renderer down
+            std::cerr << result.error << std::endl;
+            texture.failed = true;
+            texture.loading = false;
+            continue;
+        }
+        if (!texture.file) {
+            texture.file = result.file;
+        }
+        pendingUploads.push_back(std::move(result));
+    }
+
+    submitUploads();
+    balanceResidency(scratch);
+}
+// --------------------------------------------------------------------------------
+
+VkImageView TextureStreamer::getImageView(TextureHandle handle) const {
+    const Texture& texture = textures.at(handle);
+    if (texture.streamedImage != 0) {
+        return images.at(texture.streamedImage).view;
+    }
+    if (texture.tailImage != 0) {
+        return images.at(texture.tailImage).view;
+    }
+    return VK_NULL_HANDLE;
+}
+// --------------------------------------------------------------------------------
+
+uint32_t TextureStreamer::getResidentMip(TextureHandle handle) const {
+    const Texture& texture = textures.at(handle);
+    if (texture.streamedImage != 0) {
+        return images.at(texture.streamedImage).firstMip;
+    }
+    if (texture.tailImage != 0) {
+        return images.at(texture.tailImage).firstMip;
+    }
+    return UINT32_MAX;
+}
+// --------------------------------------------------------------------------------
+
+TextureStreamingStats TextureStreamer::getStats() const {
+    TextureStreamingStats stats;
+    stats.textureCount = static_cast<uint32_t>(textures.size());
+    stats.pendingLoads = pendingLoads;
+    for (const UploadBatch& batch : batches) {
+        stats.batchesInFlight += batch.inFlight ? 1 : 0;
+    }
+    stats.bytesResident = bytesResident;
+    stats.bytesUploaded = bytesUploaded;
+    stats.promotions = promotions;
+    stats.demotions = demotions;
+    return stats;
+}
+// --------------------------------------------------------------------------------
+
+uint32_t TextureStreamer::mipForScreenSize(uint32_t textureSize, uint32_t screenPixels) {
+    screenPixels = std::max(screenPixels, 1u);
+
+    // The sharpest level still needed is the smallest one that covers the
+    // screen footprint; anything larger would only be minified away
+    uint32_t mip = 0;
+    while (mip < 31 && (textureSize >> (mip + 1)) >= screenPixels) {
+        mip++;
+    }
+    return mip;
+}
+// ================================================================================
+
+void TextureStreamer::startLoad(TextureHandle handle, bool tail, uint32_t firstMip) {
+    Texture& texture = textures[handle];
+    texture.loading = true;
+    pendingLoads++;
+
+    std::string path = texture.path;
+    std::shared_ptr<const TextureFile> file = texture.file;
+    jobs.run([this, handle, tail, firstMip, path, file]() {
+        LoadResult result;
+        result.texture = handle;
+        result.tail = tail;
+        try {
+            result.file = file ? file : std::make_shared<const TextureFile>(path);
+            result.firstMip = tail ? tailMip(*result.file) : firstMip;
+            result.data = result.file->readLevels(result.firstMip,
+                                                  result.file->getLevelCount() - result.firstMip,
+                                                  result.offsets);
+        } catch (const std::exception& e) {
+            // Jobs must not throw; the error is reported by update()
+            result.error = e.what();
+        }
+
+        std::lock_guard<std::mutex> lock(completedMutex);
+        completedLoads.push_back(std::move(result));
+    }, &loadCounter);
+}
+// --------------------------------------------------------------------------------
+
+void TextureStreamer::retireBatches() {
+    for (UploadBatch& batch : batches) {
+        if (!batch.inFlight || !transferTimeline.isComplete(batch.timelineValue)) {
+            continue;
+        }
+        batch.inFlight = false;
+        stagingRing->release(batch.ringEnd);
+
+        for (uint64_t id : batch.images) {
+            StreamImage& image = images.at(id);
+            image.uploaded = true;
+
+            Texture& texture = textures[image.texture];
+            texture.loading = false;
+            if (image.tail) {
+                texture.tailImage = id;
+            } else {
+                retireStreamedImage(texture);
+                texture.streamedImage = id;
+                promotions++;
+            }
+        }
+        batch.images.clear();
+    }
+}
+// --------------------------------------------------------------------------------
+
+void TextureStreamer::destroyRetiredImages() {
+    auto expired = [this](const std::pair<uint64_t, uint64_t>& retired) {
+        return graphicsTimeline.isComplete(retired.second);
+    };
+    for (const auto& retired : retiredImages) {
+        if (expired(retired)) {
+            destroyImage(images.at(retired.first), true);
+            images.erase(retired.first);
+        }
+    }
+    retiredImages.erase(std::remove_if(retiredImages.begin(), retiredImages.end(), expired),
+                        retiredImages.end());
+}
+// --------------------------------------------------------------------------------
+
+void TextureStreamer::submitUploads() {
+    if (pendingUploads.empty()) {
+        return;
+    }
+    auto free = std::find_if(batches.begin(), batches.end(),
+                             [](const UploadBatch& batch) { return !batch.inFlight; });
+    if (free == batches.end()) {
+        return;
+    }
+    UploadBatch& batch = *free;
+
+    vkResetCommandBuffer(batch.commandBuffer, 0);
+    VkCommandBufferBeginInfo beginInfo{};
+    beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+    beginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+    if (vkBeginCommandBuffer(batch.commandBuffer, &beginInfo) != VK_SUCCESS) {
+        throw std::runtime_error("failed to begin texture upload command buffer!");
+    }
+
+    // Uploads are recorded in arrival order so tails are never starved
+    size_t recorded = 0;
+    while (recorded < pendingUploads.size() && recordUpload(pendingUploads[recorded], batch)) {
+        recorded++;
+    }
+    pendingUploads.erase(pendingUploads.begin(), pendingUploads.begin() + recorded);
+
+    if (vkEndCommandBuffer(batch.commandBuffer) != VK_SUCCESS) {
+        throw std::runtime_error("failed to record texture upload command buffer!");
+    }
+    if (recorded == 0) {
+        return;
+    }
+
+    batch.ringEnd = stagingRing->getHead();
+
+    batch.timelineValue = transferTimeline.reserve();
+    VkCommandBufferSubmitInfo commandBufferInfo{};
+    commandBufferInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_SUBMIT_INFO;
+    commandBufferInfo.commandBuffer = batch.commandBuffer;
+    VkSemaphoreSubmitInfo signalInfo = transferTimeline.signalInfo(batch.timelineValue,
+                                                                   VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT);
+
+    VkSubmitInfo2 submitInfo{};
+    submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO_2;
+    submitInfo.commandBufferInfoCount = 1;
+    submitInfo.pCommandBufferInfos = &commandBufferInfo;
+    submitInfo.signalSemaphoreInfoCount = 1;
+    submitInfo.pSignalSemaphoreInfos = &signalInfo;
+
+    if (vkQueueSubmit2(transferQueue, 1, &submitInfo, VK_NULL_HANDLE) != VK_SUCCESS) {
+        throw std::runtime_error("failed to submit texture uploads!");
+    }
+    batch.inFlight = true;
+}
+// --------------------------------------------------------------------------------
+
+bool TextureStreamer::recordUpload(LoadResult& load, UploadBatch& batch) {
+    StagingAllocation staging{};
+    if (!stagingRing->allocate(load.data.size(), TEXTURE_UPLOAD_ALIGNMENT, staging)) {
+        return false;
+    }
+    std::memcpy(staging.data, load.data.data(), load.data.size());
+
+    const TextureFile& file = *load.file;
+    const TextureLevel& base = file.getLevel(load.firstMip);
+    uint32_t levelCount = file.getLevelCount() - load.firstMip;
+    Texture& texture = textures[load.texture];
+
+    StreamImage image;
+    image.texture = load.texture;
+    image.tail = load.tail;
+    image.firstMip = load.firstMip;
+
+    VkImageCreateInfo imageInfo{};
+    imageInfo.sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO;
+    imageInfo.imageType = VK_IMAGE_TYPE_2D;
+    imageInfo.format = file.getFormat();
+    imageInfo.extent = {base.width, base.height, 1};
+    imageInfo.mipLevels = levelCount;
+    imageInfo.arrayLayers = 1;
+    imageInfo.samples = VK_SAMPLE_COUNT_1_BIT;
+    imageInfo.tiling = VK_IMAGE_TILING_OPTIMAL;
+    imageInfo.usage = VK_IMAGE_USAGE_TRANSFER_DST_BIT | VK_IMAGE_USAGE_SAMPLED_BIT;
+    imageInfo.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+    if (sharingFamilies.size() > 1) {
+        imageInfo.sharingMode = VK_SHARING_MODE_CONCURRENT;
+        imageInfo.queueFamilyIndexCount = static_cast<uint32_t>(sharingFamilies.size());
+        imageInfo.pQueueFamilyIndices = sharingFamilies.data();
+    } else {
+        imageInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+    }
+
+    if (vkCreateImage(device, &imageInfo, hostAllocator(VK_OBJECT_TYPE_IMAGE), &image.image) != VK_SUCCESS) {
+        throw std::runtime_error("failed to create image for texture '" + texture.path + "'!");
+    }
+
+    VkMemoryRequirements memRequirements;
+    vkGetImageMemoryRequirements(device, image.image, &memRequirements);
+
+    VkMemoryAllocateInfo allocInfo{};
+    allocInfo.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
+    allocInfo.allocationSize = memRequirements.size;
+    allocInfo.memoryTypeIndex = findMemoryType(physicalDevice, memRequirements.memoryTypeBits,
+                                               VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
+
+    uint64_t id = nextImageId++;
+    if (image.tail) {
+        image.residencyHandle = residency.allocate(allocInfo, RESIDENCY_PRIORITY_HIGH,
+                                                   texture.path + " (tail)", nullptr, image.memory);
+    } else {
+        try {
+            image.residencyHandle = residency.allocate(allocInfo, RESIDENCY_PRIORITY_LOW, texture.path,
+                                                       [this, id](VkDeviceSize) { return evictImage(id); },
+                                                       image.memory);
+        } catch (const std::runtime_error&) {
+            // Out of device memory; keep sampling the levels already resident
+            vkDestroyImage(device, image.image, hostAllocator(VK_OBJECT_TYPE_IMAGE));
+            texture.loading = false;
+            return true;
+        }
+    }
+    image.size = memRequirements.size;
+    bytesResident += image.size;
+    vkBindImageMemory(device, image.image, image.memory, 0);
+
+    VkImageViewCreateInfo viewInfo{};
+    viewInfo.sType = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO;
+    viewInfo.image = image.image;
+    viewInfo.viewType = VK_IMAGE_VIEW_TYPE_2D;
+    viewInfo.format = file.getFormat();
+    viewInfo.subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+    viewInfo.subresourceRange.baseMipLevel = 0;
+    viewInfo.subresourceRange.levelCount = levelCount;
+    viewInfo.subresourceRange.baseArrayLayer = 0;
+    viewInfo.subresourceRange.layerCount = 1;
+    if (vkCreateImageView(device, &viewInfo, hostAllocator(VK_OBJECT_TYPE_IMAGE_VIEW), &image.view) != VK_SUCCESS) {
+        throw std::runtime_error("failed to create image view for texture '" + texture.path + "'!");
+    }
+
+    VkImageMemoryBarrier2 barrier{};
+    barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER_2;
+    barrier.srcStageMask = VK_PIPELINE_STAGE_2_NONE;
+    barrier.srcAccessMask = 0;
+    barrier.dstStageMask = VK_PIPELINE_STAGE_2_COPY_BIT;
+    barrier.dstAccessMask = VK_ACCESS_2_TRANSFER_WRITE_BIT;
+    barrier.oldLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+    barrier.newLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+    barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    barrier.image = image.image;
+    barrier.subresourceRange = viewInfo.subresourceRange;
+
+    VkDependencyInfo dependencyInfo{};
+    dependencyInfo.sType = VK_STRUCTURE_TYPE_DEPENDENCY_INFO;
+    dependencyInfo.imageMemoryBarrierCount = 1;
+    dependencyInfo.pImageMemoryBarriers = &barrier;
+    vkCmdPipelineBarrier2(batch.commandBuffer, &dependencyInfo);
+
+    std::vector<VkBufferImageCopy> regions(levelCount);
+    for (uint32_t i = 0; i < levelCount; i++) {
+        const TextureLevel& level = file.getLevel(load.firstMip + i);
+        regions[i] = VkBufferImageCopy{};
+        regions[i].bufferOffset = staging.offset + load.offsets[i];
+        regions[i].imageSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+        regions[i].imageSubresource.mipLevel = i;
+        regions[i].imageSubresource.baseArrayLayer = 0;
+        regions[i].imageSubresource.layerCount = 1;
+        regions[i].imageExtent = {level.width, level.height, 1};
+    }
+    vkCmdCopyBufferToImage(batch.commandBuffer, stagingRing->getBuffer(), image.image,
+                           VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+                           levelCount, regions.data());
+
+    // The transfer queue cannot name fragment shader stages.  The graphics
+    // queue only samples the image after the batch's timeline value has been
+    // observed, which is ordered after every command of the batch.
+    barrier.srcStageMask = VK_PIPELINE_STAGE_2_COPY_BIT;
+    barrier.srcAccessMask = VK_ACCESS_2_TRANSFER_WRITE_BIT;
+    barrier.dstStageMask = VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT;
+    barrier.dstAccessMask = 0;
+    barrier.oldLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+    barrier.newLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+    vkCmdPipelineBarrier2(batch.commandBuffer, &dependencyInfo);
+
+    images[id] = image;
+    batch.images.push_back(id);
+    bytesUploaded += load.data.size();
+    return true;
+}
+// --------------------------------------------------------------------------------
+
+void TextureStreamer::balanceResidency(std::pmr::memory_resource* scratch) {
+    std::pmr::vector<TextureHandle> wanted(scratch);
+    for (TextureHandle handle = 0; handle < textures.size(); handle++) {
+        const Texture& texture = textures[handle];
+        if (texture.file && !texture.failed && !texture.loading && texture.tailImage != 0 &&
+            desiredMip(texture) < getResidentMip(handle)) {
+            wanted.push_back(handle);
+        }
+    }
+
+    // Recently sampled textures first, then those furthest from their target
+    std::sort(wanted.begin(), wanted.end(), [this](TextureHandle a, TextureHandle b) {
+        if (textures[a].lastUsedFrame != textures[b].lastUsedFrame) {
+            return textures[a].lastUsedFrame > textures[b].lastUsedFrame;
+        }
+        return getResidentMip(a) - desiredMip(textures[a]) > getResidentMip(b) - desiredMip(textures[b]);
+    });
+
+    for (TextureHandle handle : wanted) {
+        if (pendingLoads >= TEXTURE_STREAMING_MAX_PENDING_LOADS) {
+            break;
+        }
+        Texture& texture = textures[handle];
+        uint32_t mip = desiredMip(texture);
+        VkDeviceSize cost = texture.file->getSizeFrom(mip);
+
+        if (bytesResident + cost > TEXTURE_STREAMING_BUDGET) {
+            // Release streamed levels sharper than their texture now needs,
+            // least recently used first.  Their memory returns once the GPU is
+            // done with them, so the promotion is retried on a later frame.
+            std::pmr::vector<TextureHandle> victims(scratch);
+            for (TextureHandle other = 0; other < textures.size(); other++) {
+                const Texture& candidate = textures[other];
+                if (other != handle && candidate.streamedImage != 0 &&
+                    images.at(candidate.streamedImage).firstMip < desiredMip(candidate)) {
+                    victims.push_back(other);
+                }
+            }
+            std::sort(victims.begin(), victims.end(), [this](TextureHandle a, TextureHandle b) {
+                return textures[a].lastUsedFrame < textures[b].lastUsedFrame;
+            });
+
+            VkDeviceSize released = 0;
+            for (TextureHandle victim : victims) {
+                if (bytesResident - released + cost <= TEXTURE_STREAMING_BUDGET) {
+                    break;
+                }
+                released += images.at(textures[victim].streamedImage).size;
+                retireStreamedImage(textures[victim]);
+                demotions++;
+            }
+            continue;
+        }
+
+        startLoad(handle, false, mip);
+    }
+}
+// --------------------------------------------------------------------------------
+
+uint32_t TextureStreamer::desiredMip(const Texture& texture) const {
+    const TextureFile& file = *texture.file;
+    const TextureLevel& base = file.getLevel(0);
+    uint32_t last = file.getLevelCount() - 1;
+
+    uint32_t mip = std::min(mipForScreenSize(std::max(base.width, base.height), texture.requestedPixels), last);
+    while (mip < last && file.getSizeFrom(mip) > stagingRing->getSize()) {
+        mip++;
+    }
+    return mip;
+}
+// --------------------------------------------------------------------------------
+
+uint32_t TextureStreamer::tailMip(const TextureFile& file) {
+    uint32_t last = file.getLevelCount() - 1;
+    for (uint32_t i = 0; i < last; i++) {
+        const TextureLevel& level = file.getLevel(i);
+        if (std::max(level.width, level.height) <= TEXTURE_STREAMING_TAIL_SIZE) {
+            return i;
+        }
+    }
+    return last;
+}
+// --------------------------------------------------------------------------------
+
+void TextureStreamer::retireStreamedImage(Texture& texture) {
+    if (texture.streamedImage == 0) {
+        return;
+    }
+    // Frames recorded from now on see the replacement, so only the ones
+    // already submitted can still sample the image
+    retiredImages.emplace_back(texture.streamedImage, graphicsTimeline.getPendingValue());
+    texture.streamedImage = 0;
+}
+// --------------------------------------------------------------------------------
+
+VkDeviceSize TextureStreamer::evictImage(uint64_t imageId) {
+    auto it = images.find(imageId);
+    if (it == images.end()) {
+        return 0;
+    }
+    StreamImage& image = it->second;
+    Texture& texture = textures[image.texture];
+
+    // Uploads in flight and retired images may still be in use by the GPU
+    if (!image.uploaded || texture.streamedImage != imageId) {
+        return image.size;
+    }
+
+    texture.streamedImage = 0;
+    destroyImage(image, false);
+    images.erase(it);
+    demotions++;
+    return 0;
+}
+// --------------------------------------------------------------------------------
+
+void TextureStreamer::destroyImage(StreamImage& image, bool throughResidency) {
+    if (image.view != VK_NULL_HANDLE) {
+        vkDestroyImageView(device, image.view, hostAllocator(VK_OBJECT_TYPE_IMAGE_VIEW));
+    }
+    if (image.image != VK_NULL_HANDLE) {
+        vkDestroyImage(device, image.image, hostAllocator(VK_OBJECT_TYPE_IMAGE));
+    }
+    if (image.memory != VK_NULL_HANDLE) {
+        if (throughResidency) {
+            residency.free(image.residencyHandle, image.memory);
+        } else {
+            vkFreeMemory(device, image.memory, hostAllocator(VK_OBJECT_TYPE_DEVICE_MEMORY));
+        }
+    }
+    bytesResident -= std::min(bytesResident, image.size);
+}
+// ================================================================================
+// ================================================================================
+// eof
@@ -0,0 +1,339 @@
+// ================================================================================
+// ================================================================================
+// - File:    upload_manager.cpp
+// - Purpose: Contains the implementation for upload_manager.hpp
+//
+// Source Metadata
+// - Author:  Jonathan A. Webb
+// - Date:    October 18, 2026
+// - Version: 1.0
+// - Copyright: Copyright 2022, Jon Webb Inc.
+// ================================================================================
+// ================================================================================
+// Include modules here
+
+#include "include/upload_manager.hpp"
+#include <algorithm>
+#include <cstring>
+#include <functional>
+#include <stdexcept>
+// ================================================================================
+// ================================================================================
+
+UploadManager::UploadManager(VkDevice device,
+                             VkPhysicalDevice physicalDevice,
+                             const QueueFamilyIndices& queueFamilies,
+                             VkQueue transferQueue,
+                             TimelineSemaphore& transferTimeline,
+                             const TimelineSemaphore& graphicsTimeline,
+                             VkDeviceSize stagingSize,
+                             uint32_t batchCount)
+    : device(device),
+      transferQueue(transferQueue),
+      transferTimeline(transferTimeline),
+      graphicsTimeline(graphicsTimeline),
+      transferFamily(queueFamilies.transferFamily.value()),
+      graphicsFamily(queueFamilies.graphicsFamily.value()) {
+    stagingRing = std::make_unique<StagingRing>(device, physicalDevice, stagingSize);
+    transferCommandBuffers = std::make_unique<CommandBufferManager>(device, transferFamily, batchCount);
+    if (transferFamily != graphicsFamily) {
+        acquireCommandBuffers = std::make_unique<CommandBufferManager>(device, graphicsFamily, batchCount);
+    }
+
+    batches.resize(batchCount);
+    for (uint32_t i = 0; i < batchCount; i++) {
+        batches[i].transferCommandBuffer = transferCommandBuffers->getCommandBuffer(i);
+        if (acquireCommandBuffers) {
+            batches[i].acquireCommandBuffer = acquireCommandBuffers->getCommandBuffer(i);
+        }
+    }
+}
+// --------------------------------------------------------------------------------
+
+UploadManager::~UploadManager() {
+    for (const UploadBatch& batch : batches) {
+        if (!batch.inFlight) {
+            continue;
+        }
+        transferTimeline.wait(batch.transferValue);
+        if (batch.graphicsValue != 0) {
+            graphicsTimeline.wait(batch.graphicsValue);
+        }
+    }
+}
+// --------------------------------------------------------------------------------
+
+bool UploadManager::write(VkBuffer buffer, VkDeviceSize offset, const void* data, VkDeviceSize size) {
+    if (size == 0) {
+        throw std::runtime_error("upload of zero bytes!");
+    }
+    if (size > stagingRing->getSize()) {
+        throw std::runtime_error("upload is larger than the staging ring!");
+    }
+
+    // Byte alignment keeps consecutive writes contiguous in the ring, which
+    // lets them merge; vkCmdCopyBuffer has no alignment requirement
+    StagingAllocation staging{};
+    if (!stagingRing->allocate(size, 1, staging)) {
+        return false;
+    }
+    std::memcpy(staging.data, data, static_cast<size_t>(size));
+
+    plan.add(buffer, staging.offset, offset, size);
+    stats.writes++;
+    stats.bytes += size;
+    return true;
+}
+// --------------------------------------------------------------------------------
+
+bool UploadManager::submit(UploadSubmission& submission) {
+    retireBatches();
+    if (plan.getWriteCount() == 0) {
+        return false;
+    }
+    auto free = std::find_if(batches.begin(), batches.end(),
+                             [](const UploadBatch& batch) { return !batch.inFlight; });
+    if (free == batches.end()) {
+        return false;
+    }
+    UploadBatch& batch = *free;
+
+    VkCommandBufferBeginInfo beginInfo{};
+    beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+    beginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+
+    vkResetCommandBuffer(batch.transferCommandBuffer, 0);
+    if (vkBeginCommandBuffer(batch.transferCommandBuffer, &beginInfo) != VK_SUCCESS) {
+        throw std::runtime_error("failed to begin upload command buffer!");
+    }
+    recordCopies(batch.transferCommandBuffer);
+    if (vkEndCommandBuffer(batch.transferCommandBuffer) != VK_SUCCESS) {
+        throw std::runtime_error("failed to record upload command buffer!");
+    }
+
+    batch.ringEnd = stagingRing->getHead();
+    batch.transferValue = transferTimeline.reserve();
+    VkCommandBufferSubmitInfo commandBufferInfo{};
+    commandBufferInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_SUBMIT_INFO;
+    commandBufferInfo.commandBuffer = batch.transferCommandBuffer;
+    VkSemaphoreSubmitInfo signalInfo = transferTimeline.signalInfo(batch.transferValue,
+                                                                   VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT);
+
+    VkSubmitInfo2 submitInfo{};
+    submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO_2;
+    submitInfo.commandBufferInfoCount = 1;
+    submitInfo.pCommandBufferInfos = &commandBufferInfo;
+    submitInfo.signalSemaphoreInfoCount = 1;
+    submitInfo.pSignalSemaphoreInfos = &signalInfo;
+
+    if (vkQueueSubmit2(transferQueue, 1, &submitInfo, VK_NULL_HANDLE) != VK_SUCCESS) {
+        throw std::runtime_error("failed to submit uploads!");
+    }
+
+    submission.acquireCommandBuffer = VK_NULL_HANDLE;
+    if (batch.acquireCommandBuffer != VK_NULL_HANDLE) {
+        vkResetCommandBuffer(batch.acquireCommandBuffer, 0);
+        if (vkBeginCommandBuffer(batch.acquireCommandBuffer, &beginInfo) != VK_SUCCESS) {
+            throw std::runtime_error("failed to begin upload acquire command buffer!");
+        }
+        recordAcquire(batch.acquireCommandBuffer);
+        if (vkEndCommandBuffer(batch.acquireCommandBuffer) != VK_SUCCESS) {
+            throw std::runtime_error("failed to record upload acquire command buffer!");
+        }
+        submission.acquireCommandBuffer = batch.acquireCommandBuffer;
+    }
+
+    // The semaphore wait also makes the copies visible when no ownership
+    // transfer is needed
+    submission.waitInfo = transferTimeline.waitInfo(batch.transferValue, VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT);
+
+    batch.graphicsValue = 0;
+    batch.inFlight = true;
+    lastSubmitted = &batch;
+
+    plan.clear();
+    stats.submits++;
+    return true;
+}
+// --------------------------------------------------------------------------------
+
+void UploadManager::submitted(uint64_t graphicsValue) {
+    if (lastSubmitted != nullptr) {
+        lastSubmitted->graphicsValue = graphicsValue;
+        lastSubmitted = nullptr;
+    }
+}
+// --------------------------------------------------------------------------------
+
+void UploadManager::flush(VkQueue queue, uint32_t queueFamily, TimelineSemaphore& timeline) {
+    // Releasing the ring past a batch still in flight would hand its staging
+    // memory out again
+    for (const UploadBatch& batch : batches) {
+        if (batch.inFlight) {
+            throw std::runtime_error("upload flushed while a batch is in flight!");
+        }
+    }
+    UploadSubmission submission;
+    if (!submit(submission)) {
+        return;
+    }
+    UploadBatch& batch = *lastSubmitted;
+
+    // The acquire half of the ownership transfer can only run on the graphics
+    // family; any other reader shares the buffers concurrently and needs none
+    VkCommandBufferSubmitInfo commandBufferInfo{};
+    commandBufferInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_SUBMIT_INFO;
+    commandBufferInfo.commandBuffer = submission.acquireCommandBuffer;
+    bool acquire = submission.acquireCommandBuffer != VK_NULL_HANDLE && queueFamily == graphicsFamily;
+
+    uint64_t value = timeline.reserve();
+    VkSemaphoreSubmitInfo signalInfo = timeline.signalInfo(value, VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT);
+
+    VkSubmitInfo2 submitInfo{};
+    submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO_2;
+    submitInfo.waitSemaphoreInfoCount = 1;
+    submitInfo.pWaitSemaphoreInfos = &submission.waitInfo;
+    submitInfo.commandBufferInfoCount = acquire ? 1 : 0;
+    submitInfo.pCommandBufferInfos = &commandBufferInfo;
+    submitInfo.signalSemaphoreInfoCount = 1;
+    submitInfo.pSignalSemaphoreInfos = &signalInfo;
+    if (vkQueueSubmit2(queue, 1, &submitInfo, VK_NULL_HANDLE) != VK_SUCCESS) {
+        throw std::runtime_error("failed to submit upload flush!");
+    }
+
+    // Runs before the first frame, so a blocking wait is acceptable.  The
+    // reader's timeline is not the one batches retire on, so the batch is
+    // retired here.
+    timeline.wait(value);
+    batch.inFlight = false;
+    stagingRing->release(batch.ringEnd);
+    lastSubmitted = nullptr;
+}
+// --------------------------------------------------------------------------------
+
+VkDeviceSize UploadManager::getStagingSize() const {
+    return stagingRing->getSize();
+}
+// --------------------------------------------------------------------------------
+
+size_t UploadManager::getPendingWriteCount() const {
+    return plan.getWriteCount();
+}
+// --------------------------------------------------------------------------------
+
+const UploadStats& UploadManager::getStats() const {
+    return stats;
+}
+// ================================================================================
+
+void UploadManager::retireBatches() {
+    for (UploadBatch& batch : batches) {
+        // The frame that acquired the batch waited for its copies, so its
+        // value covers both command buffers and the staging memory
+        if (!batch.inFlight || batch.graphicsValue == 0 || !graphicsTimeline.isComplete(batch.graphicsValue)) {
+            continue;
+        }
+        batch.inFlight = false;
+        stagingRing->release(batch.ringEnd);
+    }
+}
+// --------------------------------------------------------------------------------
+
+void UploadManager::recordCopies(VkCommandBuffer commandBuffer) {
+    plan.build();
+    const std::vector<VkBufferCopy>& regions = plan.getRegions();
+
+    ownershipBarriers.clear();
+    for (const UploadCopy& copy : plan.getCopies()) {
+        if (copy.barrierBefore) {
+            VkMemoryBarrier2 barrier{};
+            barrier.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER_2;
+            barrier.srcStageMask = VK_PIPELINE_STAGE_2_COPY_BIT;
+            barrier.srcAccessMask = VK_ACCESS_2_TRANSFER_WRITE_BIT;
+            barrier.dstStageMask = VK_PIPELINE_STAGE_2_COPY_BIT;
+            barrier.dstAccessMask = VK_ACCESS_2_TRANSFER_WRITE_BIT;
+
+            VkDependencyInfo dependencyInfo{};
+            dependencyInfo.sType = VK_STRUCTURE_TYPE_DEPENDENCY_INFO;
+            dependencyInfo.memoryBarrierCount = 1;
+            dependencyInfo.pMemoryBarriers = &barrier;
+            vkCmdPipelineBarrier2(commandBuffer, &dependencyInfo);
+        }
+
+        vkCmdCopyBuffer(commandBuffer, stagingRing->getBuffer(), copy.buffer,
+                        copy.regionCount, regions.data() + copy.firstRegion);
+        stats.copyRegions += copy.regionCount;
+
+        // The release half of the ownership transfer; the destination stages
+        // are ignored on the releasing queue
+        if (transferFamily == graphicsFamily) {
+            continue;
+        }
+        for (uint32_t i = copy.firstRegion; i < copy.firstRegion + copy.regionCount; i++) {
+            VkBufferMemoryBarrier2 barrier{};
+            barrier.sType = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER_2;
+            barrier.srcStageMask = VK_PIPELINE_STAGE_2_COPY_BIT;
+            barrier.srcAccessMask = VK_ACCESS_2_TRANSFER_WRITE_BIT;
+            barrier.dstStageMask = VK_PIPELINE_STAGE_2_NONE;
+            barrier.dstAccessMask = 0;
+            barrier.srcQueueFamilyIndex = transferFamily;
+            barrier.dstQueueFamilyIndex = graphicsFamily;
+            barrier.buffer = copy.buffer;
+            barrier.offset = regions[i].dstOffset;
+            barrier.size = regions[i].size;
+            ownershipBarriers.push_back(barrier);
+        }
+    }
+
+    if (ownershipBarriers.empty()) {
+        return;
+    }
+
+    // A range rewritten by a later group must only be released once, so
+    // overlapping and adjacent ranges are merged
+    std::less<VkBuffer> bufferLess;
+    std::sort(ownershipBarriers.begin(), ownershipBarriers.end(),
+              [&bufferLess](const VkBufferMemoryBarrier2& a, const VkBufferMemoryBarrier2& b) {
+        if (a.buffer != b.buffer) {
+            return bufferLess(a.buffer, b.buffer);
+        }
+        return a.offset < b.offset;
+    });
+    size_t merged = 0;
+    for (size_t i = 1; i < ownershipBarriers.size(); i++) {
+        VkBufferMemoryBarrier2& last = ownershipBarriers[merged];
+        const VkBufferMemoryBarrier2& next = ownershipBarriers[i];
+        if (next.buffer == last.buffer && next.offset <= last.offset + last.size) {
+            last.size = std::max(last.offset + last.size, next.offset + next.size) - last.offset;
+        } else {
+            ownershipBarriers[++merged] = next;
+        }
+    }
+    ownershipBarriers.resize(merged + 1);
+
+    VkDependencyInfo dependencyInfo{};
+    dependencyInfo.sType = VK_STRUCTURE_TYPE_DEPENDENCY_INFO;
+    dependencyInfo.bufferMemoryBarrierCount = static_cast<uint32_t>(ownershipBarriers.size());
+    dependencyInfo.pBufferMemoryBarriers = ownershipBarriers.data();
+    vkCmdPipelineBarrier2(commandBuffer, &dependencyInfo);
+}
+// --------------------------------------------------------------------------------
+
+void UploadManager::recordAcquire(VkCommandBuffer commandBuffer) {
+    // The acquire half repeats the release with the source stages ignored
+    for (VkBufferMemoryBarrier2& barrier : ownershipBarriers) {
+        barrier.srcStageMask = VK_PIPELINE_STAGE_2_NONE;
+        barrier.srcAccessMask = 0;
+        barrier.dstStageMask = VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT;
+        barrier.dstAccessMask = VK_ACCESS_2_MEMORY_READ_BIT;
+    }
+
+    VkDependencyInfo dependencyInfo{};
+    dependencyInfo.sType = VK_STRUCTURE_TYPE_DEPENDENCY_INFO;
+    dependencyInfo.bufferMemoryBarrierCount = static_cast<uint32_t>(ownershipBarriers.size());
+    dependencyInfo.pBufferMemoryBarriers = ownershipBarriers.data();
+    vkCmdPipelineBarrier2(commandBuffer, &dependencyInfo);
+}
+// ================================================================================
+// ================================================================================
+// eof
@@ -0,0 +1,101 @@
+// ================================================================================
+// ================================================================================
+// - File:    upload_plan.cpp
+// - Purpose: Contains the implementation for upload_plan.hpp
+//
+// Source Metadata
+// - Author:  Jonathan A. Webb
+// - Date:    October 18, 2026
+// - Version: 1.0
+// - Copyright: Copyright 2022, Jon Webb Inc.
+// ================================================================================
+// ================================================================================
+// Include modules here
+
+#include "include/upload_plan.hpp"
+#include <algorithm>
+#include <functional>
+// ================================================================================
+// ================================================================================
+
+void UploadPlan::add(VkBuffer buffer, VkDeviceSize srcOffset, VkDeviceSize dstOffset, VkDeviceSize size) {
+    VkDeviceSize end = dstOffset + size;
+    auto span = std::find_if(groupSpans.begin(), groupSpans.end(),
+                             [buffer](const WrittenSpan& written) { return written.buffer == buffer; });
+    if (span != groupSpans.end() && dstOffset < span->end && end > span->begin) {
+        currentGroup++;
+        groupSpans.clear();
+        span = groupSpans.end();
+    }
+    if (span == groupSpans.end()) {
+        groupSpans.push_back({buffer, dstOffset, end});
+    } else {
+        span->begin = std::min(span->begin, dstOffset);
+        span->end = std::max(span->end, end);
+    }
+
+    pendingWrites.push_back({buffer, srcOffset, dstOffset, size, currentGroup});
+}
+// --------------------------------------------------------------------------------
+
+void UploadPlan::build() {
+    std::less<VkBuffer> bufferLess;
+    std::sort(pendingWrites.begin(), pendingWrites.end(),
+              [&bufferLess](const PendingWrite& a, const PendingWrite& b) {
+        if (a.group != b.group) {
+            return a.group < b.group;
+        }
+        if (a.buffer != b.buffer) {
+            return bufferLess(a.buffer, b.buffer);
+        }
+        return a.dstOffset < b.dstOffset;
+    });
+
+    copies.clear();
+    regions.clear();
+    const PendingWrite* previous = nullptr;
+    for (const PendingWrite& write : pendingWrites) {
+        if (previous == nullptr || write.buffer != previous->buffer || write.group != previous->group) {
+            UploadCopy copy;
+            copy.buffer = write.buffer;
+            copy.firstRegion = static_cast<uint32_t>(regions.size());
+            copy.barrierBefore = previous != nullptr && write.group != previous->group;
+            copies.push_back(copy);
+            regions.push_back({write.srcOffset, write.dstOffset, write.size});
+        } else if (regions.back().srcOffset + regions.back().size == write.srcOffset &&
+                   regions.back().dstOffset + regions.back().size == write.dstOffset) {
+            regions.back().size += write.size;
+        } else {
+            regions.push_back({write.srcOffset, write.dstOffset, write.size});
+        }
+        copies.back().regionCount = static_cast<uint32_t>(regions.size()) - copies.back().firstRegion;
+        previous = &write;
+    }
+}
+// --------------------------------------------------------------------------------
+
+void UploadPlan::clear() {
+    pendingWrites.clear();
+    groupSpans.clear();
+    copies.clear();
+    regions.clear();
+    currentGroup = 0;
+}
+// --------------------------------------------------------------------------------
+
+size_t UploadPlan::getWriteCount() const {
+    return pendingWrites.size();
+}
+// --------------------------------------------------------------------------------
+
+const std::vector<UploadCopy>& UploadPlan::getCopies() const {
+    return copies;
+}
+// --------------------------------------------------------------------------------
+
+const std::vector<VkBufferCopy>& UploadPlan::getRegions() const {
+    return regions;
+}
+// ================================================================================
+// ================================================================================
+// eof
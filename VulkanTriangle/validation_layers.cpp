@@ -13,6 +13,7 @@
 // Include modules here
 
 #include "include/validation_layers.hpp"
+#include "include/host_allocator.hpp"
 #include <stdexcept>
 #include <cstring>
 #include <iostream>
@@ -56,11 +57,13 @@ bool ValidationLayers::isEnabled() const {
 // --------------------------------------------------------------------------------
 
 std::vector<const char*> ValidationLayers::getRequiredExtensions() const {
-    uint32_t glfwExtensionCount = 0;
-    const char** glfwExtensions;
-    glfwExtensions = window->getRequiredInstanceExtensions(&glfwExtensionCount);
-
-    std::vector<const char*> extensions(glfwExtensions, glfwExtensions + glfwExtensionCount);
+    // A headless instance has no window and needs no surface extensions
+    std::vector<const char*> extensions;
+    if (window) {
+        uint32_t glfwExtensionCount = 0;
+        const char** glfwExtensions = window->getRequiredInstanceExtensions(&glfwExtensionCount);
+        extensions.assign(glfwExtensions, glfwExtensions + glfwExtensionCount);
+    }
 
     if (enableValidationLayers) {
         extensions.push_back(VK_EXT_DEBUG_UTILS_EXTENSION_NAME);
@@ -76,7 +79,7 @@ void ValidationLayers::setupDebugMessenger(VkInstance instance) {
     VkDebugUtilsMessengerCreateInfoEXT createInfo;
     populateDebugMessengerCreateInfo(createInfo);
 
-    if (CreateDebugUtilsMessengerEXT(instance, &createInfo, nullptr, &debugMessenger) != VK_SUCCESS) {
+    if (CreateDebugUtilsMessengerEXT(instance, &createInfo, hostAllocator(VK_OBJECT_TYPE_DEBUG_UTILS_MESSENGER_EXT), &debugMessenger) != VK_SUCCESS) {
         throw std::runtime_error("failed to set up debug messenger!");
     }
 }
@@ -84,7 +87,7 @@ void ValidationLayers::setupDebugMessenger(VkInstance instance) {
 
 void ValidationLayers::cleanup(VkInstance instance) {
     if (enableValidationLayers) {
-        DestroyDebugUtilsMessengerEXT(instance, debugMessenger, nullptr);
+        DestroyDebugUtilsMessengerEXT(instance, debugMessenger, hostAllocator(VK_OBJECT_TYPE_DEBUG_UTILS_MESSENGER_EXT));
     }
 }
 // --------------------------------------------------------------------------------
@@ -95,28 +98,31 @@ VkDebugUtilsMessengerEXT ValidationLayers::getDebugMessenger() const {
 // --------------------------------------------------------------------------------
 
 bool ValidationLayers::checkValidationLayerSupport() {
-    uint32_t layerCount;
-    vkEnumerateInstanceLayerProperties(&layerCount, nullptr);
-
-    std::vector<VkLayerProperties> availableLayers(layerCount);
-    vkEnumerateInstanceLayerProperties(&layerCount, availableLayers.data());
-
-    for (const char* layerName : validationLayers) {
-        bool layerFound = false;
+    std::call_once(layerSupportQueried, [this]() {
+        uint32_t layerCount;
+        vkEnumerateInstanceLayerProperties(&layerCount, nullptr);
+
+        std::vector<VkLayerProperties> availableLayers(layerCount);
+        vkEnumerateInstanceLayerProperties(&layerCount, availableLayers.data());
+
+        layerSupport = true;
+        for (const char* layerName : validationLayers) {
+            bool layerFound = false;
+
+            for (const auto& layerProperties : availableLayers) {
+                if (strcmp(layerName, layerProperties.layerName) == 0) {
+                    layerFound = true;
+                    break;
+                }
+            }
 
-        for (const auto& layerProperties : availableLayers) {
-            if (strcmp(layerName, layerProperties.layerName) == 0) {
-                layerFound = true;
+            if (!layerFound) {
+                layerSupport = false;
                 break;
             }
         }
-
-        if (!layerFound) {
-            return false;
-        }
-    }
-
-    return true;
+    });
+    return layerSupport;
 }
 // --------------------------------------------------------------------------------
 
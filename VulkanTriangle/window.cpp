@@ -40,6 +40,15 @@ GlfwWindow::GlfwWindow(uint32_t h,
         glfwTerminate();
         throw std::runtime_error("GLFW Instantiation failed!\n");
     }
+
+    mainThread = std::this_thread::get_id();
+    iconified = glfwGetWindowAttrib(window, GLFW_ICONIFIED) != 0;
+    glfwSetWindowUserPointer(window, this);
+    glfwSetFramebufferSizeCallback(window, framebufferSizeCallback);
+    glfwSetWindowIconifyCallback(window, iconifyCallback);
+    glfwSetKeyCallback(window, keyCallback);
+    glfwSetMouseButtonCallback(window, mouseButtonCallback);
+    glfwSetCursorPosCallback(window, cursorPositionCallback);
 }
 // --------------------------------------------------------------------------------
 
@@ -63,6 +72,26 @@ void GlfwWindow::pollEvents() {
 }
 // --------------------------------------------------------------------------------
 
+void GlfwWindow::waitEventsTimeout(double timeout) {
+    glfwWaitEventsTimeout(timeout);
+}
+// --------------------------------------------------------------------------------
+
+bool GlfwWindow::isMinimized() {
+    return glfwGetWindowAttrib(window, GLFW_ICONIFIED) || !glfwGetWindowAttrib(window, GLFW_VISIBLE);
+}
+// --------------------------------------------------------------------------------
+
+bool GlfwWindow::isIconified() {
+    return iconified;
+}
+// --------------------------------------------------------------------------------
+
+void GlfwWindow::setEventQueue(WindowEventQueue* queue) {
+    eventQueue = queue;
+}
+// --------------------------------------------------------------------------------
+
 bool GlfwWindow::isInstance() {
     return glfw_terminated;
 }
@@ -82,7 +111,14 @@ VkResult GlfwWindow::createWindowSurface(VkInstance instance,
 // --------------------------------------------------------------------------------
 
 void GlfwWindow::getFrameBufferSize() {
-    glfwGetFramebufferSize(window, reinterpret_cast<int*>(&width), reinterpret_cast<int*>(&height));
+    if (std::this_thread::get_id() != mainThread) {
+        return;
+    }
+    int w = 0;
+    int h = 0;
+    glfwGetFramebufferSize(window, &w, &h);
+    width = static_cast<uint32_t>(w);
+    height = static_cast<uint32_t>(h);
 }
 // --------------------------------------------------------------------------------
 
@@ -95,5 +131,58 @@ uint32_t GlfwWindow::get_height() {
     return height;
 }
 // ================================================================================
+
+void GlfwWindow::forwardEvent(const WindowEvent& event) {
+    if (eventQueue != nullptr) {
+        eventQueue->push(event);
+    }
+}
+// --------------------------------------------------------------------------------
+
+void GlfwWindow::framebufferSizeCallback(GLFWwindow* window, int width, int height) {
+    GlfwWindow* self = static_cast<GlfwWindow*>(glfwGetWindowUserPointer(window));
+    self->width = static_cast<uint32_t>(width);
+    self->height = static_cast<uint32_t>(height);
+}
+// --------------------------------------------------------------------------------
+
+void GlfwWindow::iconifyCallback(GLFWwindow* window, int iconified) {
+    GlfwWindow* self = static_cast<GlfwWindow*>(glfwGetWindowUserPointer(window));
+    self->iconified = iconified != 0;
+}
+// --------------------------------------------------------------------------------
+
+void GlfwWindow::keyCallback(GLFWwindow* window, int key, int scancode, int action, int mods) {
+    (void)scancode;
+    GlfwWindow* self = static_cast<GlfwWindow*>(glfwGetWindowUserPointer(window));
+    WindowEvent event;
+    event.type = WindowEventType::Key;
+    event.key = key;
+    event.action = action;
+    event.mods = mods;
+    self->forwardEvent(event);
+}
+// --------------------------------------------------------------------------------
+
+void GlfwWindow::mouseButtonCallback(GLFWwindow* window, int button, int action, int mods) {
+    GlfwWindow* self = static_cast<GlfwWindow*>(glfwGetWindowUserPointer(window));
+    WindowEvent event;
+    event.type = WindowEventType::MouseButton;
+    event.key = button;
+    event.action = action;
+    event.mods = mods;
+    self->forwardEvent(event);
+}
+// --------------------------------------------------------------------------------
+
+void GlfwWindow::cursorPositionCallback(GLFWwindow* window, double x, double y) {
+    GlfwWindow* self = static_cast<GlfwWindow*>(glfwGetWindowUserPointer(window));
+    WindowEvent event;
+    event.type = WindowEventType::CursorPosition;
+    event.x = x;
+    event.y = y;
+    self->forwardEvent(event);
+}
+// ================================================================================
 // ================================================================================
 // eof